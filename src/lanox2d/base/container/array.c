@@ -171,6 +171,11 @@ lx_size_t lx_array_size(lx_array_ref_t self) {
     return array? array->size : 0;
 }
 
+lx_size_t lx_array_maxn(lx_array_ref_t self) {
+    lx_array_t* array = (lx_array_t*)self;
+    return array? array->maxn : 0;
+}
+
 lx_pointer_t lx_array_head(lx_array_ref_t self) {
     lx_array_t* array = (lx_array_t*)self;
     if (array && array->data && array->size) {
@@ -73,6 +73,14 @@ lx_pointer_t        lx_array_data(lx_array_ref_t array);
  */
 lx_size_t           lx_array_size(lx_array_ref_t array);
 
+/*! get the array maxn
+ *
+ * @param array     the array
+ *
+ * @return          the array maxn
+ */
+lx_size_t           lx_array_maxn(lx_array_ref_t array);
+
 /*! get the array head item
  *
  * @param array     the array
@@ -199,6 +199,12 @@ lx_size_t lx_list_size(lx_list_ref_t self) {
     return lx_list_entry_size(&list->head);
 }
 
+lx_size_t lx_list_allocs(lx_list_ref_t self) {
+    lx_list_t* list = (lx_list_t*)self;
+    lx_assert_and_check_return_val(list && list->pool, 0);
+    return lx_fixed_pool_allocs(list->pool);
+}
+
 lx_size_t lx_list_insert_prev(lx_list_ref_t self, lx_size_t itor, lx_cpointer_t data) {
     lx_list_t* list = (lx_list_t*)self;
     lx_assert_and_check_return_val(list && list->pool, 0);
@@ -163,6 +163,14 @@ lx_size_t           lx_list_remove(lx_list_ref_t list, lx_size_t itor);
  */
 lx_size_t           lx_list_size(lx_list_ref_t list);
 
+/*! the slot allocation count of the item pool
+ *
+ * @param list      the list
+ *
+ * @return          the allocation count
+ */
+lx_size_t           lx_list_allocs(lx_list_ref_t list);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
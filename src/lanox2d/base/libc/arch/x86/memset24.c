@@ -0,0 +1,159 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        memset24.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#ifdef LX_ARCH_SIMD_DISPATCH
+#   include "../../../platform/cpu.h"
+#   include <immintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef LX_ARCH_SIMD_DISPATCH
+#   define LX_LIBC_ARCH_MEMSET24
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef LX_ARCH_SIMD_DISPATCH
+typedef lx_void_t (*lx_memset24_func_t)(lx_byte_t* p, lx_uint32_t c, lx_size_t n);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef LX_ARCH_SIMD_DISPATCH
+static lx_void_t lx_memset24_opt_v0(lx_byte_t* p, lx_uint32_t c, lx_size_t n) {
+    lx_size_t l = n & 0x3; n = (n - l) >> 2;
+    while (n--) {
+        lx_bits_set_u24_ne(p + 0, c);
+        lx_bits_set_u24_ne(p + 3, c);
+        lx_bits_set_u24_ne(p + 6, c);
+        lx_bits_set_u24_ne(p + 9, c);
+        p += 12;
+    }
+    while (l--) {
+        lx_bits_set_u24_ne(p, c);
+        p += 3;
+    }
+}
+
+/* the 24-bits pixels are not aligned by the vector size,
+ * so we fill the lcm(3, size) bytes with three unaligned stores of the repeated pattern each time
+ */
+static lx_target("sse2") lx_void_t lx_memset24_opt_v2(lx_byte_t* p, lx_uint32_t c, lx_size_t n) {
+    if (n >= 16) {
+        lx_byte_t b[48];
+        lx_memset24_opt_v0(b, c, 16);
+
+        // l = n % 16
+        lx_size_t l = n & 0x0f; n = (n - l) >> 4;
+
+        // fill 3 x 16 bytes
+        __m128i v0 = _mm_loadu_si128((__m128i const*)(b + 0));
+        __m128i v1 = _mm_loadu_si128((__m128i const*)(b + 16));
+        __m128i v2 = _mm_loadu_si128((__m128i const*)(b + 32));
+        while (n) {
+            _mm_storeu_si128((__m128i*)(p + 0), v0);
+            _mm_storeu_si128((__m128i*)(p + 16), v1);
+            _mm_storeu_si128((__m128i*)(p + 32), v2);
+            p += 48;
+            --n;
+        }
+        n = l;
+    }
+    lx_memset24_opt_v0(p, c, n);
+}
+
+static lx_target("avx2") lx_void_t lx_memset24_opt_v3(lx_byte_t* p, lx_uint32_t c, lx_size_t n) {
+    if (n >= 32) {
+        lx_byte_t b[96];
+        lx_memset24_opt_v0(b, c, 32);
+
+        // l = n % 32
+        lx_size_t l = n & 0x1f; n = (n - l) >> 5;
+
+        // fill 3 x 32 bytes
+        __m256i v0 = _mm256_loadu_si256((__m256i const*)(b + 0));
+        __m256i v1 = _mm256_loadu_si256((__m256i const*)(b + 32));
+        __m256i v2 = _mm256_loadu_si256((__m256i const*)(b + 64));
+        while (n) {
+            _mm256_storeu_si256((__m256i*)(p + 0), v0);
+            _mm256_storeu_si256((__m256i*)(p + 32), v1);
+            _mm256_storeu_si256((__m256i*)(p + 64), v2);
+            p += 96;
+            --n;
+        }
+        n = l;
+    }
+    lx_memset24_opt_v0(p, c, n);
+}
+
+static lx_target("avx512f,avx512bw") lx_void_t lx_memset24_opt_v4(lx_byte_t* p, lx_uint32_t c, lx_size_t n) {
+    if (n >= 64) {
+        lx_byte_t b[192];
+        lx_memset24_opt_v0(b, c, 64);
+
+        // l = n % 64
+        lx_size_t l = n & 0x3f; n = (n - l) >> 6;
+
+        // fill 3 x 64 bytes
+        __m512i v0 = _mm512_loadu_si512((lx_pointer_t)(b + 0));
+        __m512i v1 = _mm512_loadu_si512((lx_pointer_t)(b + 64));
+        __m512i v2 = _mm512_loadu_si512((lx_pointer_t)(b + 128));
+        while (n) {
+            _mm512_storeu_si512((lx_pointer_t)(p + 0), v0);
+            _mm512_storeu_si512((lx_pointer_t)(p + 64), v1);
+            _mm512_storeu_si512((lx_pointer_t)(p + 128), v2);
+            p += 192;
+            --n;
+        }
+        n = l;
+    }
+    lx_memset24_opt_v0(p, c, n);
+}
+
+/* select the best implementation for the current cpu at the first call
+ *
+ * it may be selected repeatly by the concurrent threads, but they always get the same function.
+ */
+static lx_void_t lx_memset24_opt_init(lx_byte_t* p, lx_uint32_t c, lx_size_t n);
+static lx_memset24_func_t g_memset24_opt = lx_memset24_opt_init;
+static lx_void_t lx_memset24_opt_init(lx_byte_t* p, lx_uint32_t c, lx_size_t n) {
+    lx_size_t features = lx_cpu_features();
+    lx_memset24_func_t func = lx_memset24_opt_v0;
+    if (features & LX_CPU_FEATURE_AVX512) func = lx_memset24_opt_v4;
+    else if (features & LX_CPU_FEATURE_AVX2) func = lx_memset24_opt_v3;
+    else if (features & LX_CPU_FEATURE_SSE2) func = lx_memset24_opt_v2;
+    g_memset24_opt = func;
+    func(p, c, n);
+}
+
+lx_pointer_t lx_memset24(lx_pointer_t s, lx_uint32_t c, lx_size_t n) {
+    if (n) g_memset24_opt((lx_byte_t*)s, c, n);
+    return s;
+}
+#endif
@@ -23,21 +23,46 @@
  * includes
  */
 #include "prefix.h"
-#ifdef LX_ARCH_SSE2
+#if defined(LX_ARCH_SIMD_DISPATCH)
+#   include "../../../platform/cpu.h"
+#   include <immintrin.h>
+#elif defined(LX_ARCH_SSE2)
 #   include <emmintrin.h>
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#if (defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32) || defined(LX_ARCH_SSE2)
+#if (defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32) || defined(LX_ARCH_SSE2) || defined(LX_ARCH_SIMD_DISPATCH)
 #   define LX_LIBC_ARCH_MEMSET32
 #endif
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef LX_ARCH_SIMD_DISPATCH
+typedef lx_void_t (*lx_memset32_func_t)(lx_uint32_t* s, lx_uint32_t c, lx_size_t n);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32
+#ifdef LX_ARCH_SIMD_DISPATCH
+static lx_void_t lx_memset32_opt_v0(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
+    lx_size_t l = n & 0x3; n = (n - l) >> 2;
+    while (n--) {
+        s[0] = c;
+        s[1] = c;
+        s[2] = c;
+        s[3] = c;
+        s += 4;
+    }
+    while (l--) *s++ = c;
+}
+#endif
+
+// the rep stos version is only used without the runtime dispatch, all sizes will be dispatched to the selected version
+#if defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32 && !defined(LX_ARCH_SIMD_DISPATCH)
 static lx_inline lx_void_t lx_memset32_opt_v1(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
     lx_asm lx_volatile
     (
@@ -49,8 +74,8 @@ static lx_inline lx_void_t lx_memset32_opt_v1(lx_uint32_t* s, lx_uint32_t c, lx_
 }
 #endif
 
-#ifdef LX_ARCH_SSE2
-static lx_inline lx_void_t lx_memset32_opt_v2(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
+#if defined(LX_ARCH_SSE2) || defined(LX_ARCH_SIMD_DISPATCH)
+static lx_target("sse2") lx_void_t lx_memset32_opt_v2(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
     if (n >= 16) {
         // aligned by 16-bytes
         for (; ((lx_size_t)s) & 0x0f; --n) *s++ = c;
@@ -75,11 +100,79 @@ static lx_inline lx_void_t lx_memset32_opt_v2(lx_uint32_t* s, lx_uint32_t c, lx_
 }
 #endif
 
+#ifdef LX_ARCH_SIMD_DISPATCH
+static lx_target("avx2") lx_void_t lx_memset32_opt_v3(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
+    if (n >= 32) {
+        // aligned by 32-bytes
+        for (; ((lx_size_t)s) & 0x1f; --n) *s++ = c;
+
+        // l = n % 32
+        lx_size_t l = n & 0x1f; n = (n - l) >> 5;
+
+        // fill 4 x 32 bytes
+        __m256i*    d = (__m256i*)(s);
+        __m256i     v = _mm256_set1_epi32(c);
+        while (n) {
+            _mm256_store_si256(d++, v);
+            _mm256_store_si256(d++, v);
+            _mm256_store_si256(d++, v);
+            _mm256_store_si256(d++, v);
+            --n;
+        }
+        s = (lx_uint32_t*)(d);
+        n = l;
+    }
+    while (n--) *s++ = c;
+}
+
+static lx_target("avx512f,avx512bw") lx_void_t lx_memset32_opt_v4(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
+    if (n >= 64) {
+        // aligned by 64-bytes
+        for (; ((lx_size_t)s) & 0x3f; --n) *s++ = c;
+
+        // l = n % 64
+        lx_size_t l = n & 0x3f; n = (n - l) >> 6;
+
+        // fill 4 x 64 bytes
+        __m512i*    d = (__m512i*)(s);
+        __m512i     v = _mm512_set1_epi32(c);
+        while (n) {
+            _mm512_store_si512(d++, v);
+            _mm512_store_si512(d++, v);
+            _mm512_store_si512(d++, v);
+            _mm512_store_si512(d++, v);
+            --n;
+        }
+        s = (lx_uint32_t*)(d);
+        n = l;
+    }
+    while (n--) *s++ = c;
+}
+
+/* select the best implementation for the current cpu at the first call
+ *
+ * it may be selected repeatly by the concurrent threads, but they always get the same function.
+ */
+static lx_void_t lx_memset32_opt_init(lx_uint32_t* s, lx_uint32_t c, lx_size_t n);
+static lx_memset32_func_t g_memset32_opt = lx_memset32_opt_init;
+static lx_void_t lx_memset32_opt_init(lx_uint32_t* s, lx_uint32_t c, lx_size_t n) {
+    lx_size_t features = lx_cpu_features();
+    lx_memset32_func_t func = lx_memset32_opt_v0;
+    if (features & LX_CPU_FEATURE_AVX512) func = lx_memset32_opt_v4;
+    else if (features & LX_CPU_FEATURE_AVX2) func = lx_memset32_opt_v3;
+    else if (features & LX_CPU_FEATURE_SSE2) func = lx_memset32_opt_v2;
+    g_memset32_opt = func;
+    func(s, c, n);
+}
+#endif
+
 #ifdef LX_LIBC_ARCH_MEMSET32
 lx_pointer_t lx_memset32(lx_pointer_t s, lx_uint32_t c, lx_size_t n) {
     lx_assert(!(((lx_size_t)s) & 0x3));
     if (!n) return s;
-#   if (defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32) &&  defined(LX_ARCH_SSE2)
+#   if defined(LX_ARCH_SIMD_DISPATCH)
+    g_memset32_opt(s, c, n);
+#   elif (defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32) &&  defined(LX_ARCH_SSE2)
     if (n < 2049) lx_memset32_opt_v2(s, c, n);
     else lx_memset32_opt_v1(s, c, n);
 #   elif defined(LX_ASSEMBLER_IS_GAS) && LX_CPU_BIT32
@@ -183,6 +183,16 @@ lx_pointer_t        lx_memcpy(lx_pointer_t s1, lx_cpointer_t s2, lx_size_t n);
  */
 lx_pointer_t        lx_memmov(lx_pointer_t s1, lx_cpointer_t s2, lx_size_t n);
 
+/*! memcmp
+ *
+ * @param s1        the first data
+ * @param s2        the second data
+ * @param n         the data size
+ *
+ * @return          zero if equal, otherwise the difference
+ */
+lx_long_t           lx_memcmp(lx_cpointer_t s1, lx_cpointer_t s2, lx_size_t n);
+
 /*! strlen
  *
  * @param s         the c-string
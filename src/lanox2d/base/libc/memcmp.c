@@ -0,0 +1,33 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        memcmp.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "libc.h"
+#include <string.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_long_t lx_memcmp(lx_cpointer_t s1, lx_cpointer_t s2, lx_size_t n) {
+    return memcmp(s1, s2, n);
+}
@@ -24,16 +24,20 @@
  */
 #include "libc.h"
 #include "../utils/bits.h"
+#if defined(LX_ARCH_x86) || defined(LX_ARCH_x64)
+#    include "arch/x86/memset24.c"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+#ifndef LX_LIBC_ARCH_MEMSET24
 lx_pointer_t lx_memset24(lx_pointer_t s, lx_uint32_t c, lx_size_t n) {
     lx_check_return_val(n, s);
 
+    lx_size_t l = n & 0x3; n -= l;
     lx_register lx_byte_t* p = (lx_byte_t*)s;
     lx_register lx_byte_t* e = p + (n * 3);
-    lx_size_t l = n & 0x3; n -= l;
     while (p < e) {
         lx_bits_set_u24_ne(p + 0, c);
         lx_bits_set_u24_ne(p + 3, c);
@@ -47,3 +51,4 @@ lx_pointer_t lx_memset24(lx_pointer_t s, lx_uint32_t c, lx_size_t n) {
     }
     return s;
 }
+#endif
@@ -129,6 +129,8 @@ lx_bool_t lx_matrix_invert(lx_matrix_ref_t matrix) {
             // compute sx and tx
             mx.sx = 1.0f / matrix->sx;
             mx.tx = -matrix->tx / matrix->sx;
+        } else {
+            mx.tx = -matrix->tx;
         }
 
         // invert it if sy != 1.0
@@ -140,6 +142,8 @@ lx_bool_t lx_matrix_invert(lx_matrix_ref_t matrix) {
             // compute sy and ty
             mx.sy = 1.0f / matrix->sy;
             mx.ty = -matrix->ty / matrix->sy;
+        } else {
+            mx.ty = -matrix->ty;
         }
     } else {
         /* |A|
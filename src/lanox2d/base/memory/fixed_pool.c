@@ -60,6 +60,7 @@ typedef struct lx_fixed_pool_t_ {
     lx_uint16_t                     slot_count;
     lx_uint16_t                     item_size;
     lx_uint32_t                     item_count;
+    lx_uint32_t                     slot_allocs;
 }lx_fixed_pool_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -122,6 +123,9 @@ static lx_fixed_pool_slot_t* lx_fixed_pool_slot_init(lx_fixed_pool_t* pool) {
         lx_assert_and_check_break(slot);
         lx_assert_and_check_break(need_space > sizeof(lx_fixed_pool_slot_t) + item_space);
 
+        // update the slot allocation count
+        pool->slot_allocs++;
+
         // init slot
         slot->size = need_space;
         slot->pool = lx_static_fixed_pool_init((lx_byte_t*)&slot[1], need_space - sizeof(lx_fixed_pool_slot_t), pool->item_size);
@@ -229,6 +233,21 @@ lx_void_t lx_fixed_pool_exit(lx_fixed_pool_ref_t self) {
     lx_fixed_pool_t* pool = (lx_fixed_pool_t*)self;
     if (pool) {
         lx_fixed_pool_clear(self);
+
+        // exit the cleared slots
+        lx_iterator_t iterator;
+        lx_iterator_of(&iterator, lx_list_entry_itor(&pool->partial_slots));
+        lx_size_t itor = lx_iterator_head(&iterator);
+        while (itor != lx_iterator_tail(&iterator)) {
+            lx_fixed_pool_slot_t* slot = (lx_fixed_pool_slot_t*)lx_iterator_item(&iterator, itor);
+            lx_assert_and_check_break(slot);
+            lx_size_t next = lx_iterator_next(&iterator, itor);
+            lx_fixed_pool_slot_exit(pool, slot);
+            itor = next;
+        }
+        lx_list_entry_clear(&pool->partial_slots);
+
+        // exit the current slot
         if (pool->current_slot) {
             lx_fixed_pool_slot_exit(pool, pool->current_slot);
             pool->current_slot = lx_null;
@@ -250,6 +269,12 @@ lx_size_t lx_fixed_pool_size(lx_fixed_pool_ref_t self) {
     return pool? pool->item_count : 0;
 }
 
+lx_size_t lx_fixed_pool_allocs(lx_fixed_pool_ref_t self) {
+    lx_fixed_pool_t* pool = (lx_fixed_pool_t*)self;
+    lx_assert_and_check_return_val(pool, 0);
+    return pool->slot_allocs;
+}
+
 lx_void_t lx_fixed_pool_clear(lx_fixed_pool_ref_t self) {
     lx_fixed_pool_t* pool = (lx_fixed_pool_t*)self;
     lx_assert_and_check_return(pool);
@@ -259,39 +284,18 @@ lx_void_t lx_fixed_pool_clear(lx_fixed_pool_ref_t self) {
         lx_fixed_pool_foreach(self, lx_fixed_pool_item_free, (lx_pointer_t)pool);
     }
 
-    // exit the partial slots
-    lx_iterator_t partial_iterator;
-    lx_iterator_of(&partial_iterator, lx_list_entry_itor(&pool->partial_slots));
-    lx_size_t itor = lx_iterator_head(&partial_iterator);
-    while (itor != lx_iterator_tail(&partial_iterator)) {
-        lx_fixed_pool_slot_t* slot = (lx_fixed_pool_slot_t*)lx_iterator_item(&partial_iterator, itor);
-        lx_assert_and_check_break(slot);
-        lx_assert(slot != pool->current_slot);
-        lx_size_t next = lx_iterator_next(&partial_iterator, itor);
-        lx_fixed_pool_slot_exit(pool, slot);
-        itor = next;
+    /* clear all slots and keep them in the partial slots for reusing,
+     * so we need not malloc them again if this pool is filled and cleared repeatedly
+     */
+    lx_list_entry_splice_tail(&pool->partial_slots, &pool->full_slots);
+    lx_for_all (lx_fixed_pool_slot_t*, slot, lx_list_entry_itor(&pool->partial_slots)) {
+        lx_assert(slot && slot != pool->current_slot && slot->pool);
+        lx_static_fixed_pool_clear(slot->pool);
     }
-
-    // exit the full slots
-    lx_iterator_t full_iterator;
-    lx_iterator_of(&full_iterator, lx_list_entry_itor(&pool->full_slots));
-    itor = lx_iterator_head(&full_iterator);
-    while (itor != lx_iterator_tail(&full_iterator)) {
-        lx_fixed_pool_slot_t* slot = (lx_fixed_pool_slot_t*)lx_iterator_item(&full_iterator, itor);
-        lx_assert_and_check_break(slot);
-        lx_assert(slot != pool->current_slot);
-        lx_size_t next = lx_iterator_next(&full_iterator, itor);
-        lx_fixed_pool_slot_exit(pool, slot);
-        itor = next;
-    }
-
-    // clear slots
     if (pool->current_slot && pool->current_slot->pool) {
         lx_static_fixed_pool_clear(pool->current_slot->pool);
     }
     pool->item_count = 0;
-    lx_list_entry_clear(&pool->partial_slots);
-    lx_list_entry_clear(&pool->full_slots);
 }
 
 lx_pointer_t lx_fixed_pool_malloc(lx_fixed_pool_ref_t self) {
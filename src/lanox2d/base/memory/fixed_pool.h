@@ -148,7 +148,19 @@ lx_void_t                   lx_fixed_pool_exit(lx_fixed_pool_ref_t pool);
  */
 lx_size_t                   lx_fixed_pool_size(lx_fixed_pool_ref_t pool);
 
-/*! clear pool
+/*! the slot allocation count
+ *
+ * the cleared slots are kept for reusing, so it will not grow if the pool is filled and cleared repeatedly.
+ *
+ * @param pool              the pool
+ *
+ * @return                  the allocated slot count since the pool was inited
+ */
+lx_size_t                   lx_fixed_pool_allocs(lx_fixed_pool_ref_t pool);
+
+/*! clear pool and keep all slots for reusing
+ *
+ * the slots will be not freed until lx_fixed_pool_exit(), so the pool keeps its peak memory after clearing.
  *
  * @param pool              the pool
  */
@@ -0,0 +1,67 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        atomic.h
+ *
+ */
+#ifndef LX_BASE_PLATFORM_ATOMIC_H
+#define LX_BASE_PLATFORM_ATOMIC_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#ifdef LX_COMPILER_IS_MSVC
+#   include <intrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the atomic type
+typedef lx_volatile lx_size_t       lx_atomic_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inline interfaces
+ */
+
+/*! add the value to the atomic counter and return the old value
+ *
+ * @param a             the atomic counter
+ * @param v             the added value
+ *
+ * @return              the old value
+ */
+static lx_inline lx_size_t lx_atomic_fetch_and_add(lx_atomic_t* a, lx_size_t v) {
+#if defined(__ATOMIC_SEQ_CST)
+    return __atomic_fetch_add(a, v, __ATOMIC_SEQ_CST);
+#elif defined(LX_COMPILER_IS_GCC)
+    return __sync_fetch_and_add(a, v);
+#elif defined(LX_COMPILER_IS_MSVC) && LX_CPU_BIT64
+    return (lx_size_t)_InterlockedExchangeAdd64((__int64 volatile*)a, (__int64)v);
+#elif defined(LX_COMPILER_IS_MSVC)
+    return (lx_size_t)_InterlockedExchangeAdd((long volatile*)a, (long)v);
+#else
+    // no atomic operations for this compiler, it's only safe in one thread
+    lx_size_t o = *a;
+    *a = o + v;
+    return o;
+#endif
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        cpu.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cpu.h"
+#include "environment.h"
+#include "../libc/libc.h"
+#ifdef LX_ARCH_SIMD_DISPATCH
+#   if defined(LX_COMPILER_IS_MSVC)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#if defined(LX_ARCH_SIMD_DISPATCH)
+static lx_void_t lx_cpu_cpuid(lx_uint32_t leaf, lx_uint32_t subleaf, lx_uint32_t regs[4]) {
+#   if defined(LX_COMPILER_IS_MSVC)
+    __cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#   else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#   endif
+}
+
+// get the enabled register states of os, xcr0
+static lx_uint32_t lx_cpu_xgetbv(lx_noarg_t) {
+#   if defined(LX_COMPILER_IS_MSVC)
+    return (lx_uint32_t)_xgetbv(0);
+#   else
+    lx_uint32_t eax = 0;
+    lx_uint32_t edx = 0;
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+    return eax;
+#   endif
+}
+
+static lx_size_t lx_cpu_features_detect(lx_noarg_t) {
+    lx_size_t   features = LX_CPU_FEATURE_NONE;
+    lx_uint32_t regs[4] = {0};
+    lx_cpu_cpuid(0, 0, regs);
+    lx_uint32_t maxleaf = regs[0];
+    lx_check_return_val(maxleaf >= 1, features);
+
+    // sse2: edx.26
+    lx_cpu_cpuid(1, 0, regs);
+    if (regs[3] & (1 << 26)) features |= LX_CPU_FEATURE_SSE2;
+
+    // the os must save the ymm and zmm registers, osxsave: ecx.27
+    lx_check_return_val((regs[2] & (1 << 27)) && maxleaf >= 7, features);
+    lx_uint32_t xcr0 = lx_cpu_xgetbv();
+    lx_check_return_val((xcr0 & 0x6) == 0x6, features);
+
+    // avx2: ebx.5, avx512f: ebx.16, avx512bw: ebx.30
+    lx_cpu_cpuid(7, 0, regs);
+    if (regs[1] & (1 << 5)) features |= LX_CPU_FEATURE_AVX2;
+    if ((features & LX_CPU_FEATURE_AVX2) && (regs[1] & (1 << 16)) && (regs[1] & (1 << 30)) && (xcr0 & 0xe0) == 0xe0) {
+        features |= LX_CPU_FEATURE_AVX512;
+    }
+    return features;
+}
+#elif defined(LX_ARCH_SSE2)
+static lx_size_t lx_cpu_features_detect(lx_noarg_t) {
+    return LX_CPU_FEATURE_SSE2;
+}
+#elif defined(LX_ARCH_ARM_NEON)
+static lx_size_t lx_cpu_features_detect(lx_noarg_t) {
+    // the neon implementations are only compiled with the neon arch flags, so it's always supported here
+    return LX_CPU_FEATURE_NEON;
+}
+#else
+static lx_size_t lx_cpu_features_detect(lx_noarg_t) {
+    return LX_CPU_FEATURE_NONE;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_size_t lx_cpu_features_level(lx_char_t const* level) {
+    if (level) {
+        if (!lx_strcmp(level, "none")) return LX_CPU_FEATURE_NONE;
+        else if (!lx_strcmp(level, "sse2")) return LX_CPU_FEATURE_SSE2;
+        else if (!lx_strcmp(level, "avx2")) return LX_CPU_FEATURE_SSE2 | LX_CPU_FEATURE_AVX2;
+        else if (!lx_strcmp(level, "avx512")) return LX_CPU_FEATURE_SSE2 | LX_CPU_FEATURE_AVX2 | LX_CPU_FEATURE_AVX512;
+        else if (!lx_strcmp(level, "neon")) return LX_CPU_FEATURE_NEON;
+        lx_trace_w("unknown cpu level: %s", level);
+    }
+    return (lx_size_t)-1;
+}
+
+lx_size_t lx_cpu_features() {
+    /* it may be detected repeatly by the concurrent threads at the first time,
+     * but we always get the same result, so it's safe.
+     */
+    static lx_size_t g_cpu_features = (lx_size_t)-1;
+    if (g_cpu_features == (lx_size_t)-1) {
+        lx_char_t level[32];
+        lx_size_t features = lx_cpu_features_detect();
+        if (lx_environment_get("LX_CPU_LEVEL", level, sizeof(level))) {
+            features &= lx_cpu_features_level(level);
+        }
+        lx_trace_d("cpu features: %lx", features);
+        g_cpu_features = features;
+    }
+    return g_cpu_features;
+}
@@ -0,0 +1,75 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        cpu.h
+ *
+ */
+#ifndef LX_BASE_PLATFORM_CPU_H
+#define LX_BASE_PLATFORM_CPU_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the cpu feature enum
+typedef enum lx_cpu_feature_e_ {
+    LX_CPU_FEATURE_NONE     = 0
+,   LX_CPU_FEATURE_SSE2     = 1
+,   LX_CPU_FEATURE_AVX2     = 2
+,   LX_CPU_FEATURE_AVX512   = 4     //!< avx512f and avx512bw
+,   LX_CPU_FEATURE_NEON     = 8
+}lx_cpu_feature_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! get the cpu features
+ *
+ * the features are detected only once by cpuid, and the os support of the avx registers is checked too.
+ *
+ * we can force a lower simd level by the environment variable LX_CPU_LEVEL,
+ * e.g. none, sse2, avx2, avx512 and neon, so we can benchmark and test each simd path on one machine.
+ *
+ * @return              the cpu features
+ */
+lx_size_t               lx_cpu_features(lx_noarg_t);
+
+/*! get the allowed cpu features of the simd level
+ *
+ * @param level         the simd level, e.g. none, sse2, avx2, avx512 and neon
+ *
+ * @return              the allowed features, all features are allowed if the level is null or unknown
+ */
+lx_size_t               lx_cpu_features_level(lx_char_t const* level);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
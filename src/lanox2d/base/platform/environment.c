@@ -0,0 +1,54 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        environment.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "environment.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef LX_CONFIG_OS_WINDOWS
+#include <windows.h>
+lx_size_t lx_environment_get(lx_char_t const* name, lx_char_t* value, lx_size_t maxn) {
+    lx_assert_and_check_return_val(name && value && maxn, 0);
+
+    // the returned size does not contain the null terminator if it's successful
+    DWORD size = GetEnvironmentVariableA(name, value, (DWORD)maxn);
+    lx_check_return_val(size && size < maxn, 0);
+    return (lx_size_t)size;
+}
+#else
+#include <stdlib.h>
+lx_size_t lx_environment_get(lx_char_t const* name, lx_char_t* value, lx_size_t maxn) {
+    lx_assert_and_check_return_val(name && value && maxn, 0);
+
+    lx_char_t const* data = getenv(name);
+    lx_check_return_val(data, 0);
+
+    lx_size_t size = lx_strlen(data);
+    lx_check_return_val(size < maxn, 0);
+    lx_memcpy(value, data, size + 1);
+    return size;
+}
+#endif
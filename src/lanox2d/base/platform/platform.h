@@ -25,8 +25,12 @@
  * includes
  */
 #include "time.h"
+#include "atomic.h"
 #include "page.h"
+#include "cpu.h"
+#include "environment.h"
 #include "dlopen.h"
+#include "thread.h"
 
 #endif
 
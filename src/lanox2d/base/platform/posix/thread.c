@@ -0,0 +1,178 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread type
+typedef struct lx_thread_t_ {
+    pthread_t           pthread;
+    lx_thread_func_t    func;
+    lx_cpointer_t       priv;
+}lx_thread_t;
+
+// the semaphore type
+typedef struct lx_semaphore_t_ {
+    pthread_mutex_t     mutex;
+    pthread_cond_t      cond;
+    lx_size_t           value;
+}lx_semaphore_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_pointer_t lx_thread_func(lx_pointer_t priv) {
+    lx_thread_t* thread = (lx_thread_t*)priv;
+    if (thread && thread->func) {
+        thread->func(thread->priv);
+    }
+    return lx_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_thread_ref_t lx_thread_init(lx_thread_func_t func, lx_cpointer_t priv) {
+    lx_assert_and_check_return_val(func, lx_null);
+
+    lx_thread_t* thread = lx_malloc0_type(lx_thread_t);
+    lx_assert_and_check_return_val(thread, lx_null);
+
+    thread->func = func;
+    thread->priv = priv;
+    if (0 != pthread_create(&thread->pthread, lx_null, lx_thread_func, thread)) {
+        lx_free(thread);
+        thread = lx_null;
+    }
+    return (lx_thread_ref_t)thread;
+}
+
+lx_void_t lx_thread_exit(lx_thread_ref_t self) {
+    lx_thread_t* thread = (lx_thread_t*)self;
+    if (thread) {
+        pthread_join(thread->pthread, lx_null);
+        lx_free(thread);
+    }
+}
+
+lx_mutex_ref_t lx_mutex_init() {
+    pthread_mutex_t* mutex = lx_malloc0_type(pthread_mutex_t);
+    lx_assert_and_check_return_val(mutex, lx_null);
+
+    if (0 != pthread_mutex_init(mutex, lx_null)) {
+        lx_free(mutex);
+        mutex = lx_null;
+    }
+    return (lx_mutex_ref_t)mutex;
+}
+
+lx_void_t lx_mutex_exit(lx_mutex_ref_t self) {
+    pthread_mutex_t* mutex = (pthread_mutex_t*)self;
+    if (mutex) {
+        pthread_mutex_destroy(mutex);
+        lx_free(mutex);
+    }
+}
+
+lx_bool_t lx_mutex_enter(lx_mutex_ref_t self) {
+    pthread_mutex_t* mutex = (pthread_mutex_t*)self;
+    lx_assert_and_check_return_val(mutex, lx_false);
+    return pthread_mutex_lock(mutex) == 0;
+}
+
+lx_bool_t lx_mutex_leave(lx_mutex_ref_t self) {
+    pthread_mutex_t* mutex = (pthread_mutex_t*)self;
+    lx_assert_and_check_return_val(mutex, lx_false);
+    return pthread_mutex_unlock(mutex) == 0;
+}
+
+lx_semaphore_ref_t lx_semaphore_init(lx_size_t value) {
+    lx_bool_t       ok = lx_false;
+    lx_semaphore_t* semaphore = lx_null;
+    do {
+        semaphore = lx_malloc0_type(lx_semaphore_t);
+        lx_assert_and_check_break(semaphore);
+
+        semaphore->value = value;
+        lx_assert_and_check_break(0 == pthread_mutex_init(&semaphore->mutex, lx_null));
+        if (0 != pthread_cond_init(&semaphore->cond, lx_null)) {
+            pthread_mutex_destroy(&semaphore->mutex);
+            break;
+        }
+        ok = lx_true;
+    } while (0);
+
+    if (!ok && semaphore) {
+        lx_free(semaphore);
+        semaphore = lx_null;
+    }
+    return (lx_semaphore_ref_t)semaphore;
+}
+
+lx_void_t lx_semaphore_exit(lx_semaphore_ref_t self) {
+    lx_semaphore_t* semaphore = (lx_semaphore_t*)self;
+    if (semaphore) {
+        pthread_cond_destroy(&semaphore->cond);
+        pthread_mutex_destroy(&semaphore->mutex);
+        lx_free(semaphore);
+    }
+}
+
+lx_bool_t lx_semaphore_post(lx_semaphore_ref_t self, lx_size_t post) {
+    lx_semaphore_t* semaphore = (lx_semaphore_t*)self;
+    lx_assert_and_check_return_val(semaphore && post, lx_false);
+
+    lx_check_return_val(0 == pthread_mutex_lock(&semaphore->mutex), lx_false);
+    semaphore->value += post;
+    pthread_cond_broadcast(&semaphore->cond);
+    pthread_mutex_unlock(&semaphore->mutex);
+    return lx_true;
+}
+
+lx_bool_t lx_semaphore_wait(lx_semaphore_ref_t self) {
+    lx_semaphore_t* semaphore = (lx_semaphore_t*)self;
+    lx_assert_and_check_return_val(semaphore, lx_false);
+
+    lx_check_return_val(0 == pthread_mutex_lock(&semaphore->mutex), lx_false);
+    while (!semaphore->value) {
+        pthread_cond_wait(&semaphore->cond, &semaphore->mutex);
+    }
+    semaphore->value--;
+    pthread_mutex_unlock(&semaphore->mutex);
+    return lx_true;
+}
+
+lx_size_t lx_cpu_count() {
+#if defined(LX_CONFIG_POSIX_HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+    lx_long_t count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0? (lx_size_t)count : 1;
+#else
+    return 1;
+#endif
+}
@@ -0,0 +1,85 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "thread.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#if defined(LX_CONFIG_OS_WINDOWS)
+#   include "windows/thread.c"
+#elif defined(LX_CONFIG_POSIX_HAVE_PTHREAD_CREATE)
+#   include "posix/thread.c"
+#else
+lx_thread_ref_t lx_thread_init(lx_thread_func_t func, lx_cpointer_t priv) {
+    lx_trace_noimpl();
+    return lx_null;
+}
+
+lx_void_t lx_thread_exit(lx_thread_ref_t thread) {
+    lx_trace_noimpl();
+}
+
+lx_mutex_ref_t lx_mutex_init() {
+    lx_trace_noimpl();
+    return lx_null;
+}
+
+lx_void_t lx_mutex_exit(lx_mutex_ref_t mutex) {
+    lx_trace_noimpl();
+}
+
+lx_bool_t lx_mutex_enter(lx_mutex_ref_t mutex) {
+    lx_trace_noimpl();
+    return lx_false;
+}
+
+lx_bool_t lx_mutex_leave(lx_mutex_ref_t mutex) {
+    lx_trace_noimpl();
+    return lx_false;
+}
+
+lx_semaphore_ref_t lx_semaphore_init(lx_size_t value) {
+    lx_trace_noimpl();
+    return lx_null;
+}
+
+lx_void_t lx_semaphore_exit(lx_semaphore_ref_t semaphore) {
+    lx_trace_noimpl();
+}
+
+lx_bool_t lx_semaphore_post(lx_semaphore_ref_t semaphore, lx_size_t post) {
+    lx_trace_noimpl();
+    return lx_false;
+}
+
+lx_bool_t lx_semaphore_wait(lx_semaphore_ref_t semaphore) {
+    lx_trace_noimpl();
+    return lx_false;
+}
+
+lx_size_t lx_cpu_count() {
+    return 1;
+}
+#endif
@@ -0,0 +1,141 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread.h
+ *
+ */
+#ifndef LX_BASE_PLATFORM_THREAD_H
+#define LX_BASE_PLATFORM_THREAD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the thread ref type
+typedef lx_typeref(thread);
+
+/// the mutex ref type
+typedef lx_typeref(mutex);
+
+/// the semaphore ref type
+typedef lx_typeref(semaphore);
+
+/// the thread function type
+typedef lx_void_t       (*lx_thread_func_t)(lx_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init and start thread
+ *
+ * @param func          the thread function
+ * @param priv          the thread private data
+ *
+ * @return              the thread
+ */
+lx_thread_ref_t         lx_thread_init(lx_thread_func_t func, lx_cpointer_t priv);
+
+/*! wait the thread exit and free it
+ *
+ * @param thread        the thread
+ */
+lx_void_t               lx_thread_exit(lx_thread_ref_t thread);
+
+/*! init mutex
+ *
+ * @return              the mutex
+ */
+lx_mutex_ref_t          lx_mutex_init(lx_noarg_t);
+
+/*! exit mutex
+ *
+ * @param mutex         the mutex
+ */
+lx_void_t               lx_mutex_exit(lx_mutex_ref_t mutex);
+
+/*! enter mutex
+ *
+ * @param mutex         the mutex
+ *
+ * @return              lx_true or lx_false
+ */
+lx_bool_t               lx_mutex_enter(lx_mutex_ref_t mutex);
+
+/*! leave mutex
+ *
+ * @param mutex         the mutex
+ *
+ * @return              lx_true or lx_false
+ */
+lx_bool_t               lx_mutex_leave(lx_mutex_ref_t mutex);
+
+/*! init semaphore
+ *
+ * @param value         the initial value
+ *
+ * @return              the semaphore
+ */
+lx_semaphore_ref_t      lx_semaphore_init(lx_size_t value);
+
+/*! exit semaphore
+ *
+ * @param semaphore     the semaphore
+ */
+lx_void_t               lx_semaphore_exit(lx_semaphore_ref_t semaphore);
+
+/*! post semaphore
+ *
+ * @param semaphore     the semaphore
+ * @param post          the post count
+ *
+ * @return              lx_true or lx_false
+ */
+lx_bool_t               lx_semaphore_post(lx_semaphore_ref_t semaphore, lx_size_t post);
+
+/*! wait semaphore
+ *
+ * @param semaphore     the semaphore
+ *
+ * @return              lx_true or lx_false
+ */
+lx_bool_t               lx_semaphore_wait(lx_semaphore_ref_t semaphore);
+
+/*! get the cpu count
+ *
+ * @return              the cpu count, at least 1
+ */
+lx_size_t               lx_cpu_count(lx_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
+
+
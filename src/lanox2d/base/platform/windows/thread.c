@@ -0,0 +1,131 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread type
+typedef struct lx_thread_t_ {
+    HANDLE              handle;
+    lx_thread_func_t    func;
+    lx_cpointer_t       priv;
+}lx_thread_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static DWORD WINAPI lx_thread_func(LPVOID priv) {
+    lx_thread_t* thread = (lx_thread_t*)priv;
+    if (thread && thread->func) {
+        thread->func(thread->priv);
+    }
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_thread_ref_t lx_thread_init(lx_thread_func_t func, lx_cpointer_t priv) {
+    lx_assert_and_check_return_val(func, lx_null);
+
+    lx_thread_t* thread = lx_malloc0_type(lx_thread_t);
+    lx_assert_and_check_return_val(thread, lx_null);
+
+    thread->func   = func;
+    thread->priv   = priv;
+    thread->handle = CreateThread(lx_null, 0, lx_thread_func, (LPVOID)thread, 0, lx_null);
+    if (!thread->handle) {
+        lx_free(thread);
+        thread = lx_null;
+    }
+    return (lx_thread_ref_t)thread;
+}
+
+lx_void_t lx_thread_exit(lx_thread_ref_t self) {
+    lx_thread_t* thread = (lx_thread_t*)self;
+    if (thread) {
+        WaitForSingleObject(thread->handle, INFINITE);
+        CloseHandle(thread->handle);
+        lx_free(thread);
+    }
+}
+
+lx_mutex_ref_t lx_mutex_init() {
+    CRITICAL_SECTION* mutex = lx_malloc0_type(CRITICAL_SECTION);
+    lx_assert_and_check_return_val(mutex, lx_null);
+
+    InitializeCriticalSection(mutex);
+    return (lx_mutex_ref_t)mutex;
+}
+
+lx_void_t lx_mutex_exit(lx_mutex_ref_t self) {
+    CRITICAL_SECTION* mutex = (CRITICAL_SECTION*)self;
+    if (mutex) {
+        DeleteCriticalSection(mutex);
+        lx_free(mutex);
+    }
+}
+
+lx_bool_t lx_mutex_enter(lx_mutex_ref_t self) {
+    CRITICAL_SECTION* mutex = (CRITICAL_SECTION*)self;
+    lx_assert_and_check_return_val(mutex, lx_false);
+    EnterCriticalSection(mutex);
+    return lx_true;
+}
+
+lx_bool_t lx_mutex_leave(lx_mutex_ref_t self) {
+    CRITICAL_SECTION* mutex = (CRITICAL_SECTION*)self;
+    lx_assert_and_check_return_val(mutex, lx_false);
+    LeaveCriticalSection(mutex);
+    return lx_true;
+}
+
+lx_semaphore_ref_t lx_semaphore_init(lx_size_t value) {
+    return (lx_semaphore_ref_t)CreateSemaphoreA(lx_null, (LONG)value, LX_MAXS32, lx_null);
+}
+
+lx_void_t lx_semaphore_exit(lx_semaphore_ref_t semaphore) {
+    if (semaphore) {
+        CloseHandle((HANDLE)semaphore);
+    }
+}
+
+lx_bool_t lx_semaphore_post(lx_semaphore_ref_t semaphore, lx_size_t post) {
+    lx_assert_and_check_return_val(semaphore && post, lx_false);
+    return ReleaseSemaphore((HANDLE)semaphore, (LONG)post, lx_null)? lx_true : lx_false;
+}
+
+lx_bool_t lx_semaphore_wait(lx_semaphore_ref_t semaphore) {
+    lx_assert_and_check_return_val(semaphore, lx_false);
+    return WaitForSingleObject((HANDLE)semaphore, INFINITE) == WAIT_OBJECT_0;
+}
+
+lx_size_t lx_cpu_count() {
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0? (lx_size_t)info.dwNumberOfProcessors : 1;
+}
@@ -37,9 +37,9 @@ typedef struct lx_bitmap_t_ {
     lx_uint8_t          is_owner    : 1;
     lx_uint8_t          has_alpha   : 1;
     lx_uint16_t         pixfmt;
-    lx_uint16_t         width;
-    lx_uint16_t         height;
-    lx_uint16_t         row_bytes;
+    lx_uint32_t         width;
+    lx_uint32_t         height;
+    lx_uint32_t         row_bytes;
 }lx_bitmap_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -60,13 +60,16 @@ lx_bitmap_ref_t lx_bitmap_init(lx_pointer_t data, lx_size_t pixfmt, lx_size_t wi
         // the row bytes
         lx_byte_t btp = lx_pixmap_btp(pixfmt);
         if (!row_bytes) row_bytes = width * btp;
-        lx_assert_and_check_break(row_bytes && row_bytes >= width * btp);
+        lx_assert_and_check_break(row_bytes && row_bytes >= width * btp && row_bytes <= LX_MAXU32);
+
+        // the data size cannot be overflow
+        lx_assert_and_check_break(height <= ((lx_size_t)-1) / row_bytes);
 
         // init bitmap
         bitmap->pixfmt        = (lx_uint16_t)pixfmt;
-        bitmap->width         = (lx_uint16_t)width;
-        bitmap->height        = (lx_uint16_t)height;
-        bitmap->row_bytes     = (lx_uint16_t)row_bytes;
+        bitmap->width         = (lx_uint32_t)width;
+        bitmap->height        = (lx_uint32_t)height;
+        bitmap->row_bytes     = (lx_uint32_t)row_bytes;
         bitmap->size          = row_bytes * height;
         bitmap->data          = data? data : lx_malloc0(bitmap->size);
         bitmap->has_alpha     = (lx_uint8_t)has_alpha;
@@ -134,11 +137,11 @@ lx_bool_t lx_bitmap_attach(lx_bitmap_ref_t self, lx_pointer_t data, lx_size_t wi
         }
 
         // attach bitmap data
-        bitmap->width         = (lx_uint16_t)width;
-        bitmap->height        = (lx_uint16_t)height;
+        bitmap->width         = (lx_uint32_t)width;
+        bitmap->height        = (lx_uint32_t)height;
         bitmap->data          = data;
         bitmap->size          = row_bytes * height;
-        bitmap->row_bytes     = (lx_uint16_t)row_bytes;
+        bitmap->row_bytes     = (lx_uint32_t)row_bytes;
 
         // ok
         ok = lx_true;
@@ -159,9 +162,9 @@ lx_bool_t lx_bitmap_resize(lx_bitmap_ref_t self, lx_size_t width, lx_size_t heig
     // space enough?
     lx_byte_t btp = lx_pixmap_btp(bitmap->pixfmt);
     if (height * width * btp <= bitmap->size) {
-        bitmap->width     = (lx_uint16_t)width;
-        bitmap->height    = (lx_uint16_t)height;
-        if (bitmap->is_owner) bitmap->row_bytes = (lx_uint16_t)(width * btp);
+        bitmap->width     = (lx_uint32_t)width;
+        bitmap->height    = (lx_uint32_t)height;
+        if (bitmap->is_owner) bitmap->row_bytes = (lx_uint32_t)(width * btp);
         bitmap->size      = bitmap->row_bytes * height;
     } else {
 
@@ -170,9 +173,9 @@ lx_bool_t lx_bitmap_resize(lx_bitmap_ref_t self, lx_size_t width, lx_size_t heig
         lx_check_return_val(bitmap->is_owner, lx_false);
 
         // resize
-        bitmap->width     = (lx_uint16_t)width;
-        bitmap->height    = (lx_uint16_t)height;
-        bitmap->row_bytes = (lx_uint16_t)(width * btp);
+        bitmap->width     = (lx_uint32_t)width;
+        bitmap->height    = (lx_uint32_t)height;
+        bitmap->row_bytes = (lx_uint32_t)(width * btp);
         bitmap->size      = bitmap->row_bytes * height;
         bitmap->data      = lx_ralloc(bitmap->data, bitmap->size);
         lx_assert_and_check_return_val(bitmap->data, lx_false);
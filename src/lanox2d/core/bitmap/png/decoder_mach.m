@@ -99,7 +99,14 @@ lx_bitmap_ref_t lx_bitmap_png_decode(lx_size_t pixfmt, lx_stream_ref_t stream) {
 
         // get pixmap
         lx_pixmap_ref_t dp = lx_pixmap(pixfmt, 0xff);
-        lx_pixmap_ref_t sp = lx_pixmap(LX_PIXFMT_RGBA8888 | LX_PIXFMT_BENDIAN, 0xff);
+        lx_size_t       spixfmt = LX_PIXFMT_RGBA8888;
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+        // we can copy the premultiplied pixels directly if the bitmap pixfmt is premultiplied too
+        if (CGImageGetAlphaInfo(image) == kCGImageAlphaPremultipliedLast) {
+            spixfmt = LX_PIXFMT_RGBA8888_PREMUL;
+        }
+#endif
+        lx_pixmap_ref_t sp = lx_pixmap(spixfmt | LX_PIXFMT_BENDIAN, 0xff);
         lx_assert_and_check_break(dp && sp);
 
         // init bitmap, default: no alpha
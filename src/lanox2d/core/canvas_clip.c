@@ -23,6 +23,7 @@
  * includes
  */
 #include "canvas_clip.h"
+#include "canvas_paint.h"
 #include "device.h"
 #include "private/canvas.h"
 #include "../base/base.h"
@@ -33,7 +34,12 @@
 lx_clipper_ref_t lx_canvas_clipper(lx_canvas_ref_t self) {
     lx_canvas_t* canvas = (lx_canvas_t*)self;
     if (canvas && canvas->clipper_stack) {
-        return (lx_clipper_ref_t)lx_object_stack_object(canvas->clipper_stack);
+        // the added clip shapes will use the current canvas matrix and the fill rule of paint
+        lx_clipper_ref_t clipper = (lx_clipper_ref_t)lx_object_stack_object(canvas->clipper_stack);
+        lx_paint_ref_t   paint = lx_canvas_paint(self);
+        lx_clipper_matrix_set(clipper, &canvas->matrix);
+        if (paint) lx_clipper_fill_rule_set(clipper, lx_paint_fill_rule(paint));
+        return clipper;
     }
     return lx_null;
 }
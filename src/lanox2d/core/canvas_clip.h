@@ -36,6 +36,10 @@ lx_extern_c_enter
  */
 
 /*! get the clipper
+ *
+ * the clipper matrix will be updated to the current canvas matrix,
+ * so the added clip shapes are in the current canvas coordinates,
+ * and the added clip paths will be filled with the fill rule of the current paint.
  *
  * @param canvas    the canvas
  *
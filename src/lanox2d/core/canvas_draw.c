@@ -120,7 +120,7 @@ lx_void_t lx_canvas_draw_triangle(lx_canvas_ref_t self, lx_triangle_ref_t triang
     // init polygon
     lx_polygon_t    polygon;
     lx_point_t      points[] = {triangle->p0, triangle->p1, triangle->p2, triangle->p0};
-    lx_uint16_t     counts[] = {4, 0};
+    lx_uint32_t     counts[] = {4, 0};
     lx_polygon_make(&polygon, points, counts, 4, lx_true);
 
     // init hint
@@ -155,7 +155,7 @@ lx_void_t lx_canvas_draw_rect(lx_canvas_ref_t self, lx_rect_ref_t rect) {
     // init polygon
     lx_polygon_t    polygon;
     lx_point_t      points[5];
-    lx_uint16_t     counts[] = {5, 0};
+    lx_uint32_t     counts[] = {5, 0};
     lx_polygon_make(&polygon, points, counts, 5, lx_true);
 
     // init points
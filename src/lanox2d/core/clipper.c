@@ -15,69 +15,477 @@
  * Copyright (C) 2021-present, Lanox2D Open Source Group.
  *
  * @author      ruki
- * @file        paint.c
+ * @file        clipper.c
  *
  */
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
-#include "paint.h"
 #include "clipper.h"
-#include "quality.h"
+#include "path.h"
+#include "paint.h"
+#include "private/clipper.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the items grow
+#ifdef LX_CONFIG_SMALL
+#   define LX_CLIPPER_ITEMS_GROW        (8)
+#else
+#   define LX_CLIPPER_ITEMS_GROW        (16)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_void_t lx_clipper_item_free(lx_pointer_t data, lx_pointer_t udata) {
+    lx_clipper_item_ref_t item = (lx_clipper_item_ref_t)data;
+    if (item && item->type == LX_CLIPPER_ITEM_TYPE_PATH && item->u.path) {
+        lx_path_exit(item->u.path);
+        item->u.path = lx_null;
+    }
+}
+
+static lx_void_t lx_clipper_item_init(lx_clipper_item_ref_t item, lx_size_t type, lx_size_t mode) {
+    // clear the unused bytes, the items will be compared by lx_memcmp()
+    lx_memset(item, 0, sizeof(lx_clipper_item_t));
+    item->type = (lx_uint8_t)type;
+    item->mode = (lx_uint8_t)mode;
+}
+
+static lx_bool_t lx_clipper_path_equal(lx_path_ref_t path, lx_path_ref_t other) {
+    if (path == other) return lx_true;
+    lx_check_return_val(path && other, lx_false);
+
+    lx_polygon_ref_t polygon = lx_path_polygon(path);
+    lx_polygon_ref_t polygon_other = lx_path_polygon(other);
+    lx_check_return_val(polygon && polygon_other, polygon == polygon_other);
+    lx_check_return_val(polygon->total == polygon_other->total, lx_false);
+    lx_check_return_val(!polygon->total || !lx_memcmp(polygon->points, polygon_other->points, polygon->total * sizeof(lx_point_t)), lx_false);
+
+    lx_size_t i = 0;
+    do {
+        lx_check_return_val(polygon->counts[i] == polygon_other->counts[i], lx_false);
+    } while (polygon->counts[i++]);
+    return lx_true;
+}
+
+static lx_void_t lx_clipper_item_add(lx_clipper_t* clipper, lx_clipper_item_ref_t item) {
+    lx_assert(clipper && clipper->items && item);
+
+    // the replaced clipper will discard all previous items
+    if (item->mode == LX_CLIPPER_MODE_REPLACE) {
+        lx_array_clear(clipper->items);
+    }
+    item->matrix = clipper->matrix;
+    lx_array_insert_tail(clipper->items, item);
+}
+
+static lx_bool_t lx_clipper_rect_empty(lx_rect_ref_t rect) {
+    return rect->w <= 0 || rect->h <= 0;
+}
+
+static lx_void_t lx_clipper_rect_intersect(lx_rect_ref_t rect, lx_rect_ref_t other) {
+    lx_float_t x0 = lx_max(rect->x, other->x);
+    lx_float_t y0 = lx_max(rect->y, other->y);
+    lx_float_t x1 = lx_min(rect->x + rect->w, other->x + other->w);
+    lx_float_t y1 = lx_min(rect->y + rect->h, other->y + other->h);
+    lx_rect_make(rect, x0, y0, x1 > x0? x1 - x0 : 0, y1 > y0? y1 - y0 : 0);
+}
+
+static lx_bool_t lx_clipper_rect_contains(lx_rect_ref_t rect, lx_rect_ref_t other) {
+    return      other->x >= rect->x && other->x + other->w <= rect->x + rect->w
+            &&  other->y >= rect->y && other->y + other->h <= rect->y + rect->h;
+}
+
+/* merge the other rect to the rect
+ *
+ * @return      lx_true if the union region is exactly the merged rect
+ */
+static lx_bool_t lx_clipper_rect_union(lx_rect_ref_t rect, lx_rect_ref_t other) {
+    if (lx_clipper_rect_empty(other)) return lx_true;
+    if (lx_clipper_rect_empty(rect)) {
+        *rect = *other;
+        return lx_true;
+    }
+
+    // is exact? one contains another or they are adjacent with the same edges
+    lx_bool_t exact =       lx_clipper_rect_contains(rect, other)
+                        ||  lx_clipper_rect_contains(other, rect)
+                        ||  (   rect->x == other->x && rect->w == other->w
+                            &&  rect->y <= other->y + other->h && other->y <= rect->y + rect->h)
+                        ||  (   rect->y == other->y && rect->h == other->h
+                            &&  rect->x <= other->x + other->w && other->x <= rect->x + rect->w);
+
+    lx_float_t x0 = lx_min(rect->x, other->x);
+    lx_float_t y0 = lx_min(rect->y, other->y);
+    lx_float_t x1 = lx_max(rect->x + rect->w, other->x + other->w);
+    lx_float_t y1 = lx_max(rect->y + rect->h, other->y + other->h);
+    lx_rect_make(rect, x0, y0, x1 - x0, y1 - y0);
+    return exact;
+}
+
+/* subtract the other rect from the rect
+ *
+ * @return      lx_true if the subtracted region is exactly the rect, otherwise the rect is unchanged
+ */
+static lx_bool_t lx_clipper_rect_subtract(lx_rect_ref_t rect, lx_rect_ref_t other) {
+
+    // no intersection?
+    lx_rect_t clipped = *rect;
+    lx_clipper_rect_intersect(&clipped, other);
+    if (lx_clipper_rect_empty(&clipped)) return lx_true;
+
+    // all are subtracted?
+    if (lx_clipper_rect_contains(other, rect)) {
+        lx_rect_make(rect, rect->x, rect->y, 0, 0);
+        return lx_true;
+    }
+
+    // subtract the top or bottom side
+    lx_float_t x1 = rect->x + rect->w;
+    lx_float_t y1 = rect->y + rect->h;
+    if (other->x <= rect->x && other->x + other->w >= x1) {
+        if (other->y <= rect->y) {
+            lx_rect_make(rect, rect->x, other->y + other->h, rect->w, y1 - other->y - other->h);
+            return lx_true;
+        } else if (other->y + other->h >= y1) {
+            rect->h = other->y - rect->y;
+            return lx_true;
+        }
+    }
+
+    // subtract the left or right side
+    if (other->y <= rect->y && other->y + other->h >= y1) {
+        if (other->x <= rect->x) {
+            lx_rect_make(rect, other->x + other->w, rect->y, x1 - other->x - other->w, rect->h);
+            return lx_true;
+        } else if (other->x + other->w >= x1) {
+            rect->w = other->x - rect->x;
+            return lx_true;
+        }
+    }
+    return lx_false;
+}
+
+static lx_void_t lx_clipper_rect_apply(lx_rect_ref_t rect, lx_rect_ref_t applied, lx_matrix_ref_t matrix) {
+    lx_point_t points[4];
+    lx_point_make(&points[0], rect->x, rect->y);
+    lx_point_make(&points[1], rect->x + rect->w, rect->y);
+    lx_point_make(&points[2], rect->x + rect->w, rect->y + rect->h);
+    lx_point_make(&points[3], rect->x, rect->y + rect->h);
+    lx_matrix_apply_points(matrix, points, lx_arrayn(points));
+    lx_bounds_make(applied, points, lx_arrayn(points));
+}
+
+/* get the device bounds of the clipper item
+ *
+ * @return      lx_true if the item region is exactly the bounds
+ */
+static lx_bool_t lx_clipper_item_bounds(lx_clipper_item_ref_t item, lx_rect_ref_t bounds) {
+    lx_rect_t rect;
+    lx_bool_t exact = lx_false;
+    switch (item->type) {
+    case LX_CLIPPER_ITEM_TYPE_RECT:
+        rect = item->u.rect;
+        exact = 0 == item->matrix.kx && 0 == item->matrix.ky;
+        break;
+    case LX_CLIPPER_ITEM_TYPE_ROUND_RECT:
+        rect = item->u.round_rect.bounds;
+        break;
+    case LX_CLIPPER_ITEM_TYPE_CIRCLE:
+        lx_rect_make(&rect, item->u.circle.c.x - item->u.circle.r, item->u.circle.c.y - item->u.circle.r, item->u.circle.r * 2, item->u.circle.r * 2);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_ELLIPSE:
+        lx_rect_make(&rect, item->u.ellipse.c.x - item->u.ellipse.rx, item->u.ellipse.c.y - item->u.ellipse.ry, item->u.ellipse.rx * 2, item->u.ellipse.ry * 2);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_TRIANGLE:
+        lx_bounds_make(&rect, (lx_point_ref_t)&item->u.triangle, 3);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_PATH:
+        if (item->u.path && !lx_path_empty(item->u.path)) {
+            rect = *lx_path_bounds(item->u.path);
+        } else {
+            lx_rect_make(&rect, 0, 0, 0, 0);
+            exact = lx_true;
+        }
+        break;
+    default:
+        lx_rect_make(&rect, 0, 0, 0, 0);
+        break;
+    }
+    lx_clipper_rect_apply(&rect, bounds, &item->matrix);
+    return exact;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 lx_clipper_ref_t lx_clipper_init() {
-    return (lx_clipper_ref_t)1;
+    lx_bool_t     ok = lx_false;
+    lx_clipper_t* clipper = lx_null;
+    do {
+
+        clipper = lx_malloc0_type(lx_clipper_t);
+        lx_assert_and_check_break(clipper);
+
+        clipper->items = lx_array_init(LX_CLIPPER_ITEMS_GROW, lx_element_mem(sizeof(lx_clipper_item_t), lx_clipper_item_free, lx_null));
+        lx_assert_and_check_break(clipper->items);
+
+        lx_matrix_clear(&clipper->matrix);
+        clipper->rule = LX_PAINT_FILL_RULE_ODD;
+        ok = lx_true;
+
+    } while (0);
+
+    if (!ok && clipper) {
+        lx_clipper_exit((lx_clipper_ref_t)clipper);
+        clipper = lx_null;
+    }
+    return (lx_clipper_ref_t)clipper;
 }
 
 lx_void_t lx_clipper_exit(lx_clipper_ref_t self) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    if (clipper) {
+        if (clipper->items) {
+            lx_array_exit(clipper->items);
+            clipper->items = lx_null;
+        }
+        lx_free(clipper);
+    }
 }
 
 lx_size_t lx_clipper_size(lx_clipper_ref_t self) {
-    lx_trace_noimpl();
-    return 0;
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    return clipper && clipper->items? lx_array_size(clipper->items) : 0;
 }
 
 lx_void_t lx_clipper_clear(lx_clipper_ref_t self) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    if (clipper && clipper->items) {
+        lx_array_clear(clipper->items);
+        lx_matrix_clear(&clipper->matrix);
+        clipper->rule = LX_PAINT_FILL_RULE_ODD;
+    }
 }
 
 lx_void_t lx_clipper_copy(lx_clipper_ref_t self, lx_clipper_ref_t copied) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_clipper_t* clipper_copied = (lx_clipper_t*)copied;
+    lx_assert_and_check_return(clipper && clipper->items && clipper_copied && clipper_copied->items);
+
+    // copy matrix and rule
+    clipper->matrix = clipper_copied->matrix;
+    clipper->rule   = clipper_copied->rule;
+
+    // copy items, we need copy the paths instead of sharing them
+    lx_array_clear(clipper->items);
+    lx_size_t i;
+    lx_size_t n = lx_array_size(clipper_copied->items);
+    for (i = 0; i < n; i++) {
+        lx_clipper_item_t item = *((lx_clipper_item_ref_t)lx_array_item(clipper_copied->items, i));
+        if (item.type == LX_CLIPPER_ITEM_TYPE_PATH) {
+            lx_path_ref_t path = lx_path_init();
+            lx_assert_and_check_continue(path);
+            lx_path_copy(path, item.u.path);
+            item.u.path = path;
+        }
+        lx_array_insert_tail(clipper->items, &item);
+    }
 }
 
 lx_matrix_ref_t lx_clipper_matrix(lx_clipper_ref_t self) {
-    lx_trace_noimpl();
-    return lx_null;
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    return clipper? &clipper->matrix : lx_null;
 }
 
 lx_void_t lx_clipper_matrix_set(lx_clipper_ref_t self, lx_matrix_ref_t matrix) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    if (clipper) {
+        if (matrix) clipper->matrix = *matrix;
+        else lx_matrix_clear(&clipper->matrix);
+    }
+}
+
+lx_size_t lx_clipper_fill_rule(lx_clipper_ref_t self) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    return clipper? clipper->rule : LX_PAINT_FILL_RULE_ODD;
+}
+
+lx_void_t lx_clipper_fill_rule_set(lx_clipper_ref_t self, lx_size_t rule) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    if (clipper) clipper->rule = rule;
 }
 
 lx_void_t lx_clipper_add_path(lx_clipper_ref_t self, lx_size_t mode, lx_path_ref_t path) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && path);
+
+    // only the path need the fill rule, the other shapes are always convex
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_PATH, mode);
+    item.rule = (lx_uint8_t)clipper->rule;
+    item.u.path = lx_path_init();
+    lx_assert_and_check_return(item.u.path);
+    lx_path_copy(item.u.path, path);
+    lx_clipper_item_add(clipper, &item);
 }
 
 lx_void_t lx_clipper_add_triangle(lx_clipper_ref_t self, lx_size_t mode, lx_triangle_ref_t triangle) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && triangle);
+
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_TRIANGLE, mode);
+    item.u.triangle = *triangle;
+    lx_clipper_item_add(clipper, &item);
 }
 
 lx_void_t lx_clipper_add_rect(lx_clipper_ref_t self, lx_size_t mode, lx_rect_ref_t rect) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && rect);
+
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_RECT, mode);
+    item.u.rect = *rect;
+    lx_clipper_item_add(clipper, &item);
 }
 
 lx_void_t lx_clipper_add_round_rect(lx_clipper_ref_t self, lx_size_t mode, lx_round_rect_ref_t rect) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && rect);
+
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_ROUND_RECT, mode);
+    item.u.round_rect = *rect;
+    lx_clipper_item_add(clipper, &item);
 }
 
 lx_void_t lx_clipper_add_circle(lx_clipper_ref_t self, lx_size_t mode, lx_circle_ref_t circle) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && circle);
+
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_CIRCLE, mode);
+    item.u.circle = *circle;
+    lx_clipper_item_add(clipper, &item);
 }
 
 lx_void_t lx_clipper_add_ellipse(lx_clipper_ref_t self, lx_size_t mode, lx_ellipse_ref_t ellipse) {
-    lx_trace_noimpl();
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return(clipper && ellipse);
+
+    lx_clipper_item_t item;
+    lx_clipper_item_init(&item, LX_CLIPPER_ITEM_TYPE_ELLIPSE, mode);
+    item.u.ellipse = *ellipse;
+    lx_clipper_item_add(clipper, &item);
+}
+
+lx_bool_t lx_clipper_bounds(lx_clipper_ref_t self, lx_rect_ref_t bounds) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_assert_and_check_return_val(bounds, lx_false);
+    lx_check_return_val(clipper && clipper->items, lx_true);
+
+    // combine all items in order
+    lx_rect_t   device = *bounds;
+    lx_bool_t   exact = lx_true;
+    lx_size_t   i;
+    lx_size_t   n = lx_array_size(clipper->items);
+    for (i = 0; i < n; i++) {
+        lx_clipper_item_ref_t item = (lx_clipper_item_ref_t)lx_array_item(clipper->items, i);
+        lx_assert(item);
+
+        lx_rect_t rect;
+        lx_bool_t rect_exact = lx_clipper_item_bounds(item, &rect);
+        lx_clipper_rect_intersect(&rect, &device);
+        switch (item->mode) {
+        case LX_CLIPPER_MODE_REPLACE:
+            *bounds = rect;
+            exact = rect_exact;
+            break;
+        case LX_CLIPPER_MODE_INTERSECT:
+            lx_clipper_rect_intersect(bounds, &rect);
+            exact = exact && rect_exact;
+            break;
+        case LX_CLIPPER_MODE_UNION:
+            exact = lx_clipper_rect_union(bounds, &rect) && exact && rect_exact;
+            break;
+        case LX_CLIPPER_MODE_SUBTRACT:
+            if (rect_exact) exact = lx_clipper_rect_subtract(bounds, &rect) && exact;
+            else {
+                // the bounds is unchanged, but the clipped region may be not a rect now
+                lx_clipper_rect_intersect(&rect, bounds);
+                if (!lx_clipper_rect_empty(&rect)) exact = lx_false;
+            }
+            break;
+        default:
+            break;
+        }
+
+        // all are clipped? it's always exact
+        if (lx_clipper_rect_empty(bounds)) {
+            lx_rect_make(bounds, bounds->x, bounds->y, 0, 0);
+            exact = lx_true;
+        }
+    }
+    return exact;
+}
+
+lx_bool_t lx_clipper_equal(lx_clipper_ref_t self, lx_clipper_ref_t other) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_clipper_t* clipper_other = (lx_clipper_t*)other;
+    lx_check_return_val(clipper && clipper_other, clipper == clipper_other);
+
+    lx_size_t i;
+    lx_size_t n = lx_clipper_size(self);
+    lx_check_return_val(n == lx_clipper_size(other), lx_false);
+    for (i = 0; i < n; i++) {
+        lx_clipper_item_ref_t item = (lx_clipper_item_ref_t)lx_array_item(clipper->items, i);
+        lx_clipper_item_ref_t item_other = (lx_clipper_item_ref_t)lx_array_item(clipper_other->items, i);
+        lx_assert(item && item_other);
+        if (item->type == LX_CLIPPER_ITEM_TYPE_PATH) {
+            lx_check_return_val(item_other->type == LX_CLIPPER_ITEM_TYPE_PATH && item->mode == item_other->mode && item->rule == item_other->rule, lx_false);
+            lx_check_return_val(!lx_memcmp(&item->matrix, &item_other->matrix, sizeof(lx_matrix_t)), lx_false);
+            lx_check_return_val(lx_clipper_path_equal(item->u.path, item_other->u.path), lx_false);
+        } else {
+            lx_check_return_val(!lx_memcmp(item, item_other, sizeof(lx_clipper_item_t)), lx_false);
+        }
+    }
+    return lx_true;
+}
+
+lx_void_t lx_clipper_add_clipper(lx_clipper_ref_t self, lx_clipper_ref_t other, lx_matrix_ref_t matrix) {
+    lx_clipper_t* clipper = (lx_clipper_t*)self;
+    lx_clipper_t* clipper_other = (lx_clipper_t*)other;
+    lx_assert_and_check_return(clipper && clipper->items && clipper_other && clipper_other->items && matrix);
+
+    lx_size_t i;
+    lx_size_t n = lx_array_size(clipper_other->items);
+    for (i = 0; i < n; i++) {
+        lx_clipper_item_ref_t item_other = (lx_clipper_item_ref_t)lx_array_item(clipper_other->items, i);
+        lx_assert_and_check_continue(item_other);
+
+        // copy item, we need copy the path instead of sharing it
+        lx_clipper_item_t item = *item_other;
+        if (item.type == LX_CLIPPER_ITEM_TYPE_PATH) {
+            lx_path_ref_t path = lx_path_init();
+            lx_assert_and_check_continue(path);
+            lx_path_copy(path, item_other->u.path);
+            item.u.path = path;
+        }
+
+        // apply the base matrix
+        item.matrix = *matrix;
+        lx_matrix_multiply(&item.matrix, &item_other->matrix);
+
+        // the replaced item will discard all previous items
+        if (item.mode == LX_CLIPPER_MODE_REPLACE) {
+            lx_array_clear(clipper->items);
+        }
+        lx_array_insert_tail(clipper->items, &item);
+    }
 }
@@ -96,7 +96,22 @@ lx_matrix_ref_t             lx_clipper_matrix(lx_clipper_ref_t clipper);
  */
 lx_void_t                   lx_clipper_matrix_set(lx_clipper_ref_t clipper, lx_matrix_ref_t matrix);
 
-/*! add path
+/*! get the fill rule of the added paths
+ *
+ * @param clipper           the clipper
+ *
+ * @return                  the fill rule
+ */
+lx_size_t                   lx_clipper_fill_rule(lx_clipper_ref_t clipper);
+
+/*! set the fill rule of the added paths, the odd rule by default
+ *
+ * @param clipper           the clipper
+ * @param rule              the fill rule, e.g. LX_PAINT_FILL_RULE_NONZERO
+ */
+lx_void_t                   lx_clipper_fill_rule_set(lx_clipper_ref_t clipper, lx_size_t rule);
+
+/*! add path, it will be filled with the current fill rule of clipper
  *
  * @param clipper           the clipper
  * @param mode              the clipper mode
@@ -144,6 +159,17 @@ lx_void_t                   lx_clipper_add_circle(lx_clipper_ref_t clipper, lx_s
  */
 lx_void_t                   lx_clipper_add_ellipse(lx_clipper_ref_t clipper, lx_size_t mode, lx_ellipse_ref_t ellipse);
 
+/*! get the clipped bounds in the device coordinate
+ *
+ * all items will be combined in order, and the items out of the device bounds will be ignored.
+ *
+ * @param clipper           the clipper
+ * @param bounds            the device bounds, it will be clipped to the bounds of the clipped region
+ *
+ * @return                  lx_true if the clipped region is exactly this rect, otherwise it's only the approximate bounds
+ */
+lx_bool_t                   lx_clipper_bounds(lx_clipper_ref_t clipper, lx_rect_ref_t bounds);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -80,6 +80,14 @@ lx_void_t lx_device_draw_commit(lx_device_ref_t self) {
     device->draw_commit(self);
 }
 
+lx_void_t lx_device_stroke_cache_set(lx_device_ref_t self, lx_size_t maxsize) {
+    lx_device_t* device = (lx_device_t*)self;
+    lx_assert_and_check_return(device);
+    if (device->stroke_cache_set) {
+        device->stroke_cache_set(self, maxsize);
+    }
+}
+
 lx_void_t lx_device_draw_clear(lx_device_ref_t self, lx_color_t color) {
     lx_device_t* device = (lx_device_t*)self;
     lx_assert(device && device->draw_clear);
@@ -98,7 +106,7 @@ lx_void_t lx_device_draw_path(lx_device_ref_t self, lx_path_ref_t path) {
              *
              * @note the quality of drawing curve may be not higher and faster for stroking with the width > 1
              */
-            lx_device_draw_polygon(self, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+            lx_device_draw_polygon(self, lx_path_polygon_for_matrix(path, device->matrix), lx_path_hint(path), lx_path_bounds(path));
         }
     }
 }
@@ -43,6 +43,38 @@ lx_extern_c_enter
  */
 lx_device_ref_t         lx_device_init_from_bitmap(lx_bitmap_ref_t bitmap);
 
+/*! init tiled device from bitmap
+ *
+ * all draw commands will be recorded and binned into the 64x64 tiles,
+ * and they will be rasterized in parallel by lx_device_draw_commit().
+ *
+ * @note the shaders of paints must be valid until committing draw
+ *
+ * @param bitmap        the bitmap
+ * @param threads       the threads count, uses the cpu count if it's zero
+ *
+ * @return              the device
+ */
+lx_device_ref_t         lx_device_init_from_bitmap_tiled(lx_bitmap_ref_t bitmap, lx_size_t threads);
+
+/*! init streamed device for the large surface
+ *
+ * it's the tiled device without the whole surface bitmap, e.g. the print-resolution poster.
+ * all draw commands will be recorded and binned into the 64x64 tiles, and lx_device_draw_commit()
+ * will rasterize them row by row of tiles into a band bitmap and write the raw pixels of bands to the stream in order.
+ *
+ * @note the row bytes of the written pixels is width * btp, and the shaders of paints must be valid until committing draw
+ *
+ * @param stream        the output stream
+ * @param pixfmt        the pixel format
+ * @param width         the surface width
+ * @param height        the surface height
+ * @param threads       the threads count, uses the cpu count if it's zero
+ *
+ * @return              the device
+ */
+lx_device_ref_t         lx_device_init_from_stream(lx_stream_ref_t stream, lx_size_t pixfmt, lx_size_t width, lx_size_t height, lx_size_t threads);
+
 /*! init device from vulkan
  *
  * @param width         the window width
@@ -142,6 +174,16 @@ lx_bool_t               lx_device_draw_lock(lx_device_ref_t device);
  */
 lx_void_t               lx_device_draw_commit(lx_device_ref_t device);
 
+/*! set the memory budget of the stroked path cache (optional), it's disabled by default.
+ *
+ * the stroked outlines of the unchanged paths will be reused for all zoom levels if the stroke width, cap, join
+ * and miter are not changed, and the least recently used outlines will be removed if the cache size exceeds the budget.
+ *
+ * @param device        the device
+ * @param maxsize       the maximum memory size in bytes, it will disable and clear the cache if it's zero
+ */
+lx_void_t               lx_device_stroke_cache_set(lx_device_ref_t device, lx_size_t maxsize);
+
 /*! clear draw and fill the given color
  *
  * @param device        the device
@@ -38,10 +38,41 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static lx_bool_t lx_device_bitmap_draw_lock(lx_device_ref_t self) {
+    return lx_true;
+}
+
+static lx_void_t lx_device_bitmap_draw_commit(lx_device_ref_t self) {
+    lx_bitmap_device_t* device = (lx_bitmap_device_t*)self;
+    lx_assert(device);
+
+    // flush all recorded draw commands of tiles
+    if (device->tiler) {
+        lx_bitmap_tiler_flush(device->tiler);
+    }
+}
+
+static lx_void_t lx_device_bitmap_stroke_cache_set(lx_device_ref_t self, lx_size_t maxsize) {
+    lx_bitmap_device_t* device = (lx_bitmap_device_t*)self;
+    lx_assert(device && device->stroker);
+    lx_stroker_cache_set(device->stroker, maxsize);
+}
+
 static lx_void_t lx_device_bitmap_draw_clear(lx_device_ref_t self, lx_color_t color) {
     lx_bitmap_device_t* device = (lx_bitmap_device_t*)self;
     lx_assert(device && device->bitmap);
 
+    // flush the previous draw commands first
+    if (device->tiler) {
+
+        // the streamed device has not the whole surface, so we only fill the background of bands when flushing them
+        if (lx_bitmap_tiler_stream(device->tiler)) {
+            lx_bitmap_tiler_background_set(device->tiler, color);
+            return ;
+        }
+        lx_bitmap_tiler_flush(device->tiler);
+    }
+
     // get the bitmap data
     lx_byte_t* data = (lx_byte_t*)lx_bitmap_data(device->bitmap);
     lx_assert(data);
@@ -108,6 +139,11 @@ static lx_void_t lx_device_bitmap_draw_path(lx_device_ref_t self, lx_path_ref_t
 static lx_void_t lx_device_bitmap_exit(lx_device_ref_t self) {
     lx_bitmap_device_t* device = (lx_bitmap_device_t*)self;
     if (device) {
+        if (device->tiler) {
+            lx_bitmap_tiler_flush(device->tiler);
+            lx_bitmap_tiler_exit(device->tiler);
+            device->tiler = lx_null;
+        }
         if (device->points) {
             lx_array_exit(device->points);
             device->points = lx_null;
@@ -124,6 +160,7 @@ static lx_void_t lx_device_bitmap_exit(lx_device_ref_t self) {
             lx_polygon_raster_exit(device->raster);
             device->raster = lx_null;
         }
+        lx_bitmap_mask_exit(&device->mask);
         lx_free(device);
     }
 }
@@ -147,12 +184,17 @@ lx_device_ref_t lx_device_init_from_bitmap(lx_bitmap_ref_t bitmap) {
         device = lx_malloc0_type(lx_bitmap_device_t);
         lx_assert_and_check_break(device);
 
+        device->base.draw_lock    = lx_device_bitmap_draw_lock;
+        device->base.draw_commit  = lx_device_bitmap_draw_commit;
+        device->base.stroke_cache_set = lx_device_bitmap_stroke_cache_set;
         device->base.draw_clear   = lx_device_bitmap_draw_clear;
         device->base.draw_lines   = lx_device_bitmap_draw_lines;
         device->base.draw_points  = lx_device_bitmap_draw_points;
         device->base.draw_polygon = lx_device_bitmap_draw_polygon;
         device->base.draw_path    = lx_device_bitmap_draw_path;
         device->base.exit         = lx_device_bitmap_exit;
+        device->base.width        = (lx_uint32_t)width;
+        device->base.height       = (lx_uint32_t)height;
         device->bitmap            = bitmap;
 
         // init pixmap
@@ -172,7 +214,7 @@ lx_device_ref_t lx_device_init_from_bitmap(lx_bitmap_ref_t bitmap) {
         lx_assert_and_check_break(device->points);
 
         // init counts
-        device->counts = lx_array_init(8, lx_element_mem(sizeof(lx_uint16_t), lx_null, lx_null));
+        device->counts = lx_array_init(8, lx_element_mem(sizeof(lx_uint32_t), lx_null, lx_null));
         lx_assert_and_check_break(device->counts);
 
         // ok
@@ -188,3 +230,69 @@ lx_device_ref_t lx_device_init_from_bitmap(lx_bitmap_ref_t bitmap) {
     return (lx_device_ref_t)device;
 }
 
+lx_device_ref_t lx_device_init_from_bitmap_tiled(lx_bitmap_ref_t bitmap, lx_size_t threads) {
+    lx_assert_and_check_return_val(bitmap, lx_null);
+
+    lx_bool_t           ok = lx_false;
+    lx_bitmap_device_t* device = lx_null;
+    do {
+
+        // init device
+        device = (lx_bitmap_device_t*)lx_device_init_from_bitmap(bitmap);
+        lx_assert_and_check_break(device);
+
+        // init tiler
+        device->tiler = lx_bitmap_tiler_init(bitmap, threads);
+        lx_assert_and_check_break(device->tiler);
+
+        // ok
+        ok = lx_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && device) {
+        lx_device_exit((lx_device_ref_t)device);
+        device = lx_null;
+    }
+    return (lx_device_ref_t)device;
+}
+
+lx_device_ref_t lx_device_init_from_stream(lx_stream_ref_t stream, lx_size_t pixfmt, lx_size_t width, lx_size_t height, lx_size_t threads) {
+    lx_assert_and_check_return_val(stream && LX_PIXFMT_OK(pixfmt), lx_null);
+
+    lx_bool_t               ok = lx_false;
+    lx_bitmap_device_t*     device = lx_null;
+    lx_bitmap_tiler_ref_t   tiler = lx_null;
+    do {
+
+        // check
+        lx_assert_and_check_break(width && height && width <= LX_WIDTH_MAX && height <= LX_HEIGHT_MAX);
+
+        // init the streamed tiler
+        tiler = lx_bitmap_tiler_init_stream(stream, pixfmt, width, height, threads);
+        lx_assert_and_check_break(tiler);
+
+        // init device with the band bitmap of tiler
+        device = (lx_bitmap_device_t*)lx_device_init_from_bitmap(lx_bitmap_tiler_bitmap(tiler));
+        lx_assert_and_check_break(device);
+
+        // the device size is the whole surface
+        device->base.width  = (lx_uint32_t)width;
+        device->base.height = (lx_uint32_t)height;
+        device->tiler       = tiler;
+        tiler               = lx_null;
+
+        // ok
+        ok = lx_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok) {
+        if (tiler) lx_bitmap_tiler_exit(tiler);
+        if (device) lx_device_exit((lx_device_ref_t)device);
+        device = lx_null;
+    }
+    return (lx_device_ref_t)device;
+}
@@ -26,6 +26,8 @@
  */
 #include "writer.h"
 #include "polygon_raster.h"
+#include "tiler.h"
+#include "mask.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -42,6 +44,8 @@ typedef struct lx_bitmap_device_t_ {
     lx_polygon_raster_ref_t raster;
     lx_bitmap_writer_t      writer;
     lx_stroker_ref_t        stroker;
+    lx_bitmap_tiler_ref_t   tiler;
+    lx_bitmap_mask_t        mask;
 }lx_bitmap_device_t;
 
 #endif
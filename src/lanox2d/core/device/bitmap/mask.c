@@ -0,0 +1,236 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        mask.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mask.h"
+#include "../../clipper.h"
+#include "../../quality.h"
+#include "../../private/clipper.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the points grow
+#ifdef LX_CONFIG_SMALL
+#   define LX_BITMAP_MASK_POINTS_GROW       (64)
+#else
+#   define LX_BITMAP_MASK_POINTS_GROW       (128)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_void_t lx_bitmap_mask_raster(lx_polygon_raster_span_t const* spans, lx_size_t count, lx_cpointer_t udata) {
+    lx_bitmap_mask_t* mask = (lx_bitmap_mask_t*)udata;
+    lx_assert(mask && mask->item && spans);
+
+    lx_polygon_raster_span_t const* tail = spans + count;
+    for (; spans < tail; spans++) {
+        lx_long_t x0 = lx_max(spans->x0, mask->x);
+        lx_long_t x1 = lx_min(spans->x1, mask->x + mask->width);
+        lx_long_t y0 = lx_max(spans->y, mask->y);
+        lx_long_t y1 = lx_min(spans->y + spans->h, mask->y + mask->height);
+        lx_check_continue(x0 < x1);
+
+        lx_byte_t* data = mask->item + (y0 - mask->y) * mask->width + x0 - mask->x;
+        for (; y0 < y1; y0++, data += mask->width) {
+            lx_memset(data, spans->coverage, x1 - x0);
+        }
+    }
+}
+
+// make the polygon of clipper item in the device coordinate
+static lx_bool_t lx_bitmap_mask_polygon(lx_bitmap_mask_t* mask, lx_clipper_item_ref_t item, lx_polygon_ref_t polygon, lx_rect_ref_t bounds) {
+    lx_assert(mask && mask->path && mask->points && item && polygon && bounds);
+
+    // make path
+    lx_path_ref_t path = mask->path;
+    lx_path_clear(path);
+    switch (item->type) {
+    case LX_CLIPPER_ITEM_TYPE_PATH:
+        path = item->u.path;
+        break;
+    case LX_CLIPPER_ITEM_TYPE_TRIANGLE:
+        lx_path_add_triangle(path, &item->u.triangle);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_RECT:
+        lx_path_add_rect(path, &item->u.rect, LX_ROTATE_DIRECTION_CW);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_ROUND_RECT:
+        lx_path_add_round_rect(path, &item->u.round_rect, LX_ROTATE_DIRECTION_CW);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_CIRCLE:
+        lx_path_add_circle(path, &item->u.circle, LX_ROTATE_DIRECTION_CW);
+        break;
+    case LX_CLIPPER_ITEM_TYPE_ELLIPSE:
+        lx_path_add_ellipse(path, &item->u.ellipse, LX_ROTATE_DIRECTION_CW);
+        break;
+    default:
+        break;
+    }
+    lx_check_return_val(path && !lx_path_empty(path), lx_false);
+
+    // get the polygon of path
+    lx_polygon_ref_t path_polygon = lx_path_polygon_for_matrix(path, &item->matrix);
+    lx_check_return_val(path_polygon && path_polygon->points && path_polygon->counts && path_polygon->total, lx_false);
+
+    // apply the clipper matrix to the polygon points
+    lx_size_t i;
+    lx_array_clear(mask->points);
+    for (i = 0; i < path_polygon->total; i++) {
+        lx_point_t point;
+        lx_point_apply2(path_polygon->points + i, &point, &item->matrix);
+        lx_array_insert_tail(mask->points, &point);
+    }
+
+    lx_point_ref_t points = (lx_point_ref_t)lx_array_data(mask->points);
+    lx_polygon_make(polygon, points, path_polygon->counts, path_polygon->total, path_polygon->convex);
+    lx_bounds_make(bounds, points, path_polygon->total);
+    return lx_true;
+}
+
+// combine the item coverage to the mask coverage
+static lx_void_t lx_bitmap_mask_combine(lx_bitmap_mask_t* mask, lx_size_t mode) {
+    lx_assert(mask && mask->data && mask->item);
+
+    lx_byte_t*          data = mask->data;
+    lx_byte_t const*    item = mask->item;
+    lx_size_t           size = (lx_size_t)(mask->width * mask->height);
+    lx_size_t           i;
+    switch (mode) {
+    case LX_CLIPPER_MODE_REPLACE:
+        lx_memcpy(data, item, size);
+        break;
+    case LX_CLIPPER_MODE_INTERSECT:
+        for (i = 0; i < size; i++) {
+            lx_size_t t = item[i];
+            data[i] = (lx_byte_t)((data[i] * (t + (t >> 7))) >> 8);
+        }
+        break;
+    case LX_CLIPPER_MODE_UNION:
+        for (i = 0; i < size; i++) {
+            lx_size_t t = item[i];
+            data[i] = (lx_byte_t)(data[i] + t - ((data[i] * (t + (t >> 7))) >> 8));
+        }
+        break;
+    case LX_CLIPPER_MODE_SUBTRACT:
+        for (i = 0; i < size; i++) {
+            lx_size_t t = 0xff - item[i];
+            data[i] = (lx_byte_t)((data[i] * (t + (t >> 7))) >> 8);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_void_t lx_bitmap_mask_exit(lx_bitmap_mask_t* mask) {
+    lx_assert_and_check_return(mask);
+    if (mask->data) {
+        lx_free(mask->data);
+        mask->data = lx_null;
+    }
+    if (mask->item) {
+        lx_free(mask->item);
+        mask->item = lx_null;
+    }
+    if (mask->clipper) {
+        lx_clipper_exit(mask->clipper);
+        mask->clipper = lx_null;
+    }
+    if (mask->path) {
+        lx_path_exit(mask->path);
+        mask->path = lx_null;
+    }
+    if (mask->points) {
+        lx_array_exit(mask->points);
+        mask->points = lx_null;
+    }
+    mask->maxn = 0;
+}
+
+lx_bool_t lx_bitmap_mask_changed(lx_bitmap_mask_t* mask, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_assert(mask && clipper);
+    return      !mask->data || !mask->clipper
+            ||  mask->x != x || mask->y != y || mask->width != w || mask->height != h
+            ||  mask->quality != lx_quality()
+            ||  !lx_clipper_equal(mask->clipper, clipper);
+}
+
+lx_bool_t lx_bitmap_mask_make(lx_bitmap_mask_t* mask, lx_polygon_raster_ref_t raster, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_assert(mask && raster && clipper && w > 0 && h > 0);
+
+    // init the temporary objects
+    if (!mask->clipper) mask->clipper = lx_clipper_init();
+    if (!mask->path) mask->path = lx_path_init();
+    if (!mask->points) mask->points = lx_array_init(LX_BITMAP_MASK_POINTS_GROW, lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+    lx_assert_and_check_return_val(mask->clipper && mask->path && mask->points, lx_false);
+
+    // grow data
+    lx_size_t size = (lx_size_t)(w * h);
+    if (size > mask->maxn) {
+        mask->data = (lx_byte_t*)lx_ralloc(mask->data, size);
+        mask->item = (lx_byte_t*)lx_ralloc(mask->item, size);
+        lx_assert_and_check_return_val(mask->data && mask->item, lx_false);
+        mask->maxn = size;
+    }
+
+    // cache the clipper first, we will use the copied paths
+    lx_clipper_copy(mask->clipper, clipper);
+    mask->quality = lx_quality();
+    mask->x       = x;
+    mask->y       = y;
+    mask->width   = w;
+    mask->height  = h;
+
+    // all are visible by default
+    lx_memset(mask->data, 0xff, size);
+
+    // make the coverage of all items and combine them in order
+    lx_size_t       i;
+    lx_size_t       n = lx_clipper_size(mask->clipper);
+    lx_bool_t       antialiasing = mask->quality > LX_QUALITY_LOW;
+    lx_clipper_t*   cached = (lx_clipper_t*)mask->clipper;
+    lx_polygon_raster_clip_set(raster, x, y, w, h);
+    for (i = 0; i < n; i++) {
+        lx_clipper_item_ref_t item = (lx_clipper_item_ref_t)lx_array_item(cached->items, i);
+        lx_assert(item);
+
+        lx_polygon_t polygon;
+        lx_rect_t    bounds;
+        lx_memset(mask->item, 0, size);
+        if (lx_bitmap_mask_polygon(mask, item, &polygon, &bounds)) {
+            if (antialiasing) {
+                lx_polygon_raster_make_aa(raster, &polygon, &bounds, item->rule, lx_bitmap_mask_raster, mask);
+            } else {
+                lx_polygon_raster_make(raster, &polygon, &bounds, item->rule, lx_bitmap_mask_raster, mask);
+            }
+        }
+        lx_bitmap_mask_combine(mask, item->mode);
+    }
+    return lx_true;
+}
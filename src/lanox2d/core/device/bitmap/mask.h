@@ -0,0 +1,115 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        mask.h
+ *
+ */
+#ifndef LX_CORE_DEVICE_BITMAP_MASK_H
+#define LX_CORE_DEVICE_BITMAP_MASK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "polygon_raster.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the clip mask type
+ *
+ * it's the 8-bits coverage of the complex clipped region in the clip bounds,
+ * and it will be cached until the clipper is changed.
+ */
+typedef struct lx_bitmap_mask_t_ {
+
+    // the mask bounds, the row bytes is the width
+    lx_long_t               x;
+    lx_long_t               y;
+    lx_long_t               width;
+    lx_long_t               height;
+
+    // the coverage data
+    lx_byte_t*              data;
+
+    // the coverage data of the current clipper item
+    lx_byte_t*              item;
+
+    // the data size
+    lx_size_t               maxn;
+
+    // the cached clipper and quality
+    lx_clipper_ref_t        clipper;
+    lx_size_t               quality;
+
+    // the temporary path and points for making the polygon of clipper item
+    lx_path_ref_t           path;
+    lx_array_ref_t          points;
+
+}lx_bitmap_mask_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* exit mask
+ *
+ * @param mask          the mask
+ */
+lx_void_t               lx_bitmap_mask_exit(lx_bitmap_mask_t* mask);
+
+/* is the cached mask changed for the given clipper and bounds?
+ *
+ * @param mask          the mask
+ * @param clipper       the clipper
+ * @param x             the x-coordinate of the clip bounds
+ * @param y             the y-coordinate of the clip bounds
+ * @param w             the width of the clip bounds
+ * @param h             the height of the clip bounds
+ *
+ * @return              lx_true if we need remake it
+ */
+lx_bool_t               lx_bitmap_mask_changed(lx_bitmap_mask_t* mask, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
+/* make mask from the clipper
+ *
+ * @param mask          the mask
+ * @param raster        the polygon raster
+ * @param clipper       the clipper
+ * @param x             the x-coordinate of the clip bounds
+ * @param y             the y-coordinate of the clip bounds
+ * @param w             the width of the clip bounds
+ * @param h             the height of the clip bounds
+ *
+ * @return              lx_true or lx_false
+ */
+lx_bool_t               lx_bitmap_mask_make(lx_bitmap_mask_t* mask, lx_polygon_raster_ref_t raster, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
+
+
@@ -33,12 +33,53 @@
 #   define LX_POLYGON_RASTER_EDGES_GROW     (2048)
 #endif
 
+#ifdef LX_CONFIG_SMALL
+#   define LX_POLYGON_RASTER_CELLS_GROW     (1024)
+#else
+#   define LX_POLYGON_RASTER_CELLS_GROW     (4096)
+#endif
+
+// the spans count of the span buffer
+#ifdef LX_CONFIG_SMALL
+#   define LX_POLYGON_RASTER_SPANS_MAXN     (64)
+#else
+#   define LX_POLYGON_RASTER_SPANS_MAXN     (256)
+#endif
+
+// the sub-pixel bits of the anti-aliased raster
+#define LX_POLYGON_RASTER_AA_BITS           (8)
+
+// the sub-pixel one of the anti-aliased raster
+#define LX_POLYGON_RASTER_AA_ONE            (1 << LX_POLYGON_RASTER_AA_BITS)
+
+// the sub-pixel mask of the anti-aliased raster
+#define LX_POLYGON_RASTER_AA_MASK           (LX_POLYGON_RASTER_AA_ONE - 1)
+
+// get the integer part of the sub-pixel coordinate
+#define LX_POLYGON_RASTER_AA_TRUNC(x)       ((x) >> LX_POLYGON_RASTER_AA_BITS)
+
+// get the fractional part of the sub-pixel coordinate
+#define LX_POLYGON_RASTER_AA_FRACT(x)       ((x) & LX_POLYGON_RASTER_AA_MASK)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the polygon raster edge type
+/* the polygon raster edge type
+ *
+ * it's only 16 bytes and the hot fields for stepping the active edges are placed together
+ */
 typedef struct lx_polygon_raster_edge_t_ {
+
+    // the x-coordinate of the active edge
+    lx_fixed_t      x;
+
+    // the slope of the edge: dx / dy
+    lx_fixed_t      slope;
+
+    // the index of next edge at the edge pool
+    lx_uint32_t     next;
+
     /* the winding for rule
      *
      *   . <= -1
@@ -52,21 +93,42 @@ typedef struct lx_polygon_raster_edge_t_ {
      * 1:  top => bottom
      * -1: bottom => top
      */
-    lx_int8_t       winding     : 2;
-
-    // the index of next edge at the edge pool
-    lx_uint16_t     next;
+    lx_int32_t      winding     : 2;
 
     // the bottom y-coordinate
-    lx_int16_t      y_bottom;
+    lx_int32_t      y_bottom    : 30;
 
-    // the x-coordinate of the active edge
-    lx_fixed_t      x;
+}lx_polygon_raster_edge_t;
 
-    // the slope of the edge: dx / dy
-    lx_fixed_t      slope;
+/* the polygon raster cell type for the anti-aliased raster
+ *
+ * the cell is one pixel which is crossed by the edges,
+ * and we only need to save these sparse cells for each scanline
+ *
+ *  ----------------------------
+ * |         |    .    |         |
+ * |         |   .     |         |
+ * |         |  . area |         |
+ * |         | .       |         |
+ *  ----------------------------
+ *             cover: the signed height of the edges in this cell
+ *             area:  the signed area at the right-hand of the edges in this cell, x2
+ */
+typedef struct lx_polygon_raster_cell_t_ {
 
-}lx_polygon_raster_edge_t;
+    // the x-coordinate of the cell
+    lx_int32_t      x;
+
+    // the cover of the cell
+    lx_int32_t      cover;
+
+    // the area of the cell
+    lx_long_t       area;
+
+    // the index of next cell at the cell pool
+    lx_uint32_t     next;
+
+}lx_polygon_raster_cell_t;
 
 /* the polygon raster type
  *
@@ -155,7 +217,7 @@ typedef struct lx_polygon_raster_t_ {
     lx_size_t                   edge_pool_maxn;
 
     // the edge table
-    lx_uint16_t*                edge_table;
+    lx_uint32_t*                edge_table;
 
     // the edge table base for the y-coordinate
     lx_long_t                   edge_table_base;
@@ -164,7 +226,7 @@ typedef struct lx_polygon_raster_t_ {
     lx_size_t                   edge_table_maxn;
 
     // the active edges
-    lx_uint16_t                 active_edges;
+    lx_uint32_t                 active_edges;
 
     // the top of the polygon bounds
     lx_long_t                   top;
@@ -172,6 +234,63 @@ typedef struct lx_polygon_raster_t_ {
     // the bottom of the polygon bounds
     lx_long_t                   bottom;
 
+    // the left of the clip bounds
+    lx_long_t                   clip_left;
+
+    // the top of the clip bounds
+    lx_long_t                   clip_top;
+
+    // the right of the clip bounds
+    lx_long_t                   clip_right;
+
+    // the bottom of the clip bounds
+    lx_long_t                   clip_bottom;
+
+    // the cell pool, tail: 0, index: > 0
+    lx_polygon_raster_cell_t*   cell_pool;
+
+    // the cell pool size
+    lx_size_t                   cell_pool_size;
+
+    // the cell pool maxn
+    lx_size_t                   cell_pool_maxn;
+
+    // the cell table, the sorted cells of each scanline
+    lx_uint32_t*                cell_table;
+
+    // the cell table base for the y-coordinate
+    lx_long_t                   cell_table_base;
+
+    // the cell table size
+    lx_size_t                   cell_table_size;
+
+    // the cell table maxn
+    lx_size_t                   cell_table_maxn;
+
+    // the min x-coordinate of the cells
+    lx_long_t                   cell_xmin;
+
+    // the max x-coordinate of the cells
+    lx_long_t                   cell_xmax;
+
+    // the current cell
+    lx_polygon_raster_cell_t    cell;
+
+    // the y-coordinate of the current cell
+    lx_long_t                   cell_y;
+
+    // the span buffer, all spans will be passed to the callback in batches
+    lx_polygon_raster_span_t    spans[LX_POLYGON_RASTER_SPANS_MAXN];
+
+    // the spans count of the span buffer
+    lx_size_t                   spans_count;
+
+    // the raster callback
+    lx_polygon_raster_cb_t      callback;
+
+    // the user data of the raster callback
+    lx_cpointer_t               udata;
+
 }lx_polygon_raster_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -195,22 +314,22 @@ static lx_void_t lx_polygon_raster_edge_pool_exit(lx_polygon_raster_t* raster) {
     }
 }
 
-static lx_uint16_t lx_polygon_raster_edge_pool_aloc(lx_polygon_raster_t* raster) {
+static lx_uint32_t lx_polygon_raster_edge_pool_aloc(lx_polygon_raster_t* raster) {
     lx_assert(raster && raster->edge_pool);
 
     // the new index
     lx_size_t index = ++raster->edge_pool_size;
-    lx_assert(index < LX_MAXU16);
+    lx_assert(index < LX_MAXU32);
 
-    // grow the edge pool
+    // grow the edge pool geometrically, the dense polygon may have a huge number of edges
     if (index >= raster->edge_pool_maxn) {
-        raster->edge_pool_maxn = index + LX_POLYGON_RASTER_EDGES_GROW;
+        raster->edge_pool_maxn = lx_max(index + LX_POLYGON_RASTER_EDGES_GROW, raster->edge_pool_maxn << 1);
         raster->edge_pool = lx_ralloc_type(raster->edge_pool, raster->edge_pool_maxn, lx_polygon_raster_edge_t);
         lx_assert_and_check_return_val(raster->edge_pool, 0);
     }
 
     // make a new edge from the edge pool
-    return (lx_uint16_t)index;
+    return (lx_uint32_t)index;
 }
 
 static lx_bool_t lx_polygon_raster_edge_table_init(lx_polygon_raster_t* raster, lx_long_t table_base, lx_size_t table_size) {
@@ -218,14 +337,14 @@ static lx_bool_t lx_polygon_raster_edge_table_init(lx_polygon_raster_t* raster,
 
     if (!raster->edge_table) {
         raster->edge_table_maxn = table_size;
-        raster->edge_table = lx_nalloc_type(raster->edge_table_maxn, lx_uint16_t);
+        raster->edge_table = lx_nalloc_type(raster->edge_table_maxn, lx_uint32_t);
     } else if (table_size > raster->edge_table_maxn) {
         raster->edge_table_maxn = table_size;
-        raster->edge_table = lx_ralloc_type(raster->edge_table, raster->edge_table_maxn, lx_uint16_t);
+        raster->edge_table = lx_ralloc_type(raster->edge_table, raster->edge_table_maxn, lx_uint32_t);
     }
-    lx_assert_and_check_return_val(raster->edge_table && table_size <= LX_MAXU16, lx_false);
+    lx_assert_and_check_return_val(raster->edge_table, lx_false);
 
-    lx_memset(raster->edge_table, 0, table_size * sizeof(lx_uint16_t));
+    lx_memset(raster->edge_table, 0, table_size * sizeof(lx_uint32_t));
     raster->edge_table_base = table_base;
     return lx_true;
 }
@@ -257,12 +376,12 @@ static lx_bool_t lx_polygon_raster_edge_table_make(lx_polygon_raster_t* raster,
     lx_bool_t           first       = lx_true;
     lx_long_t           top         = 0;
     lx_long_t           bottom      = 0;
-    lx_uint16_t         index       = 0;
+    lx_uint32_t         index       = 0;
     lx_long_t           table_index = 0;
     lx_point_ref_t      points      = polygon->points;
-    lx_uint16_t*        counts      = polygon->counts;
-    lx_uint16_t         count       = *counts++;
-    lx_uint16_t*        edge_table  = raster->edge_table;
+    lx_uint32_t*        counts      = polygon->counts;
+    lx_uint32_t         count       = *counts++;
+    lx_uint32_t*        edge_table  = raster->edge_table;
     while (index < count) {
         pe = *points++;
         // exists edge?
@@ -280,19 +399,8 @@ static lx_bool_t lx_polygon_raster_edge_table_make(lx_polygon_raster_t* raster,
                 lx_fixed6_t xe = lx_float_to_fixed6(pe.x);
                 lx_fixed6_t ye = lx_float_to_fixed6(pe.y);
 
-                // compute the delta coordinates
-                lx_fixed6_t dx = xe - xb;
-                lx_fixed6_t dy = ye - yb;
-
-                // make a new edge from the edge pool
-                lx_uint16_t edge_index = lx_polygon_raster_edge_pool_aloc(raster);
-                lx_assert(edge_index);
-
-                // the edge
-                lx_polygon_raster_edge_t* edge = raster->edge_pool + edge_index;
-
                 // init the winding
-                edge->winding = 1;
+                lx_int8_t winding = 1;
 
                 // sort the points of the edge by the y-coordinate
                 if (yb > ye) {
@@ -302,48 +410,74 @@ static lx_bool_t lx_polygon_raster_edge_table_make(lx_polygon_raster_t* raster,
                     lx_swap(lx_long_t, iyb, iye);
 
                     // reverse the winding
-                    edge->winding = -1;
+                    winding = -1;
                 }
 
-                // compute the accurate bounds of the y-coordinate
-                if (first) {
-                    top     = iyb;
-                    bottom  = iye;
-                    first   = lx_false;
-                } else {
-                    if (iyb < top)    top = iyb;
-                    if (iye > bottom) bottom = iye;
-                }
+                // compute the delta coordinates
+                lx_fixed6_t dx = xe - xb;
+                lx_fixed6_t dy = ye - yb;
 
-                // check
-                lx_assert(iyb < iye);
+                // the iyb and iye after clipping
+                lx_long_t iyb_clipped = lx_max(iyb, raster->clip_top);
+                lx_long_t iye_clipped = lx_min(iye, raster->clip_bottom);
+
+                // clip the edge in the vertical direction
+                if (iyb_clipped < iye_clipped) {
+
+                    // make a new edge from the edge pool
+                    lx_uint32_t edge_index = lx_polygon_raster_edge_pool_aloc(raster);
+                    lx_assert_and_check_return_val(edge_index, lx_false);
+
+                    // the edge
+                    lx_polygon_raster_edge_t* edge = raster->edge_pool + edge_index;
+                    edge->winding = winding;
+
+                    // compute the accurate bounds of the y-coordinate
+                    if (first) {
+                        top     = iyb_clipped;
+                        bottom  = iye_clipped;
+                        first   = lx_false;
+                    } else {
+                        if (iyb_clipped < top)    top = iyb_clipped;
+                        if (iye_clipped > bottom) bottom = iye_clipped;
+                    }
 
-                // compute the slope
-                edge->slope = lx_fixed6_div(dx, dy);
+                    // check
+                    lx_assert(iyb < iye);
 
-                /* compute the more accurate start x-coordinate
-                 *
-                 * xb + (iyb - yb + 0.5) * dx / dy
-                 * => xb + ((0.5 - yb) % 1) * dx / dy
-                 */
-                edge->x = lx_fixed6_to_fixed(xb) + ((edge->slope * ((LX_FIXED6_HALF - yb) & 63)) >> 6);
+                    // compute the slope
+                    edge->slope = lx_fixed6_div(dx, dy);
 
-                // init bottom y-coordinate
-                edge->y_bottom = (lx_int16_t)(iye - 1);
-                lx_assert(iye - 1 > LX_MINS16 && iye - 1 <= LX_MAXS16);
+                    /* compute the more accurate start x-coordinate
+                     *
+                     * xb + (iyb - yb + 0.5) * dx / dy
+                     * => xb + ((0.5 - yb) % 1) * dx / dy
+                     */
+                    edge->x = lx_fixed6_to_fixed(xb) + ((edge->slope * ((LX_FIXED6_HALF - yb) & 63)) >> 6);
 
-                // the table index
-                table_index = iyb - raster->edge_table_base;
-                lx_assert(table_index >= 0 && table_index < raster->edge_table_maxn);
+                    // clip the top of edge, we need move the x-coordinate to the clipped top
+                    if (iyb < iyb_clipped) {
+                        edge->x += (lx_fixed_t)((lx_hong_t)edge->slope * (iyb_clipped - iyb));
+                        iyb = iyb_clipped;
+                    }
+                    iye = iye_clipped;
 
-                /* insert edge to the head of the edge table
-                 *
-                 * table[index]: => edge => edge => .. => 0
-                 *              |
-                 *            insert
-                 */
-                edge->next = edge_table[table_index];
-                edge_table[table_index] = edge_index;
+                    // init bottom y-coordinate
+                    edge->y_bottom = (lx_int32_t)(iye - 1);
+
+                    // the table index
+                    table_index = iyb - raster->edge_table_base;
+                    lx_assert(table_index >= 0 && table_index < raster->edge_table_maxn);
+
+                    /* insert edge to the head of the edge table
+                     *
+                     * table[index]: => edge => edge => .. => 0
+                     *              |
+                     *            insert
+                     */
+                    edge->next = edge_table[table_index];
+                    edge_table[table_index] = edge_index;
+                }
             }
         }
 
@@ -366,18 +500,52 @@ static lx_bool_t lx_polygon_raster_edge_table_make(lx_polygon_raster_t* raster,
     return lx_true;
 }
 
-static lx_void_t lx_polygon_raster_active_scan_line_convex(lx_polygon_raster_t* raster, lx_long_t y, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
-    lx_assert(raster && raster->edge_pool && callback);
+static lx_void_t lx_polygon_raster_spans_flush(lx_polygon_raster_t* raster) {
+    lx_assert(raster && raster->callback);
+    if (raster->spans_count) {
+        raster->callback(raster->spans, raster->spans_count, raster->udata);
+        raster->spans_count = 0;
+    }
+}
+
+static lx_inline lx_void_t lx_polygon_raster_span_add(lx_polygon_raster_t* raster, lx_long_t x0, lx_long_t x1, lx_long_t y, lx_long_t h, lx_byte_t coverage) {
+    lx_assert(x0 < x1 && h > 0 && h <= LX_MAXU16);
+    if (raster->spans_count == LX_POLYGON_RASTER_SPANS_MAXN) {
+        lx_polygon_raster_spans_flush(raster);
+    }
+    lx_polygon_raster_span_t* span = raster->spans + raster->spans_count++;
+    span->x0       = (lx_int32_t)x0;
+    span->x1       = (lx_int32_t)x1;
+    span->y        = (lx_int32_t)y;
+    span->h        = (lx_uint16_t)h;
+    span->coverage = coverage;
+}
+
+static lx_inline lx_void_t lx_polygon_raster_done(lx_polygon_raster_t* raster, lx_long_t lx, lx_long_t rx, lx_long_t yb, lx_long_t ye) {
+    // clip it in the horizontal direction
+    if (lx < raster->clip_left) lx = raster->clip_left;
+    if (rx > raster->clip_right) rx = raster->clip_right;
+    if (lx < rx) {
+        while (ye - yb > LX_MAXU16) {
+            lx_polygon_raster_span_add(raster, lx, rx, yb, LX_MAXU16, 0xff);
+            yb += LX_MAXU16;
+        }
+        if (yb < ye) lx_polygon_raster_span_add(raster, lx, rx, yb, ye - yb, 0xff);
+    }
+}
+
+static lx_void_t lx_polygon_raster_active_scan_line_convex(lx_polygon_raster_t* raster, lx_long_t y) {
+    lx_assert(raster && raster->edge_pool);
 
     // the edge index
-    lx_uint16_t index = raster->active_edges;
+    lx_uint32_t index = raster->active_edges;
     lx_check_return(index);
 
     // the edge
     lx_polygon_raster_edge_t* edge = raster->edge_pool + index;
 
     // the next edge index
-    lx_uint16_t index_next = edge->next;
+    lx_uint32_t index_next = edge->next;
     lx_check_return(index_next);
 
     // the next edge
@@ -402,7 +570,7 @@ static lx_void_t lx_polygon_raster_active_scan_line_convex(lx_polygon_raster_t*
         // get the min and max edge for the y-bottom
         lx_polygon_raster_edge_t* edge_min  = edge;
         lx_polygon_raster_edge_t* edge_max  = edge_next;
-        lx_uint16_t               index_max = index_next;
+        lx_uint32_t               index_max = index_next;
         if (edge_min->y_bottom > edge_max->y_bottom) {
             edge_min  = edge_next;
             edge_max  = edge;
@@ -430,17 +598,17 @@ static lx_void_t lx_polygon_raster_active_scan_line_convex(lx_polygon_raster_t*
         }
     }
 
-    // do callback
-    callback(lx_fixed_round(edge->x), lx_fixed_round(edge_next->x), y, ye, udata);
+    // add span
+    lx_polygon_raster_done(raster, lx_fixed_round(edge->x), lx_fixed_round(edge_next->x), y, ye);
 }
 
-static lx_void_t lx_polygon_raster_active_scan_line_concave(lx_polygon_raster_t* raster, lx_long_t y, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
-    lx_assert(raster && raster->edge_pool && callback);
+static lx_void_t lx_polygon_raster_active_scan_line_concave(lx_polygon_raster_t* raster, lx_long_t y, lx_size_t rule) {
+    lx_assert(raster && raster->edge_pool);
 
     lx_long_t                 done            = 0;
     lx_long_t                 winding         = 0;
-    lx_uint16_t               index           = raster->active_edges;
-    lx_uint16_t               index_next      = 0;
+    lx_uint32_t               index           = raster->active_edges;
+    lx_uint32_t               index_next      = 0;
     lx_polygon_raster_edge_t* edge            = lx_null;
     lx_polygon_raster_edge_t* edge_next       = lx_null;
     lx_polygon_raster_edge_t* edge_cache      = lx_null;
@@ -518,7 +686,7 @@ static lx_void_t lx_polygon_raster_active_scan_line_concave(lx_polygon_raster_t*
 #if 0
         // do it for winding?
         if (done) {
-            callback(lx_fixed_round(edge->x), lx_fixed_round(edge_next->x), y, y + 1, udata);
+            lx_polygon_raster_done(raster, lx_fixed_round(edge->x), lx_fixed_round(edge_next->x), y, y + 1);
         }
 #else
         // cache the conjoint edges and done them together
@@ -536,8 +704,8 @@ static lx_void_t lx_polygon_raster_active_scan_line_concave(lx_polygon_raster_t*
                 // check
                 lx_assert(edge_cache && edge_cache_next);
 
-                // do callback with edge cache
-                callback(lx_fixed_round(edge_cache->x), lx_fixed_round(edge_cache_next->x), y, y + 1, udata);
+                // add span with edge cache
+                lx_polygon_raster_done(raster, lx_fixed_round(edge_cache->x), lx_fixed_round(edge_cache_next->x), y, y + 1);
 
                 // update edge cache
                 edge_cache = edge;
@@ -550,9 +718,9 @@ static lx_void_t lx_polygon_raster_active_scan_line_concave(lx_polygon_raster_t*
         index = index_next;
     }
 
-    // do callback with the left edge cache
+    // add span with the left edge cache
     if (edge_cache && edge_cache_next) {
-        callback(lx_fixed_round(edge_cache->x), lx_fixed_round(edge_cache_next->x), y, y + 1, udata);
+        lx_polygon_raster_done(raster, lx_fixed_round(edge_cache->x), lx_fixed_round(edge_cache_next->x), y, y + 1);
     }
 }
 
@@ -562,12 +730,12 @@ static lx_void_t lx_polygon_raster_active_scan_next(lx_polygon_raster_t* raster,
     lx_size_t                 first = 1;
     lx_size_t                 order = 1;
     lx_fixed_t                x_prev = 0;
-    lx_uint16_t               index_prev = 0;
-    lx_uint16_t               index = raster->active_edges;
+    lx_uint32_t               index_prev = 0;
+    lx_uint32_t               index = raster->active_edges;
     lx_polygon_raster_edge_t* edge = lx_null;
     lx_polygon_raster_edge_t* edge_prev = lx_null;
     lx_polygon_raster_edge_t* edge_pool = raster->edge_pool;
-    lx_uint16_t               active_edges = raster->active_edges;
+    lx_uint32_t               active_edges = raster->active_edges;
     while (index) {
         // the edge
         edge = edge_pool + index;
@@ -631,214 +799,79 @@ static lx_void_t lx_polygon_raster_active_scan_next(lx_polygon_raster_t* raster,
     raster->active_edges = active_edges;
 }
 
-static lx_void_t lx_polygon_raster_active_append(lx_polygon_raster_t* raster, lx_uint16_t index) {
-    lx_assert(raster && raster->edge_pool);
-
-    lx_uint16_t               next = 0;
-    lx_polygon_raster_edge_t* edge = lx_null;
-    lx_polygon_raster_edge_t* edge_pool = raster->edge_pool;
-    lx_uint16_t               active_edges = raster->active_edges;
-    while (index) {
-
-        // save the next edge index
-        edge = edge_pool + index;
-        next = edge->next;
-
-        // insert the edge to the head of the active edges
-        edge->next = active_edges;
-        active_edges = index;
-
-        // the next edge index
-        index = next;
-    }
-
-    // update the active edges
-    raster->active_edges = active_edges;
+// is the edge a in front of the edge b? the edges are sorted by x and slope in ascending
+static lx_inline lx_bool_t lx_polygon_raster_edge_less(lx_polygon_raster_edge_t const* a, lx_polygon_raster_edge_t const* b) {
+    return a->x < b->x || (a->x == b->x && a->slope < b->slope);
 }
 
-static lx_void_t lx_polygon_raster_active_sorted_insert(lx_polygon_raster_t* raster, lx_uint16_t edge_index) {
-    lx_assert(raster && raster->edge_pool && edge_index);
-
-    // the edge pool
-    lx_polygon_raster_edge_t* edge_pool = raster->edge_pool;
-
-    // the edge
-    lx_polygon_raster_edge_t* edge = edge_pool + edge_index;
-
-    // insert edge to the active edges by x in ascending
-    edge->next = 0;
-    if (!raster->active_edges) {
-        raster->active_edges = edge_index;
-    } else {
-        // find an inserted position
-        lx_polygon_raster_edge_t* edge_prev    = lx_null;
-        lx_polygon_raster_edge_t* edge_active  = lx_null;
-        lx_uint16_t               index_active = raster->active_edges;
-        while (index_active) {
-
-            // the active edge
-            edge_active = edge_pool + index_active;
-            lx_assert(edge_index != index_active);
-
-            /* is this?
-             *
-             * x: 1 2 3     5 6
-             *               |
-             *             4 or 5
-             */
-            if (edge->x <= edge_active->x) {
-                /* same vertex?
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5    .
-                 *             .       .
-                 *           .          .
-                 *         .          active_edge
-                 *       .
-                 *     edge
-                 *
-                 * x: 1 2 3   5         6
-                 *                 .    |
-                 *                  .   5
-                 *                   .    .
-                 *                    .     .
-                 *          active_edge       .
-                 *                              .
-                 *                                .
-                 *                                  .
-                 *                                   edge
-                 *
-                 *  x: 1 2 3   5         6
-                 *                 .    |
-                 *                .     5
-                 *              .    .
-                 *            .     .
-                 *  active_edge    .
-                 *                .
-                 *               .
-                 *              .
-                 *             edge
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5      .
-                 *                 .       .
-                 *                   .       active_edge
-                 *                     .
-                 *                       .
-                 *                         .
-                 *                           .
-                 *                             .
-                 *                               .
-                 *                                 .
-                 *                                 edge
-                 */
-                if (edge->x == edge_active->x) {
-                    /* the edge is at the left-hand of the active edge?
-                     *
-                     * x: 1 2 3     5 6    <- active_edges
-                     *               |   .
-                     *               5    .
-                     *             .       .
-                     *           .          .
-                     *         .        active_edge
-                     *       .
-                     *     edge
-                     *
-                     * if (edge->dx / edge->dy < active->dx / active->dy)?
-                     */
-                    if (edge->slope < edge_active->slope) {
-                        break;
-                    }
-
-                } else {
-                    break;
-                }
-            }
-
-            // the previous active edge
-            edge_prev = edge_active;
-
-            // the next active edge index
-            index_active = edge_prev->next;
-        }
-
-        // insert edge to the active edges: edge_prev -> edge -> edge_active
-        if (!edge_prev) {
-            // insert to the head
-            edge->next          = raster->active_edges;
-            raster->active_edges  = edge_index;
+/* merge two sorted edge lists
+ *
+ * the edges of the list a will be in front of the same edges of the list b
+ */
+static lx_uint32_t lx_polygon_raster_edges_merge(lx_polygon_raster_edge_t* edge_pool, lx_uint32_t a, lx_uint32_t b) {
+    lx_uint32_t  head = 0;
+    lx_uint32_t* tail = &head;
+    while (a && b) {
+        if (lx_polygon_raster_edge_less(edge_pool + b, edge_pool + a)) {
+            *tail = b;
+            tail  = &edge_pool[b].next;
+            b     = edge_pool[b].next;
         } else {
-            // insert to the body
-            edge->next      = index_active;
-            edge_prev->next = edge_index;
+            *tail = a;
+            tail  = &edge_pool[a].next;
+            a     = edge_pool[a].next;
         }
     }
+    *tail = a? a : b;
+    return head;
 }
 
-static lx_void_t lx_polygon_raster_active_sorted_append(lx_polygon_raster_t* raster, lx_uint16_t edge_index) {
-    lx_assert(raster && raster->edge_pool);
-
-    lx_uint16_t               index_next = 0;
-    lx_polygon_raster_edge_t* edge = lx_null;
-    lx_polygon_raster_edge_t* edge_pool = raster->edge_pool;
-    while (edge_index) {
-
-        // save the next edge index
-        edge = edge_pool + edge_index;
-        index_next = edge->next;
+/* sort the edge list by x and slope in ascending
+ *
+ * it's a stable bottom-up merge sort for the linked list, O(n * log(n)),
+ * bins[i] is the sorted list with 2^i edges, and the earlier edges are always in the higher bins.
+ */
+static lx_uint32_t lx_polygon_raster_edges_sort(lx_polygon_raster_edge_t* edge_pool, lx_uint32_t index) {
+    lx_check_return_val(index && edge_pool[index].next, index);
 
-        // insert the edge to the active edges
-        lx_polygon_raster_active_sorted_insert(raster, edge_index);
+    lx_size_t   i;
+    lx_size_t   binn = 0;
+    lx_uint32_t bins[32];
+    while (index) {
+        // take the head edge
+        lx_uint32_t carry = index;
+        index = edge_pool[index].next;
+        edge_pool[carry].next = 0;
+
+        // merge the full bins
+        for (i = 0; i < binn && bins[i]; i++) {
+            carry   = lx_polygon_raster_edges_merge(edge_pool, bins[i], carry);
+            bins[i] = 0;
+        }
+        lx_assert(i < lx_arrayn(bins));
+        if (i == binn) binn++;
+        bins[i] = carry;
+    }
 
-        // the next edge index
-        edge_index = index_next;
+    // merge all bins
+    lx_uint32_t sorted = 0;
+    for (i = 0; i < binn; i++) {
+        if (bins[i]) sorted = lx_polygon_raster_edges_merge(edge_pool, bins[i], sorted);
     }
+    return sorted;
 }
 
-static lx_void_t lx_polygon_raster_active_sort(lx_polygon_raster_t* raster) {
+// sort the new edges and merge them into the sorted active edges in one pass
+static lx_inline lx_void_t lx_polygon_raster_active_sorted_append(lx_polygon_raster_t* raster, lx_uint32_t edge_index) {
     lx_assert(raster && raster->edge_pool);
+    lx_check_return(edge_index);
 
-    lx_uint16_t               index       = raster->active_edges;
-    lx_uint16_t               index_next  = 0;
-    lx_polygon_raster_edge_t* edge        = lx_null;
-    lx_polygon_raster_edge_t* edge_next   = lx_null;
-    lx_polygon_raster_edge_t  edge_tmp;
-    lx_polygon_raster_edge_t* edge_pool   = raster->edge_pool;
-    while (index) {
-
-        // the next edge index
-        edge = edge_pool + index;
-        index_next = edge->next;
-        while (index_next) {
-
-            // the next edge
-            edge_next = edge_pool + index_next;
-
-            // need sort? swap them
-            if (edge->x > edge_next->x || (edge->x == edge_next->x && edge->slope > edge_next->slope)) {
-
-                // swap the edge
-                edge_tmp = *edge;
-                *edge = *edge_next;
-
-                // restore the next index
-                edge->next = edge_tmp.next;
-                edge_tmp.next = edge_next->next;
-
-                // swap the next edge
-                *edge_next = edge_tmp;
-            }
-            index_next = edge_next->next;
-        }
-        index = edge->next;
-    }
+    lx_polygon_raster_edge_t* edge_pool = raster->edge_pool;
+    edge_index = lx_polygon_raster_edges_sort(edge_pool, edge_index);
+    raster->active_edges = lx_polygon_raster_edges_merge(edge_pool, raster->active_edges, edge_index);
 }
 
-static lx_void_t lx_polygon_raster_make_convex(lx_polygon_raster_t* raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
+static lx_void_t lx_polygon_raster_make_convex(lx_polygon_raster_t* raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds) {
     lx_assert(raster && polygon && polygon->convex && bounds);
 
     // init the active edges
@@ -854,14 +887,14 @@ static lx_void_t lx_polygon_raster_make_convex(lx_polygon_raster_t* raster, lx_p
     lx_long_t    top         = raster->top;
     lx_long_t    bottom      = raster->bottom;
     lx_long_t    base        = raster->edge_table_base;
-    lx_uint16_t* edge_table  = raster->edge_table;
+    lx_uint32_t* edge_table  = raster->edge_table;
     for (y = top; y < bottom; y++) {
 
         // append edges to the sorted active edges by x in ascending
         lx_polygon_raster_active_sorted_append(raster, edge_table[y - base]);
 
         // scan line from the active edges
-        lx_polygon_raster_active_scan_line_convex(raster, y, callback, udata);
+        lx_polygon_raster_active_scan_line_convex(raster, y);
 
         // end?
         lx_check_break(y < bottom - 1);
@@ -871,7 +904,7 @@ static lx_void_t lx_polygon_raster_make_convex(lx_polygon_raster_t* raster, lx_p
     }
 }
 
-static lx_void_t lx_polygon_raster_make_concave(lx_polygon_raster_t* raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
+static lx_void_t lx_polygon_raster_make_concave(lx_polygon_raster_t* raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule) {
     lx_assert(raster && polygon && !polygon->convex && bounds);
 
     // init the active edges
@@ -888,21 +921,18 @@ static lx_void_t lx_polygon_raster_make_concave(lx_polygon_raster_t* raster, lx_
     lx_long_t       top         = raster->top;
     lx_long_t       bottom      = raster->bottom;
     lx_long_t       base        = raster->edge_table_base;
-    lx_uint16_t*    edge_table  = raster->edge_table;
+    lx_uint32_t*    edge_table  = raster->edge_table;
     for (y = top; y < bottom; y++) {
-        // order? append edges to the sorted active edges by x in ascending
-        if (order) {
-            lx_polygon_raster_active_sorted_append(raster, edge_table[y - base]);
-        } else {
-            // append edges to the active edges from the edge table
-            lx_polygon_raster_active_append(raster, edge_table[y - base]);
-
-            // sort by x in ascending at the active edges
-            lx_polygon_raster_active_sort(raster);
+        // the edges have been crossed? we need re-sort the active edges by x in ascending
+        if (!order) {
+            raster->active_edges = lx_polygon_raster_edges_sort(raster->edge_pool, raster->active_edges);
         }
 
+        // append edges to the sorted active edges by x in ascending
+        lx_polygon_raster_active_sorted_append(raster, edge_table[y - base]);
+
         // scan line from the active edges
-        lx_polygon_raster_active_scan_line_concave(raster, y, rule, callback, udata);
+        lx_polygon_raster_active_scan_line_concave(raster, y, rule);
 
         // end?
         lx_check_break(y < bottom - 1);
@@ -912,11 +942,558 @@ static lx_void_t lx_polygon_raster_make_concave(lx_polygon_raster_t* raster, lx_
     }
 }
 
+static lx_bool_t lx_polygon_raster_cell_pool_init(lx_polygon_raster_t* raster) {
+    lx_assert(raster);
+    if (!raster->cell_pool) {
+        raster->cell_pool_maxn = LX_POLYGON_RASTER_CELLS_GROW;
+        raster->cell_pool = lx_nalloc_type(raster->cell_pool_maxn, lx_polygon_raster_cell_t);
+    }
+    lx_assert_and_check_return_val(raster->cell_pool, lx_false);
+    raster->cell_pool_size = 0;
+    return lx_true;
+}
+
+static lx_void_t lx_polygon_raster_cell_pool_exit(lx_polygon_raster_t* raster) {
+    lx_assert(raster);
+    if (raster->cell_pool) {
+        lx_free(raster->cell_pool);
+        raster->cell_pool = lx_null;
+    }
+}
+
+static lx_uint32_t lx_polygon_raster_cell_pool_aloc(lx_polygon_raster_t* raster) {
+    lx_assert(raster && raster->cell_pool);
+
+    // the new index
+    lx_size_t index = ++raster->cell_pool_size;
+    lx_assert(index < LX_MAXU32);
+
+    // grow the cell pool
+    if (index >= raster->cell_pool_maxn) {
+        raster->cell_pool_maxn = index + LX_POLYGON_RASTER_CELLS_GROW;
+        raster->cell_pool = lx_ralloc_type(raster->cell_pool, raster->cell_pool_maxn, lx_polygon_raster_cell_t);
+        lx_assert_and_check_return_val(raster->cell_pool, 0);
+    }
+    return (lx_uint32_t)index;
+}
+
+static lx_bool_t lx_polygon_raster_cell_table_init(lx_polygon_raster_t* raster, lx_long_t table_base, lx_size_t table_size) {
+    lx_assert(raster && table_size);
+
+    if (!raster->cell_table) {
+        raster->cell_table_maxn = table_size;
+        raster->cell_table = lx_nalloc_type(raster->cell_table_maxn, lx_uint32_t);
+    } else if (table_size > raster->cell_table_maxn) {
+        raster->cell_table_maxn = table_size;
+        raster->cell_table = lx_ralloc_type(raster->cell_table, raster->cell_table_maxn, lx_uint32_t);
+    }
+    lx_assert_and_check_return_val(raster->cell_table, lx_false);
+
+    lx_memset(raster->cell_table, 0, table_size * sizeof(lx_uint32_t));
+    raster->cell_table_base = table_base;
+    raster->cell_table_size = table_size;
+    return lx_true;
+}
+
+static lx_void_t lx_polygon_raster_cell_table_exit(lx_polygon_raster_t* raster) {
+    lx_assert(raster);
+    if (raster->cell_table) {
+        lx_free(raster->cell_table);
+        raster->cell_table = lx_null;
+    }
+}
+
+static lx_void_t lx_polygon_raster_cell_flush(lx_polygon_raster_t* raster) {
+    lx_assert(raster && raster->cell_pool && raster->cell_table);
+
+    // empty cell? ignore it
+    lx_polygon_raster_cell_t* cell = &raster->cell;
+    lx_check_return(cell->area || cell->cover);
+
+    // out of the cell table?
+    lx_long_t table_index = raster->cell_y - raster->cell_table_base;
+    lx_check_return(table_index >= 0 && table_index < raster->cell_table_size);
+
+    /* find the inserted position, the cells are sorted by x in ascending
+     *
+     * table[y]: => cell(x0) => cell(x1) => .. => 0
+     */
+    lx_uint32_t               prev      = 0;
+    lx_uint32_t               index     = raster->cell_table[table_index];
+    lx_polygon_raster_cell_t* cell_pool = raster->cell_pool;
+    while (index && cell_pool[index].x < cell->x) {
+        prev  = index;
+        index = cell_pool[index].next;
+    }
+
+    // the same cell? merge it
+    if (index && cell_pool[index].x == cell->x) {
+        cell_pool[index].area  += cell->area;
+        cell_pool[index].cover += cell->cover;
+    } else {
+        // make a new cell, @note the cell pool may be re-allocated
+        lx_uint32_t cell_index = lx_polygon_raster_cell_pool_aloc(raster);
+        lx_assert_and_check_return(cell_index);
+        cell_pool = raster->cell_pool;
+
+        // insert it: prev => cell_new => index
+        lx_polygon_raster_cell_t* cell_new = cell_pool + cell_index;
+        cell_new->x     = cell->x;
+        cell_new->area  = cell->area;
+        cell_new->cover = cell->cover;
+        cell_new->next  = index;
+        if (prev) cell_pool[prev].next = cell_index;
+        else raster->cell_table[table_index] = cell_index;
+    }
+}
+
+static lx_inline lx_void_t lx_polygon_raster_cell_set(lx_polygon_raster_t* raster, lx_long_t ex, lx_long_t ey) {
+    /* all cells on the left-hand of the bounds are merged to one cell, we only need the cover of them,
+     * and all cells on the right-hand of the clip bounds are merged to one cell which will be not outputed
+     */
+    if (ex < raster->cell_xmin) ex = raster->cell_xmin - 1;
+    else if (ex > raster->cell_xmax) ex = raster->cell_xmax;
+
+    // move to the new cell?
+    lx_polygon_raster_cell_t* cell = &raster->cell;
+    if (ex != cell->x || ey != raster->cell_y) {
+        lx_polygon_raster_cell_flush(raster);
+        cell->x        = (lx_int32_t)ex;
+        cell->area     = 0;
+        cell->cover    = 0;
+        raster->cell_y = ey;
+    }
+}
+
+/* render the line segment in the given scanline
+ *
+ * @param raster        the raster
+ * @param ey            the scanline
+ * @param x1            the start sub-pixel x-coordinate
+ * @param y1            the start sub-pixel y-coordinate in this scanline, [0, one]
+ * @param x2            the end sub-pixel x-coordinate
+ * @param y2            the end sub-pixel y-coordinate in this scanline, [0, one]
+ */
+static lx_void_t lx_polygon_raster_cell_render_scanline(lx_polygon_raster_t* raster, lx_long_t ey, lx_long_t x1, lx_long_t y1, lx_long_t x2, lx_long_t y2) {
+    lx_long_t ex1 = LX_POLYGON_RASTER_AA_TRUNC(x1);
+    lx_long_t ex2 = LX_POLYGON_RASTER_AA_TRUNC(x2);
+    lx_long_t fx1 = LX_POLYGON_RASTER_AA_FRACT(x1);
+    lx_long_t fx2 = LX_POLYGON_RASTER_AA_FRACT(x2);
+    lx_polygon_raster_cell_t* cell = &raster->cell;
+
+    // horizontal line? only move to the end cell
+    if (y1 == y2) {
+        lx_polygon_raster_cell_set(raster, ex2, ey);
+        return ;
+    }
+
+    // in the same cell?
+    if (ex1 == ex2) {
+        lx_long_t delta = y2 - y1;
+        cell->area  += (fx1 + fx2) * delta;
+        cell->cover += (lx_int32_t)delta;
+        return ;
+    }
+
+    /* cross the multiple cells
+     *
+     *  ---------------------------------
+     * |    .    |         |         |
+     * |      .  |         |         |
+     * |         |.  .  .  |  .      |
+     * |         |         |      .  |
+     *  ---------------------------------
+     *    first      lift      last
+     */
+    lx_long_t p;
+    lx_long_t first;
+    lx_long_t incr;
+    lx_long_t dx = x2 - x1;
+    lx_long_t dy = y2 - y1;
+    if (dx > 0) {
+        p     = (LX_POLYGON_RASTER_AA_ONE - fx1) * dy;
+        first = LX_POLYGON_RASTER_AA_ONE;
+        incr  = 1;
+    } else {
+        p     = fx1 * dy;
+        first = 0;
+        incr  = -1;
+        dx    = -dx;
+    }
+
+    // the first cell
+    lx_long_t delta = p / dx;
+    lx_long_t mod   = p % dx;
+    if (mod < 0) {
+        delta--;
+        mod += dx;
+    }
+    cell->area  += (fx1 + first) * delta;
+    cell->cover += (lx_int32_t)delta;
+    y1  += delta;
+    ex1 += incr;
+    lx_polygon_raster_cell_set(raster, ex1, ey);
+
+    // the middle cells
+    if (ex1 != ex2) {
+        p = LX_POLYGON_RASTER_AA_ONE * (y2 - y1 + delta);
+        lx_long_t lift = p / dx;
+        lx_long_t rem  = p % dx;
+        if (rem < 0) {
+            lift--;
+            rem += dx;
+        }
+        mod -= dx;
+        while (ex1 != ex2) {
+            delta = lift;
+            mod += rem;
+            if (mod >= 0) {
+                mod -= dx;
+                delta++;
+            }
+            cell->area  += LX_POLYGON_RASTER_AA_ONE * delta;
+            cell->cover += (lx_int32_t)delta;
+            y1  += delta;
+            ex1 += incr;
+            lx_polygon_raster_cell_set(raster, ex1, ey);
+        }
+    }
+
+    // the last cell
+    delta = y2 - y1;
+    cell->area  += (fx2 + LX_POLYGON_RASTER_AA_ONE - first) * delta;
+    cell->cover += (lx_int32_t)delta;
+}
+
+/* get the count of the scanlines which need be skipped before entering the cell table
+ *
+ * @return  the skipped count, -1 if all scanlines are out of the cell table
+ */
+static lx_inline lx_long_t lx_polygon_raster_cell_skip(lx_polygon_raster_t* raster, lx_long_t ey1, lx_long_t ey2, lx_long_t incr) {
+    lx_long_t top    = raster->cell_table_base;
+    lx_long_t bottom = raster->cell_table_base + (lx_long_t)raster->cell_table_size;
+    if (incr > 0) {
+        if (ey1 >= top) return 0;
+        return ey2 >= top? top - ey1 : -1;
+    } else {
+        if (ey1 < bottom) return 0;
+        return ey2 < bottom? ey1 - bottom + 1 : -1;
+    }
+}
+
+// get the scanline after leaving the cell table
+static lx_inline lx_long_t lx_polygon_raster_cell_end(lx_polygon_raster_t* raster, lx_long_t incr) {
+    return incr > 0? raster->cell_table_base + (lx_long_t)raster->cell_table_size : raster->cell_table_base - 1;
+}
+
+/* render the edge to the cells
+ *
+ * @param raster        the raster
+ * @param x1            the start sub-pixel x-coordinate
+ * @param y1            the start sub-pixel y-coordinate
+ * @param x2            the end sub-pixel x-coordinate
+ * @param y2            the end sub-pixel y-coordinate
+ */
+static lx_void_t lx_polygon_raster_cell_render_line(lx_polygon_raster_t* raster, lx_long_t x1, lx_long_t y1, lx_long_t x2, lx_long_t y2) {
+    lx_long_t ey1 = LX_POLYGON_RASTER_AA_TRUNC(y1);
+    lx_long_t ey2 = LX_POLYGON_RASTER_AA_TRUNC(y2);
+    lx_long_t fy1 = LX_POLYGON_RASTER_AA_FRACT(y1);
+    lx_long_t fy2 = LX_POLYGON_RASTER_AA_FRACT(y2);
+    lx_polygon_raster_cell_t* cell = &raster->cell;
+
+    // move to the start cell
+    lx_polygon_raster_cell_set(raster, LX_POLYGON_RASTER_AA_TRUNC(x1), ey1);
+
+    // in the same scanline?
+    if (ey1 == ey2) {
+        lx_polygon_raster_cell_render_scanline(raster, ey1, x1, fy1, x2, fy2);
+        return ;
+    }
+
+    lx_long_t p;
+    lx_long_t first;
+    lx_long_t incr;
+    lx_long_t delta;
+    lx_long_t dx = x2 - x1;
+    lx_long_t dy = y2 - y1;
+
+    // vertical line? we need not render the scanlines
+    if (!dx) {
+        lx_long_t ex     = LX_POLYGON_RASTER_AA_TRUNC(x1);
+        lx_long_t two_fx = LX_POLYGON_RASTER_AA_FRACT(x1) << 1;
+        if (dy > 0) {
+            first = LX_POLYGON_RASTER_AA_ONE;
+            incr  = 1;
+        } else {
+            first = 0;
+            incr  = -1;
+        }
+
+        // the first cell
+        delta = first - fy1;
+        cell->area  += two_fx * delta;
+        cell->cover += (lx_int32_t)delta;
+        ey1 += incr;
+
+        // skip the middle cells out of the cell table
+        lx_long_t skip = lx_polygon_raster_cell_skip(raster, ey1, ey2, incr);
+        if (skip < 0) return ;
+        ey1 += incr * skip;
+        lx_polygon_raster_cell_set(raster, ex, ey1);
+
+        // the middle cells, we need not render the cells after leaving the cell table
+        lx_long_t end = lx_polygon_raster_cell_end(raster, incr);
+        delta = first + first - LX_POLYGON_RASTER_AA_ONE;
+        while (ey1 != ey2) {
+            if (ey1 == end) return ;
+            cell->area  += two_fx * delta;
+            cell->cover += (lx_int32_t)delta;
+            ey1 += incr;
+            lx_polygon_raster_cell_set(raster, ex, ey1);
+        }
+
+        // the last cell
+        delta = fy2 - LX_POLYGON_RASTER_AA_ONE + first;
+        cell->area  += two_fx * delta;
+        cell->cover += (lx_int32_t)delta;
+        return ;
+    }
+
+    // cross the multiple scanlines
+    if (dy > 0) {
+        p     = (LX_POLYGON_RASTER_AA_ONE - fy1) * dx;
+        first = LX_POLYGON_RASTER_AA_ONE;
+        incr  = 1;
+    } else {
+        p     = fy1 * dx;
+        first = 0;
+        incr  = -1;
+        dy    = -dy;
+    }
+
+    // the first scanline
+    delta = p / dy;
+    lx_long_t mod = p % dy;
+    if (mod < 0) {
+        delta--;
+        mod += dy;
+    }
+    lx_long_t x = x1 + delta;
+    lx_polygon_raster_cell_render_scanline(raster, ey1, x1, fy1, x, first);
+    ey1 += incr;
+
+    /* skip the middle scanlines out of the cell table
+     *
+     * the x-coordinate at the m-th scanline is x1 + floor((p + m * dx * ONE) / dy),
+     * so we can jump to the first visible scanline directly and get the same result as stepping
+     */
+    lx_long_t skip = lx_polygon_raster_cell_skip(raster, ey1, ey2, incr);
+    if (skip < 0) return ;
+    if (skip) {
+        lx_hong_t n = (lx_hong_t)p + (lx_hong_t)skip * LX_POLYGON_RASTER_AA_ONE * dx;
+        lx_hong_t d = n / dy;
+        lx_hong_t m = n % dy;
+        if (m < 0) {
+            d--;
+            m += dy;
+        }
+        x    = x1 + (lx_long_t)d;
+        mod  = (lx_long_t)m;
+        ey1 += incr * skip;
+    }
+    lx_polygon_raster_cell_set(raster, LX_POLYGON_RASTER_AA_TRUNC(x), ey1);
+
+    // the middle scanlines, we need not render the scanlines after leaving the cell table
+    lx_long_t end = lx_polygon_raster_cell_end(raster, incr);
+    if (ey1 != ey2) {
+        p = LX_POLYGON_RASTER_AA_ONE * dx;
+        lx_long_t lift = p / dy;
+        lx_long_t rem  = p % dy;
+        if (rem < 0) {
+            lift--;
+            rem += dy;
+        }
+        mod -= dy;
+        while (ey1 != ey2) {
+            if (ey1 == end) return ;
+            delta = lift;
+            mod += rem;
+            if (mod >= 0) {
+                mod -= dy;
+                delta++;
+            }
+            lx_long_t x_next = x + delta;
+            lx_polygon_raster_cell_render_scanline(raster, ey1, x, LX_POLYGON_RASTER_AA_ONE - first, x_next, first);
+            x = x_next;
+            ey1 += incr;
+            lx_polygon_raster_cell_set(raster, LX_POLYGON_RASTER_AA_TRUNC(x), ey1);
+        }
+    }
+
+    // the last scanline
+    lx_polygon_raster_cell_render_scanline(raster, ey1, x, LX_POLYGON_RASTER_AA_ONE - first, x2, fy2);
+}
+
+static lx_bool_t lx_polygon_raster_cell_table_make(lx_polygon_raster_t* raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds) {
+    lx_check_return_val(!lx_near0(bounds->w) && !lx_near0(bounds->h), lx_false);
+
+    // init the cell pool
+    if (!lx_polygon_raster_cell_pool_init(raster)) {
+        return lx_false;
+    }
+
+    // init the cell table
+    lx_long_t top    = lx_max(lx_floor(bounds->y), raster->clip_top);
+    lx_long_t bottom = lx_min(lx_floor(bounds->y + bounds->h) + 1, raster->clip_bottom);
+    lx_check_return_val(top < bottom, lx_false);
+    if (!lx_polygon_raster_cell_table_init(raster, top, bottom - top)) {
+        return lx_false;
+    }
+
+    // init the current cell
+    raster->cell_xmin  = lx_max(lx_floor(bounds->x), raster->clip_left);
+    raster->cell_xmax  = raster->clip_right;
+    lx_check_return_val(raster->cell_xmin < raster->cell_xmax, lx_false);
+    raster->cell.x     = (lx_int32_t)(raster->cell_xmin - 1);
+    raster->cell.area  = 0;
+    raster->cell.cover = 0;
+    raster->cell_y     = top;
+
+    // render all edges to the cells
+    lx_long_t       xb     = 0;
+    lx_long_t       yb     = 0;
+    lx_long_t       xe     = 0;
+    lx_long_t       ye     = 0;
+    lx_long_t       ymin   = top << LX_POLYGON_RASTER_AA_BITS;
+    lx_long_t       ymax   = bottom << LX_POLYGON_RASTER_AA_BITS;
+    lx_uint32_t     index  = 0;
+    lx_point_ref_t  points = polygon->points;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count  = *counts++;
+    while (index < count) {
+        xe = lx_round(points->x * LX_POLYGON_RASTER_AA_ONE);
+        ye = lx_round(points->y * LX_POLYGON_RASTER_AA_ONE);
+        points++;
+        if (index && ye != yb && !(yb <= ymin && ye <= ymin) && !(yb >= ymax && ye >= ymax)) {
+            // the scanlines out of the clip bounds will be skipped when rendering line
+            lx_polygon_raster_cell_render_line(raster, xb, yb, xe, ye);
+        }
+        xb = xe;
+        yb = ye;
+        index++;
+        if (index == count) { // next polygon
+            count = *counts++;
+            index = 0;
+        }
+    }
+
+    // flush the last cell
+    lx_polygon_raster_cell_flush(raster);
+
+    // update top and bottom of the polygon
+    raster->top    = top;
+    raster->bottom = bottom;
+    return lx_true;
+}
+
+static lx_inline lx_byte_t lx_polygon_raster_cell_coverage(lx_long_t area, lx_size_t rule) {
+    // area => [-256, 256] * N
+    lx_long_t coverage = area >> (LX_POLYGON_RASTER_AA_BITS * 2 + 1 - 8);
+    if (coverage < 0) coverage = -coverage;
+    if (rule == LX_POLYGON_RASTER_RULE_ODD) {
+        coverage &= 511;
+        if (coverage > 256) coverage = 512 - coverage;
+        else if (coverage == 256) coverage = 255;
+    } else if (coverage >= 256) {
+        coverage = 255;
+    }
+    return (lx_byte_t)coverage;
+}
+
+static lx_void_t lx_polygon_raster_cell_sweep(lx_polygon_raster_t* raster, lx_size_t rule) {
+    lx_assert(raster && raster->cell_pool && raster->cell_table);
+
+    lx_long_t                 y;
+    lx_long_t                 base      = raster->cell_table_base;
+    lx_long_t                 xmin      = raster->cell_xmin;
+    lx_long_t                 xmax      = raster->cell_xmax;
+    lx_uint32_t*              cell_table = raster->cell_table;
+    lx_polygon_raster_cell_t* cell_pool = raster->cell_pool;
+    for (y = raster->top; y < raster->bottom; y++) {
+
+        // the cells of this scanline
+        lx_uint32_t index = cell_table[y - base];
+        lx_check_continue(index);
+
+        // the pending span
+        lx_long_t   span_lx       = 0;
+        lx_long_t   span_rx       = 0;
+        lx_byte_t   span_coverage = 0;
+
+        // scan cells by x in ascending
+        lx_long_t   x     = xmin;
+        lx_long_t   cover = 0;
+        while (index) {
+            lx_polygon_raster_cell_t* cell = cell_pool + index;
+
+            /* the span between the previous cell and this cell only has the cover
+             *
+             * cell ... [x, cell->x) ... cell
+             */
+            lx_byte_t coverage;
+            if (cover && cell->x > x) {
+                coverage = lx_polygon_raster_cell_coverage(cover << (LX_POLYGON_RASTER_AA_BITS + 1), rule);
+                if (coverage) {
+                    if (span_coverage == coverage && span_rx == x) {
+                        span_rx = cell->x;
+                    } else {
+                        if (span_coverage) lx_polygon_raster_span_add(raster, span_lx, span_rx, y, 1, span_coverage);
+                        span_lx       = x;
+                        span_rx       = cell->x;
+                        span_coverage = coverage;
+                    }
+                }
+            }
+
+            // the coverage of this cell
+            cover += cell->cover;
+            if (cell->x >= xmin && cell->x < xmax) {
+                coverage = lx_polygon_raster_cell_coverage((cover << (LX_POLYGON_RASTER_AA_BITS + 1)) - cell->area, rule);
+                if (coverage) {
+                    if (span_coverage == coverage && span_rx == cell->x) {
+                        span_rx = cell->x + 1;
+                    } else {
+                        if (span_coverage) lx_polygon_raster_span_add(raster, span_lx, span_rx, y, 1, span_coverage);
+                        span_lx       = cell->x;
+                        span_rx       = cell->x + 1;
+                        span_coverage = coverage;
+                    }
+                }
+            }
+
+            // the next cell
+            x     = cell->x + 1;
+            index = cell->next;
+        }
+
+        // add the left span
+        if (span_coverage) lx_polygon_raster_span_add(raster, span_lx, span_rx, y, 1, span_coverage);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 lx_polygon_raster_ref_t lx_polygon_raster_init() {
-    return (lx_polygon_raster_ref_t)lx_malloc0_type(lx_polygon_raster_t);
+    lx_polygon_raster_t* raster = lx_malloc0_type(lx_polygon_raster_t);
+    if (raster) {
+        // clip it to the max device bounds by default
+        raster->clip_left   = 0;
+        raster->clip_top    = 0;
+        raster->clip_right  = LX_WIDTH_MAX;
+        raster->clip_bottom = LX_HEIGHT_MAX;
+    }
+    return (lx_polygon_raster_ref_t)raster;
 }
 
 lx_void_t lx_polygon_raster_exit(lx_polygon_raster_ref_t self) {
@@ -924,35 +1501,78 @@ lx_void_t lx_polygon_raster_exit(lx_polygon_raster_ref_t self) {
     if (raster) {
         lx_polygon_raster_edge_table_exit(raster);
         lx_polygon_raster_edge_pool_exit(raster);
+        lx_polygon_raster_cell_table_exit(raster);
+        lx_polygon_raster_cell_pool_exit(raster);
         lx_free(raster);
     }
 }
 
+lx_void_t lx_polygon_raster_clip_set(lx_polygon_raster_ref_t self, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_polygon_raster_t* raster = (lx_polygon_raster_t*)self;
+    lx_assert_and_check_return(raster && w >= 0 && h >= 0);
+
+    // the clip bounds cannot be larger than the max device bounds
+    raster->clip_left   = lx_max(x, 0);
+    raster->clip_top    = lx_max(y, 0);
+    raster->clip_right  = lx_min(x + w, LX_WIDTH_MAX);
+    raster->clip_bottom = lx_min(y + h, LX_HEIGHT_MAX);
+}
+
 lx_void_t lx_polygon_raster_make(lx_polygon_raster_ref_t self, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
     lx_polygon_raster_t* raster = (lx_polygon_raster_t*)self;
     lx_assert_and_check_return(raster && polygon && polygon->points && polygon->counts && bounds && callback);
 
+    // init the span buffer
+    raster->spans_count = 0;
+    raster->callback    = callback;
+    raster->udata       = udata;
+
     // is convex polygon for each contour?
     if (polygon->convex) {
         lx_polygon_t    contour;
         lx_size_t       index               = 0;
         lx_point_ref_t  points              = polygon->points;
-        lx_uint16_t*    counts              = polygon->counts;
-        lx_uint16_t     contour_counts[2]   = {0, 0};
+        lx_uint32_t*    counts              = polygon->counts;
+        lx_uint32_t     contour_counts[2]   = {0, 0};
         lx_polygon_make(&contour, lx_null, contour_counts, 0, lx_true);
         while ((contour_counts[0] = *counts++)) {
             // init the polygon for this contour
             contour.points = points + index;
 
             // do raster for the convex contour, will be faster
-            lx_polygon_raster_make_convex(raster, &contour, bounds, callback, udata);
+            lx_polygon_raster_make_convex(raster, &contour, bounds);
 
             // update the contour index
             index += contour_counts[0];
         }
     } else {
         // do raster for the concave polygon
-        lx_polygon_raster_make_concave(raster, polygon, bounds, rule, callback, udata);
+        lx_polygon_raster_make_concave(raster, polygon, bounds, rule);
+    }
+
+    // flush the left spans
+    lx_polygon_raster_spans_flush(raster);
+}
+
+lx_void_t lx_polygon_raster_make_aa(lx_polygon_raster_ref_t self, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata) {
+    lx_polygon_raster_t* raster = (lx_polygon_raster_t*)self;
+    lx_assert_and_check_return(raster && polygon && polygon->points && polygon->counts && bounds && callback);
+
+    // convex polygon? we can use the non-zero rule for all contours
+    if (polygon->convex) {
+        rule = LX_POLYGON_RASTER_RULE_NONZERO;
     }
+
+    // make the cell table
+    if (!lx_polygon_raster_cell_table_make(raster, polygon, bounds)) {
+        return ;
+    }
+
+    // sweep the cells and output the spans
+    raster->spans_count = 0;
+    raster->callback    = callback;
+    raster->udata       = udata;
+    lx_polygon_raster_cell_sweep(raster, rule);
+    lx_polygon_raster_spans_flush(raster);
 }
 
@@ -44,15 +44,29 @@ typedef enum lx_polygon_raster_rule_e_ {
 // the polygon raster ref type
 typedef lx_typeref(polygon_raster);
 
+/* the polygon raster span type
+ *
+ * it covers [x0, x1) x [y, y + h), the anti-aliased raster only outputs the spans with one row,
+ * and the aliased raster only outputs the spans with the full coverage.
+ */
+typedef struct lx_polygon_raster_span_t_ {
+    lx_int32_t              x0;
+    lx_int32_t              x1;
+    lx_int32_t              y;
+    lx_uint16_t             h;
+    lx_byte_t               coverage;
+}lx_polygon_raster_span_t;
+
 /* the polygon raster callback type
  *
- * @param lx            the left x-coordinate
- * @param rx            the right x-coordinate
- * @param yb            the top y-coordinate
- * @param ye            the bottom y-coordinate
+ * the spans are sorted by y in ascending and clipped to the clip bounds in the horizontal direction,
+ * they are passed in batches to reduce the indirect calls for each span.
+ *
+ * @param spans         the spans
+ * @param count         the spans count
  * @param udata         the user data
  */
-typedef lx_void_t       (*lx_polygon_raster_cb_t)(lx_long_t lx, lx_long_t rx, lx_long_t yb, lx_long_t ye, lx_cpointer_t udata);
+typedef lx_void_t       (*lx_polygon_raster_cb_t)(lx_polygon_raster_span_t const* spans, lx_size_t count, lx_cpointer_t udata);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -70,6 +84,16 @@ lx_polygon_raster_ref_t lx_polygon_raster_init(lx_noarg_t);
  */
 lx_void_t               lx_polygon_raster_exit(lx_polygon_raster_ref_t raster);
 
+/* set the clip bounds of raster, all spans will be clipped to it and the max device bounds
+ *
+ * @param raster        the raster
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate
+ * @param w             the width
+ * @param h             the height
+ */
+lx_void_t               lx_polygon_raster_clip_set(lx_polygon_raster_ref_t raster, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
 /* make raster
  *
  * @param raster        the raster
@@ -81,6 +105,20 @@ lx_void_t               lx_polygon_raster_exit(lx_polygon_raster_ref_t raster);
  */
 lx_void_t               lx_polygon_raster_make(lx_polygon_raster_ref_t raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata);
 
+/* make anti-aliased raster
+ *
+ * it accumulates the area and cover of the sparse cells for each scanline
+ * and outputs the spans with the partial coverage
+ *
+ * @param raster        the raster
+ * @param polygon       the polygon
+ * @param bounds        the bounds
+ * @param rule          the raster rule
+ * @param callback      the raster callback
+ * @param udata         the user data
+ */
+lx_void_t               lx_polygon_raster_make_aa(lx_polygon_raster_ref_t raster, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule, lx_polygon_raster_cb_t callback, lx_cpointer_t udata);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -24,10 +24,12 @@
  */
 #include "renderer.h"
 #include "renderer/rect.h"
+#include "renderer/round_rect.h"
 #include "renderer/lines.h"
 #include "renderer/points.h"
 #include "renderer/polygon.h"
 #include "writer.h"
+#include "../../clipper.h"
 #include "../../private/stroker.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -39,12 +41,56 @@ static lx_bool_t lx_bitmap_renderer_apply_matrix_for_hint(lx_bitmap_device_t* de
     // clear output first
     output->type = LX_SHAPE_TYPE_NONE;
 
-    // rect and no rotation?
-    if (    hint
-        &&  hint->type == LX_SHAPE_TYPE_RECT
-        &&  0 == device->base.matrix->kx && 0 == device->base.matrix->ky) {
-        lx_rect_apply2(&hint->u.rect, &output->u.rect, device->base.matrix);
+    // no hint or rotation?
+    lx_matrix_ref_t matrix = device->base.matrix;
+    lx_check_return_val(hint && 0 == matrix->kx && 0 == matrix->ky, lx_false);
+
+    // apply matrix to hint
+    switch (hint->type) {
+    case LX_SHAPE_TYPE_RECT: {
+        lx_rect_apply2(&hint->u.rect, &output->u.rect, matrix);
         output->type = LX_SHAPE_TYPE_RECT;
+        break;
+    }
+    case LX_SHAPE_TYPE_CIRCLE:
+    case LX_SHAPE_TYPE_ELLIPSE:
+    case LX_SHAPE_TYPE_ROUND_RECT: {
+        // make the round rect, the circle and ellipse are the round rect with the half-size radius
+        lx_size_t       i;
+        lx_rect_t       bounds;
+        lx_round_rect_t rect;
+        if (hint->type == LX_SHAPE_TYPE_ROUND_RECT) {
+            rect = hint->u.round_rect;
+        } else {
+            if (hint->type == LX_SHAPE_TYPE_CIRCLE) {
+                lx_circle_ref_t circle = &hint->u.circle;
+                lx_rect_make(&bounds, circle->c.x - circle->r, circle->c.y - circle->r, circle->r * 2.0f, circle->r * 2.0f);
+            } else {
+                lx_ellipse_ref_t ellipse = &hint->u.ellipse;
+                lx_rect_make(&bounds, ellipse->c.x - ellipse->rx, ellipse->c.y - ellipse->ry, ellipse->rx * 2.0f, ellipse->ry * 2.0f);
+            }
+            rect.bounds = bounds;
+            for (i = 0; i < LX_RECT_CORNER_MAXN; i++) {
+                lx_vector_make(&rect.radius[i], lx_half(bounds.w), lx_half(bounds.h));
+            }
+        }
+
+        // apply matrix to the bounds and radius, the corners will be flipped if the scale is negative
+        lx_round_rect_t* applied = &output->u.round_rect;
+        lx_float_t       sx = matrix->sx;
+        lx_float_t       sy = matrix->sy;
+        lx_rect_apply2(&rect.bounds, &applied->bounds, matrix);
+        for (i = 0; i < LX_RECT_CORNER_MAXN; i++) {
+            lx_size_t corner = i;
+            if (sx < 0) corner ^= 1;
+            if (sy < 0) corner = 3 - corner;
+            lx_vector_make(&applied->radius[corner], rect.radius[i].x * lx_abs(sx), rect.radius[i].y * lx_abs(sy));
+        }
+        output->type = LX_SHAPE_TYPE_ROUND_RECT;
+        break;
+    }
+    default:
+        break;
     }
     return output->type != LX_SHAPE_TYPE_NONE;
 }
@@ -69,9 +115,9 @@ static lx_size_t lx_bitmap_renderer_apply_matrix_for_polygon(lx_bitmap_device_t*
 
     lx_array_clear(device->points);
     lx_point_ref_t  points = polygon->points;
-    lx_uint16_t*    counts = polygon->counts;
-    lx_uint16_t     count = *counts++;
-    lx_uint16_t     index = 0;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count = *counts++;
+    lx_uint32_t     index = 0;
     while (index < count) {
         lx_point_t point;
         lx_point_apply2(points++, &point, device->base.matrix);
@@ -105,6 +151,23 @@ static lx_rect_ref_t lx_bitmap_renderer_make_bounds_for_points(lx_bitmap_device_
     return &device->bounds;
 }
 
+static lx_bool_t lx_bitmap_renderer_fill_hint(lx_bitmap_device_t* device, lx_shape_ref_t hint) {
+    lx_assert(device);
+
+    // apply matrix to hint
+    lx_shape_t filled_hint;
+    lx_check_return_val(lx_bitmap_renderer_apply_matrix_for_hint(device, hint, &filled_hint), lx_false);
+
+    // fill the rect or the round rect directly without making the polygon
+    if (filled_hint.type == LX_SHAPE_TYPE_RECT) {
+        lx_bitmap_renderer_fill_rect(device, &filled_hint.u.rect);
+    } else {
+        lx_assert(filled_hint.type == LX_SHAPE_TYPE_ROUND_RECT);
+        lx_bitmap_renderer_fill_round_rect(device, &filled_hint.u.round_rect);
+    }
+    return lx_true;
+}
+
 static lx_void_t lx_bitmap_renderer_stroke_fill(lx_bitmap_device_t* device, lx_path_ref_t path) {
     lx_assert(device && device->stroker && device->base.paint && path);
     if (!lx_path_empty(path)) {
@@ -118,23 +181,145 @@ static lx_void_t lx_bitmap_renderer_stroke_fill(lx_bitmap_device_t* device, lx_p
     }
 }
 
+static lx_void_t lx_bitmap_renderer_stroke_fill_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon) {
+    lx_assert(device && device->base.paint && polygon);
+
+    // apply matrix to the stroked polygon
+    lx_polygon_t filled_polygon;
+    lx_polygon_make(&filled_polygon, lx_null, polygon->counts, polygon->total, polygon->convex);
+    lx_size_t filled_count = lx_bitmap_renderer_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
+    lx_assert_and_check_return(filled_polygon.points && filled_count);
+
+    // make the filled bounds
+    lx_rect_ref_t filled_bounds = lx_bitmap_renderer_make_bounds_for_points(device, lx_null, filled_polygon.points, filled_count);
+    lx_assert(filled_bounds);
+
+    // fill it with the nonzero rule, the overlapped pieces will be merged and every pixel is only blended once
+    lx_bitmap_renderer_fill_polygon(device, &filled_polygon, filled_bounds, LX_POLYGON_RASTER_RULE_NONZERO);
+}
+
 static lx_inline lx_bool_t lx_bitmap_renderer_stroke_only(lx_bitmap_device_t* device) {
     lx_assert(device && device->base.paint && device->base.matrix);
-    // width == 1 and solid? only stroke it
-    return (    1.0f == lx_paint_stroke_width(device->base.paint)
-            &&  1.0f == lx_abs(device->base.matrix->sx)
-            &&  1.0f == lx_abs(device->base.matrix->sy));
+    // not wider than one device pixel and solid? only stroke it as the hairline, the dashes need be split by the stroker
+    return lx_bitmap_renderer_stroke_hairline_width(device) <= 1.0f + LX_NEAR0 && !lx_paint_stroke_dash(device->base.paint, lx_null, lx_null);
+}
+
+// fill the polygon without stroking it, the paint mode will be ignored
+static lx_void_t lx_bitmap_renderer_fill_polygon_only(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_shape_ref_t hint, lx_rect_ref_t bounds) {
+    lx_assert(device && device->base.paint && polygon);
+
+    // attempt to fill the hint shape first, the clip bounds and mask have been applied by the writer
+    lx_check_return(!lx_bitmap_renderer_fill_hint(device, hint));
+
+    lx_polygon_t filled_polygon;
+    lx_polygon_make(&filled_polygon, lx_null, polygon->counts, polygon->total, polygon->convex);
+    lx_size_t filled_count = lx_bitmap_renderer_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
+    lx_assert(filled_polygon.points && filled_count);
+
+    // make the filled bounds
+    lx_rect_ref_t filled_bounds = lx_bitmap_renderer_make_bounds_for_points(device, bounds, filled_polygon.points, filled_count);
+    lx_assert(filled_bounds);
+
+    // fill polygon
+    lx_bitmap_renderer_fill_polygon(device, &filled_polygon, filled_bounds, lx_paint_fill_rule(device->base.paint));
+}
+
+// stroke the polygon without filling it, the paint mode will be ignored
+static lx_void_t lx_bitmap_renderer_stroke_polygon_only(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_shape_ref_t hint, lx_rect_ref_t bounds) {
+    lx_assert(device && device->base.paint && polygon);
+
+    if (hint && hint->type == LX_SHAPE_TYPE_LINE) {
+        lx_point_t points[2];
+        points[0] = hint->u.line.p0;
+        points[1] = hint->u.line.p1;
+        lx_bitmap_renderer_draw_lines(device, points, 2, bounds);
+    } else if (hint && hint->type == LX_SHAPE_TYPE_POINT) {
+        lx_bitmap_renderer_draw_points(device, &hint->u.point, 1, bounds);
+    } else if (lx_bitmap_renderer_stroke_only(device)) {
+        lx_polygon_t stroked_polygon;
+        lx_polygon_make(&stroked_polygon, lx_null, polygon->counts, polygon->total, polygon->convex);
+        lx_size_t stroked_count = lx_bitmap_renderer_apply_matrix_for_polygon(device, polygon, &stroked_polygon.points);
+        lx_assert(stroked_polygon.points && stroked_count);
+
+        // stroke polygon
+        if (stroked_count) lx_bitmap_renderer_stroke_polygon(device, &stroked_polygon);
+    } else {
+        // attempt to make the stroked polyline pieces directly first
+        lx_polygon_ref_t stroked_polygon = lx_stroker_make_polygon_from_polygon(device->stroker, device->base.paint, polygon, hint);
+        if (stroked_polygon) {
+            lx_bitmap_renderer_stroke_fill_polygon(device, stroked_polygon);
+        } else {
+            lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_polygon(device->stroker, device->base.paint, polygon, hint));
+        }
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 lx_bool_t lx_bitmap_renderer_init(lx_bitmap_device_t* device) {
-    return lx_bitmap_writer_init(&device->writer, device->bitmap, device->base.paint);
+    lx_assert(device && device->bitmap);
+
+    // get the clip bounds, the device may be larger than the bitmap if it's only a band of the streamed device
+    lx_long_t x = 0;
+    lx_long_t y = 0;
+    lx_long_t w = (lx_long_t)device->base.width;
+    lx_long_t h = (lx_long_t)device->base.height;
+    lx_bitmap_mask_t const* mask = lx_null;
+    if (device->base.clipper && lx_clipper_size(device->base.clipper)) {
+        lx_rect_t bounds;
+        lx_rect_imake(&bounds, x, y, w, h);
+
+        // get the clip bounds and intersect it with the bitmap bounds
+        lx_bool_t exact = lx_clipper_bounds(device->base.clipper, &bounds);
+        lx_long_t l = lx_max(lx_round(bounds.x), x);
+        lx_long_t t = lx_max(lx_round(bounds.y), y);
+        lx_long_t r = lx_min(lx_round(bounds.x + bounds.w), x + w);
+        lx_long_t b = lx_min(lx_round(bounds.y + bounds.h), y + h);
+        x = l;
+        y = t;
+        w = r - l;
+        h = b - t;
+
+        // all are clipped? we need not draw it
+        lx_check_return_val(w > 0 && h > 0, lx_false);
+
+        // it's a complex clipped region? we need clip it by the coverage mask
+        if (!exact) {
+            if (device->tiler && lx_bitmap_tiler_stream(device->tiler)) {
+                // the streamed device has not the whole surface, so the mask will be made in each band when flushing them
+                mask = lx_bitmap_tiler_mask_save(device->tiler, device->base.clipper, x, y, w, h);
+                lx_check_return_val(mask, lx_false);
+            } else {
+                if (lx_bitmap_mask_changed(&device->mask, device->base.clipper, x, y, w, h)) {
+
+                    // the recorded commands of tiler are still using the old mask, we need flush them first
+                    if (device->tiler) lx_bitmap_tiler_flush(device->tiler);
+                    if (!lx_bitmap_mask_make(&device->mask, device->raster, device->base.clipper, x, y, w, h)) {
+                        return lx_false;
+                    }
+                }
+                mask = &device->mask;
+            }
+        }
+    }
+
+    // we only record the draw commands for the tiled device, the writer will be inited when flushing tiles
+    if (device->tiler) {
+        lx_bitmap_tiler_clip_set(device->tiler, x, y, w, h);
+        lx_bitmap_tiler_mask_set(device->tiler, mask);
+        return lx_true;
+    }
+    if (!lx_bitmap_writer_init(&device->writer, device->bitmap, device->base.paint, device->base.matrix)) {
+        return lx_false;
+    }
+    lx_bitmap_writer_clip_set(&device->writer, x, y, w, h);
+    lx_bitmap_writer_mask_set(&device->writer, mask);
+    return lx_true;
 }
 
 lx_void_t lx_bitmap_renderer_exit(lx_bitmap_device_t* device) {
-    lx_bitmap_writer_exit(&device->writer);
+    if (!device->tiler) lx_bitmap_writer_exit(&device->writer);
 }
 
 lx_void_t lx_bitmap_renderer_draw_path(lx_bitmap_device_t* device, lx_path_ref_t path) {
@@ -143,15 +328,25 @@ lx_void_t lx_bitmap_renderer_draw_path(lx_bitmap_device_t* device, lx_path_ref_t
     // fill it
     lx_size_t mode = lx_paint_mode(device->base.paint);
     if (mode & LX_PAINT_MODE_FILL) {
-        lx_bitmap_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+        // attempt to fill the hint shape first, we need not flatten the curves of the circle, ellipse and round rect
+        lx_shape_ref_t hint = lx_path_hint(path);
+        if (!lx_bitmap_renderer_fill_hint(device, hint)) {
+            lx_bitmap_renderer_fill_polygon_only(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_null, lx_path_bounds(path));
+        }
     }
 
     // stroke it
     if ((mode & LX_PAINT_MODE_STROKE) && (lx_paint_stroke_width(device->base.paint) > 0)) {
         if (lx_bitmap_renderer_stroke_only(device)) {
-            lx_bitmap_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+            lx_bitmap_renderer_stroke_polygon_only(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_path_hint(path), lx_path_bounds(path));
         } else {
-            lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, path));
+            // fill the stroked outline directly first, we need not make the stroked path
+            lx_polygon_ref_t stroked_polygon = lx_stroker_make_polygon_from_path(device->stroker, device->base.paint, device->base.matrix, path);
+            if (stroked_polygon) {
+                lx_bitmap_renderer_stroke_fill_polygon(device, stroked_polygon);
+            } else {
+                lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, device->base.matrix, path));
+            }
         }
     }
 }
@@ -167,14 +362,16 @@ lx_void_t lx_bitmap_renderer_draw_lines(lx_bitmap_device_t* device, lx_point_ref
         lx_size_t       stroked_count   = lx_bitmap_renderer_apply_matrix_for_points(device, points, count, &stroked_points);
         lx_assert(stroked_points && stroked_count);
 
-        // TODO: clip it
-        // ...
-
         // stroke lines
         lx_bitmap_renderer_stroke_lines(device, stroked_points, stroked_count);
     } else {
-        // fill the stroked lines
-        lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_lines(device->stroker, device->base.paint, points, count));
+        // fill the stroked lines, attempt to make the stroked quads directly first
+        lx_polygon_ref_t stroked_polygon = lx_stroker_make_polygon_from_lines(device->stroker, device->base.paint, points, count);
+        if (stroked_polygon) {
+            lx_bitmap_renderer_stroke_fill_polygon(device, stroked_polygon);
+        } else {
+            lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_lines(device->stroker, device->base.paint, points, count));
+        }
     }
 }
 
@@ -189,9 +386,6 @@ lx_void_t lx_bitmap_renderer_draw_points(lx_bitmap_device_t* device, lx_point_re
         lx_size_t       stroked_count   = lx_bitmap_renderer_apply_matrix_for_points(device, points, count, &stroked_points);
         lx_assert(stroked_points && stroked_count);
 
-        // TODO: clip it
-        // ...
-
         // stroke points
         lx_bitmap_renderer_stroke_points(device, stroked_points, stroked_count);
     } else {
@@ -203,58 +397,15 @@ lx_void_t lx_bitmap_renderer_draw_points(lx_bitmap_device_t* device, lx_point_re
 lx_void_t lx_bitmap_renderer_draw_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_shape_ref_t hint, lx_rect_ref_t bounds) {
     lx_assert(device && device->base.paint && polygon);
 
-    if (hint && hint->type == LX_SHAPE_TYPE_LINE) {
-        lx_point_t points[2];
-        points[0] = hint->u.line.p0;
-        points[1] = hint->u.line.p1;
-        lx_bitmap_renderer_draw_lines(device, points, 2, bounds);
-        return ;
-    } else if (hint && hint->type == LX_SHAPE_TYPE_POINT) {
-        lx_bitmap_renderer_draw_points(device, &hint->u.point, 1, bounds);
-        return ;
-    }
-
-    // fill it
+    // fill it, the line and point have nothing to fill
     lx_size_t mode = lx_paint_mode(device->base.paint);
-    if (mode & LX_PAINT_MODE_FILL) {
-        lx_polygon_t filled_polygon;
-        lx_polygon_make(&filled_polygon, lx_null, polygon->counts, polygon->total, polygon->convex);
-        lx_size_t filled_count = lx_bitmap_renderer_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
-        lx_assert(filled_polygon.points && filled_count);
-
-        // make the filled bounds
-        lx_rect_ref_t filled_bounds = lx_bitmap_renderer_make_bounds_for_points(device, bounds, filled_polygon.points, filled_count);
-        lx_assert(filled_bounds);
-
-        // TODO: clip it
-        lx_bool_t clipped = lx_false;
-
-        // apply matrix to hint
-        lx_shape_t filled_hint;
-        if (!clipped && lx_bitmap_renderer_apply_matrix_for_hint(device, hint, &filled_hint)) {
-            lx_assert(filled_hint.type == LX_SHAPE_TYPE_RECT);
-            lx_bitmap_renderer_fill_rect(device, &filled_hint.u.rect);
-        } else {
-            lx_bitmap_renderer_fill_polygon(device, &filled_polygon, filled_bounds);
-        }
+    if ((mode & LX_PAINT_MODE_FILL) && !(hint && (hint->type == LX_SHAPE_TYPE_LINE || hint->type == LX_SHAPE_TYPE_POINT))) {
+        lx_bitmap_renderer_fill_polygon_only(device, polygon, hint, bounds);
     }
 
     // stroke it
     if ((mode & LX_PAINT_MODE_STROKE) && (lx_paint_stroke_width(device->base.paint) > 0)) {
-        if (lx_bitmap_renderer_stroke_only(device)) {
-            lx_polygon_t stroked_polygon;
-            lx_polygon_make(&stroked_polygon, lx_null, polygon->counts, polygon->total, polygon->convex);
-            lx_size_t stroked_count = lx_bitmap_renderer_apply_matrix_for_polygon(device, polygon, &stroked_polygon.points);
-            lx_assert(stroked_polygon.points && stroked_count);
-
-            // TODO: clip it
-            // ...
-
-            // stroke polygon
-            if (stroked_count) lx_bitmap_renderer_stroke_polygon(device, &stroked_polygon);
-        } else {
-            lx_bitmap_renderer_stroke_fill(device, lx_stroker_make_from_polygon(device->stroker, device->base.paint, polygon, hint));
-        }
+        lx_bitmap_renderer_stroke_polygon_only(device, polygon, hint, bounds);
     }
 }
 
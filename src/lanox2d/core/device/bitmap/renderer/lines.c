@@ -72,8 +72,13 @@ static lx_size_t lx_bitmap_renderer_stroke_line_generic(lx_bitmap_writer_t* writ
          */
         lx_fixed_t start_y = lx_fixed6_to_fixed(yb) + ((slope * ((LX_FIXED6_HALF - xb) & 63)) >> 6);
 
-        // check
-        lx_assert(ixb < ixe);
+        // clip it in the horizontal direction
+        if (ixb < writer->clip_left) {
+            start_y += (lx_fixed_t)((lx_hong_t)slope * (writer->clip_left - ixb));
+            ixb = writer->clip_left;
+        }
+        if (ixe > writer->clip_right) ixe = writer->clip_right;
+        lx_check_return_val(ixb < ixe, 0);
 
         // draw
         do {
@@ -113,8 +118,13 @@ static lx_size_t lx_bitmap_renderer_stroke_line_generic(lx_bitmap_writer_t* writ
          */
         lx_fixed_t start_x = lx_fixed6_to_fixed(xb) + ((slope * ((LX_FIXED6_HALF - yb) & 63)) >> 6);
 
-        // check
-        lx_assert(iyb < iye);
+        // clip it in the vertical direction
+        if (iyb < writer->clip_top) {
+            start_x += (lx_fixed_t)((lx_hong_t)slope * (writer->clip_top - iyb));
+            iyb = writer->clip_top;
+        }
+        if (iye > writer->clip_bottom) iye = writer->clip_bottom;
+        lx_check_return_val(iyb < iye, 0);
 
         // draw
         do {
@@ -125,6 +135,120 @@ static lx_size_t lx_bitmap_renderer_stroke_line_generic(lx_bitmap_writer_t* writ
     return 0;
 }
 
+/* draw the anti-aliased pixel of the hairline
+ *
+ * @param coverage  the coverage, [0, 255 * 256]
+ */
+static lx_inline lx_void_t lx_bitmap_renderer_stroke_pixel_aa(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_size_t coverage) {
+    if (coverage >= 256) lx_bitmap_writer_draw_span(writer, x, y, 1, (lx_byte_t)(coverage >> 8));
+}
+
+/* stroke the anti-aliased hairline by the wu's algorithm
+ *
+ * the line center is sampled at the pixel centers of the major direction,
+ * and each sample is split to the two nearest pixels of the minor direction by its fraction.
+ *
+ * the sampled pixel centers are in the half-open range [b, e) of the line direction,
+ * so the shared vertices of the polylines and polygon outlines will be neither blended twice nor missed.
+ *
+ * @param alpha     the coverage scale of the thinner hairline, [1, 256]
+ */
+static lx_void_t lx_bitmap_renderer_stroke_line_aa(lx_bitmap_writer_t* writer, lx_fixed6_t xb, lx_fixed6_t yb, lx_fixed6_t xe, lx_fixed6_t ye, lx_size_t alpha) {
+    lx_fixed6_t dx = xe - xb;
+    lx_fixed6_t dy = ye - yb;
+    if (lx_fixed6_abs(dx) >= lx_fixed6_abs(dy)) {
+        // get the pixels range, the pixel centers are in [xb, xe) or (xe, xb]
+        lx_long_t ixb;
+        lx_long_t ixe;
+        if (xb > xe) {
+            ixb = lx_fixed6_floor(xe - LX_FIXED6_HALF) + 1;
+            ixe = lx_fixed6_floor(xb - LX_FIXED6_HALF) + 1;
+            xb = xe;
+            yb = ye;
+        } else {
+            ixb = lx_fixed6_ceil(xb - LX_FIXED6_HALF);
+            ixe = lx_fixed6_ceil(xe - LX_FIXED6_HALF);
+        }
+
+        // too short? ignore it
+        lx_check_return(ixb < ixe);
+
+        /* compute the top edge of the line at the first pixel center
+         *
+         * yb - 0.5 + (ixb + 0.5 - xb) * dy / dx
+         */
+        lx_fixed_t slope = lx_fixed6_div(dy, dx);
+        lx_fixed_t y = lx_fixed6_to_fixed(yb - LX_FIXED6_HALF) + ((slope * (lx_long_to_fixed6(ixb) + LX_FIXED6_HALF - xb)) >> 6);
+
+        // clip it in the horizontal direction
+        if (ixb < writer->clip_left) {
+            y += (lx_fixed_t)((lx_hong_t)slope * (writer->clip_left - ixb));
+            ixb = writer->clip_left;
+        }
+        if (ixe > writer->clip_right) ixe = writer->clip_right;
+        lx_check_return(ixb < ixe);
+
+        // horizontal? draw the two spans directly
+        if (!slope) {
+            lx_size_t f = (y >> 8) & 0xff;
+            lx_long_t iy = lx_fixed_floor(y);
+            if ((255 - f) * alpha >= 256) lx_bitmap_writer_draw_span(writer, ixb, iy, ixe - ixb, (lx_byte_t)(((255 - f) * alpha) >> 8));
+            if (f * alpha >= 256) lx_bitmap_writer_draw_span(writer, ixb, iy + 1, ixe - ixb, (lx_byte_t)((f * alpha) >> 8));
+            return ;
+        }
+
+        // draw
+        do {
+            lx_size_t f = (y >> 8) & 0xff;
+            lx_long_t iy = lx_fixed_floor(y);
+            lx_bitmap_renderer_stroke_pixel_aa(writer, ixb, iy, (255 - f) * alpha);
+            lx_bitmap_renderer_stroke_pixel_aa(writer, ixb, iy + 1, f * alpha);
+            y += slope;
+        } while (++ixb < ixe);
+
+    } else {
+        // get the pixels range, the pixel centers are in [yb, ye) or (ye, yb]
+        lx_long_t iyb;
+        lx_long_t iye;
+        if (yb > ye) {
+            iyb = lx_fixed6_floor(ye - LX_FIXED6_HALF) + 1;
+            iye = lx_fixed6_floor(yb - LX_FIXED6_HALF) + 1;
+            xb = xe;
+            yb = ye;
+        } else {
+            iyb = lx_fixed6_ceil(yb - LX_FIXED6_HALF);
+            iye = lx_fixed6_ceil(ye - LX_FIXED6_HALF);
+        }
+
+        // too short? ignore it
+        lx_check_return(iyb < iye);
+
+        /* compute the left edge of the line at the first pixel center
+         *
+         * xb - 0.5 + (iyb + 0.5 - yb) * dx / dy
+         */
+        lx_fixed_t slope = lx_fixed6_div(dx, dy);
+        lx_fixed_t x = lx_fixed6_to_fixed(xb - LX_FIXED6_HALF) + ((slope * (lx_long_to_fixed6(iyb) + LX_FIXED6_HALF - yb)) >> 6);
+
+        // clip it in the vertical direction
+        if (iyb < writer->clip_top) {
+            x += (lx_fixed_t)((lx_hong_t)slope * (writer->clip_top - iyb));
+            iyb = writer->clip_top;
+        }
+        if (iye > writer->clip_bottom) iye = writer->clip_bottom;
+        lx_check_return(iyb < iye);
+
+        // draw
+        do {
+            lx_size_t f = (x >> 8) & 0xff;
+            lx_long_t ix = lx_fixed_floor(x);
+            lx_bitmap_renderer_stroke_pixel_aa(writer, ix, iyb, (255 - f) * alpha);
+            lx_bitmap_renderer_stroke_pixel_aa(writer, ix + 1, iyb, f * alpha);
+            x += slope;
+        } while (++iyb < iye);
+    }
+}
+
 static lx_void_t lx_bitmap_renderer_stroke_line_vertical(lx_bitmap_writer_t* writer, lx_fixed6_t xb, lx_fixed6_t yb, lx_fixed6_t xe, lx_fixed6_t ye) {
     // ensure the order
     if (yb > ye) {
@@ -144,35 +268,70 @@ static lx_void_t lx_bitmap_renderer_stroke_line_horizontal(lx_bitmap_writer_t* w
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+lx_float_t lx_bitmap_renderer_stroke_hairline_width(lx_bitmap_device_t* device) {
+    lx_assert(device && device->base.paint && device->base.matrix);
+
+    // we use the largest scale of the matrix axes, so it works for the rotated and skewed matrix too
+    lx_matrix_ref_t matrix = device->base.matrix;
+    lx_float_t      scale_x = lx_sqrtf(matrix->sx * matrix->sx + matrix->ky * matrix->ky);
+    lx_float_t      scale_y = lx_sqrtf(matrix->kx * matrix->kx + matrix->sy * matrix->sy);
+    return lx_paint_stroke_width(device->base.paint) * lx_max(scale_x, scale_y);
+}
+
 lx_void_t lx_bitmap_renderer_stroke_lines(lx_bitmap_device_t* device, lx_point_ref_t points, lx_size_t count) {
     lx_assert(device && points && count && !(count & 0x1));
+    if (device->tiler) {
+        lx_bitmap_tiler_stroke_lines(device->tiler, device->base.paint, device->base.matrix, points, count);
+        return ;
+    }
 
-    lx_size_t       i   = 0;
-    lx_size_t       ok  = 0;
-    lx_point_ref_t  pb  = lx_null;
-    lx_point_ref_t  pe  = lx_null;
-    lx_fixed6_t     xb  = 0;
-    lx_fixed6_t     yb  = 0;
-    lx_fixed6_t     xe  = 0;
-    lx_fixed6_t     ye  = 0;
+    lx_size_t           i       = 0;
+    lx_size_t           ok      = 0;
+    lx_point_ref_t      pb      = lx_null;
+    lx_point_ref_t      pe      = lx_null;
+    lx_fixed6_t         xb      = 0;
+    lx_fixed6_t         yb      = 0;
+    lx_fixed6_t         xe      = 0;
+    lx_fixed6_t         ye      = 0;
+    lx_bitmap_writer_t* writer  = &device->writer;
+
+    // the thinner hairline is drawn with the less coverage
+    lx_size_t alpha = 0;
+    if (lx_paint_flags(device->base.paint) & LX_PAINT_FLAG_ANTIALIASING) {
+        lx_float_t width = lx_bitmap_renderer_stroke_hairline_width(device);
+        alpha = width < 1.0f? (lx_size_t)(width * 256.0f) : 256;
+        lx_check_return(alpha);
+    }
     for (i = 0; i + 1 < count; i += 2) {
         // line: pb => pe
         pb = points + i;
         pe = points + i + 1;
 
+        // the line is out of the clip bounds? skip it
+        lx_check_continue(  lx_max(pb->x, pe->x) >= (lx_float_t)writer->clip_left - 1
+                        &&  lx_min(pb->x, pe->x) <= (lx_float_t)writer->clip_right + 1
+                        &&  lx_max(pb->y, pe->y) >= (lx_float_t)writer->clip_top - 1
+                        &&  lx_min(pb->y, pe->y) <= (lx_float_t)writer->clip_bottom + 1);
+
         // (xb, yb) => (xe, ye)
         xb = lx_float_to_fixed6(pb->x);
         yb = lx_float_to_fixed6(pb->y);
         xe = lx_float_to_fixed6(pe->x);
         ye = lx_float_to_fixed6(pe->y);
 
+        // draw the anti-aliased line
+        if (alpha) {
+            lx_bitmap_renderer_stroke_line_aa(writer, xb, yb, xe, ye, alpha);
+            continue ;
+        }
+
         // draw line
-        if ((ok = lx_bitmap_renderer_stroke_line_generic(&device->writer, xb, yb, xe, ye))) {
+        if ((ok = lx_bitmap_renderer_stroke_line_generic(writer, xb, yb, xe, ye))) {
             lx_assert(ok == 'h' || ok == 'v');
             if (ok == 'h') {
-                lx_bitmap_renderer_stroke_line_horizontal(&device->writer, xb, yb, xe, ye);
+                lx_bitmap_renderer_stroke_line_horizontal(writer, xb, yb, xe, ye);
             } else {
-                lx_bitmap_renderer_stroke_line_vertical(&device->writer, xb, yb, xe, ye);
+                lx_bitmap_renderer_stroke_line_vertical(writer, xb, yb, xe, ye);
             }
         }
     }
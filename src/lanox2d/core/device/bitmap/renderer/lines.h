@@ -35,7 +35,19 @@ lx_extern_c_enter
  * interfaces
  */
 
+/* get the stroke width of the hairline in the device pixels
+ *
+ * the stroke is drawn as the hairline directly if it's not wider than one device pixel
+ *
+ * @param device    the device
+ *
+ * @return          the stroke width
+ */
+lx_float_t          lx_bitmap_renderer_stroke_hairline_width(lx_bitmap_device_t* device);
+
 /* stroke lines
+ *
+ * it's anti-aliased by the wu's algorithm if the paint has the antialiasing flag
  *
  * @param device    the device
  * @param points    the points
@@ -29,6 +29,11 @@
  */
 lx_void_t lx_bitmap_renderer_stroke_points(lx_bitmap_device_t* device, lx_point_ref_t points, lx_size_t count) {
     lx_assert(device && points && count);
+    if (device->tiler) {
+        lx_bitmap_tiler_stroke_points(device->tiler, device->base.paint, device->base.matrix, points, count);
+        return ;
+    }
+
     lx_size_t i;
     for (i = 0; i < count; i++) {
         lx_bitmap_writer_draw_pixel(&device->writer, (lx_long_t)points[i].x, (lx_long_t)points[i].y);
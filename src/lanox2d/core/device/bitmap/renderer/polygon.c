@@ -28,26 +28,49 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static lx_void_t lx_bitmap_renderer_fill_raster(lx_long_t lx, lx_long_t rx, lx_long_t yb, lx_long_t ye, lx_cpointer_t udata) {
-    lx_assert(udata && rx >= lx && ye > yb);
-    lx_bitmap_writer_draw_rect((lx_bitmap_writer_t*)udata, lx, yb, rx - lx, ye - yb);
+static lx_void_t lx_bitmap_renderer_fill_raster(lx_polygon_raster_span_t const* spans, lx_size_t count, lx_cpointer_t udata) {
+    lx_assert(udata && spans);
+    lx_bitmap_writer_draw_spans((lx_bitmap_writer_t*)udata, spans, count);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-lx_void_t lx_bitmap_renderer_fill_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_rect_ref_t bounds) {
+lx_void_t lx_bitmap_renderer_fill_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule) {
     lx_assert(device && device->base.paint);
-    lx_polygon_raster_make(device->raster, polygon, bounds, lx_paint_fill_rule(device->base.paint), lx_bitmap_renderer_fill_raster, &device->writer);
+    if (device->tiler) {
+        lx_bitmap_tiler_fill_polygon(device->tiler, device->base.paint, device->base.matrix, polygon, bounds, rule);
+        return ;
+    }
+
+    // the polygon is out of the clip bounds? skip it
+    lx_bitmap_writer_t* writer = &device->writer;
+    if (bounds) {
+        lx_check_return(    bounds->x <= (lx_float_t)writer->clip_right && bounds->x + bounds->w >= (lx_float_t)writer->clip_left
+                        &&  bounds->y <= (lx_float_t)writer->clip_bottom && bounds->y + bounds->h >= (lx_float_t)writer->clip_top);
+    }
+
+    // clip the spans to the clip bounds of writer
+    lx_polygon_raster_clip_set(device->raster, writer->clip_left, writer->clip_top, writer->clip_right - writer->clip_left, writer->clip_bottom - writer->clip_top);
+    if (lx_paint_flags(device->base.paint) & LX_PAINT_FLAG_ANTIALIASING) {
+        lx_polygon_raster_make_aa(device->raster, polygon, bounds, rule, lx_bitmap_renderer_fill_raster, &device->writer);
+    } else {
+        lx_polygon_raster_make(device->raster, polygon, bounds, rule, lx_bitmap_renderer_fill_raster, &device->writer);
+    }
 }
 
 lx_void_t lx_bitmap_renderer_stroke_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon) {
     lx_assert(device && polygon && polygon->points && polygon->counts);
-    lx_uint16_t     index = 0;
+    if (device->tiler) {
+        lx_bitmap_tiler_stroke_polygon(device->tiler, device->base.paint, device->base.matrix, polygon);
+        return ;
+    }
+
+    lx_uint32_t     index = 0;
     lx_point_t      points_line[2];
     lx_point_ref_t  points = polygon->points;
-    lx_uint16_t*    counts = polygon->counts;
-    lx_uint16_t     count = *counts++;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count = *counts++;
     while (index < count) {
         points_line[1] = *points++;
         if (index) {
@@ -40,8 +40,9 @@ lx_extern_c_enter
  * @param device    the device
  * @param polygon   the polygon
  * @param bounds    the bounds
+ * @param rule      the fill rule
  */
-lx_void_t           lx_bitmap_renderer_fill_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_rect_ref_t bounds);
+lx_void_t           lx_bitmap_renderer_fill_polygon(lx_bitmap_device_t* device, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule);
 
 /* stroke polygon
  *
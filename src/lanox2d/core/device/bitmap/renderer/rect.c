@@ -29,5 +29,9 @@
  */
 lx_void_t lx_bitmap_renderer_fill_rect(lx_bitmap_device_t* device, lx_rect_ref_t rect) {
     lx_assert(device && rect);
+    if (device->tiler) {
+        lx_bitmap_tiler_fill_rect(device->tiler, device->base.paint, device->base.matrix, rect);
+        return ;
+    }
     lx_bitmap_writer_draw_rect(&device->writer, (lx_long_t)rect->x, (lx_long_t)rect->y, (lx_long_t)rect->w, (lx_long_t)rect->h);
 }
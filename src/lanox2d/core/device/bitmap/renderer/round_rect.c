@@ -0,0 +1,485 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        round_rect.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "round_rect.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum edge pieces count of each side in one row
+#define LX_BITMAP_RENDERER_ROUND_RECT_PIECES_MAXN   (64)
+
+// the spans cache count
+#define LX_BITMAP_RENDERER_ROUND_RECT_SPANS_MAXN    (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the round rect edge piece type
+ *
+ * the edge in one row is split to some short line pieces at the corner boundaries and the pixel column boundaries,
+ * and the exact coverage of each line piece and the arc segment on its chord is accumulated to the edge pixels.
+ */
+typedef struct lx_bitmap_renderer_round_rect_piece_t_ {
+
+    // the x-coordinate of the top point
+    lx_float_t                  xt;
+
+    // the x-coordinate of the bottom point
+    lx_float_t                  xb;
+
+    // the signed height, the left edge is positive and the right edge is negative
+    lx_float_t                  h;
+
+    // the area of the arc segment between the chord and the arc, it's zero for the straight edge
+    lx_float_t                  area;
+
+}lx_bitmap_renderer_round_rect_piece_t;
+
+// the round rect spans cache type
+typedef struct lx_bitmap_renderer_round_rect_spans_t_ {
+    lx_bitmap_writer_t*         writer;
+    lx_size_t                   count;
+    lx_polygon_raster_span_t    spans[LX_BITMAP_RENDERER_ROUND_RECT_SPANS_MAXN];
+}lx_bitmap_renderer_round_rect_spans_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_inline lx_void_t lx_bitmap_renderer_round_rect_spans_flush(lx_bitmap_renderer_round_rect_spans_t* cache) {
+    if (cache->count) {
+        lx_bitmap_writer_draw_spans(cache->writer, cache->spans, cache->count);
+        cache->count = 0;
+    }
+}
+
+static lx_inline lx_void_t lx_bitmap_renderer_round_rect_spans_add(lx_bitmap_renderer_round_rect_spans_t* cache, lx_long_t x0, lx_long_t x1, lx_long_t y, lx_byte_t coverage) {
+    if (cache->count == LX_BITMAP_RENDERER_ROUND_RECT_SPANS_MAXN) {
+        lx_bitmap_renderer_round_rect_spans_flush(cache);
+    }
+    lx_polygon_raster_span_t* span = &cache->spans[cache->count++];
+    span->x0       = (lx_int32_t)x0;
+    span->x1       = (lx_int32_t)x1;
+    span->y        = (lx_int32_t)y;
+    span->h        = 1;
+    span->coverage = coverage;
+}
+
+/* get the horizontal inset of the corner ellipse
+ *
+ *      rx
+ * . . . . . . .
+ * .        . dy
+ * .   .
+ * . inset
+ * .
+ *
+ * inset = rx - rx * sqrt(1 - (dy / ry)^2), dy is the distance to the center row of the corner ellipse
+ */
+static lx_inline lx_float_t lx_bitmap_renderer_round_rect_inset(lx_vector_ref_t radius, lx_float_t dy) {
+    lx_float_t t = dy / radius->y;
+    t = 1.0f - t * t;
+    return t > 0? radius->x - radius->x * lx_sqrtf(t) : radius->x;
+}
+
+/* get the left and right edges of the round rect at the given y-coordinate
+ *
+ * @param rect      the round rect
+ * @param y         the y-coordinate in the vertical range of the round rect
+ * @param pxl       the left x-coordinate
+ * @param pxr       the right x-coordinate
+ */
+static lx_void_t lx_bitmap_renderer_round_rect_edges(lx_round_rect_ref_t rect, lx_float_t y, lx_float_t* pxl, lx_float_t* pxr) {
+    lx_float_t top = rect->bounds.y;
+    lx_float_t bottom = rect->bounds.y + rect->bounds.h;
+
+    // the left edge
+    lx_float_t      xl = rect->bounds.x;
+    lx_vector_ref_t radius = &rect->radius[LX_RECT_CORNER_LT];
+    if (y < top + radius->y) {
+        xl += lx_bitmap_renderer_round_rect_inset(radius, top + radius->y - y);
+    } else {
+        radius = &rect->radius[LX_RECT_CORNER_LB];
+        if (y > bottom - radius->y) {
+            xl += lx_bitmap_renderer_round_rect_inset(radius, y - bottom + radius->y);
+        }
+    }
+
+    // the right edge
+    lx_float_t xr = rect->bounds.x + rect->bounds.w;
+    radius = &rect->radius[LX_RECT_CORNER_RT];
+    if (y < top + radius->y) {
+        xr -= lx_bitmap_renderer_round_rect_inset(radius, top + radius->y - y);
+    } else {
+        radius = &rect->radius[LX_RECT_CORNER_RB];
+        if (y > bottom - radius->y) {
+            xr -= lx_bitmap_renderer_round_rect_inset(radius, y - bottom + radius->y);
+        }
+    }
+
+    *pxl = xl;
+    *pxr = lx_max(xl, xr);
+}
+
+/* add the arc piece from the angle (sin0, cos0) to (sin1, cos1)
+ *
+ * the chord is inside the round rect, so the arc segment area (rx * ry / 2) * (da - sin(da)) on the chord
+ * is always added to the coverage of the pixel column containing it.
+ */
+static lx_inline lx_void_t lx_bitmap_renderer_round_rect_add_arc(lx_bitmap_renderer_round_rect_piece_t* piece, lx_vector_ref_t radius, lx_float_t sx,
+                                                                 lx_float_t xt, lx_float_t yt, lx_float_t sin0, lx_float_t cos0,
+                                                                 lx_float_t xb, lx_float_t yb, lx_float_t sin1, lx_float_t cos1) {
+    // get the angle of this piece, it's in [0, pi/2]
+    lx_float_t sin = lx_abs(sin1 * cos0 - cos1 * sin0);
+    lx_float_t cos = cos1 * cos0 + sin1 * sin0;
+    lx_float_t angle = cos > 1e-6f? lx_atanf(sin / cos) : LX_PI / 2;
+
+    piece->xt   = xt;
+    piece->xb   = xb;
+    piece->h    = sx * (yb - yt);
+    piece->area = lx_half(radius->x * radius->y) * lx_max(angle - sin, 0);
+}
+
+/* split the corner arc of one edge in [y0, y1) to the line pieces
+ *
+ * the arc is split at the pixel column boundaries, so each piece is in one pixel column
+ * and the arc segment on its chord can be added to this column exactly.
+ *
+ * if the arc is too flat and crosses too many columns, it's split by the equal angle steps,
+ * and the arc segments on these pieces are ignored.
+ *
+ * @param pieces    the pieces
+ * @param maxn      the maximum pieces count
+ * @param radius    the corner radius
+ * @param x         the x-coordinate of the straight edge
+ * @param cy        the center row of the corner ellipse
+ * @param sx        1 for the left edge, -1 for the right edge
+ * @param sy        -1 for the top corners, 1 for the bottom corners
+ * @param y0        the top y-coordinate
+ * @param y1        the bottom y-coordinate
+ *
+ * @return          the pieces count
+ */
+static lx_size_t lx_bitmap_renderer_round_rect_split_arc(lx_bitmap_renderer_round_rect_piece_t* pieces, lx_size_t maxn, lx_vector_ref_t radius,
+                                                          lx_float_t x, lx_float_t cy, lx_float_t sx, lx_float_t sy, lx_float_t y0, lx_float_t y1) {
+    /* get the start and end angles of the arc in this row
+     *
+     * dy = ry * sin(angle), inset = rx - rx * cos(angle)
+     */
+    lx_float_t sin0 = lx_min(lx_max(sy * (y0 - cy) / radius->y, 0), 1.0f);
+    lx_float_t sin1 = lx_min(lx_max(sy * (y1 - cy) / radius->y, 0), 1.0f);
+    lx_float_t cos0 = lx_sqrtf(1.0f - sin0 * sin0);
+    lx_float_t cos1 = lx_sqrtf(1.0f - sin1 * sin1);
+    lx_float_t xt   = x + sx * (radius->x - radius->x * cos0);
+    lx_float_t xb   = x + sx * (radius->x - radius->x * cos1);
+
+    // split it at the pixel column boundaries
+    lx_long_t  c0 = lx_floor(xt);
+    lx_long_t  c1 = lx_floor(xb);
+    lx_size_t  n  = (lx_size_t)lx_abs(c1 - c0) + 1;
+    lx_size_t  i;
+    if (n <= maxn) {
+        lx_long_t  dc = c1 > c0? 1 : -1;
+        lx_long_t  c  = c1 > c0? c0 + 1 : c0;
+        lx_float_t yt = y0;
+        lx_float_t sin = sin0;
+        lx_float_t cos = cos0;
+        for (i = 0; i + 1 < n; i++, c += dc) {
+            lx_float_t xc = (lx_float_t)c;
+            lx_float_t cos_c = lx_min(lx_max(1.0f - sx * (xc - x) / radius->x, 0), 1.0f);
+            lx_float_t sin_c = lx_sqrtf(1.0f - cos_c * cos_c);
+            lx_float_t yc = lx_min(lx_max(cy + sy * radius->y * sin_c, yt), y1);
+            lx_bitmap_renderer_round_rect_add_arc(&pieces[i], radius, sx, xt, yt, sin, cos, xc, yc, sin_c, cos_c);
+            xt  = xc;
+            yt  = yc;
+            sin = sin_c;
+            cos = cos_c;
+        }
+        lx_bitmap_renderer_round_rect_add_arc(&pieces[i], radius, sx, xt, yt, sin, cos, xb, y1, sin1, cos1);
+        return n;
+    }
+
+    /* split it by the equal angle steps
+     *
+     * sin(a + da) = sin(a) * cos(da) + cos(a) * sin(da)
+     * cos(a + da) = cos(a) * cos(da) - sin(a) * sin(da)
+     */
+    lx_float_t sin = sin1 * cos0 - cos1 * sin0;
+    lx_float_t cos = cos1 * cos0 + sin1 * sin0;
+    lx_float_t angle = cos > 1e-6f? lx_atanf(sin / cos) : (sin > 0? LX_PI / 2 : -LX_PI / 2);
+    lx_float_t sin_step;
+    lx_float_t cos_step;
+    lx_sincosf(angle / (lx_float_t)maxn, &sin_step, &cos_step);
+    lx_float_t yt = y0;
+    sin = sin0;
+    cos = cos0;
+    for (i = 0; i < maxn; i++) {
+        lx_float_t xe;
+        lx_float_t ye;
+        if (i + 1 < maxn) {
+            lx_float_t t = sin * cos_step + cos * sin_step;
+            cos = cos * cos_step - sin * sin_step;
+            sin = t;
+            xe = x + sx * (radius->x - radius->x * cos);
+            ye = cy + sy * radius->y * sin;
+        } else {
+            xe = xb;
+            ye = y1;
+        }
+        pieces[i].xt   = xt;
+        pieces[i].xb   = xe;
+        pieces[i].h    = sx * (ye - yt);
+        pieces[i].area = 0;
+        xt = xe;
+        yt = ye;
+    }
+    return maxn;
+}
+
+/* split the left or right edge of the round rect in [y0, y1) to the line pieces
+ *
+ * @param rect      the round rect
+ * @param right     is the right edge?
+ * @param y0        the top y-coordinate
+ * @param y1        the bottom y-coordinate
+ * @param pieces    the pieces, LX_BITMAP_RENDERER_ROUND_RECT_PIECES_MAXN at most
+ *
+ * @return          the pieces count
+ */
+static lx_size_t lx_bitmap_renderer_round_rect_split(lx_round_rect_ref_t rect, lx_bool_t right, lx_float_t y0, lx_float_t y1, lx_bitmap_renderer_round_rect_piece_t* pieces) {
+    lx_float_t      top = rect->bounds.y;
+    lx_float_t      bottom = rect->bounds.y + rect->bounds.h;
+    lx_float_t      x = right? rect->bounds.x + rect->bounds.w : rect->bounds.x;
+    lx_float_t      sx = right? -1.0f : 1.0f;
+    lx_vector_ref_t radius_top = &rect->radius[right? LX_RECT_CORNER_RT : LX_RECT_CORNER_LT];
+    lx_vector_ref_t radius_bottom = &rect->radius[right? LX_RECT_CORNER_RB : LX_RECT_CORNER_LB];
+    lx_float_t      ytop = top + radius_top->y;
+    lx_float_t      ybottom = bottom - radius_bottom->y;
+    lx_size_t       count = 0;
+
+    // the top corner arc, we reserve two pieces for the straight edge and the bottom corner arc
+    if (y0 < ytop) {
+        count += lx_bitmap_renderer_round_rect_split_arc(pieces, LX_BITMAP_RENDERER_ROUND_RECT_PIECES_MAXN - 2, radius_top,
+                                                         x, ytop, sx, -1.0f, y0, lx_min(y1, ytop));
+    }
+
+    // the straight edge
+    lx_float_t ya = lx_max(y0, ytop);
+    lx_float_t yb = lx_min(y1, ybottom);
+    if (ya < yb) {
+        lx_bitmap_renderer_round_rect_piece_t* piece = &pieces[count++];
+        piece->xt   = x;
+        piece->xb   = x;
+        piece->h    = sx * (yb - ya);
+        piece->area = 0;
+    }
+
+    // the bottom corner arc
+    if (y1 > ybottom) {
+        count += lx_bitmap_renderer_round_rect_split_arc(pieces + count, LX_BITMAP_RENDERER_ROUND_RECT_PIECES_MAXN - count, radius_bottom,
+                                                         x, ybottom, sx, 1.0f, lx_max(y0, ybottom), y1);
+    }
+    return count;
+}
+
+/* get the coverage of the pixel column [x, x + 1) on the right side of the edge piece
+ *
+ * the part on the left of this column covers it fully, and the part in this column covers
+ * the area between the middle x-coordinate of this part and the right side of the column.
+ * the arc segment on the chord is added only if the whole piece is in this column.
+ */
+static lx_inline lx_float_t lx_bitmap_renderer_round_rect_piece_coverage(lx_bitmap_renderer_round_rect_piece_t const* piece, lx_float_t x) {
+    lx_float_t xa = lx_min(piece->xt, piece->xb);
+    lx_float_t xb = lx_max(piece->xt, piece->xb);
+    if (xb <= x) return piece->h;
+    if (xa >= x + 1.0f) return 0;
+    if (xa >= x && xb <= x + 1.0f) return piece->h * (x + 1.0f - lx_half(xa + xb)) + piece->area;
+
+    lx_float_t dh = piece->h / (xb - xa);
+    lx_float_t ca = lx_max(xa, x);
+    lx_float_t cb = lx_min(xb, x + 1.0f);
+    return (ca - xa) * dh + (cb - ca) * dh * (x + 1.0f - lx_half(ca + cb));
+}
+
+/* fill the edge pixels in [x0, x1) of this row
+ *
+ * the coverage of each pixel is accumulated from the given base cover and the edge pieces in the same order,
+ * so the tiles with the different clip bounds will get the same pixels.
+ *
+ * the area is mapped to [0, 256] and clamped to 255, the same as the polygon raster,
+ * so the round rect filled here is the same as the filled round rect path within 1 / 255.
+ */
+static lx_void_t lx_bitmap_renderer_round_rect_fill_edge(lx_bitmap_renderer_round_rect_spans_t* cache, lx_bitmap_renderer_round_rect_piece_t const* pieces, lx_size_t count, lx_float_t base, lx_long_t x0, lx_long_t x1, lx_long_t y) {
+    lx_long_t   x;
+    lx_size_t   i;
+    lx_long_t   span_x = x0;
+    lx_byte_t   span_coverage = 0;
+    for (x = x0; x < x1; x++) {
+        lx_float_t cover = base;
+        for (i = 0; i < count; i++) {
+            cover += lx_bitmap_renderer_round_rect_piece_coverage(pieces + i, (lx_float_t)x);
+        }
+
+        // merge the adjacent pixels with the same coverage
+        lx_long_t value = lx_round(cover * 256.0f);
+        lx_byte_t coverage = (lx_byte_t)lx_max(lx_min(value, 0xff), 0);
+        if (coverage != span_coverage) {
+            if (span_coverage) {
+                lx_bitmap_renderer_round_rect_spans_add(cache, span_x, x, y, span_coverage);
+            }
+            span_x = x;
+            span_coverage = coverage;
+        }
+    }
+    if (span_coverage) {
+        lx_bitmap_renderer_round_rect_spans_add(cache, span_x, x1, y, span_coverage);
+    }
+}
+
+static lx_void_t lx_bitmap_renderer_round_rect_fill_aa(lx_bitmap_renderer_round_rect_spans_t* cache, lx_round_rect_ref_t rect, lx_long_t top, lx_long_t bottom) {
+    lx_bitmap_writer_t*                     writer = cache->writer;
+    lx_long_t                               y;
+    lx_size_t                               i;
+    lx_bitmap_renderer_round_rect_piece_t   pieces[LX_BITMAP_RENDERER_ROUND_RECT_PIECES_MAXN << 1];
+    for (y = top; y < bottom; y++) {
+
+        // get the vertical range of the round rect in this row
+        lx_float_t y0 = lx_max((lx_float_t)y, rect->bounds.y);
+        lx_float_t y1 = lx_min((lx_float_t)(y + 1), rect->bounds.y + rect->bounds.h);
+        lx_check_continue(y0 < y1);
+
+        /* split the left and right edges of this row to the line pieces
+         *
+         * the edges are split at the corner boundaries, because the chord across them is not accurate
+         */
+        lx_size_t nl = lx_bitmap_renderer_round_rect_split(rect, lx_false, y0, y1, pieces);
+        lx_size_t n  = nl + lx_bitmap_renderer_round_rect_split(rect, lx_true, y0, y1, pieces + nl);
+        lx_float_t lmin = pieces[0].xt;
+        lx_float_t lmax = lmin;
+        lx_float_t rmin = pieces[nl].xt;
+        lx_float_t rmax = rmin;
+        for (i = 0; i < n; i++) {
+            lx_bitmap_renderer_round_rect_piece_t const* piece = &pieces[i];
+            lx_float_t xa = lx_min(piece->xt, piece->xb);
+            lx_float_t xb = lx_max(piece->xt, piece->xb);
+            if (i < nl) {
+                if (xa < lmin) lmin = xa;
+                if (xb > lmax) lmax = xb;
+            } else {
+                if (xa < rmin) rmin = xa;
+                if (xb > rmax) rmax = xb;
+            }
+        }
+
+        // the pixels range of this row
+        lx_long_t x0 = lx_max(lx_floor(lmin), writer->clip_left);
+        lx_long_t x1 = lx_min(lx_ceil(rmax), writer->clip_right);
+        lx_check_continue(x0 < x1);
+
+        /* fill the left edge pixels, the fully covered pixels and the right edge pixels
+         *
+         * if the left and right edges are apart, the left edge pixels are not covered by the right pieces,
+         * and the right edge pixels are covered by all left pieces, it does not depend on the clip bounds.
+         */
+        lx_long_t left = lx_ceil(lmax);
+        lx_long_t right = lx_floor(rmin);
+        if (left <= right) {
+            lx_float_t cover = y1 - y0;
+            lx_long_t  value = lx_round(cover * 256.0f);
+            lx_long_t  full_x0 = lx_max(left, x0);
+            lx_long_t  full_x1 = lx_min(right, x1);
+            lx_bitmap_renderer_round_rect_fill_edge(cache, pieces, nl, 0, x0, lx_min(left, x1), y);
+            if (full_x0 < full_x1) {
+                lx_bitmap_renderer_round_rect_spans_add(cache, full_x0, full_x1, y, (lx_byte_t)lx_min(value, 0xff));
+            }
+            lx_bitmap_renderer_round_rect_fill_edge(cache, pieces + nl, n - nl, cover, lx_max(right, x0), x1, y);
+        } else {
+            lx_bitmap_renderer_round_rect_fill_edge(cache, pieces, n, 0, x0, x1, y);
+        }
+    }
+}
+
+static lx_void_t lx_bitmap_renderer_round_rect_fill(lx_bitmap_renderer_round_rect_spans_t* cache, lx_round_rect_ref_t rect, lx_long_t top, lx_long_t bottom) {
+    lx_long_t y;
+    for (y = top; y < bottom; y++) {
+        // sample the center of this row, the same as the polygon raster
+        lx_float_t yc = (lx_float_t)y + 0.5f;
+        lx_check_continue(yc >= rect->bounds.y && yc <= rect->bounds.y + rect->bounds.h);
+
+        lx_float_t xl;
+        lx_float_t xr;
+        lx_bitmap_renderer_round_rect_edges(rect, yc, &xl, &xr);
+        lx_long_t x0 = lx_round(xl);
+        lx_long_t x1 = lx_round(xr);
+        if (x0 < x1) lx_bitmap_renderer_round_rect_spans_add(cache, x0, x1, y, 0xff);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_void_t lx_bitmap_renderer_fill_round_rect(lx_bitmap_device_t* device, lx_round_rect_ref_t rect) {
+    lx_assert(device && device->base.paint && rect);
+    if (device->tiler) {
+        lx_bitmap_tiler_fill_round_rect(device->tiler, device->base.paint, device->base.matrix, rect);
+        return ;
+    }
+
+    // the round rect is out of the clip bounds? skip it
+    lx_bitmap_writer_t* writer = &device->writer;
+    lx_rect_ref_t       bounds = &rect->bounds;
+    lx_check_return(    bounds->w > 0 && bounds->h > 0
+                    &&  bounds->x <= (lx_float_t)writer->clip_right && bounds->x + bounds->w >= (lx_float_t)writer->clip_left
+                    &&  bounds->y <= (lx_float_t)writer->clip_bottom && bounds->y + bounds->h >= (lx_float_t)writer->clip_top);
+
+    // limit the corner radius to the half size
+    lx_size_t       i;
+    lx_round_rect_t limited = *rect;
+    for (i = 0; i < LX_RECT_CORNER_MAXN; i++) {
+        lx_vector_ref_t radius = &limited.radius[i];
+        radius->x = lx_min(lx_max(radius->x, 0), lx_half(bounds->w));
+        radius->y = lx_min(lx_max(radius->y, 0), lx_half(bounds->h));
+        if (radius->x <= 0 || radius->y <= 0) {
+            radius->x = 0;
+            radius->y = 0;
+        }
+    }
+
+    // fill it
+    lx_bitmap_renderer_round_rect_spans_t cache;
+    cache.writer = writer;
+    cache.count  = 0;
+    if (lx_paint_flags(device->base.paint) & LX_PAINT_FLAG_ANTIALIASING) {
+        lx_long_t top    = lx_max(lx_floor(bounds->y), writer->clip_top);
+        lx_long_t bottom = lx_min(lx_ceil(bounds->y + bounds->h), writer->clip_bottom);
+        lx_bitmap_renderer_round_rect_fill_aa(&cache, &limited, top, bottom);
+    } else {
+        lx_long_t top    = lx_max(lx_round(bounds->y), writer->clip_top);
+        lx_long_t bottom = lx_min(lx_round(bounds->y + bounds->h), writer->clip_bottom);
+        lx_bitmap_renderer_round_rect_fill(&cache, &limited, top, bottom);
+    }
+    lx_bitmap_renderer_round_rect_spans_flush(&cache);
+}
@@ -0,0 +1,52 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        round_rect.h
+ *
+ */
+#ifndef LX_CORE_DEVICE_BITMAP_RENDERER_ROUND_RECT_H
+#define LX_CORE_DEVICE_BITMAP_RENDERER_ROUND_RECT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* fill the axis-aligned round rect analytically
+ *
+ * the spans of each row are computed from the corner ellipses directly without flattening them,
+ * so circles and ellipses can be filled as the round rect with the half-size radius.
+ *
+ * @param device    the device
+ * @param rect      the round rect in the device coordinates
+ */
+lx_void_t           lx_bitmap_renderer_fill_round_rect(lx_bitmap_device_t* device, lx_round_rect_ref_t rect);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+#endif
@@ -0,0 +1,976 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        tiler.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tiler.h"
+#include "device.h"
+#include "renderer.h"
+#include "renderer/rect.h"
+#include "renderer/round_rect.h"
+#include "renderer/lines.h"
+#include "renderer/points.h"
+#include "renderer/polygon.h"
+#include "../../clipper.h"
+#include "../../private/clipper.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the grow size of the recorded data
+#ifdef LX_CONFIG_SMALL
+#   define LX_BITMAP_TILER_GROW             (256)
+#else
+#   define LX_BITMAP_TILER_GROW             (1024)
+#endif
+
+// we will flush all recorded commands if there are too many points
+#ifdef LX_CONFIG_SMALL
+#   define LX_BITMAP_TILER_POINTS_MAXN      (16384)
+#else
+#   define LX_BITMAP_TILER_POINTS_MAXN      (262144)
+#endif
+
+// the maximum threads count
+#define LX_BITMAP_TILER_THREADS_MAXN        (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the command type enum
+typedef enum lx_bitmap_tiler_cmd_type_e_ {
+    LX_BITMAP_TILER_CMD_TYPE_FILL_POLYGON   = 0
+,   LX_BITMAP_TILER_CMD_TYPE_FILL_RECT      = 1
+,   LX_BITMAP_TILER_CMD_TYPE_STROKE_LINES   = 2
+,   LX_BITMAP_TILER_CMD_TYPE_STROKE_POINTS  = 3
+,   LX_BITMAP_TILER_CMD_TYPE_STROKE_POLYGON = 4
+,   LX_BITMAP_TILER_CMD_TYPE_FILL_ROUND_RECT = 5
+}lx_bitmap_tiler_cmd_type_e;
+
+// the recorded command type
+typedef struct lx_bitmap_tiler_cmd_t_ {
+
+    // the command type
+    lx_uint8_t                  type;
+
+    // is convex polygon?
+    lx_uint8_t                  convex;
+
+    // the fill rule of polygon
+    lx_uint8_t                  rule;
+
+    // the paint index
+    lx_uint32_t                 paint;
+
+    // the offset of points
+    lx_uint32_t                 points;
+
+    // the points count
+    lx_uint32_t                 count;
+
+    // the offset of polygon counts
+    lx_uint32_t                 counts;
+
+    // the bounds (or rect for filling rect and round rect)
+    lx_rect_t                   bounds;
+
+    // the device matrix for the shader of paint
+    lx_matrix_t                 matrix;
+
+    // the clip bounds, [left, right) x [top, bottom)
+    lx_int32_t                  clip_left;
+    lx_int32_t                  clip_top;
+    lx_int32_t                  clip_right;
+    lx_int32_t                  clip_bottom;
+
+    // the clip mask
+    lx_bitmap_mask_t const*     mask;
+
+}lx_bitmap_tiler_cmd_t;
+
+/* the command link type of tile
+ *
+ * tile: head => ref => ref => ... => tail
+ */
+typedef struct lx_bitmap_tiler_link_t_ {
+
+    // the command index
+    lx_uint32_t                 cmd;
+
+    // the next reference index, 0: end
+    lx_uint32_t                 next;
+
+}lx_bitmap_tiler_link_t;
+
+// the tile type
+typedef struct lx_bitmap_tiler_tile_t_ {
+
+    // the head reference index, 0: empty
+    lx_uint32_t                 head;
+
+    // the tail reference index
+    lx_uint32_t                 tail;
+
+}lx_bitmap_tiler_tile_t;
+
+// the saved clip type of the streamed tiler
+typedef struct lx_bitmap_tiler_clip_t_ {
+
+    // the copied clipper
+    lx_clipper_ref_t            clipper;
+
+    // the clip bounds
+    lx_long_t                   x;
+    lx_long_t                   y;
+    lx_long_t                   width;
+    lx_long_t                   height;
+
+    // the clip mask in the current band
+    lx_bitmap_mask_t            mask;
+
+}lx_bitmap_tiler_clip_t;
+
+// the worker type
+typedef struct lx_bitmap_tiler_worker_t_ {
+
+    // the render context, it only uses the bitmap, pixmap, raster and writer
+    lx_bitmap_device_t          device;
+
+    // the thread, the first worker runs in the caller thread
+    lx_thread_ref_t             thread;
+
+    // the tiler
+    struct lx_bitmap_tiler_t_*  tiler;
+
+}lx_bitmap_tiler_worker_t;
+
+// the bitmap tiler type
+typedef struct lx_bitmap_tiler_t_ {
+
+    // the bitmap, it's the band bitmap of the 64 rows for the streamed tiler
+    lx_bitmap_ref_t             bitmap;
+
+    // the pixmap of bitmap
+    lx_pixmap_ref_t             pixmap;
+
+    // the output stream of the streamed tiler
+    lx_stream_ref_t             stream;
+
+    // the surface width and height
+    lx_long_t                   width;
+    lx_long_t                   height;
+
+    // the device y-coordinate of the first bitmap row
+    lx_long_t                   top;
+
+    // the background color of the bands
+    lx_color_t                  background;
+
+    // is the streamed surface changed after flushing it?
+    lx_bool_t                   dirty;
+
+    // the clip bounds of the next recorded commands
+    lx_long_t                   clip_left;
+    lx_long_t                   clip_top;
+    lx_long_t                   clip_right;
+    lx_long_t                   clip_bottom;
+
+    // the clip mask of the next recorded commands
+    lx_bitmap_mask_t const*     mask;
+
+    // the tiles count in the horizontal and vertical direction
+    lx_size_t                   tiles_x;
+    lx_size_t                   tiles_y;
+
+    // the tiles
+    lx_bitmap_tiler_tile_t*     tiles;
+
+    // the next tile index and the tail index for workers
+    lx_size_t                   tile_next;
+    lx_size_t                   tile_tail;
+
+    // the commands
+    lx_bitmap_tiler_cmd_t*      cmds;
+    lx_size_t                   cmds_size;
+    lx_size_t                   cmds_maxn;
+
+    // the command references of tiles, the first reference is unused
+    lx_bitmap_tiler_link_t*     refs;
+    lx_size_t                   refs_size;
+    lx_size_t                   refs_maxn;
+
+    // the points
+    lx_point_t*                 points;
+    lx_size_t                   points_size;
+    lx_size_t                   points_maxn;
+
+    // the polygon counts
+    lx_uint32_t*                counts;
+    lx_size_t                   counts_size;
+    lx_size_t                   counts_maxn;
+
+    // the saved clips of the streamed tiler, all clips will be reused after flushing
+    lx_bitmap_tiler_clip_t**    clips;
+    lx_size_t                   clips_size;
+    lx_size_t                   clips_maxn;
+
+    // the paints, all paints will be reused after flushing
+    lx_paint_ref_t*             paints;
+    lx_size_t                   paints_size;
+    lx_size_t                   paints_maxn;
+
+    // the workers, all workers except for the first worker have own thread
+    lx_bitmap_tiler_worker_t*   workers;
+    lx_size_t                   workers_count;
+    lx_size_t                   workers_maxn;
+
+    // the mutex for the next tile
+    lx_mutex_ref_t              mutex;
+
+    // the semaphore for starting and finishing work
+    lx_semaphore_ref_t          semaphore_start;
+    lx_semaphore_ref_t          semaphore_done;
+
+    // is stopped?
+    lx_bool_t                   stopped;
+
+}lx_bitmap_tiler_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_bool_t lx_bitmap_tiler_grow(lx_pointer_t* pdata, lx_size_t* pmaxn, lx_size_t need, lx_size_t itemsize) {
+    lx_assert(pdata && pmaxn);
+    lx_check_return_val(need > *pmaxn, lx_true);
+
+    // grow the data geometrically
+    lx_size_t    maxn = lx_max(need, *pmaxn + (*pmaxn >> 1)) + LX_BITMAP_TILER_GROW;
+    lx_pointer_t data = lx_ralloc(*pdata, maxn * itemsize);
+    lx_assert_and_check_return_val(data, lx_false);
+
+    *pdata = data;
+    *pmaxn = maxn;
+    return lx_true;
+}
+
+static lx_bool_t lx_bitmap_tiler_paint_save(lx_bitmap_tiler_t* tiler, lx_paint_ref_t paint, lx_uint32_t* poffset) {
+    lx_assert(tiler && paint && poffset);
+
+    // grow paints
+    lx_size_t paints_maxn = tiler->paints_maxn;
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->paints, &tiler->paints_maxn, tiler->paints_size + 1, sizeof(lx_paint_ref_t))) {
+        return lx_false;
+    }
+    if (tiler->paints_maxn > paints_maxn) {
+        lx_memset(tiler->paints + paints_maxn, 0, (tiler->paints_maxn - paints_maxn) * sizeof(lx_paint_ref_t));
+    }
+
+    // reuse the previous paint
+    lx_paint_ref_t* copied = tiler->paints + tiler->paints_size;
+    if (!*copied) {
+        *copied = lx_paint_init();
+        lx_assert_and_check_return_val(*copied, lx_false);
+    }
+    lx_paint_copy(*copied, paint);
+    *poffset = (lx_uint32_t)tiler->paints_size++;
+    return lx_true;
+}
+
+static lx_bool_t lx_bitmap_tiler_points_save(lx_bitmap_tiler_t* tiler, lx_point_ref_t points, lx_size_t count, lx_uint32_t* poffset) {
+    lx_assert(tiler && points && count && poffset);
+
+    // grow points
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->points, &tiler->points_maxn, tiler->points_size + count, sizeof(lx_point_t))) {
+        return lx_false;
+    }
+
+    // copy points
+    *poffset = (lx_uint32_t)tiler->points_size;
+    lx_memcpy(tiler->points + tiler->points_size, points, count * sizeof(lx_point_t));
+    tiler->points_size += count;
+    return lx_true;
+}
+
+static lx_bool_t lx_bitmap_tiler_counts_save(lx_bitmap_tiler_t* tiler, lx_uint32_t* counts, lx_uint32_t* poffset) {
+    lx_assert(tiler && counts && poffset);
+
+    // get the counts size with the zero end
+    lx_size_t size = 0;
+    while (counts[size]) size++;
+    size++;
+
+    // grow counts
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->counts, &tiler->counts_maxn, tiler->counts_size + size, sizeof(lx_uint32_t))) {
+        return lx_false;
+    }
+
+    // copy counts
+    *poffset = (lx_uint32_t)tiler->counts_size;
+    lx_memcpy(tiler->counts + tiler->counts_size, counts, size * sizeof(lx_uint32_t));
+    tiler->counts_size += size;
+    return lx_true;
+}
+
+static lx_size_t lx_bitmap_tiler_polygon_total(lx_polygon_ref_t polygon) {
+    lx_size_t    total  = 0;
+    lx_uint32_t* counts = polygon->counts;
+    while (*counts) total += *counts++;
+    return total;
+}
+
+static lx_bitmap_tiler_cmd_t* lx_bitmap_tiler_cmd_aloc(lx_bitmap_tiler_t* tiler, lx_size_t type, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_size_t count) {
+    lx_assert(tiler && paint && matrix);
+
+    /* too many recorded points? flush them first
+     *
+     * the streamed tiler need record all commands of the whole surface, so we cannot flush them here
+     */
+    if (!tiler->stream && tiler->points_size + count > LX_BITMAP_TILER_POINTS_MAXN) {
+        lx_bitmap_tiler_flush((lx_bitmap_tiler_ref_t)tiler);
+    }
+
+    // grow commands
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->cmds, &tiler->cmds_maxn, tiler->cmds_size + 1, sizeof(lx_bitmap_tiler_cmd_t))) {
+        return lx_null;
+    }
+
+    // init command
+    lx_bitmap_tiler_cmd_t* cmd = tiler->cmds + tiler->cmds_size;
+    lx_memset(cmd, 0, sizeof(lx_bitmap_tiler_cmd_t));
+    cmd->type   = (lx_uint8_t)type;
+    cmd->count  = (lx_uint32_t)count;
+    cmd->matrix = *matrix;
+    cmd->clip_left   = (lx_int32_t)tiler->clip_left;
+    cmd->clip_top    = (lx_int32_t)tiler->clip_top;
+    cmd->clip_right  = (lx_int32_t)tiler->clip_right;
+    cmd->clip_bottom = (lx_int32_t)tiler->clip_bottom;
+    cmd->mask        = tiler->mask;
+    tiler->dirty     = lx_true;
+
+    // prepare the shader data here, because the writers of workers cannot build it in parallel
+    lx_bitmap_writer_prepare(tiler->bitmap, paint);
+    return lx_bitmap_tiler_paint_save(tiler, paint, &cmd->paint)? cmd : lx_null;
+}
+
+static lx_void_t lx_bitmap_tiler_cmd_bin(lx_bitmap_tiler_t* tiler, lx_bitmap_tiler_cmd_t* cmd) {
+    lx_assert(tiler && cmd && tiler->tiles);
+
+    /* get the covered pixels of the command bounds
+     *
+     * we add one pixel margin for the rounding of the rasterizers
+     */
+    lx_rect_ref_t bounds = &cmd->bounds;
+    lx_long_t x0 = lx_floor(bounds->x) - 1;
+    lx_long_t y0 = lx_floor(bounds->y) - 1;
+    lx_long_t x1 = lx_ceil(bounds->x + bounds->w) + 1;
+    lx_long_t y1 = lx_ceil(bounds->y + bounds->h) + 1;
+    if (x0 < cmd->clip_left) x0 = cmd->clip_left;
+    if (y0 < cmd->clip_top) y0 = cmd->clip_top;
+    if (x1 > cmd->clip_right) x1 = cmd->clip_right;
+    if (y1 > cmd->clip_bottom) y1 = cmd->clip_bottom;
+    lx_check_return(x0 < x1 && y0 < y1);
+
+    // save command
+    lx_uint32_t cmd_index = (lx_uint32_t)tiler->cmds_size++;
+
+    // grow references
+    lx_long_t tx0 = x0 >> LX_BITMAP_TILER_TILE_BITS;
+    lx_long_t ty0 = y0 >> LX_BITMAP_TILER_TILE_BITS;
+    lx_long_t tx1 = (x1 - 1) >> LX_BITMAP_TILER_TILE_BITS;
+    lx_long_t ty1 = (y1 - 1) >> LX_BITMAP_TILER_TILE_BITS;
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->refs, &tiler->refs_maxn, tiler->refs_size + (tx1 - tx0 + 1) * (ty1 - ty0 + 1), sizeof(lx_bitmap_tiler_link_t))) {
+        return ;
+    }
+
+    // append command to the tail of all covered tiles to keep the drawing order
+    lx_long_t tx;
+    lx_long_t ty;
+    for (ty = ty0; ty <= ty1; ty++) {
+        lx_bitmap_tiler_tile_t* tile = tiler->tiles + ty * tiler->tiles_x + tx0;
+        for (tx = tx0; tx <= tx1; tx++, tile++) {
+            lx_uint32_t             ref_index = (lx_uint32_t)tiler->refs_size++;
+            lx_bitmap_tiler_link_t* ref      = tiler->refs + ref_index;
+            ref->cmd  = cmd_index;
+            ref->next = 0;
+            if (tile->tail) tiler->refs[tile->tail].next = ref_index;
+            else tile->head = ref_index;
+            tile->tail = ref_index;
+        }
+    }
+}
+
+static lx_void_t lx_bitmap_tiler_cmd_draw(lx_bitmap_tiler_t* tiler, lx_bitmap_device_t* device, lx_bitmap_tiler_cmd_t* cmd, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_assert(tiler && device && cmd);
+
+    // only draw the pixels in this tile and the clip bounds
+    lx_long_t x0 = lx_max(x, cmd->clip_left);
+    lx_long_t y0 = lx_max(y, cmd->clip_top);
+    lx_long_t x1 = lx_min(x + w, cmd->clip_right);
+    lx_long_t y1 = lx_min(y + h, cmd->clip_bottom);
+    lx_check_return(x0 < x1 && y0 < y1);
+
+    device->base.paint  = tiler->paints[cmd->paint];
+    device->base.matrix = &cmd->matrix;
+    if (lx_bitmap_renderer_init(device)) {
+        lx_bitmap_writer_top_set(&device->writer, tiler->top);
+        lx_bitmap_writer_clip_set(&device->writer, x0, y0, x1 - x0, y1 - y0);
+        lx_bitmap_writer_mask_set(&device->writer, cmd->mask);
+
+        // draw it
+        lx_polygon_t polygon;
+        switch (cmd->type) {
+        case LX_BITMAP_TILER_CMD_TYPE_FILL_POLYGON:
+            lx_polygon_make(&polygon, tiler->points + cmd->points, tiler->counts + cmd->counts, cmd->count, cmd->convex);
+            lx_bitmap_renderer_fill_polygon(device, &polygon, &cmd->bounds, cmd->rule);
+            break;
+        case LX_BITMAP_TILER_CMD_TYPE_FILL_RECT:
+            lx_bitmap_renderer_fill_rect(device, &cmd->bounds);
+            break;
+        case LX_BITMAP_TILER_CMD_TYPE_FILL_ROUND_RECT: {
+            lx_round_rect_t rect;
+            rect.bounds = cmd->bounds;
+            lx_memcpy(rect.radius, tiler->points + cmd->points, sizeof(rect.radius));
+            lx_bitmap_renderer_fill_round_rect(device, &rect);
+            break;
+        }
+        case LX_BITMAP_TILER_CMD_TYPE_STROKE_LINES:
+            lx_bitmap_renderer_stroke_lines(device, tiler->points + cmd->points, cmd->count);
+            break;
+        case LX_BITMAP_TILER_CMD_TYPE_STROKE_POINTS:
+            lx_bitmap_renderer_stroke_points(device, tiler->points + cmd->points, cmd->count);
+            break;
+        case LX_BITMAP_TILER_CMD_TYPE_STROKE_POLYGON:
+            lx_polygon_make(&polygon, tiler->points + cmd->points, tiler->counts + cmd->counts, cmd->count, cmd->convex);
+            lx_bitmap_renderer_stroke_polygon(device, &polygon);
+            break;
+        default:
+            lx_assert(0);
+            break;
+        }
+        lx_bitmap_renderer_exit(device);
+    }
+}
+
+static lx_void_t lx_bitmap_tiler_work(lx_bitmap_tiler_t* tiler, lx_bitmap_tiler_worker_t* worker) {
+    lx_assert(tiler && worker);
+
+    while (1) {
+
+        // get the next tile
+        lx_mutex_enter(tiler->mutex);
+        lx_size_t index = tiler->tile_next++;
+        lx_mutex_leave(tiler->mutex);
+        lx_check_break(index < tiler->tile_tail);
+
+        // empty tile?
+        lx_bitmap_tiler_tile_t* tile = tiler->tiles + index;
+        lx_check_continue(tile->head);
+
+        // get the tile bounds
+        lx_long_t x = (lx_long_t)(index % tiler->tiles_x) << LX_BITMAP_TILER_TILE_BITS;
+        lx_long_t y = (lx_long_t)(index / tiler->tiles_x) << LX_BITMAP_TILER_TILE_BITS;
+        lx_long_t w = lx_min(LX_BITMAP_TILER_TILE_SIZE, tiler->width - x);
+        lx_long_t h = lx_min(LX_BITMAP_TILER_TILE_SIZE, tiler->height - y);
+
+        // draw all commands of this tile in order
+        lx_uint32_t ref_index = tile->head;
+        while (ref_index) {
+            lx_bitmap_tiler_link_t* ref = tiler->refs + ref_index;
+            lx_bitmap_tiler_cmd_draw(tiler, &worker->device, tiler->cmds + ref->cmd, x, y, w, h);
+            ref_index = ref->next;
+        }
+    }
+}
+
+static lx_void_t lx_bitmap_tiler_loop(lx_cpointer_t priv) {
+    lx_bitmap_tiler_worker_t* worker = (lx_bitmap_tiler_worker_t*)priv;
+    lx_assert_and_check_return(worker && worker->tiler);
+
+    lx_bitmap_tiler_t* tiler = worker->tiler;
+    while (lx_semaphore_wait(tiler->semaphore_start)) {
+        lx_check_break(!tiler->stopped);
+        lx_bitmap_tiler_work(tiler, worker);
+        lx_semaphore_post(tiler->semaphore_done, 1);
+    }
+}
+
+// draw the tiles in [head, tail) by all workers
+static lx_void_t lx_bitmap_tiler_draw(lx_bitmap_tiler_t* tiler, lx_size_t head, lx_size_t tail) {
+    lx_assert(tiler && tiler->workers_count);
+
+    // start all workers
+    tiler->tile_next = head;
+    tiler->tile_tail = tail;
+    if (tiler->workers_count > 1) {
+        lx_semaphore_post(tiler->semaphore_start, tiler->workers_count - 1);
+    }
+
+    // the caller thread works too
+    lx_bitmap_tiler_work(tiler, tiler->workers);
+
+    // wait all workers
+    lx_size_t i;
+    for (i = 1; i < tiler->workers_count; i++) {
+        lx_semaphore_wait(tiler->semaphore_done);
+    }
+}
+
+// make the clip masks of all saved clips in the band [top, bottom)
+static lx_bool_t lx_bitmap_tiler_mask_make(lx_bitmap_tiler_t* tiler, lx_long_t top, lx_long_t bottom) {
+    lx_assert(tiler && tiler->workers);
+
+    // all workers are idle now, so we can use the raster of the first worker
+    lx_size_t               i;
+    lx_polygon_raster_ref_t raster = tiler->workers->device.raster;
+    for (i = 0; i < tiler->clips_size; i++) {
+        lx_bitmap_tiler_clip_t* clip = tiler->clips[i];
+        lx_long_t y0 = lx_max(clip->y, top);
+        lx_long_t y1 = lx_min(clip->y + clip->height, bottom);
+        if (y0 < y1) {
+            if (!lx_bitmap_mask_make(&clip->mask, raster, clip->clipper, clip->x, y0, clip->width, y1 - y0)) {
+                return lx_false;
+            }
+        } else if (clip->y + clip->height <= top) {
+            // this clip has been drawn, we free its mask data now
+            lx_bitmap_mask_exit(&clip->mask);
+        }
+    }
+    return lx_true;
+}
+
+// draw all tile rows to the band bitmap and write them to the stream
+static lx_void_t lx_bitmap_tiler_draw_stream(lx_bitmap_tiler_t* tiler) {
+    lx_assert(tiler && tiler->stream && tiler->bitmap && tiler->pixmap);
+
+    lx_byte_t* data = (lx_byte_t*)lx_bitmap_data(tiler->bitmap);
+    lx_assert_and_check_return(data);
+
+    lx_size_t  ty;
+    lx_size_t  row_bytes = lx_bitmap_row_bytes(tiler->bitmap);
+    lx_pixel_t pixel     = tiler->pixmap->pixel(tiler->background);
+    for (ty = 0; ty < tiler->tiles_y; ty++) {
+
+        // fill the background of this band
+        lx_long_t top = (lx_long_t)ty << LX_BITMAP_TILER_TILE_BITS;
+        lx_long_t h   = lx_min(LX_BITMAP_TILER_TILE_SIZE, tiler->height - top);
+        tiler->pixmap->pixels_fill(data, pixel, tiler->width * h, 0xff);
+
+        // make the clip masks of this band
+        if (!lx_bitmap_tiler_mask_make(tiler, top, top + h)) {
+            break;
+        }
+
+        // draw the tiles of this band
+        tiler->top = top;
+        lx_bitmap_tiler_draw(tiler, ty * tiler->tiles_x, (ty + 1) * tiler->tiles_x);
+
+        // write this band
+        if (!lx_stream_write(tiler->stream, data, row_bytes * h)) {
+            break;
+        }
+    }
+    tiler->top = 0;
+
+    // free the mask data of all clips
+    lx_size_t i;
+    for (i = 0; i < tiler->clips_size; i++) {
+        lx_bitmap_mask_exit(&tiler->clips[i]->mask);
+    }
+}
+
+static lx_void_t lx_bitmap_tiler_clear(lx_bitmap_tiler_t* tiler) {
+    lx_assert(tiler && tiler->tiles);
+    tiler->cmds_size   = 0;
+    tiler->refs_size   = 1;
+    tiler->points_size = 0;
+    tiler->counts_size = 0;
+    tiler->paints_size = 0;
+    tiler->clips_size  = 0;
+    lx_memset(tiler->tiles, 0, tiler->tiles_x * tiler->tiles_y * sizeof(lx_bitmap_tiler_tile_t));
+}
+
+static lx_bitmap_tiler_t* lx_bitmap_tiler_init_impl(lx_bitmap_ref_t bitmap, lx_size_t width, lx_size_t height, lx_size_t threads) {
+    lx_assert_and_check_return_val(bitmap, lx_null);
+
+    lx_bool_t          ok = lx_false;
+    lx_bitmap_tiler_t* tiler = lx_null;
+    do {
+
+        // init tiler
+        tiler = lx_malloc0_type(lx_bitmap_tiler_t);
+        lx_assert_and_check_break(tiler);
+
+        tiler->bitmap    = bitmap;
+        tiler->width     = (lx_long_t)width;
+        tiler->height    = (lx_long_t)height;
+        tiler->refs_size = 1;
+        lx_assert_and_check_break(tiler->width > 0 && tiler->height > 0);
+        lx_bitmap_tiler_clip_set((lx_bitmap_tiler_ref_t)tiler, 0, 0, tiler->width, tiler->height);
+
+        // init pixmap
+        tiler->pixmap = lx_pixmap(lx_bitmap_pixfmt(bitmap), 0xff);
+        lx_assert_and_check_break(tiler->pixmap);
+
+        // init tiles
+        tiler->tiles_x = (tiler->width + LX_BITMAP_TILER_TILE_SIZE - 1) >> LX_BITMAP_TILER_TILE_BITS;
+        tiler->tiles_y = (tiler->height + LX_BITMAP_TILER_TILE_SIZE - 1) >> LX_BITMAP_TILER_TILE_BITS;
+        tiler->tiles   = lx_nalloc0_type(tiler->tiles_x * tiler->tiles_y, lx_bitmap_tiler_tile_t);
+        lx_assert_and_check_break(tiler->tiles);
+
+        // init mutex and semaphores
+        tiler->mutex = lx_mutex_init();
+        tiler->semaphore_start = lx_semaphore_init(0);
+        tiler->semaphore_done = lx_semaphore_init(0);
+        lx_assert_and_check_break(tiler->mutex && tiler->semaphore_start && tiler->semaphore_done);
+
+        // init workers
+        if (!threads) threads = lx_cpu_count();
+        if (threads > LX_BITMAP_TILER_THREADS_MAXN) threads = LX_BITMAP_TILER_THREADS_MAXN;
+        if (!threads) threads = 1;
+        tiler->workers = lx_nalloc0_type(threads, lx_bitmap_tiler_worker_t);
+        lx_assert_and_check_break(tiler->workers);
+        tiler->workers_maxn = threads;
+
+        lx_size_t i;
+        for (i = 0; i < threads; i++) {
+            lx_bitmap_tiler_worker_t* worker = tiler->workers + i;
+            worker->tiler              = tiler;
+            worker->device.base.width  = (lx_uint32_t)width;
+            worker->device.base.height = (lx_uint32_t)height;
+            worker->device.bitmap      = bitmap;
+            worker->device.pixmap      = tiler->pixmap;
+            worker->device.raster      = lx_polygon_raster_init();
+            lx_assert_and_check_break(worker->device.raster);
+
+            // the first worker runs in the caller thread
+            if (i) {
+                worker->thread = lx_thread_init(lx_bitmap_tiler_loop, worker);
+                lx_assert_and_check_break(worker->thread);
+            }
+            tiler->workers_count++;
+        }
+        lx_assert_and_check_break(tiler->workers_count == threads);
+
+        // ok
+        ok = lx_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && tiler) {
+        lx_bitmap_tiler_exit((lx_bitmap_tiler_ref_t)tiler);
+        tiler = lx_null;
+    }
+    return tiler;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_bitmap_tiler_ref_t lx_bitmap_tiler_init(lx_bitmap_ref_t bitmap, lx_size_t threads) {
+    lx_assert_and_check_return_val(bitmap, lx_null);
+    return (lx_bitmap_tiler_ref_t)lx_bitmap_tiler_init_impl(bitmap, lx_bitmap_width(bitmap), lx_bitmap_height(bitmap), threads);
+}
+
+lx_bitmap_tiler_ref_t lx_bitmap_tiler_init_stream(lx_stream_ref_t stream, lx_size_t pixfmt, lx_size_t width, lx_size_t height, lx_size_t threads) {
+    lx_assert_and_check_return_val(stream && LX_PIXFMT_OK(pixfmt) && width && height, lx_null);
+
+    // init the band bitmap of the tile row
+    lx_size_t       band = lx_min(height, LX_BITMAP_TILER_TILE_SIZE);
+    lx_bitmap_ref_t bitmap = lx_bitmap_init(lx_null, pixfmt, width, band, 0, LX_PIXFMT_HAS_ALPHA(pixfmt)? lx_true : lx_false);
+    lx_assert_and_check_return_val(bitmap, lx_null);
+
+    // init tiler, the band bitmap will be owned by it
+    lx_bitmap_tiler_t* tiler = lx_bitmap_tiler_init_impl(bitmap, width, height, threads);
+    if (tiler) {
+        tiler->stream = stream;
+        tiler->dirty  = lx_true;
+    } else {
+        lx_bitmap_exit(bitmap);
+    }
+    return (lx_bitmap_tiler_ref_t)tiler;
+}
+
+lx_void_t lx_bitmap_tiler_exit(lx_bitmap_tiler_ref_t self) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_check_return(tiler);
+
+    // exit workers
+    if (tiler->workers) {
+        tiler->stopped = lx_true;
+        if (tiler->workers_count > 1) {
+            lx_semaphore_post(tiler->semaphore_start, tiler->workers_count - 1);
+        }
+
+        lx_size_t i;
+        for (i = 0; i < tiler->workers_count; i++) {
+            lx_bitmap_tiler_worker_t* worker = tiler->workers + i;
+            if (worker->thread) {
+                lx_thread_exit(worker->thread);
+                worker->thread = lx_null;
+            }
+        }
+        for (i = 0; i < tiler->workers_maxn; i++) {
+            lx_bitmap_tiler_worker_t* worker = tiler->workers + i;
+            if (worker->device.raster) {
+                lx_polygon_raster_exit(worker->device.raster);
+                worker->device.raster = lx_null;
+            }
+        }
+        lx_free(tiler->workers);
+        tiler->workers = lx_null;
+    }
+
+    // exit mutex and semaphores
+    if (tiler->mutex) {
+        lx_mutex_exit(tiler->mutex);
+        tiler->mutex = lx_null;
+    }
+    if (tiler->semaphore_start) {
+        lx_semaphore_exit(tiler->semaphore_start);
+        tiler->semaphore_start = lx_null;
+    }
+    if (tiler->semaphore_done) {
+        lx_semaphore_exit(tiler->semaphore_done);
+        tiler->semaphore_done = lx_null;
+    }
+
+    // exit paints
+    if (tiler->paints) {
+        lx_size_t i;
+        for (i = 0; i < tiler->paints_maxn; i++) {
+            if (tiler->paints[i]) lx_paint_exit(tiler->paints[i]);
+        }
+        lx_free(tiler->paints);
+        tiler->paints = lx_null;
+    }
+
+    // exit clips
+    if (tiler->clips) {
+        lx_size_t i;
+        for (i = 0; i < tiler->clips_maxn; i++) {
+            lx_bitmap_tiler_clip_t* clip = tiler->clips[i];
+            if (clip) {
+                if (clip->clipper) lx_clipper_exit(clip->clipper);
+                lx_bitmap_mask_exit(&clip->mask);
+                lx_free(clip);
+            }
+        }
+        lx_free(tiler->clips);
+        tiler->clips = lx_null;
+    }
+
+    // exit the band bitmap of the streamed tiler
+    if (tiler->stream && tiler->bitmap) {
+        lx_bitmap_exit(tiler->bitmap);
+        tiler->bitmap = lx_null;
+    }
+
+    // exit the recorded data
+    if (tiler->tiles) lx_free(tiler->tiles);
+    if (tiler->cmds) lx_free(tiler->cmds);
+    if (tiler->refs) lx_free(tiler->refs);
+    if (tiler->points) lx_free(tiler->points);
+    if (tiler->counts) lx_free(tiler->counts);
+    lx_free(tiler);
+}
+
+lx_void_t lx_bitmap_tiler_clip_set(lx_bitmap_tiler_ref_t self, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler);
+    tiler->clip_left   = lx_max(x, 0);
+    tiler->clip_top    = lx_max(y, 0);
+    tiler->clip_right  = lx_min(x + w, tiler->width);
+    tiler->clip_bottom = lx_min(y + h, tiler->height);
+}
+
+lx_void_t lx_bitmap_tiler_mask_set(lx_bitmap_tiler_ref_t self, lx_bitmap_mask_t const* mask) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler);
+    tiler->mask = mask;
+}
+
+lx_bitmap_ref_t lx_bitmap_tiler_bitmap(lx_bitmap_tiler_ref_t self) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    return tiler? tiler->bitmap : lx_null;
+}
+
+lx_stream_ref_t lx_bitmap_tiler_stream(lx_bitmap_tiler_ref_t self) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    return tiler? tiler->stream : lx_null;
+}
+
+lx_void_t lx_bitmap_tiler_flush(lx_bitmap_tiler_ref_t self) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert_and_check_return(tiler && tiler->workers_count);
+
+    // draw all tiles to the bitmap, or write all bands to the stream
+    if (tiler->stream) {
+        lx_check_return(tiler->dirty);
+        lx_bitmap_tiler_draw_stream(tiler);
+        tiler->dirty = lx_false;
+    } else {
+        lx_check_return(tiler->cmds_size);
+        lx_bitmap_tiler_draw(tiler, 0, tiler->tiles_x * tiler->tiles_y);
+    }
+
+    // clear all recorded commands
+    lx_bitmap_tiler_clear(tiler);
+}
+
+lx_void_t lx_bitmap_tiler_background_set(lx_bitmap_tiler_ref_t self, lx_color_t color) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert_and_check_return(tiler && tiler->stream);
+
+    // all previous commands will be covered by the background
+    lx_bitmap_tiler_clear(tiler);
+    tiler->background = color;
+    tiler->dirty      = lx_true;
+}
+
+lx_bitmap_mask_t const* lx_bitmap_tiler_mask_save(lx_bitmap_tiler_ref_t self, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && tiler->stream && clipper);
+
+    // reuse the previous clip if the clipper is not changed
+    if (tiler->clips_size) {
+        lx_bitmap_tiler_clip_t* clip = tiler->clips[tiler->clips_size - 1];
+        if (clip->x == x && clip->y == y && clip->width == w && clip->height == h && lx_clipper_equal(clip->clipper, clipper)) {
+            return &clip->mask;
+        }
+    }
+
+    // grow clips
+    lx_size_t clips_maxn = tiler->clips_maxn;
+    if (!lx_bitmap_tiler_grow((lx_pointer_t*)&tiler->clips, &tiler->clips_maxn, tiler->clips_size + 1, sizeof(lx_bitmap_tiler_clip_t*))) {
+        return lx_null;
+    }
+    if (tiler->clips_maxn > clips_maxn) {
+        lx_memset(tiler->clips + clips_maxn, 0, (tiler->clips_maxn - clips_maxn) * sizeof(lx_bitmap_tiler_clip_t*));
+    }
+
+    // reuse the previous clip
+    lx_bitmap_tiler_clip_t** pclip = tiler->clips + tiler->clips_size;
+    if (!*pclip) {
+        *pclip = lx_malloc0_type(lx_bitmap_tiler_clip_t);
+        lx_assert_and_check_return_val(*pclip, lx_null);
+    }
+    lx_bitmap_tiler_clip_t* clip = *pclip;
+    if (!clip->clipper) {
+        clip->clipper = lx_clipper_init();
+        lx_assert_and_check_return_val(clip->clipper, lx_null);
+    }
+
+    // save clip
+    lx_clipper_copy(clip->clipper, clipper);
+    clip->x      = x;
+    clip->y      = y;
+    clip->width  = w;
+    clip->height = h;
+    tiler->clips_size++;
+    return &clip->mask;
+}
+
+lx_void_t lx_bitmap_tiler_fill_polygon(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && polygon && polygon->points && polygon->counts && bounds);
+
+    lx_size_t total = lx_bitmap_tiler_polygon_total(polygon);
+    lx_check_return(total);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_FILL_POLYGON, paint, matrix, total);
+    lx_assert_and_check_return(cmd);
+
+    lx_check_return(lx_bitmap_tiler_points_save(tiler, polygon->points, total, &cmd->points));
+    lx_check_return(lx_bitmap_tiler_counts_save(tiler, polygon->counts, &cmd->counts));
+    cmd->convex = (lx_uint8_t)polygon->convex;
+    cmd->rule   = (lx_uint8_t)rule;
+    cmd->bounds = *bounds;
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
+
+lx_void_t lx_bitmap_tiler_fill_rect(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_rect_ref_t rect) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && rect);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_FILL_RECT, paint, matrix, 0);
+    lx_assert_and_check_return(cmd);
+
+    cmd->bounds = *rect;
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
+
+lx_void_t lx_bitmap_tiler_fill_round_rect(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_round_rect_ref_t rect) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && rect);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_FILL_ROUND_RECT, paint, matrix, LX_RECT_CORNER_MAXN);
+    lx_assert_and_check_return(cmd);
+
+    // the corner radius are saved as the points
+    lx_check_return(lx_bitmap_tiler_points_save(tiler, rect->radius, LX_RECT_CORNER_MAXN, &cmd->points));
+    cmd->bounds = rect->bounds;
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
+
+lx_void_t lx_bitmap_tiler_stroke_lines(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_point_ref_t points, lx_size_t count) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && points && count);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_STROKE_LINES, paint, matrix, count);
+    lx_assert_and_check_return(cmd);
+
+    lx_check_return(lx_bitmap_tiler_points_save(tiler, points, count, &cmd->points));
+    lx_bounds_make(&cmd->bounds, points, count);
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
+
+lx_void_t lx_bitmap_tiler_stroke_points(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_point_ref_t points, lx_size_t count) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && points && count);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_STROKE_POINTS, paint, matrix, count);
+    lx_assert_and_check_return(cmd);
+
+    lx_check_return(lx_bitmap_tiler_points_save(tiler, points, count, &cmd->points));
+    lx_bounds_make(&cmd->bounds, points, count);
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
+
+lx_void_t lx_bitmap_tiler_stroke_polygon(lx_bitmap_tiler_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_polygon_ref_t polygon) {
+    lx_bitmap_tiler_t* tiler = (lx_bitmap_tiler_t*)self;
+    lx_assert(tiler && paint && matrix && polygon && polygon->points && polygon->counts);
+
+    lx_size_t total = lx_bitmap_tiler_polygon_total(polygon);
+    lx_check_return(total);
+
+    lx_bitmap_tiler_cmd_t* cmd = lx_bitmap_tiler_cmd_aloc(tiler, LX_BITMAP_TILER_CMD_TYPE_STROKE_POLYGON, paint, matrix, total);
+    lx_assert_and_check_return(cmd);
+
+    lx_check_return(lx_bitmap_tiler_points_save(tiler, polygon->points, total, &cmd->points));
+    lx_check_return(lx_bitmap_tiler_counts_save(tiler, polygon->counts, &cmd->counts));
+    cmd->convex = (lx_uint8_t)polygon->convex;
+    lx_bounds_make(&cmd->bounds, polygon->points, total);
+    lx_bitmap_tiler_cmd_bin(tiler, cmd);
+}
@@ -0,0 +1,221 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        tiler.h
+ *
+ */
+#ifndef LX_CORE_DEVICE_BITMAP_TILER_H
+#define LX_CORE_DEVICE_BITMAP_TILER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "mask.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the tile size
+#define LX_BITMAP_TILER_TILE_BITS           (6)
+#define LX_BITMAP_TILER_TILE_SIZE           (1 << LX_BITMAP_TILER_TILE_BITS)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap tiler ref type
+typedef lx_typeref(bitmap_tiler);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init tiler
+ *
+ * the draw commands will be recorded and binned into the 64x64 tiles,
+ * and all tiles will be rasterized in parallel when flushing them.
+ *
+ * @param bitmap        the bitmap
+ * @param threads       the threads count, uses the cpu count if it's zero
+ *
+ * @return              the tiler
+ */
+lx_bitmap_tiler_ref_t   lx_bitmap_tiler_init(lx_bitmap_ref_t bitmap, lx_size_t threads);
+
+/* init the streamed tiler for the large surface
+ *
+ * all draw commands of the whole surface will be recorded until flushing them,
+ * and then the tile rows will be rasterized into a band bitmap of the 64 rows one by one,
+ * and the raw pixels of each band will be written to the stream in order.
+ *
+ * the clip masks are only made in the current band too, so the whole surface is never held in memory.
+ *
+ * @param stream        the output stream
+ * @param pixfmt        the pixel format
+ * @param width         the surface width
+ * @param height        the surface height
+ * @param threads       the threads count, uses the cpu count if it's zero
+ *
+ * @return              the tiler
+ */
+lx_bitmap_tiler_ref_t   lx_bitmap_tiler_init_stream(lx_stream_ref_t stream, lx_size_t pixfmt, lx_size_t width, lx_size_t height, lx_size_t threads);
+
+/* exit tiler
+ *
+ * @param tiler         the tiler
+ */
+lx_void_t               lx_bitmap_tiler_exit(lx_bitmap_tiler_ref_t tiler);
+
+/* get the bitmap of tiler
+ *
+ * @param tiler         the tiler
+ *
+ * @return              the bitmap, it's only the band bitmap of the streamed tiler
+ */
+lx_bitmap_ref_t         lx_bitmap_tiler_bitmap(lx_bitmap_tiler_ref_t tiler);
+
+/* get the output stream of tiler
+ *
+ * @param tiler         the tiler
+ *
+ * @return              the stream, it's null if it's not the streamed tiler
+ */
+lx_stream_ref_t         lx_bitmap_tiler_stream(lx_bitmap_tiler_ref_t tiler);
+
+/* flush all recorded commands to the bitmap, or to the stream for the streamed tiler
+ *
+ * @param tiler         the tiler
+ */
+lx_void_t               lx_bitmap_tiler_flush(lx_bitmap_tiler_ref_t tiler);
+
+/* discard all recorded commands and set the background color of the streamed tiler
+ *
+ * the bands will be filled with this color before drawing them.
+ *
+ * @param tiler         the tiler
+ * @param color         the background color
+ */
+lx_void_t               lx_bitmap_tiler_background_set(lx_bitmap_tiler_ref_t tiler, lx_color_t color);
+
+/* set the clip bounds of the next recorded commands
+ *
+ * @param tiler         the tiler
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate
+ * @param w             the width
+ * @param h             the height
+ */
+lx_void_t               lx_bitmap_tiler_clip_set(lx_bitmap_tiler_ref_t tiler, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
+/* set the clip mask of the next recorded commands
+ *
+ * the mask will be referenced by the recorded commands, so we need flush them before changing it.
+ *
+ * @param tiler         the tiler
+ * @param mask          the clip mask, no mask if it's null
+ */
+lx_void_t               lx_bitmap_tiler_mask_set(lx_bitmap_tiler_ref_t tiler, lx_bitmap_mask_t const* mask);
+
+/* save the complex clipper of the next recorded commands for the streamed tiler
+ *
+ * the streamed tiler has not the whole surface, so it only copies the clipper here,
+ * and the returned mask will be remade in the clip bounds of each band when flushing bands.
+ *
+ * @param tiler         the tiler
+ * @param clipper       the clipper
+ * @param x             the x-coordinate of the clip bounds
+ * @param y             the y-coordinate of the clip bounds
+ * @param w             the width of the clip bounds
+ * @param h             the height of the clip bounds
+ *
+ * @return              the clip mask of the next recorded commands
+ */
+lx_bitmap_mask_t const* lx_bitmap_tiler_mask_save(lx_bitmap_tiler_ref_t tiler, lx_clipper_ref_t clipper, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
+/* record the filled polygon
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param polygon       the polygon in the device coordinates
+ * @param bounds        the polygon bounds
+ * @param rule          the fill rule
+ */
+lx_void_t               lx_bitmap_tiler_fill_polygon(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_polygon_ref_t polygon, lx_rect_ref_t bounds, lx_size_t rule);
+
+/* record the filled rect
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param rect          the rect in the device coordinates
+ */
+lx_void_t               lx_bitmap_tiler_fill_rect(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_rect_ref_t rect);
+
+/* record the filled round rect
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param rect          the round rect in the device coordinates
+ */
+lx_void_t               lx_bitmap_tiler_fill_round_rect(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_round_rect_ref_t rect);
+
+/* record the stroked lines
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param points        the points in the device coordinates
+ * @param count         the points count
+ */
+lx_void_t               lx_bitmap_tiler_stroke_lines(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_point_ref_t points, lx_size_t count);
+
+/* record the stroked points
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param points        the points in the device coordinates
+ * @param count         the points count
+ */
+lx_void_t               lx_bitmap_tiler_stroke_points(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_point_ref_t points, lx_size_t count);
+
+/* record the stroked polygon
+ *
+ * @param tiler         the tiler
+ * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint
+ * @param polygon       the polygon in the device coordinates
+ */
+lx_void_t               lx_bitmap_tiler_stroke_polygon(lx_bitmap_tiler_ref_t tiler, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_polygon_ref_t polygon);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
+
+
@@ -23,12 +23,222 @@
  */
 #include "writer.h"
 #include "writer/solid.h"
+#include "writer/gradient.h"
+#include "writer/bitmap_shader.h"
+#include "../../shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pixels count of the blended span chunk
+#define LX_BITMAP_WRITER_BLEND_CHUNK    (256)
+
+// clip the horizontal range [x, x + w) and return if it is empty
+#define lx_bitmap_writer_clip_x(writer, x, w) \
+    do { \
+        if ((x) < (writer)->clip_left) { (w) -= (writer)->clip_left - (x); (x) = (writer)->clip_left; } \
+        if ((x) + (w) > (writer)->clip_right) (w) = (writer)->clip_right - (x); \
+        lx_check_return((w) > 0); \
+    } while (0)
+
+// clip the vertical range [y, y + h) and return if it is empty
+#define lx_bitmap_writer_clip_y(writer, y, h) \
+    do { \
+        if ((y) < (writer)->clip_top) { (h) -= (writer)->clip_top - (y); (y) = (writer)->clip_top; } \
+        if ((y) + (h) > (writer)->clip_bottom) (h) = (writer)->clip_bottom - (y); \
+        lx_check_return((h) > 0); \
+    } while (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+// blend the span with the blend mode of paint
+static lx_void_t lx_bitmap_writer_blend_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    lx_assert(writer && writer->blender.pixels_load && writer->blender.pixels_store);
+    lx_assert(x >= 0 && y >= 0 && w >= 0);
+    lx_check_return(w && coverage);
+
+    lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
+    lx_assert(pixels);
+
+    // load the pixels span to the premultiplied colors, blend them and store them back for each chunk
+    lx_size_t               btp = writer->btp;
+    lx_pixmap_blender_t*    blender = &writer->blender;
+    lx_color_t              colors[LX_BITMAP_WRITER_BLEND_CHUNK];
+    lx_color_t              source[LX_BITMAP_WRITER_BLEND_CHUNK];
+    pixels += (y - writer->top) * writer->row_bytes + x * btp;
+    while (w > 0) {
+        lx_size_t n = lx_min(w, LX_BITMAP_WRITER_BLEND_CHUNK);
+        blender->pixels_load(pixels, colors, n);
+        if (writer->shade) {
+            writer->shade(writer, x, y, n, source);
+            blender->colors_blend(colors, source, n, coverage);
+        } else {
+            blender->color_blend(colors, writer->u.solid.color, n, coverage);
+        }
+        blender->pixels_store(pixels, colors, n);
+        pixels += n * btp;
+        x += n;
+        w -= n;
+    }
+}
+
+static lx_void_t lx_bitmap_writer_blend_draw_pixel(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y) {
+    lx_bitmap_writer_blend_draw_span(writer, x, y, 1, 0xff);
+}
+
+static lx_void_t lx_bitmap_writer_blend_draw_hline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w) {
+    lx_bitmap_writer_blend_draw_span(writer, x, y, w, 0xff);
+}
+
+static lx_void_t lx_bitmap_writer_blend_draw_vline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t h) {
+    while (h--) lx_bitmap_writer_blend_draw_span(writer, x, y++, 1, 0xff);
+}
+
+/* init the blended writer for the other blend modes except src-over
+ *
+ * we only replace the draw callbacks of the inited writer, and the src-over mode still uses the faster pixmap functions
+ */
+static lx_bool_t lx_bitmap_writer_blend_init(lx_bitmap_writer_t* writer, lx_paint_ref_t paint) {
+    lx_size_t mode = lx_paint_blend_mode(paint);
+    lx_check_return_val(mode != LX_PAINT_BLEND_MODE_SRC_OVER, lx_true);
+
+    // nothing to draw for the dst mode
+    lx_check_return_val(mode != LX_PAINT_BLEND_MODE_DST, lx_false);
+
+    // no blender for this pixel format? we use src-over instead of it, e.g. pal8
+    lx_check_return_val(lx_pixmap_blender_init(&writer->blender, lx_bitmap_pixfmt(writer->bitmap), mode), lx_true);
+
+    writer->draw_pixel  = lx_bitmap_writer_blend_draw_pixel;
+    writer->draw_hline  = lx_bitmap_writer_blend_draw_hline;
+    writer->draw_vline  = lx_bitmap_writer_blend_draw_vline;
+    writer->draw_rect   = lx_null;
+    writer->draw_span   = lx_bitmap_writer_blend_draw_span;
+    return lx_true;
+}
+
+// draw the clipped span with the given coverage
+static lx_inline lx_void_t lx_bitmap_writer_fill_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    if (coverage == 0xff) {
+        lx_assert(writer->draw_hline);
+        writer->draw_hline(writer, x, y, w);
+    } else if (writer->draw_span) {
+        writer->draw_span(writer, x, y, w, coverage);
+    } else if (coverage >= 0x80) {
+        // no partial coverage support? only draw the spans which are mostly covered
+        lx_assert(writer->draw_hline);
+        writer->draw_hline(writer, x, y, w);
+    }
+}
+
+// draw the clipped span and modulate it by the runs of the same mask coverage
+static lx_void_t lx_bitmap_writer_fill_span_masked(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    lx_bitmap_mask_t const* mask = writer->mask;
+    lx_assert(mask && mask->data);
+    lx_assert(x >= mask->x && x + w <= mask->x + mask->width && y >= mask->y && y < mask->y + mask->height);
+
+    lx_byte_t const* data = mask->data + (y - mask->y) * mask->width + (x - mask->x);
+    lx_long_t        i = 0;
+    while (i < w) {
+        lx_byte_t value = data[i];
+        lx_long_t j = i + 1;
+        while (j < w && data[j] == value) j++;
+        if (value == 0xff) {
+            lx_bitmap_writer_fill_span(writer, x + i, y, j - i, coverage);
+        } else if (value) {
+            lx_byte_t modulated = (lx_byte_t)((coverage * (value + (value >> 7))) >> 8);
+            if (modulated) lx_bitmap_writer_fill_span(writer, x + i, y, j - i, modulated);
+        }
+        i = j;
+    }
+}
+
+// draw the clipped rect
+static lx_void_t lx_bitmap_writer_fill_rect(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    if (writer->mask) {
+        while (h--) lx_bitmap_writer_fill_span_masked(writer, x, y++, w, 0xff);
+    } else if (h == 1) {
+        lx_assert(writer->draw_hline);
+        writer->draw_hline(writer, x, y, w);
+    } else if (w == 1) {
+        lx_assert(writer->draw_vline);
+        writer->draw_vline(writer, x, y, h);
+    } else if (writer->draw_rect) {
+        writer->draw_rect(writer, x, y, w, h);
+    } else {
+        lx_assert(writer->draw_hline);
+        while (h--) writer->draw_hline(writer, x, y++, w);
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-lx_bool_t lx_bitmap_writer_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint) {
-    return lx_bitmap_writer_solid_init(writer, bitmap, paint);
+lx_bool_t lx_bitmap_writer_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint, lx_matrix_ref_t matrix) {
+    lx_assert(writer && bitmap && paint);
+
+    // clip to the bitmap bounds by default
+    writer->top         = 0;
+    writer->clip_left   = 0;
+    writer->clip_top    = 0;
+    writer->clip_right  = lx_bitmap_width(bitmap);
+    writer->clip_bottom = lx_bitmap_height(bitmap);
+    writer->mask        = lx_null;
+    lx_memset(&writer->blender, 0, sizeof(lx_pixmap_blender_t));
+    writer->shade       = lx_null;
+
+    // init writer for shader
+    lx_bool_t       ok = lx_false;
+    lx_shader_ref_t shader = lx_paint_shader(paint);
+    switch (shader? lx_shader_type(shader) : LX_SHADER_TYPE_NONE) {
+    case LX_SHADER_TYPE_LINEAR_GRADIENT:
+    case LX_SHADER_TYPE_RADIAL_GRADIENT:
+        ok = lx_bitmap_writer_gradient_init(writer, bitmap, paint, matrix);
+        break;
+    case LX_SHADER_TYPE_BITMAP:
+        ok = lx_bitmap_writer_bitmap_shader_init(writer, bitmap, paint, matrix);
+        break;
+    default:
+        ok = lx_bitmap_writer_solid_init(writer, bitmap, paint);
+        break;
+    }
+
+    // init writer for the blend mode
+    return ok? lx_bitmap_writer_blend_init(writer, paint) : lx_false;
+}
+
+lx_void_t lx_bitmap_writer_prepare(lx_bitmap_ref_t bitmap, lx_paint_ref_t paint) {
+    lx_assert(bitmap && paint);
+    lx_shader_ref_t shader = lx_paint_shader(paint);
+    if (shader) {
+        switch (lx_shader_type(shader)) {
+        case LX_SHADER_TYPE_LINEAR_GRADIENT:
+        case LX_SHADER_TYPE_RADIAL_GRADIENT:
+            lx_bitmap_writer_gradient_prepare(bitmap, shader);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+lx_void_t lx_bitmap_writer_clip_set(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
+    lx_assert(writer && writer->bitmap);
+    writer->clip_left   = lx_max(x, 0);
+    writer->clip_top    = lx_max(y, writer->top);
+    writer->clip_right  = lx_min(x + w, (lx_long_t)lx_bitmap_width(writer->bitmap));
+    writer->clip_bottom = lx_min(y + h, writer->top + (lx_long_t)lx_bitmap_height(writer->bitmap));
+}
+
+lx_void_t lx_bitmap_writer_top_set(lx_bitmap_writer_t* writer, lx_long_t top) {
+    lx_assert(writer && writer->bitmap && top >= 0);
+    writer->top         = top;
+    writer->clip_left   = 0;
+    writer->clip_top    = top;
+    writer->clip_right  = lx_bitmap_width(writer->bitmap);
+    writer->clip_bottom = top + lx_bitmap_height(writer->bitmap);
 }
 
 lx_void_t lx_bitmap_writer_exit(lx_bitmap_writer_t* writer) {
@@ -37,35 +247,75 @@ lx_void_t lx_bitmap_writer_exit(lx_bitmap_writer_t* writer) {
     }
 }
 
+lx_void_t lx_bitmap_writer_mask_set(lx_bitmap_writer_t* writer, lx_bitmap_mask_t const* mask) {
+    lx_assert(writer);
+    writer->mask = mask;
+}
+
 lx_void_t lx_bitmap_writer_draw_pixel(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y) {
     lx_assert(writer && writer->draw_pixel);
-    writer->draw_pixel(writer, x, y);
+    lx_check_return(x >= writer->clip_left && x < writer->clip_right && y >= writer->clip_top && y < writer->clip_bottom);
+    if (writer->mask) lx_bitmap_writer_fill_span_masked(writer, x, y, 1, 0xff);
+    else writer->draw_pixel(writer, x, y);
 }
 
 lx_void_t lx_bitmap_writer_draw_hline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w) {
     lx_assert(writer && writer->draw_hline);
-    writer->draw_hline(writer, x, y, w);
+    lx_check_return(y >= writer->clip_top && y < writer->clip_bottom);
+    lx_bitmap_writer_clip_x(writer, x, w);
+    if (writer->mask) lx_bitmap_writer_fill_span_masked(writer, x, y, w, 0xff);
+    else writer->draw_hline(writer, x, y, w);
 }
 
 lx_void_t lx_bitmap_writer_draw_vline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t h) {
     lx_assert(writer && writer->draw_vline);
-    writer->draw_vline(writer, x, y, h);
+    lx_check_return(x >= writer->clip_left && x < writer->clip_right);
+    lx_bitmap_writer_clip_y(writer, y, h);
+    if (writer->mask) {
+        while (h--) lx_bitmap_writer_fill_span_masked(writer, x, y++, 1, 0xff);
+    } else writer->draw_vline(writer, x, y, h);
 }
 
 lx_void_t lx_bitmap_writer_draw_rect(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h) {
     lx_assert(writer);
-    if (h == 1) {
-        lx_assert(writer->draw_hline);
-        writer->draw_hline(writer, x, y, w);
-        return ;
-    } else if (w == 1) {
-        lx_assert(writer->draw_vline);
-        writer->draw_vline(writer, x, y, h);
-        return ;
-    } else if (writer->draw_rect) {
-        writer->draw_rect(writer, x, y, w, h);
-    } else {
-        lx_assert(writer->draw_hline);
-        while (h--) writer->draw_hline(writer, x, y++, w);
+    lx_bitmap_writer_clip_x(writer, x, w);
+    lx_bitmap_writer_clip_y(writer, y, h);
+    lx_bitmap_writer_fill_rect(writer, x, y, w, h);
+}
+
+lx_void_t lx_bitmap_writer_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    lx_assert(writer);
+    lx_check_return(y >= writer->clip_top && y < writer->clip_bottom);
+    lx_bitmap_writer_clip_x(writer, x, w);
+    if (writer->mask) lx_bitmap_writer_fill_span_masked(writer, x, y, w, coverage);
+    else lx_bitmap_writer_fill_span(writer, x, y, w, coverage);
+}
+
+lx_void_t lx_bitmap_writer_draw_spans(lx_bitmap_writer_t* writer, lx_polygon_raster_span_t const* spans, lx_size_t count) {
+    lx_assert(writer && spans);
+
+    lx_long_t                       clip_left   = writer->clip_left;
+    lx_long_t                       clip_top    = writer->clip_top;
+    lx_long_t                       clip_right  = writer->clip_right;
+    lx_long_t                       clip_bottom = writer->clip_bottom;
+    lx_polygon_raster_span_t const* tail        = spans + count;
+    for (; spans < tail; spans++) {
+
+        // clip it
+        lx_long_t x0 = lx_max(spans->x0, clip_left);
+        lx_long_t x1 = lx_min(spans->x1, clip_right);
+        lx_long_t y0 = lx_max(spans->y, clip_top);
+        lx_long_t y1 = lx_min(spans->y + spans->h, clip_bottom);
+        lx_check_continue(x0 < x1 && y0 < y1);
+
+        // draw it
+        lx_byte_t coverage = spans->coverage;
+        if (coverage == 0xff) {
+            lx_bitmap_writer_fill_rect(writer, x0, y0, x1 - x0, y1 - y0);
+        } else if (writer->mask) {
+            for (; y0 < y1; y0++) lx_bitmap_writer_fill_span_masked(writer, x0, y0, x1 - x0, coverage);
+        } else {
+            for (; y0 < y1; y0++) lx_bitmap_writer_fill_span(writer, x0, y0, x1 - x0, coverage);
+        }
     }
 }
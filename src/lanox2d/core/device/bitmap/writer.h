@@ -24,6 +24,7 @@
  * includes
  */
 #include "prefix.h"
+#include "mask.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -37,23 +38,90 @@ lx_extern_c_enter
 // the bitmap writer solid type
 typedef struct lx_bitmap_writer_solid_t_ {
     lx_pixel_t                pixel;
+    lx_color_t                color;
     lx_byte_t                 alpha;
+    lx_pixmap_ref_t           pixmap_alpha;
 }lx_bitmap_writer_solid_t;
 
-// the bitmap writer type
+/* the bitmap writer gradient type
+ *
+ * the gradient position of the device pixel (x, y) is:
+ *
+ * linear: t = ux * x + uy * y + u0
+ * radial: t = sqrt(u * u + v * v), u = ux * x + uy * y + u0, v = vx * x + vy * y + v0
+ */
+typedef struct lx_bitmap_writer_gradient_t_ {
+    lx_pixel_t const*         pixels;
+    lx_color_t const*         colors;
+    lx_byte_t const*          alphas;
+    lx_byte_t                 alpha;
+    lx_uint8_t                tile_mode;
+    lx_uint8_t                radial;
+    lx_uint8_t                opaque;
+    lx_float_t                ux, uy, u0;
+    lx_float_t                vx, vy, v0;
+    lx_pixmap_ref_t           pixmap_alpha;
+}lx_bitmap_writer_gradient_t;
+
+/* the bitmap writer bitmap shader type
+ *
+ * the sampled position of the device pixel (x, y) in the source bitmap is:
+ *
+ * u = sx * x + kx * y + tx
+ * v = ky * x + sy * y + ty
+ */
+typedef struct lx_bitmap_writer_bitmap_shader_t_ {
+    lx_byte_t const*          data;
+    lx_pixmap_ref_t           pixmap;
+    lx_pixmap_ref_t           pixmap_alpha;
+    lx_size_t                 btp;
+    lx_size_t                 row_bytes;
+    lx_long_t                 width;
+    lx_long_t                 height;
+    lx_byte_t                 alpha;
+    lx_uint8_t                tile_mode;
+    lx_uint8_t                filter;
+    lx_uint8_t                has_alpha;
+    lx_uint8_t                same_pixfmt;
+    lx_uint8_t                translate;
+    lx_uint8_t                scale;
+    lx_uint8_t                premul;
+    lx_long_t                 dx;
+    lx_long_t                 dy;
+    lx_float_t                sx, kx, tx;
+    lx_float_t                ky, sy, ty;
+}lx_bitmap_writer_bitmap_shader_t;
+
+/* the bitmap writer type
+ *
+ * the blender is only inited for the blend modes except src-over,
+ * and the shade callback gets the source colors of the span with the paint alpha for it,
+ * it's null for the solid writer, because we blend the solid color directly.
+ */
 typedef struct lx_bitmap_writer_t_ {
     union {
-        lx_bitmap_writer_solid_t    solid;
+        lx_bitmap_writer_solid_t            solid;
+        lx_bitmap_writer_gradient_t         gradient;
+        lx_bitmap_writer_bitmap_shader_t    bitmap_shader;
     }u;
     lx_bitmap_ref_t          bitmap;
     lx_pixmap_ref_t          pixmap;
     lx_size_t                btp;
     lx_size_t                row_bytes;
+    lx_long_t                top;
+    lx_long_t                clip_left;
+    lx_long_t                clip_top;
+    lx_long_t                clip_right;
+    lx_long_t                clip_bottom;
+    lx_bitmap_mask_t const*  mask;
+    lx_pixmap_blender_t      blender;
+    lx_void_t                (*shade)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y, lx_size_t count, lx_color_t* colors);
     lx_void_t                (*exit)(struct lx_bitmap_writer_t_* writer);
     lx_void_t                (*draw_pixel)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y);
     lx_void_t                (*draw_hline)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y, lx_long_t w);
     lx_void_t                (*draw_vline)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y, lx_long_t h);
     lx_void_t                (*draw_rect)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+    lx_void_t                (*draw_span)(struct lx_bitmap_writer_t_* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage);
 }lx_bitmap_writer_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -65,10 +133,50 @@ typedef struct lx_bitmap_writer_t_ {
  * @param writer        the writer
  * @param bitmap        the bitmap
  * @param paint         the paint
+ * @param matrix        the device matrix for the shader of paint, it will be identity if it's null
  *
  * @return              lx_true or lx_false
  */
-lx_bool_t               lx_bitmap_writer_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint);
+lx_bool_t               lx_bitmap_writer_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint, lx_matrix_ref_t matrix);
+
+/* prepare the cached shader data of paint for the given bitmap
+ *
+ * the writer will build the shader data lazily, but it's not thread-safe,
+ * so we need prepare it in the recording thread before the writers are inited in the worker threads.
+ *
+ * @param bitmap        the bitmap
+ * @param paint         the paint
+ */
+lx_void_t               lx_bitmap_writer_prepare(lx_bitmap_ref_t bitmap, lx_paint_ref_t paint);
+
+/* set the clip bounds of writer, it will be intersected with the bitmap bounds
+ *
+ * @param writer        the writer
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate
+ * @param w             the width
+ * @param h             the height
+ */
+lx_void_t               lx_bitmap_writer_clip_set(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
+
+/* set the top of writer
+ *
+ * the bitmap is only a band of the device if the top is not zero, e.g. the band of the streamed device,
+ * the first bitmap row is at the given device y-coordinate, and the clip bounds will be reset to this band.
+ *
+ * @param writer        the writer
+ * @param top           the device y-coordinate of the first bitmap row
+ */
+lx_void_t               lx_bitmap_writer_top_set(lx_bitmap_writer_t* writer, lx_long_t top);
+
+/* set the clip mask of writer
+ *
+ * all spans will be modulated by the mask coverage, and the mask need cover the clip bounds of writer
+ *
+ * @param writer        the writer
+ * @param mask          the clip mask, no mask if it's null
+ */
+lx_void_t               lx_bitmap_writer_mask_set(lx_bitmap_writer_t* writer, lx_bitmap_mask_t const* mask);
 
 /* exit writer
  *
@@ -112,6 +220,26 @@ lx_void_t               lx_bitmap_writer_draw_vline(lx_bitmap_writer_t* writer,
  */
 lx_void_t               lx_bitmap_writer_draw_rect(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_long_t h);
 
+/* draw horizontal span with the partial coverage
+ *
+ * @param writer        the writer
+ * @param x             the start x-coordinate
+ * @param y             the start y-coordinate
+ * @param w             the width
+ * @param coverage      the coverage, [0, 255]
+ */
+lx_void_t               lx_bitmap_writer_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage);
+
+/* draw the spans of the polygon raster
+ *
+ * it's faster than drawing them one by one, because we need only one call for each batch
+ *
+ * @param writer        the writer
+ * @param spans         the spans
+ * @param count         the spans count
+ */
+lx_void_t               lx_bitmap_writer_draw_spans(lx_bitmap_writer_t* writer, lx_polygon_raster_span_t const* spans, lx_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
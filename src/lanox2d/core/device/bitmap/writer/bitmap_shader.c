@@ -0,0 +1,323 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        bitmap_shader.c
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitmap_shader.h"
+#include "../../../shader.h"
+#include "../../../quality.h"
+#include "../../../private/shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the fixed-point bits of the sampled position
+#define LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS   (16)
+#define LX_BITMAP_WRITER_BITMAP_SHADER_ONE          ((lx_hong_t)1 << LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS)
+
+// the maximum sampled position, we need clamp it to avoid overflow
+#define LX_BITMAP_WRITER_BITMAP_SHADER_MAXN         ((lx_float_t)(1 << 30))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_inline lx_hong_t lx_bitmap_writer_bitmap_shader_fixed(lx_float_t v) {
+    if (v > LX_BITMAP_WRITER_BITMAP_SHADER_MAXN) v = LX_BITMAP_WRITER_BITMAP_SHADER_MAXN;
+    else if (v < -LX_BITMAP_WRITER_BITMAP_SHADER_MAXN) v = -LX_BITMAP_WRITER_BITMAP_SHADER_MAXN;
+    return (lx_hong_t)(v * (lx_float_t)LX_BITMAP_WRITER_BITMAP_SHADER_ONE);
+}
+
+// tile the texel index to [0, n), returns -1 if it's out of the bitmap for border mode
+static lx_inline lx_long_t lx_bitmap_writer_bitmap_shader_tile(lx_long_t i, lx_long_t n, lx_size_t tile_mode) {
+    switch (tile_mode) {
+    case LX_SHADER_TILE_MODE_CLAMP:
+        return i < 0? 0 : (i >= n? n - 1 : i);
+    case LX_SHADER_TILE_MODE_REPEAT:
+        i %= n;
+        return i < 0? i + n : i;
+    case LX_SHADER_TILE_MODE_MIRROR:
+        i %= n << 1;
+        if (i < 0) i += n << 1;
+        return i >= n? (n << 1) - 1 - i : i;
+    default:
+        return (i >= 0 && i < n)? i : -1;
+    }
+}
+
+/* get the texel color
+ *
+ * the texels out of the bitmap are transparent for border mode,
+ * but we use the color of the nearest edge texel to avoid the dark fringes of the filtered edges.
+ */
+static lx_inline lx_color_t lx_bitmap_writer_bitmap_shader_texel(lx_bitmap_writer_bitmap_shader_t* shader, lx_long_t x, lx_long_t y) {
+    lx_long_t tx = lx_bitmap_writer_bitmap_shader_tile(x, shader->width, shader->tile_mode);
+    lx_long_t ty = lx_bitmap_writer_bitmap_shader_tile(y, shader->height, shader->tile_mode);
+    lx_bool_t border = tx < 0 || ty < 0;
+    if (tx < 0) tx = lx_bitmap_writer_bitmap_shader_tile(x, shader->width, LX_SHADER_TILE_MODE_CLAMP);
+    if (ty < 0) ty = lx_bitmap_writer_bitmap_shader_tile(y, shader->height, LX_SHADER_TILE_MODE_CLAMP);
+
+    lx_color_t color = shader->pixmap->color_get(shader->data + ty * shader->row_bytes + tx * shader->btp);
+    if (!shader->has_alpha) color.a = 0xff;
+    if (border) color.a = 0;
+    return color;
+}
+
+static lx_inline lx_bool_t lx_bitmap_writer_bitmap_shader_sample_nearest(lx_bitmap_writer_bitmap_shader_t* shader, lx_hong_t u, lx_hong_t v, lx_color_t* color) {
+    lx_long_t x = lx_bitmap_writer_bitmap_shader_tile((lx_long_t)(u >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS), shader->width, shader->tile_mode);
+    lx_long_t y = lx_bitmap_writer_bitmap_shader_tile((lx_long_t)(v >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS), shader->height, shader->tile_mode);
+    lx_check_return_val(x >= 0 && y >= 0, lx_false);
+
+    *color = shader->pixmap->color_get(shader->data + y * shader->row_bytes + x * shader->btp);
+    if (!shader->has_alpha) color->a = 0xff;
+    return lx_true;
+}
+
+static lx_inline lx_bool_t lx_bitmap_writer_bitmap_shader_sample_bilinear(lx_bitmap_writer_bitmap_shader_t* shader, lx_hong_t u, lx_hong_t v, lx_color_t* color) {
+
+    // the texel centers are at (i + 0.5, j + 0.5)
+    u -= LX_BITMAP_WRITER_BITMAP_SHADER_ONE >> 1;
+    v -= LX_BITMAP_WRITER_BITMAP_SHADER_ONE >> 1;
+
+    // get the four texels and the 8-bits weights
+    lx_long_t   x = (lx_long_t)(u >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS);
+    lx_long_t   y = (lx_long_t)(v >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS);
+    lx_size_t   wx = (lx_size_t)(u >> (LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS - 8)) & 0xff;
+    lx_size_t   wy = (lx_size_t)(v >> (LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS - 8)) & 0xff;
+    lx_color_t  c00 = lx_bitmap_writer_bitmap_shader_texel(shader, x, y);
+    lx_color_t  c10 = lx_bitmap_writer_bitmap_shader_texel(shader, x + 1, y);
+    lx_color_t  c01 = lx_bitmap_writer_bitmap_shader_texel(shader, x, y + 1);
+    lx_color_t  c11 = lx_bitmap_writer_bitmap_shader_texel(shader, x + 1, y + 1);
+    lx_size_t   w00 = (256 - wx) * (256 - wy);
+    lx_size_t   w10 = wx * (256 - wy);
+    lx_size_t   w01 = (256 - wx) * wy;
+    lx_size_t   w11 = wx * wy;
+
+    // interpolate them, the total weight is 1 << 16
+    color->a = (lx_byte_t)((c00.a * w00 + c10.a * w10 + c01.a * w01 + c11.a * w11) >> 16);
+    color->r = (lx_byte_t)((c00.r * w00 + c10.r * w10 + c01.r * w01 + c11.r * w11) >> 16);
+    color->g = (lx_byte_t)((c00.g * w00 + c10.g * w10 + c01.g * w01 + c11.g * w11) >> 16);
+    color->b = (lx_byte_t)((c00.b * w00 + c10.b * w10 + c01.b * w01 + c11.b * w11) >> 16);
+    return color->a != 0;
+}
+
+static lx_void_t lx_bitmap_writer_bitmap_shader_draw(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t alpha) {
+    lx_assert(writer && writer->pixmap && writer->u.bitmap_shader.pixmap_alpha);
+    lx_assert(x >= 0 && y >= 0 && w >= 0);
+
+    lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
+    lx_assert(pixels);
+
+    lx_bitmap_writer_bitmap_shader_t*   shader = &writer->u.bitmap_shader;
+    lx_size_t                           btp = writer->btp;
+    lx_byte_t                           alpha_min = LX_QUALITY_ALPHA_MIN;
+    lx_byte_t                           alpha_max = LX_QUALITY_ALPHA_MAX;
+    lx_pixmap_func_pixel_t              pixel = writer->pixmap->pixel;
+    lx_pixmap_func_pixel_set_t          pixel_set = writer->pixmap->pixel_set;
+    lx_pixmap_func_pixel_set_t          pixel_set_alpha = shader->pixmap_alpha->pixel_set;
+    lx_size_t                           scale = alpha + (alpha >> 7);
+    lx_check_return(alpha >= alpha_min);
+
+    pixels += (y - writer->top) * writer->row_bytes + x * btp;
+
+    // translate only? we need not interpolate it, because all pixel centers are sampled at the texel centers
+    if (shader->translate) {
+        lx_long_t sx = x + shader->dx;
+        lx_long_t sy = lx_bitmap_writer_bitmap_shader_tile(y + shader->dy, shader->height, shader->tile_mode);
+        lx_check_return(sy >= 0);
+
+        /* copy the pixels directly if all pixels are in the bitmap
+         *
+         * the premultiplied pixels with alpha can be also copied, because pixel_copy is src-over for them
+         */
+        if (shader->same_pixfmt && (!shader->has_alpha || shader->premul) && sx >= 0 && sx + w <= shader->width) {
+            lx_byte_t const* source = shader->data + sy * shader->row_bytes + sx * btp;
+            if (alpha >= alpha_max && !shader->has_alpha) {
+                lx_memcpy(pixels, source, w * btp);
+            } else {
+                lx_pixmap_func_pixel_copy_t pixel_copy = shader->pixmap_alpha->pixel_copy;
+                while (w--) {
+                    pixel_copy(pixels, source, alpha);
+                    pixels += btp;
+                    source += btp;
+                }
+            }
+            return ;
+        }
+    }
+
+    // get the sampled position of the first pixel center, we step it from the row start to keep the same results for the splitted spans
+    lx_float_t  fy = (lx_float_t)y + 0.5f;
+    lx_hong_t   du = lx_bitmap_writer_bitmap_shader_fixed(shader->sx);
+    lx_hong_t   dv = lx_bitmap_writer_bitmap_shader_fixed(shader->ky);
+    lx_hong_t   u = lx_bitmap_writer_bitmap_shader_fixed(shader->sx * 0.5f + shader->kx * fy + shader->tx) + du * x;
+    lx_hong_t   v = lx_bitmap_writer_bitmap_shader_fixed(shader->ky * 0.5f + shader->sy * fy + shader->ty) + dv * x;
+    lx_color_t  color;
+    if (shader->scale && !shader->filter) {
+
+        // scale only? the sampled row is fixed for this span
+        lx_long_t sy = lx_bitmap_writer_bitmap_shader_tile((lx_long_t)(v >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS), shader->height, shader->tile_mode);
+        lx_check_return(sy >= 0);
+
+        lx_byte_t const* source = shader->data + sy * shader->row_bytes;
+        while (w--) {
+            lx_long_t sx = lx_bitmap_writer_bitmap_shader_tile((lx_long_t)(u >> LX_BITMAP_WRITER_BITMAP_SHADER_FIXED_BITS), shader->width, shader->tile_mode);
+            if (sx >= 0) {
+                color = shader->pixmap->color_get(source + sx * shader->btp);
+                lx_byte_t a = shader->has_alpha && !shader->premul? (lx_byte_t)((color.a * scale) >> 8) : alpha;
+                if (a >= alpha_max) pixel_set(pixels, pixel(color), 0xff);
+                else if (a >= alpha_min && a) pixel_set_alpha(pixels, pixel(color), a);
+            }
+            pixels += btp;
+            u += du;
+        }
+    } else {
+        lx_bool_t filter = shader->filter;
+        while (w--) {
+            if (filter? lx_bitmap_writer_bitmap_shader_sample_bilinear(shader, u, v, &color) : lx_bitmap_writer_bitmap_shader_sample_nearest(shader, u, v, &color)) {
+                lx_byte_t a = shader->premul? alpha : (lx_byte_t)((color.a * scale) >> 8);
+                if (a >= alpha_max) pixel_set(pixels, pixel(color), 0xff);
+                else if (a >= alpha_min && a) pixel_set_alpha(pixels, pixel(color), a);
+            }
+            pixels += btp;
+            u += du;
+            v += dv;
+        }
+    }
+}
+
+// get the source colors of the span for the blend modes, the colors out of the bitmap are transparent for border mode
+static lx_void_t lx_bitmap_writer_bitmap_shader_shade(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_size_t count, lx_color_t* colors) {
+    lx_assert(writer && colors);
+
+    lx_bitmap_writer_bitmap_shader_t*   shader = &writer->u.bitmap_shader;
+    lx_size_t                           scale = shader->alpha + (shader->alpha >> 7);
+    lx_bool_t                           filter = shader->filter;
+    lx_float_t                          fy = (lx_float_t)y + 0.5f;
+    lx_hong_t                           du = lx_bitmap_writer_bitmap_shader_fixed(shader->sx);
+    lx_hong_t                           dv = lx_bitmap_writer_bitmap_shader_fixed(shader->ky);
+    lx_hong_t                           u = lx_bitmap_writer_bitmap_shader_fixed(shader->sx * 0.5f + shader->kx * fy + shader->tx) + du * x;
+    lx_hong_t                           v = lx_bitmap_writer_bitmap_shader_fixed(shader->ky * 0.5f + shader->sy * fy + shader->ty) + dv * x;
+    lx_size_t                           i;
+    for (i = 0; i < count; i++) {
+        lx_color_t* color = &colors[i];
+        if (filter? lx_bitmap_writer_bitmap_shader_sample_bilinear(shader, u, v, color) : lx_bitmap_writer_bitmap_shader_sample_nearest(shader, u, v, color)) {
+            color->a = (lx_byte_t)((color->a * scale) >> 8);
+        } else *color = lx_color_make(0, 0, 0, 0);
+        u += du;
+        v += dv;
+    }
+}
+
+static lx_void_t lx_bitmap_writer_bitmap_shader_draw_pixel(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y) {
+    lx_bitmap_writer_bitmap_shader_draw(writer, x, y, 1, writer->u.bitmap_shader.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_bitmap_shader_draw_hline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w) {
+    lx_bitmap_writer_bitmap_shader_draw(writer, x, y, w, writer->u.bitmap_shader.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_bitmap_shader_draw_vline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t h) {
+    while (h--) lx_bitmap_writer_bitmap_shader_draw(writer, x, y++, 1, writer->u.bitmap_shader.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_bitmap_shader_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    // modulate the alpha by the coverage, alpha * coverage / 255
+    lx_byte_t alpha = (lx_byte_t)((writer->u.bitmap_shader.alpha * (coverage + (coverage >> 7))) >> 8);
+    lx_bitmap_writer_bitmap_shader_draw(writer, x, y, w, alpha);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_bool_t lx_bitmap_writer_bitmap_shader_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint, lx_matrix_ref_t matrix) {
+    lx_assert(writer && bitmap && paint);
+
+    // get the source bitmap
+    lx_bitmap_shader_t* bitmap_shader = (lx_bitmap_shader_t*)lx_paint_shader(paint);
+    lx_assert_and_check_return_val(bitmap_shader && bitmap_shader->bitmap, lx_false);
+
+    lx_bitmap_ref_t source = bitmap_shader->bitmap;
+    lx_check_return_val(lx_bitmap_data(source) && lx_bitmap_width(source) && lx_bitmap_height(source), lx_false);
+
+    /* get the inverted matrix from the device coordinate to the bitmap coordinate
+     *
+     * device <= matrix <= world <= shader matrix <= bitmap
+     */
+    lx_matrix_t inverse;
+    if (matrix) inverse = *matrix;
+    else lx_matrix_clear(&inverse);
+    lx_matrix_multiply(&inverse, &bitmap_shader->base.matrix);
+    lx_check_return_val(lx_matrix_invert(&inverse), lx_false);
+
+    // init the source bitmap
+    lx_bitmap_writer_bitmap_shader_t* shader = &writer->u.bitmap_shader;
+    shader->data            = (lx_byte_t const*)lx_bitmap_data(source);
+    shader->pixmap          = lx_pixmap(lx_bitmap_pixfmt(source), 0xff);
+    shader->row_bytes       = lx_bitmap_row_bytes(source);
+    shader->width           = (lx_long_t)lx_bitmap_width(source);
+    shader->height          = (lx_long_t)lx_bitmap_height(source);
+    shader->has_alpha       = (lx_uint8_t)lx_bitmap_has_alpha(source);
+    shader->same_pixfmt     = (lx_uint8_t)(lx_bitmap_pixfmt(source) == lx_bitmap_pixfmt(bitmap));
+    shader->filter          = (lx_uint8_t)((lx_paint_flags(paint) & LX_PAINT_FLAG_FILTER_BITMAP)? 1 : 0);
+    shader->tile_mode       = bitmap_shader->base.tile_mode;
+    shader->alpha           = lx_paint_alpha(paint);
+    lx_assert_and_check_return_val(shader->pixmap && shader->pixmap->color_get, lx_false);
+    shader->btp             = shader->pixmap->btp;
+
+    // init the inverted matrix
+    shader->sx              = inverse.sx;
+    shader->kx              = inverse.kx;
+    shader->tx              = inverse.tx;
+    shader->ky              = inverse.ky;
+    shader->sy              = inverse.sy;
+    shader->ty              = inverse.ty;
+
+    // translate only with the integer offsets?
+    shader->scale           = (lx_uint8_t)(0 == inverse.kx && 0 == inverse.ky);
+    shader->translate       = (lx_uint8_t)(shader->scale && 1.0f == inverse.sx && 1.0f == inverse.sy
+                                && lx_abs(inverse.tx) < LX_BITMAP_WRITER_BITMAP_SHADER_MAXN && inverse.tx == (lx_float_t)(lx_long_t)inverse.tx
+                                && lx_abs(inverse.ty) < LX_BITMAP_WRITER_BITMAP_SHADER_MAXN && inverse.ty == (lx_float_t)(lx_long_t)inverse.ty);
+    shader->dx              = shader->translate? (lx_long_t)inverse.tx : 0;
+    shader->dy              = shader->translate? (lx_long_t)inverse.ty : 0;
+
+    /* the premultiplied pixel has contained the color alpha, so we pass only the paint alpha and coverage to pixel_set,
+     * and the opaque pixel_set need be src-over if the source bitmap has alpha.
+     */
+    shader->premul          = (lx_uint8_t)LX_PIXFMT_IS_PREMUL(lx_bitmap_pixfmt(bitmap));
+
+    // init writer
+    writer->bitmap          = bitmap;
+    writer->pixmap          = lx_pixmap(lx_bitmap_pixfmt(bitmap), shader->premul && shader->has_alpha? LX_QUALITY_ALPHA_MIN : 0xff);
+    writer->row_bytes       = lx_bitmap_row_bytes(bitmap);
+    shader->pixmap_alpha    = lx_pixmap(lx_bitmap_pixfmt(bitmap), LX_QUALITY_ALPHA_MIN);
+    writer->draw_pixel      = lx_bitmap_writer_bitmap_shader_draw_pixel;
+    writer->draw_hline      = lx_bitmap_writer_bitmap_shader_draw_hline;
+    writer->draw_vline      = lx_bitmap_writer_bitmap_shader_draw_vline;
+    writer->draw_rect       = lx_null;
+    writer->draw_span       = lx_bitmap_writer_bitmap_shader_draw_span;
+    writer->shade           = lx_bitmap_writer_bitmap_shader_shade;
+    writer->exit            = lx_null;
+    lx_check_return_val(writer->pixmap && shader->pixmap_alpha, lx_false);
+    writer->btp             = writer->pixmap->btp;
+    return lx_true;
+}
+
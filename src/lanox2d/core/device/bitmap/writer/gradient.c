@@ -0,0 +1,387 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        gradient.c
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "gradient.h"
+#include "../../../shader.h"
+#include "../../../quality.h"
+#include "../../../private/shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the color table size
+#define LX_BITMAP_WRITER_GRADIENT_LUT_BITS      (8)
+#define LX_BITMAP_WRITER_GRADIENT_LUT_SIZE      (1 << LX_BITMAP_WRITER_GRADIENT_LUT_BITS)
+
+// the fixed-point bits of the gradient position, t: [0, 1] => [0, LX_BITMAP_WRITER_GRADIENT_ONE]
+#define LX_BITMAP_WRITER_GRADIENT_FIXED_BITS    (24)
+#define LX_BITMAP_WRITER_GRADIENT_ONE           ((lx_hong_t)1 << LX_BITMAP_WRITER_GRADIENT_FIXED_BITS)
+
+// the maximum gradient position, we need clamp it to avoid overflow
+#define LX_BITMAP_WRITER_GRADIENT_MAXN          ((lx_float_t)(1 << 30))
+
+// the pixels count of the span chunk
+#define LX_BITMAP_WRITER_GRADIENT_CHUNK         (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached color table of the gradient shader
+typedef struct lx_bitmap_writer_gradient_devdata_t_ {
+    lx_size_t           pixfmt;
+    lx_bool_t           opaque;
+    lx_color_t          colors[LX_BITMAP_WRITER_GRADIENT_LUT_SIZE];
+    lx_pixel_t          pixels[LX_BITMAP_WRITER_GRADIENT_LUT_SIZE];
+    lx_byte_t           alphas[LX_BITMAP_WRITER_GRADIENT_LUT_SIZE];
+}lx_bitmap_writer_gradient_devdata_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_void_t lx_bitmap_writer_gradient_devdata_free(lx_pointer_t devdata) {
+    if (devdata) lx_free(devdata);
+}
+
+static lx_inline lx_float_t lx_bitmap_writer_gradient_stop(lx_gradient_ref_t gradient, lx_size_t index) {
+    if (gradient->radios) return gradient->radios[index];
+    return gradient->count > 1? (lx_float_t)index / (gradient->count - 1) : 0;
+}
+
+static lx_void_t lx_bitmap_writer_gradient_make_colors(lx_bitmap_writer_gradient_devdata_t* devdata, lx_gradient_ref_t gradient) {
+    lx_assert(devdata && gradient && gradient->colors && gradient->count);
+
+    lx_size_t           i;
+    lx_size_t           j = 0;
+    lx_size_t           count = gradient->count;
+    lx_color_t const*   stops = gradient->colors;
+    devdata->opaque = lx_true;
+    for (i = 0; i < LX_BITMAP_WRITER_GRADIENT_LUT_SIZE; i++) {
+
+        // find the stops [j, j + 1] of the position t
+        lx_float_t t = (lx_float_t)i / (LX_BITMAP_WRITER_GRADIENT_LUT_SIZE - 1);
+        while (j + 1 < count && t > lx_bitmap_writer_gradient_stop(gradient, j + 1)) j++;
+
+        // interpolate the color between the two stops
+        lx_color_t*  color = &devdata->colors[i];
+        lx_float_t   t0 = lx_bitmap_writer_gradient_stop(gradient, j);
+        if (j + 1 < count && t > t0) {
+            lx_float_t          t1 = lx_bitmap_writer_gradient_stop(gradient, j + 1);
+            lx_long_t           w = (lx_long_t)(((t - t0) / (t1 - t0)) * 256);
+            lx_color_t const*   c0 = &stops[j];
+            lx_color_t const*   c1 = &stops[j + 1];
+            color->a = (lx_byte_t)(c0->a + ((((lx_long_t)c1->a - c0->a) * w) >> 8));
+            color->r = (lx_byte_t)(c0->r + ((((lx_long_t)c1->r - c0->r) * w) >> 8));
+            color->g = (lx_byte_t)(c0->g + ((((lx_long_t)c1->g - c0->g) * w) >> 8));
+            color->b = (lx_byte_t)(c0->b + ((((lx_long_t)c1->b - c0->b) * w) >> 8));
+        } else {
+            *color = stops[j];
+        }
+        if (color->a != 0xff) devdata->opaque = lx_false;
+    }
+}
+
+static lx_bitmap_writer_gradient_devdata_t* lx_bitmap_writer_gradient_devdata(lx_bitmap_ref_t bitmap, lx_shader_t* shader) {
+    lx_assert(bitmap && shader);
+
+    // get the cached color table
+    lx_bitmap_writer_gradient_devdata_t* devdata = lx_null;
+    if (shader->devdata_free == lx_bitmap_writer_gradient_devdata_free) {
+        devdata = (lx_bitmap_writer_gradient_devdata_t*)shader->devdata;
+    }
+
+    // make the color table
+    if (!devdata) {
+
+        // free the cached data of other devices
+        if (shader->devdata && shader->devdata_free) {
+            shader->devdata_free(shader->devdata);
+        }
+        shader->devdata      = lx_null;
+        shader->devdata_free = lx_null;
+
+        devdata = lx_malloc0_type(lx_bitmap_writer_gradient_devdata_t);
+        lx_assert_and_check_return_val(devdata, lx_null);
+
+        if (shader->type == LX_SHADER_TYPE_LINEAR_GRADIENT) {
+            lx_bitmap_writer_gradient_make_colors(devdata, &((lx_linear_gradient_shader_t*)shader)->gradient);
+        } else {
+            lx_bitmap_writer_gradient_make_colors(devdata, &((lx_radial_gradient_shader_t*)shader)->gradient);
+        }
+        shader->devdata      = devdata;
+        shader->devdata_free = lx_bitmap_writer_gradient_devdata_free;
+    }
+
+    // convert the color table to the pixels of the bitmap format
+    lx_size_t pixfmt = lx_bitmap_pixfmt(bitmap);
+    if (devdata->pixfmt != pixfmt) {
+        lx_pixmap_ref_t pixmap = lx_pixmap(pixfmt, 0xff);
+        lx_assert_and_check_return_val(pixmap && pixmap->pixel, lx_null);
+
+        // the premultiplied pixel has contained the color alpha, so we need not modulate it again
+        lx_size_t i;
+        lx_bool_t premul = LX_PIXFMT_IS_PREMUL(pixfmt);
+        for (i = 0; i < LX_BITMAP_WRITER_GRADIENT_LUT_SIZE; i++) {
+            devdata->pixels[i] = pixmap->pixel(devdata->colors[i]);
+            devdata->alphas[i] = premul? 0xff : devdata->colors[i].a;
+        }
+        devdata->pixfmt = pixfmt;
+    }
+    return devdata;
+}
+
+static lx_inline lx_hong_t lx_bitmap_writer_gradient_fixed(lx_float_t t) {
+    if (t > LX_BITMAP_WRITER_GRADIENT_MAXN) t = LX_BITMAP_WRITER_GRADIENT_MAXN;
+    else if (t < -LX_BITMAP_WRITER_GRADIENT_MAXN) t = -LX_BITMAP_WRITER_GRADIENT_MAXN;
+    return (lx_hong_t)(t * (lx_float_t)LX_BITMAP_WRITER_GRADIENT_ONE);
+}
+
+// get the color index of the fixed-point position, returns -1 if it's out of the gradient for border mode
+static lx_inline lx_long_t lx_bitmap_writer_gradient_index(lx_hong_t t, lx_size_t tile_mode) {
+    switch (tile_mode) {
+    case LX_SHADER_TILE_MODE_CLAMP:
+        if (t < 0) t = 0;
+        else if (t >= LX_BITMAP_WRITER_GRADIENT_ONE) t = LX_BITMAP_WRITER_GRADIENT_ONE - 1;
+        break;
+    case LX_SHADER_TILE_MODE_REPEAT:
+        t = (lx_hong_t)((lx_uint64_t)t & (LX_BITMAP_WRITER_GRADIENT_ONE - 1));
+        break;
+    case LX_SHADER_TILE_MODE_MIRROR:
+        t = (lx_hong_t)((lx_uint64_t)t & ((LX_BITMAP_WRITER_GRADIENT_ONE << 1) - 1));
+        if (t >= LX_BITMAP_WRITER_GRADIENT_ONE) t = (LX_BITMAP_WRITER_GRADIENT_ONE << 1) - 1 - t;
+        break;
+    default:
+        if (t < 0 || t > LX_BITMAP_WRITER_GRADIENT_ONE) return -1;
+        if (t == LX_BITMAP_WRITER_GRADIENT_ONE) t--;
+        break;
+    }
+    return (lx_long_t)(t >> (LX_BITMAP_WRITER_GRADIENT_FIXED_BITS - LX_BITMAP_WRITER_GRADIENT_LUT_BITS));
+}
+
+/* get the color indices of the span [x, x + count)
+ *
+ * the gradient position is affine along x, so we only step it in the fixed-point,
+ * and the radial gradient need only one sqrt for each pixel.
+ *
+ * @note we step it from the row start, so the results are same for any splitted spans (e.g. tiles)
+ */
+static lx_void_t lx_bitmap_writer_gradient_indices(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_size_t count, lx_long_t* indices) {
+    lx_assert(writer && indices);
+
+    // get the gradient position of the pixel center
+    lx_bitmap_writer_gradient_t* gradient = &writer->u.gradient;
+    lx_float_t  fy = (lx_float_t)y + 0.5f;
+    lx_hong_t   du = lx_bitmap_writer_gradient_fixed(gradient->ux);
+    lx_hong_t   u = lx_bitmap_writer_gradient_fixed(gradient->ux * 0.5f + gradient->uy * fy + gradient->u0) + du * x;
+    lx_size_t   tile_mode = gradient->tile_mode;
+    lx_size_t   i;
+    if (gradient->radial) {
+        lx_hong_t dv = lx_bitmap_writer_gradient_fixed(gradient->vx);
+        lx_hong_t v = lx_bitmap_writer_gradient_fixed(gradient->vx * 0.5f + gradient->vy * fy + gradient->v0) + dv * x;
+        for (i = 0; i < count; i++) {
+            lx_float_t fu = (lx_float_t)u;
+            lx_float_t fv = (lx_float_t)v;
+            indices[i] = lx_bitmap_writer_gradient_index((lx_hong_t)lx_sqrtf(fu * fu + fv * fv), tile_mode);
+            u += du;
+            v += dv;
+        }
+    } else {
+        for (i = 0; i < count; i++) {
+            indices[i] = lx_bitmap_writer_gradient_index(u, tile_mode);
+            u += du;
+        }
+    }
+}
+
+static lx_void_t lx_bitmap_writer_gradient_draw(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t alpha) {
+    lx_assert(writer && writer->pixmap && writer->u.gradient.pixmap_alpha);
+    lx_assert(x >= 0 && y >= 0 && w >= 0);
+
+    lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
+    lx_assert(pixels);
+
+    lx_bitmap_writer_gradient_t*    gradient = &writer->u.gradient;
+    lx_pixel_t const*               lut_pixels = gradient->pixels;
+    lx_byte_t const*                lut_alphas = gradient->alphas;
+    lx_size_t                       btp = writer->btp;
+    lx_byte_t                       alpha_min = LX_QUALITY_ALPHA_MIN;
+    lx_byte_t                       alpha_max = LX_QUALITY_ALPHA_MAX;
+    lx_pixmap_func_pixel_set_t      pixel_set = writer->pixmap->pixel_set;
+    lx_pixmap_func_pixel_set_t      pixel_set_alpha = gradient->pixmap_alpha->pixel_set;
+    lx_long_t                       indices[LX_BITMAP_WRITER_GRADIENT_CHUNK];
+    lx_bool_t                       opaque = gradient->opaque && alpha >= alpha_max;
+    lx_size_t                       scale = alpha + (alpha >> 7);
+    lx_check_return(alpha >= alpha_min);
+
+    pixels += (y - writer->top) * writer->row_bytes + x * btp;
+    while (w > 0) {
+        lx_size_t i;
+        lx_size_t n = lx_min(w, LX_BITMAP_WRITER_GRADIENT_CHUNK);
+        lx_bitmap_writer_gradient_indices(writer, x, y, n, indices);
+        if (opaque) {
+            for (i = 0; i < n; i++, pixels += btp) {
+                if (indices[i] >= 0) pixel_set(pixels, lut_pixels[indices[i]], 0xff);
+            }
+        } else {
+            for (i = 0; i < n; i++, pixels += btp) {
+                lx_long_t index = indices[i];
+                if (index >= 0) {
+                    // modulate the color alpha by the paint alpha and coverage, a * alpha / 255
+                    lx_byte_t a = (lx_byte_t)((lut_alphas[index] * scale) >> 8);
+                    if (a >= alpha_max) pixel_set(pixels, lut_pixels[index], 0xff);
+                    else if (a >= alpha_min && a) pixel_set_alpha(pixels, lut_pixels[index], a);
+                }
+            }
+        }
+        x += n;
+        w -= n;
+    }
+}
+
+// get the source colors of the span for the blend modes, the colors out of the gradient are transparent for border mode
+static lx_void_t lx_bitmap_writer_gradient_shade(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_size_t count, lx_color_t* colors) {
+    lx_assert(writer && colors && count <= LX_BITMAP_WRITER_GRADIENT_CHUNK);
+
+    lx_bitmap_writer_gradient_t*    gradient = &writer->u.gradient;
+    lx_color_t const*               lut_colors = gradient->colors;
+    lx_size_t                       scale = gradient->alpha + (gradient->alpha >> 7);
+    lx_long_t                       indices[LX_BITMAP_WRITER_GRADIENT_CHUNK];
+    lx_size_t                       i;
+    lx_bitmap_writer_gradient_indices(writer, x, y, count, indices);
+    for (i = 0; i < count; i++) {
+        lx_long_t index = indices[i];
+        if (index >= 0) {
+            colors[i] = lut_colors[index];
+            colors[i].a = (lx_byte_t)((colors[i].a * scale) >> 8);
+        } else colors[i] = lx_color_make(0, 0, 0, 0);
+    }
+}
+
+static lx_void_t lx_bitmap_writer_gradient_draw_pixel(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y) {
+    lx_bitmap_writer_gradient_draw(writer, x, y, 1, writer->u.gradient.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_gradient_draw_hline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w) {
+    lx_bitmap_writer_gradient_draw(writer, x, y, w, writer->u.gradient.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_gradient_draw_vline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t h) {
+    while (h--) lx_bitmap_writer_gradient_draw(writer, x, y++, 1, writer->u.gradient.alpha);
+}
+
+static lx_void_t lx_bitmap_writer_gradient_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    // modulate the alpha by the coverage, alpha * coverage / 255
+    lx_byte_t alpha = (lx_byte_t)((writer->u.gradient.alpha * (coverage + (coverage >> 7))) >> 8);
+    lx_bitmap_writer_gradient_draw(writer, x, y, w, alpha);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_bool_t lx_bitmap_writer_gradient_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint, lx_matrix_ref_t matrix) {
+    lx_assert(writer && bitmap && paint);
+
+    // get the gradient shader
+    lx_shader_t* shader = (lx_shader_t*)lx_paint_shader(paint);
+    lx_assert_and_check_return_val(shader, lx_false);
+
+    // get the cached color table
+    lx_bitmap_writer_gradient_devdata_t* devdata = lx_bitmap_writer_gradient_devdata(bitmap, shader);
+    lx_check_return_val(devdata, lx_false);
+
+    /* get the inverted matrix from the device coordinate to the shader coordinate
+     *
+     * device <= matrix <= world <= shader matrix <= shader
+     */
+    lx_matrix_t inverse;
+    if (matrix) inverse = *matrix;
+    else lx_matrix_clear(&inverse);
+    lx_matrix_multiply(&inverse, &shader->matrix);
+    lx_check_return_val(lx_matrix_invert(&inverse), lx_false);
+
+    // init the affine coefficients of the gradient position
+    lx_bitmap_writer_gradient_t* gradient = &writer->u.gradient;
+    if (shader->type == LX_SHADER_TYPE_LINEAR_GRADIENT) {
+
+        /* t = ((p - p0) . (p1 - p0)) / |p1 - p0|^2
+         *
+         * p = (sx * x + kx * y + tx, ky * x + sy * y + ty)
+         */
+        lx_line_ref_t line = &((lx_linear_gradient_shader_t*)shader)->line;
+        lx_float_t    dx = line->p1.x - line->p0.x;
+        lx_float_t    dy = line->p1.y - line->p0.y;
+        lx_float_t    d2 = dx * dx + dy * dy;
+        lx_check_return_val(d2 > 0, lx_false);
+        dx /= d2;
+        dy /= d2;
+        gradient->ux = inverse.sx * dx + inverse.ky * dy;
+        gradient->uy = inverse.kx * dx + inverse.sy * dy;
+        gradient->u0 = (inverse.tx - line->p0.x) * dx + (inverse.ty - line->p0.y) * dy;
+        gradient->vx = 0;
+        gradient->vy = 0;
+        gradient->v0 = 0;
+        gradient->radial = 0;
+    } else {
+
+        // t = |p - c| / r, (u, v) = (p - c) / r
+        lx_circle_ref_t circle = &((lx_radial_gradient_shader_t*)shader)->circle;
+        lx_check_return_val(circle->r > 0, lx_false);
+        lx_float_t r = 1.0f / circle->r;
+        gradient->ux = inverse.sx * r;
+        gradient->uy = inverse.kx * r;
+        gradient->u0 = (inverse.tx - circle->c.x) * r;
+        gradient->vx = inverse.ky * r;
+        gradient->vy = inverse.sy * r;
+        gradient->v0 = (inverse.ty - circle->c.y) * r;
+        gradient->radial = 1;
+    }
+
+    // the opaque pixel_set need be src-over for the premultiplied pixels with alpha
+    writer->bitmap              = bitmap;
+    writer->pixmap              = lx_pixmap(lx_bitmap_pixfmt(bitmap), LX_PIXFMT_IS_PREMUL(lx_bitmap_pixfmt(bitmap)) && !devdata->opaque? LX_QUALITY_ALPHA_MIN : 0xff);
+    writer->row_bytes           = lx_bitmap_row_bytes(bitmap);
+    gradient->pixels            = devdata->pixels;
+    gradient->colors            = devdata->colors;
+    gradient->alphas            = devdata->alphas;
+    gradient->opaque            = (lx_uint8_t)devdata->opaque;
+    gradient->alpha             = lx_paint_alpha(paint);
+    gradient->tile_mode         = shader->tile_mode;
+    gradient->pixmap_alpha      = lx_pixmap(lx_bitmap_pixfmt(bitmap), LX_QUALITY_ALPHA_MIN);
+    writer->draw_pixel          = lx_bitmap_writer_gradient_draw_pixel;
+    writer->draw_hline          = lx_bitmap_writer_gradient_draw_hline;
+    writer->draw_vline          = lx_bitmap_writer_gradient_draw_vline;
+    writer->draw_rect           = lx_null;
+    writer->draw_span           = lx_bitmap_writer_gradient_draw_span;
+    writer->shade               = lx_bitmap_writer_gradient_shade;
+    writer->exit                = lx_null;
+    lx_check_return_val(writer->pixmap && gradient->pixmap_alpha, lx_false);
+    writer->btp                 = writer->pixmap->btp;
+    return lx_true;
+}
+
+lx_bool_t lx_bitmap_writer_gradient_prepare(lx_bitmap_ref_t bitmap, lx_shader_ref_t shader) {
+    lx_assert(bitmap && shader);
+    return lx_bitmap_writer_gradient_devdata(bitmap, (lx_shader_t*)shader) != lx_null;
+}
+
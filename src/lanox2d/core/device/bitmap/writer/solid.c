@@ -22,6 +22,7 @@
  * includes
  */
 #include "solid.h"
+#include "../../../quality.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -32,7 +33,7 @@ static lx_void_t lx_bitmap_writer_solid_draw_pixel(lx_bitmap_writer_t* writer, l
 
     lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
     lx_assert(pixels);
-    writer->pixmap->pixel_set(pixels + y * writer->row_bytes + x * writer->btp, writer->u.solid.pixel, writer->u.solid.alpha);
+    writer->pixmap->pixel_set(pixels + (y - writer->top) * writer->row_bytes + x * writer->btp, writer->u.solid.pixel, writer->u.solid.alpha);
 }
 
 static lx_void_t lx_bitmap_writer_solid_draw_hline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w) {
@@ -42,7 +43,7 @@ static lx_void_t lx_bitmap_writer_solid_draw_hline(lx_bitmap_writer_t* writer, l
 
     lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
     lx_assert(pixels);
-    writer->pixmap->pixels_fill(pixels + y * writer->row_bytes + x * writer->btp, writer->u.solid.pixel, w, writer->u.solid.alpha);
+    writer->pixmap->pixels_fill(pixels + (y - writer->top) * writer->row_bytes + x * writer->btp, writer->u.solid.pixel, w, writer->u.solid.alpha);
 }
 
 static lx_void_t lx_bitmap_writer_solid_draw_vline(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t h) {
@@ -58,8 +59,10 @@ static lx_void_t lx_bitmap_writer_solid_draw_vline(lx_bitmap_writer_t* writer, l
     lx_pixel_t                      pixel = writer->u.solid.pixel;
     lx_byte_t                       alpha = writer->u.solid.alpha;
     lx_pixmap_func_pixel_set_t      pixel_set = writer->pixmap->pixel_set;
+    pixels += (y - writer->top) * row_bytes + x * btp;
     while (h--) {
-        pixel_set(pixels + y++ * row_bytes + x * btp, pixel, alpha);
+        pixel_set(pixels, pixel, alpha);
+        pixels += row_bytes;
     }
 }
 
@@ -76,10 +79,10 @@ static lx_void_t lx_bitmap_writer_solid_draw_rect(lx_bitmap_writer_t* writer, lx
     lx_pixel_t                      pixel = writer->u.solid.pixel;
     lx_byte_t                       alpha = writer->u.solid.alpha;
     lx_pixmap_func_pixels_fill_t    pixels_fill = writer->pixmap->pixels_fill;
+    pixels += (y - writer->top) * row_bytes + x * btp;
     if (!x && (w * btp == row_bytes)) {
         pixels_fill(pixels, pixel, h * w, alpha);
     } else {
-        pixels += y * row_bytes + x * btp;
         while (h--) {
             pixels_fill(pixels, pixel, w, alpha);
             pixels += row_bytes;
@@ -87,24 +90,59 @@ static lx_void_t lx_bitmap_writer_solid_draw_rect(lx_bitmap_writer_t* writer, lx
     }
 }
 
+static lx_void_t lx_bitmap_writer_solid_draw_span(lx_bitmap_writer_t* writer, lx_long_t x, lx_long_t y, lx_long_t w, lx_byte_t coverage) {
+    lx_assert(writer && writer->pixmap && writer->u.solid.pixmap_alpha);
+    lx_assert(x >= 0 && y >= 0 && w >= 0);
+    lx_check_return(w);
+
+    // modulate the alpha by the coverage, alpha * coverage / 255
+    lx_byte_t alpha = (lx_byte_t)((writer->u.solid.alpha * (coverage + (coverage >> 7))) >> 8);
+    lx_check_return(alpha && alpha >= LX_QUALITY_ALPHA_MIN);
+
+    // @note the opaque pixmap is only used if the paint alpha is opaque too
+    lx_pixmap_ref_t pixmap = alpha >= LX_QUALITY_ALPHA_MAX? writer->pixmap : writer->u.solid.pixmap_alpha;
+    lx_assert(pixmap->pixels_fill);
+
+    lx_byte_t* pixels = (lx_byte_t*)lx_bitmap_data(writer->bitmap);
+    lx_assert(pixels);
+    pixmap->pixels_fill(pixels + (y - writer->top) * writer->row_bytes + x * writer->btp, writer->u.solid.pixel, w, alpha);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 lx_bool_t lx_bitmap_writer_solid_init(lx_bitmap_writer_t* writer, lx_bitmap_ref_t bitmap, lx_paint_ref_t paint) {
     lx_assert(writer && bitmap && paint);
 
+    /* the transparent paint need not be drawn for src-over mode,
+     * but the other blend modes may still change the pixels, e.g. clear and src
+     */
+    lx_byte_t  alpha      = lx_paint_alpha(paint);
+    lx_color_t color      = lx_paint_color(paint);
+    lx_size_t  pixfmt     = lx_bitmap_pixfmt(bitmap);
+
+    /* the premultiplied pixel has contained the color alpha, and the alpha of pixel_set is only the paint alpha and coverage,
+     * so we cannot use the opaque pixmap to overwrite the pixels if the color is translucent,
+     * and the color alpha is also the source opacity of the other blend modes.
+     */
+    lx_byte_t  opacity    = LX_PIXFMT_IS_PREMUL(pixfmt)? (lx_byte_t)((alpha * (color.a + (color.a >> 7))) >> 8) : alpha;
     writer->bitmap        = bitmap;
-    writer->pixmap        = lx_pixmap(lx_bitmap_pixfmt(bitmap), lx_paint_alpha(paint));
+    writer->pixmap        = lx_pixmap(pixfmt, lx_paint_blend_mode(paint) == LX_PAINT_BLEND_MODE_SRC_OVER? opacity : 0xff);
+    lx_check_return_val(writer->pixmap, lx_false);
+
     writer->btp           = writer->pixmap->btp;
     writer->row_bytes     = lx_bitmap_row_bytes(writer->bitmap);
-    writer->u.solid.pixel = writer->pixmap->pixel(lx_paint_color(paint));
-    writer->u.solid.alpha = lx_paint_alpha(paint);
+    writer->u.solid.pixel = writer->pixmap->pixel(color);
+    writer->u.solid.alpha = alpha;
+    writer->u.solid.color = color;
+    writer->u.solid.color.a = opacity;
+    writer->u.solid.pixmap_alpha = lx_pixmap(pixfmt, LX_QUALITY_ALPHA_MIN);
     writer->draw_pixel    = lx_bitmap_writer_solid_draw_pixel;
     writer->draw_hline    = lx_bitmap_writer_solid_draw_hline;
     writer->draw_vline    = lx_bitmap_writer_solid_draw_vline;
     writer->draw_rect     = lx_bitmap_writer_solid_draw_rect;
+    writer->draw_span     = lx_bitmap_writer_solid_draw_span;
     writer->exit          = lx_null;
-    lx_check_return_val(writer->pixmap, lx_false);
     return lx_true;
 }
 
@@ -148,6 +148,10 @@
     }
 }
 
+- (lx_void_t)strokeCacheSet:(lx_size_t)maxsize {
+    lx_stroker_cache_set(_stroker, maxsize);
+}
+
 - (lx_void_t)drawClear:(lx_color_t)color {
     _clearColor = MTLClearColorMake((lx_float_t)color.r / 0xff, (lx_float_t)color.g / 0xff, (lx_float_t)color.b / 0xff, (lx_float_t)color.a / 0xff);
     [self drawPrepare];
@@ -220,14 +224,14 @@
 
     lx_size_t mode = lx_paint_mode(_baseDevice->paint);
     if (mode & LX_PAINT_MODE_FILL) {
-        [self drawPolygon:lx_path_polygon(path) hint:lx_path_hint(path) bounds:lx_path_bounds(path)];
+        [self drawPolygon:lx_path_polygon_for_matrix(path, _baseDevice->matrix) hint:lx_path_hint(path) bounds:lx_path_bounds(path)];
     }
 
     if ((mode & LX_PAINT_MODE_STROKE) && (lx_paint_stroke_width(_baseDevice->paint) > 0)) {
         if ([self strokeOnly]) {
-            [self drawPolygon:lx_path_polygon(path) hint:lx_path_hint(path) bounds:lx_path_bounds(path)];
+            [self drawPolygon:lx_path_polygon_for_matrix(path, _baseDevice->matrix) hint:lx_path_hint(path) bounds:lx_path_bounds(path)];
         } else {
-            [self strokeFill:lx_stroker_make_from_path(_stroker, _baseDevice->paint, path)];
+            [self strokeFill:lx_stroker_make_from_path(_stroker, _baseDevice->paint, _baseDevice->matrix, path)];
         }
     }
 }
@@ -480,9 +484,9 @@
                 index += 4;
             }
         } else {
-            lx_uint16_t  count;
+            lx_uint32_t  count;
             lx_size_t    index = 0;
-            lx_uint16_t* counts = result->counts;
+            lx_uint32_t* counts = result->counts;
             while ((count = *counts++)) {
                 [_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:index vertexCount:count];
                 index += count;
@@ -498,7 +502,8 @@
     return (    1.0f == lx_paint_stroke_width(_baseDevice->paint)
             &&  1.0f == lx_abs(_baseDevice->matrix->sx)
             &&  1.0f == lx_abs(_baseDevice->matrix->sy)
-            &&  !lx_paint_shader(_baseDevice->paint));
+            &&  !lx_paint_shader(_baseDevice->paint)
+            &&  !lx_paint_stroke_dash(_baseDevice->paint, lx_null, lx_null));
 }
 
 - (lx_void_t)strokePoints:(nonnull lx_point_ref_t)points count:(lx_uint16_t)count {
@@ -558,9 +563,9 @@
     }
 
     // draw vertices
-    lx_uint16_t  count;
+    lx_uint32_t  count;
     lx_size_t    index = 0;
-    lx_uint16_t* counts = polygon->counts;
+    lx_uint32_t* counts = polygon->counts;
     while ((count = *counts++)) {
         [_renderEncoder drawPrimitives:MTLPrimitiveTypeLineStrip vertexStart:index vertexCount:count];
         index += count;
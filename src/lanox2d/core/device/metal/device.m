@@ -43,6 +43,13 @@ static lx_void_t lx_device_metal_draw_commit(lx_device_ref_t self) {
     }
 }
 
+static lx_void_t lx_device_metal_stroke_cache_set(lx_device_ref_t self, lx_size_t maxsize) {
+    lx_metal_device_t* device = (lx_metal_device_t*)self;
+    if (device) {
+        [device->renderer strokeCacheSet:maxsize];
+    }
+}
+
 static lx_void_t lx_device_metal_draw_clear(lx_device_ref_t self, lx_color_t color) {
     lx_metal_device_t* device = (lx_metal_device_t*)self;
     if (device) {
@@ -106,6 +113,7 @@ lx_device_ref_t lx_device_init_from_metal(lx_size_t width, lx_size_t height, lx_
         device->base.draw_path    = lx_device_metal_draw_path;
         device->base.draw_lock    = lx_device_metal_draw_lock;
         device->base.draw_commit  = lx_device_metal_draw_commit;
+        device->base.stroke_cache_set = lx_device_metal_stroke_cache_set;
         device->base.exit         = lx_device_metal_exit;
         device->base.width        = width;
         device->base.height       = height;
@@ -29,6 +29,12 @@
  * private implementation
  */
 
+static lx_void_t lx_device_opengl_stroke_cache_set(lx_device_ref_t self, lx_size_t maxsize) {
+    lx_opengl_device_t* device = (lx_opengl_device_t*)self;
+    lx_assert(device && device->stroker);
+    lx_stroker_cache_set(device->stroker, maxsize);
+}
+
 static lx_void_t lx_device_opengl_draw_clear(lx_device_ref_t self, lx_color_t color) {
     lx_glClearColor((lx_GLfloat_t)color.r / 0xff, (lx_GLfloat_t)color.g / 0xff, (lx_GLfloat_t)color.b / 0xff, (lx_GLfloat_t)color.a / 0xff);
     lx_glClear(LX_GL_COLOR_BUFFER_BIT);
@@ -128,13 +134,14 @@ lx_device_ref_t lx_device_init_from_opengl(lx_size_t width, lx_size_t height, lx
         lx_assert_and_check_break(device);
 
         device->base.draw_clear   = lx_device_opengl_draw_clear;
+        device->base.stroke_cache_set = lx_device_opengl_stroke_cache_set;
         device->base.draw_lines   = lx_device_opengl_draw_lines;
         device->base.draw_points  = lx_device_opengl_draw_points;
         device->base.draw_polygon = lx_device_opengl_draw_polygon;
         device->base.draw_path    = lx_device_opengl_draw_path;
         device->base.exit         = lx_device_opengl_exit;
-        device->base.width        = (lx_uint16_t)width;
-        device->base.height       = (lx_uint16_t)height;
+        device->base.width        = (lx_uint32_t)width;
+        device->base.height       = (lx_uint32_t)height;
 
         // init stroker
         device->stroker = lx_stroker_init();
@@ -307,7 +307,7 @@ static lx_inline lx_void_t lx_gl_renderer_apply_paint(lx_opengl_device_t* device
     }
 }
 
-static lx_inline lx_void_t lx_gl_renderer_draw_contour(lx_opengl_device_t* device, lx_point_ref_t points, lx_size_t index, lx_uint16_t count) {
+static lx_inline lx_void_t lx_gl_renderer_draw_contour(lx_opengl_device_t* device, lx_point_ref_t points, lx_size_t index, lx_uint32_t count) {
 #ifdef LX_GL_TESSELLATOR_TEST_ENABLE
     // enable blend
     lx_gl_renderer_enable_blend(device, lx_true);
@@ -364,9 +364,9 @@ static lx_inline lx_void_t lx_gl_renderer_fill_polygon(lx_opengl_device_t* devic
                 index += 4;
             }
         } else {
-            lx_uint16_t  count;
+            lx_uint32_t  count;
             lx_size_t    index = 0;
-            lx_uint16_t* counts = result->counts;
+            lx_uint32_t* counts = result->counts;
             while ((count = *counts++)) {
                 lx_gl_renderer_draw_contour(device, result->points + index, index, count);
                 index += count;
@@ -396,9 +396,9 @@ static lx_inline lx_void_t lx_gl_renderer_stroke_polygon(lx_opengl_device_t* dev
     lx_gl_renderer_apply_vertices(device, polygon->points, polygon->total);
 
     // draw vertices
-    lx_uint16_t  count;
+    lx_uint32_t  count;
     lx_size_t    index = 0;
-    lx_uint16_t* counts = polygon->counts;
+    lx_uint32_t* counts = polygon->counts;
     while ((count = *counts++)) {
         lx_glDrawArrays(LX_GL_LINE_STRIP, (lx_GLint_t)index, (lx_GLint_t)count);
         index += count;
@@ -438,7 +438,8 @@ static lx_inline lx_bool_t lx_gl_renderer_stroke_only(lx_opengl_device_t* device
     return (    1.0f == lx_paint_stroke_width(device->base.paint)
             &&  1.0f == lx_abs(device->base.matrix->sx)
             &&  1.0f == lx_abs(device->base.matrix->sy)
-            &&  !device->shader);
+            &&  !device->shader
+            &&  !lx_paint_stroke_dash(device->base.paint, lx_null, lx_null));
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -483,14 +484,14 @@ lx_void_t lx_gl_renderer_draw_path(lx_opengl_device_t* device, lx_path_ref_t pat
 
     lx_size_t mode = lx_paint_mode(device->base.paint);
     if (mode & LX_PAINT_MODE_FILL) {
-        lx_gl_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+        lx_gl_renderer_draw_polygon(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_path_hint(path), lx_path_bounds(path));
     }
 
     if ((mode & LX_PAINT_MODE_STROKE) && (lx_paint_stroke_width(device->base.paint) > 0)) {
         if (lx_gl_renderer_stroke_only(device)) {
-            lx_gl_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+            lx_gl_renderer_draw_polygon(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_path_hint(path), lx_path_bounds(path));
         } else {
-            lx_gl_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, path));
+            lx_gl_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, device->base.matrix, path));
         }
     }
 }
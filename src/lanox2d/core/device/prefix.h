@@ -35,8 +35,8 @@
 
 // the device type
 typedef struct lx_device_t_ {
-    lx_uint16_t         width;
-    lx_uint16_t         height;
+    lx_uint32_t         width;
+    lx_uint32_t         height;
     lx_paint_ref_t      paint;
     lx_matrix_ref_t     matrix;
     lx_clipper_ref_t    clipper;
@@ -47,6 +47,7 @@ typedef struct lx_device_t_ {
     lx_void_t           (*draw_polygon)(lx_device_ref_t device, lx_polygon_ref_t polygon, lx_shape_ref_t hint, lx_rect_ref_t bounds);
     lx_bool_t           (*draw_lock)(lx_device_ref_t device);
     lx_void_t           (*draw_commit)(lx_device_ref_t device);
+    lx_void_t           (*stroke_cache_set)(lx_device_ref_t device, lx_size_t maxsize);
     lx_void_t           (*exit)(lx_device_ref_t device);
 }lx_device_t;
 
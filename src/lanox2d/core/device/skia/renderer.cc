@@ -361,10 +361,10 @@ lx_void_t lx_skia_renderer_draw_polygon(lx_skia_device_t* device, lx_polygon_ref
     sk_path->setFillType(lx_skia_renderer_path_fill_type(device));
 
     // draw polygon
-    lx_uint16_t     index = 0;
+    lx_uint32_t     index = 0;
     lx_point_ref_t  points = polygon->points;
-    lx_uint16_t*    counts = polygon->counts;
-    lx_uint16_t     count = *counts++;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count = *counts++;
     while (index < count) {
         if (index == 0) {
             sk_path->moveTo(points[index].x, points[index].y);
@@ -55,6 +55,12 @@ static lx_void_t lx_device_vulkan_draw_commit(lx_device_ref_t self) {
     lx_vk_renderer_draw_commit((lx_vulkan_device_t*)self);
 }
 
+static lx_void_t lx_device_vulkan_stroke_cache_set(lx_device_ref_t self, lx_size_t maxsize) {
+    lx_vulkan_device_t* device = (lx_vulkan_device_t*)self;
+    lx_assert(device && device->stroker);
+    lx_stroker_cache_set(device->stroker, maxsize);
+}
+
 static lx_void_t lx_device_vulkan_draw_clear(lx_device_ref_t self, lx_color_t color) {
     lx_vk_renderer_draw_clear((lx_vulkan_device_t*)self, color);
 }
@@ -503,6 +509,7 @@ lx_device_ref_t lx_device_init_from_vulkan(lx_size_t width, lx_size_t height, lx
         device->base.draw_lock    = lx_device_vulkan_draw_lock;
         device->base.draw_commit  = lx_device_vulkan_draw_commit;
         device->base.draw_clear   = lx_device_vulkan_draw_clear;
+        device->base.stroke_cache_set = lx_device_vulkan_stroke_cache_set;
         device->base.draw_lines   = lx_device_vulkan_draw_lines;
         device->base.draw_points  = lx_device_vulkan_draw_points;
         device->base.draw_polygon = lx_device_vulkan_draw_polygon;
@@ -363,9 +363,9 @@ static lx_inline lx_void_t lx_vk_renderer_stroke_polygon(lx_vulkan_device_t* dev
 		lx_vk_buffer_allocator_copy(device->allocator_vertex, &vertex_buffer, 0, (lx_pointer_t)polygon->points, size);
 		lx_array_insert_tail(device->vertex_buffers, &vertex_buffer);
 
-        lx_uint16_t  count;
+        lx_uint32_t  count;
         lx_size_t    index = 0;
-        lx_uint16_t* counts = polygon->counts;
+        lx_uint32_t* counts = polygon->counts;
         lx_vk_command_buffer_ref_t cmdbuffer = device->renderer_cmdbuffer;
         while ((count = *counts++)) {
             VkDeviceSize offset = index * sizeof(lx_point_t);
@@ -409,6 +409,7 @@ static lx_inline lx_bool_t lx_vk_renderer_stroke_only(lx_vulkan_device_t* device
     return (    1.0f == lx_paint_stroke_width(device->base.paint)
         &&  1.0f == lx_abs(device->base.matrix->sx)
         &&  1.0f == lx_abs(device->base.matrix->sy)
+        &&  !lx_paint_stroke_dash(device->base.paint, lx_null, lx_null)
         /*&&  !device->shader*/);
 }
 
@@ -545,14 +546,14 @@ lx_void_t lx_vk_renderer_draw_path(lx_vulkan_device_t* device, lx_path_ref_t pat
 
     lx_size_t mode = lx_paint_mode(device->base.paint);
     if (mode & LX_PAINT_MODE_FILL) {
-        lx_vk_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+        lx_vk_renderer_draw_polygon(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_path_hint(path), lx_path_bounds(path));
     }
 
     if ((mode & LX_PAINT_MODE_STROKE) && (lx_paint_stroke_width(device->base.paint) > 0)) {
         if (lx_vk_renderer_stroke_only(device)) {
-            lx_vk_renderer_draw_polygon(device, lx_path_polygon(path), lx_path_hint(path), lx_path_bounds(path));
+            lx_vk_renderer_draw_polygon(device, lx_path_polygon_for_matrix(path, device->base.matrix), lx_path_hint(path), lx_path_bounds(path));
         } else {
-            lx_vk_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, path));
+            lx_vk_renderer_stroke_fill(device, lx_stroker_make_from_path(device->stroker, device->base.paint, device->base.matrix, path));
         }
     }
 }
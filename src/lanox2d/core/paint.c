@@ -24,6 +24,7 @@
  */
 #include "paint.h"
 #include "quality.h"
+#include "private/paint.h"
 #include "private/stroker.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -39,6 +40,9 @@
 // the default rule
 #define LX_PAINT_DEFAULT_RULE               LX_PAINT_FILL_RULE_ODD
 
+// the default blend mode
+#define LX_PAINT_DEFAULT_BLEND_MODE         LX_PAINT_BLEND_MODE_SRC_OVER
+
 // the default width
 #define LX_PAINT_DEFAULT_WIDTH              1.0f
 
@@ -48,24 +52,6 @@
 // the default miter limit
 #define LX_PAINT_DEFAULT_MITER              LX_STROKER_DEFAULT_MITER
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types
- */
-
-// the paint type
-typedef struct lx_paint_t_ {
-    lx_uint32_t      mode    : 4;
-    lx_uint32_t      flags   : 4;
-    lx_uint32_t      cap     : 4;
-    lx_uint32_t      join    : 4;
-    lx_uint32_t      rule    : 1;
-    lx_color_t       color;
-    lx_byte_t        alpha;
-    lx_float_t       width;
-    lx_float_t       miter;
-    lx_shader_ref_t shader;
-}lx_paint_t;
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -104,10 +90,13 @@ lx_void_t lx_paint_clear(lx_paint_ref_t self) {
         paint->cap   = LX_PAINT_DEFAULT_CAP;
         paint->join  = LX_PAINT_DEFAULT_JOIN;
         paint->rule  = LX_PAINT_DEFAULT_RULE;
+        paint->blend = LX_PAINT_DEFAULT_BLEND_MODE;
         paint->width = LX_PAINT_DEFAULT_WIDTH;
         paint->color = LX_COLOR_DEFAULT;
         paint->alpha = LX_PAINT_DEFAULT_ALPHA;
         paint->miter = LX_PAINT_DEFAULT_MITER;
+        paint->dash_count = 0;
+        paint->dash_phase = 0;
     }
 }
 
@@ -142,7 +131,7 @@ lx_size_t lx_paint_flags(lx_paint_ref_t self) {
     return LX_PAINT_FLAG_NONE;
 }
 
-lx_void_t lx_paint_flag_set(lx_paint_ref_t self, lx_size_t flags) {
+lx_void_t lx_paint_flags_set(lx_paint_ref_t self, lx_size_t flags) {
     lx_paint_t* paint = (lx_paint_t*)self;
     if (paint) {
         paint->flags = (lx_uint32_t)flags;
@@ -234,6 +223,45 @@ lx_void_t lx_paint_stroke_miter_set(lx_paint_ref_t self, lx_float_t miter) {
     }
 }
 
+lx_size_t lx_paint_stroke_dash(lx_paint_ref_t self, lx_float_t const** intervals, lx_float_t* phase) {
+    lx_paint_t* paint = (lx_paint_t*)self;
+    lx_check_return_val(paint && paint->dash_count, 0);
+
+    if (intervals) *intervals = paint->dash;
+    if (phase) *phase = paint->dash_phase;
+    return paint->dash_count;
+}
+
+lx_void_t lx_paint_stroke_dash_set(lx_paint_ref_t self, lx_float_t const* intervals, lx_size_t count, lx_float_t phase) {
+    lx_paint_t* paint = (lx_paint_t*)self;
+    lx_assert_and_check_return(paint);
+
+    // clear the dash intervals first, it's solid now
+    paint->dash_count = 0;
+    paint->dash_phase = 0;
+    lx_check_return(intervals && count);
+
+    // repeat the odd intervals twice
+    lx_size_t total = (count & 0x1)? (count << 1) : count;
+    lx_assert_and_check_return(total <= LX_PAINT_STROKE_DASH_MAXN);
+
+    // the intervals need be finite and not negative, and the pattern cannot be empty
+    lx_size_t  i;
+    lx_float_t length = 0;
+    for (i = 0; i < count; i++) {
+        lx_assert_and_check_return(intervals[i] >= 0 && lx_isfinf(intervals[i]));
+        length += intervals[i];
+    }
+    lx_check_return(length > 0);
+
+    // save the dash intervals
+    for (i = 0; i < total; i++) {
+        paint->dash[i] = intervals[i % count];
+    }
+    paint->dash_count = (lx_uint8_t)total;
+    paint->dash_phase = lx_isfinf(phase)? phase : 0;
+}
+
 lx_size_t lx_paint_fill_rule(lx_paint_ref_t self) {
     lx_paint_t* paint = (lx_paint_t*)self;
     return paint? paint->rule : LX_PAINT_DEFAULT_RULE;
@@ -246,3 +274,16 @@ lx_void_t lx_paint_fill_rule_set(lx_paint_ref_t self, lx_size_t rule) {
     }
 }
 
+
+lx_size_t lx_paint_blend_mode(lx_paint_ref_t self) {
+    lx_paint_t* paint = (lx_paint_t*)self;
+    return paint? paint->blend : LX_PAINT_DEFAULT_BLEND_MODE;
+}
+
+lx_void_t lx_paint_blend_mode_set(lx_paint_ref_t self, lx_size_t mode) {
+    lx_paint_t* paint = (lx_paint_t*)self;
+    if (paint) {
+        lx_assert(mode < LX_PAINT_BLEND_MODE_MAXN);
+        paint->blend = (lx_uint32_t)mode;
+    }
+}
@@ -31,6 +31,13 @@
  */
 lx_extern_c_enter
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the max count of the stroke dash intervals
+#define LX_PAINT_STROKE_DASH_MAXN       (16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -70,6 +77,32 @@ typedef enum lx_paint_fill_rule_e_ {
 ,   LX_PAINT_FILL_RULE_NONZERO  = 1 //!< non-zero fill
 }lx_paint_fill_rule_e;
 
+/*! the paint blend mode enum
+ *
+ * the porter-duff and separable blend modes, s: the source color, d: the destination color,
+ * sa and da are their alphas, and all colors are premultiplied.
+ */
+typedef enum lx_paint_blend_mode_e_ {
+    LX_PAINT_BLEND_MODE_SRC_OVER    = 0     //!< s + d * (1 - sa)
+,   LX_PAINT_BLEND_MODE_CLEAR       = 1     //!< 0
+,   LX_PAINT_BLEND_MODE_SRC         = 2     //!< s
+,   LX_PAINT_BLEND_MODE_DST         = 3     //!< d
+,   LX_PAINT_BLEND_MODE_DST_OVER    = 4     //!< d + s * (1 - da)
+,   LX_PAINT_BLEND_MODE_SRC_IN      = 5     //!< s * da
+,   LX_PAINT_BLEND_MODE_DST_IN      = 6     //!< d * sa
+,   LX_PAINT_BLEND_MODE_SRC_OUT     = 7     //!< s * (1 - da)
+,   LX_PAINT_BLEND_MODE_DST_OUT     = 8     //!< d * (1 - sa)
+,   LX_PAINT_BLEND_MODE_SRC_ATOP    = 9     //!< s * da + d * (1 - sa)
+,   LX_PAINT_BLEND_MODE_DST_ATOP    = 10    //!< d * sa + s * (1 - da)
+,   LX_PAINT_BLEND_MODE_XOR         = 11    //!< s * (1 - da) + d * (1 - sa)
+,   LX_PAINT_BLEND_MODE_PLUS        = 12    //!< min(s + d, 1)
+,   LX_PAINT_BLEND_MODE_MULTIPLY    = 13    //!< s * (1 - da) + d * (1 - sa) + s * d
+,   LX_PAINT_BLEND_MODE_SCREEN      = 14    //!< s + d - s * d
+,   LX_PAINT_BLEND_MODE_DARKEN      = 15    //!< s + d - max(s * da, d * sa)
+,   LX_PAINT_BLEND_MODE_LIGHTEN     = 16    //!< s + d - min(s * da, d * sa)
+,   LX_PAINT_BLEND_MODE_MAXN        = 17
+}lx_paint_blend_mode_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -254,6 +287,33 @@ lx_float_t          lx_paint_stroke_miter(lx_paint_ref_t paint);
  */
 lx_void_t           lx_paint_stroke_miter_set(lx_paint_ref_t paint, lx_float_t miter);
 
+/*! get the stroke dash intervals
+ *
+ * @param paint     the paint
+ * @param intervals the dash intervals pointer, optional
+ * @param phase     the dash phase pointer, optional
+ *
+ * @return          the intervals count, it's zero if the stroke is solid
+ */
+lx_size_t           lx_paint_stroke_dash(lx_paint_ref_t paint, lx_float_t const** intervals, lx_float_t* phase);
+
+/*! set the stroke dash intervals
+ *
+ * the even intervals are the lengths of the dashes and the odd intervals are the lengths of the gaps,
+ * they will be repeated twice if the count is odd, e.g. [5, 3, 2] => [5, 3, 2, 5, 3, 2]
+ *
+ * @code
+ * lx_float_t intervals[] = {10, 5};
+ * lx_paint_stroke_dash_set(paint, intervals, 2, 0);
+ * @endcode
+ *
+ * @param paint     the paint
+ * @param intervals the dash intervals in the user space, the stroke will be solid if it's null
+ * @param count     the intervals count, the repeated count cannot be larger than LX_PAINT_STROKE_DASH_MAXN
+ * @param phase     the offset into the intervals at the start of each contour
+ */
+lx_void_t           lx_paint_stroke_dash_set(lx_paint_ref_t paint, lx_float_t const* intervals, lx_size_t count, lx_float_t phase);
+
 /*! get the fill rule
  *
  * @param paint     the paint
@@ -269,6 +329,23 @@ lx_size_t           lx_paint_fill_rule(lx_paint_ref_t paint);
  */
 lx_void_t           lx_paint_fill_rule_set(lx_paint_ref_t paint, lx_size_t rule);
 
+/*! get the blend mode
+ *
+ * @param paint     the paint
+ *
+ * @return          the blend mode
+ */
+lx_size_t           lx_paint_blend_mode(lx_paint_ref_t paint);
+
+/*! set the blend mode
+ *
+ * @note only the bitmap device supports the blend modes now, the other devices always use src-over
+ *
+ * @param paint     the paint
+ * @param mode      the blend mode
+ */
+lx_void_t           lx_paint_blend_mode_set(lx_paint_ref_t paint, lx_size_t mode);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -24,6 +24,7 @@
  */
 #define LX_TRACE_DISABLED
 #include "path.h"
+#include "quality.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -36,9 +37,32 @@
 #   define LX_PATH_POINTS_GROW      (64)
 #endif
 
+// the min and max scale class of the flattened polygon, 2^-16 ~ 2^16
+#define LX_PATH_POLYGON_SCALE_MIN   (-16)
+#define LX_PATH_POLYGON_SCALE_MAX   (16)
+
+// the max count of the cached polygons for the different scale classes
+#ifdef LX_CONFIG_SMALL
+#   define LX_PATH_POLYGON_CACHE_MAXN   (2)
+#else
+#   define LX_PATH_POLYGON_CACHE_MAXN   (4)
+#endif
+
 // the point step for code
 #define lx_path_point_step(code)    ((code) < 1? 1 : (code) - 1)
 
+/* the path iterator, itor: code_index | point_index
+ *
+ * the code index is stored in the high half bits and the point index is stored in the low half bits,
+ * so we can iterate over 2^32 points on the 64-bits platform.
+ */
+#define LX_PATH_ITOR_BITS           (LX_CPU_BITSIZE >> 1)
+#define LX_PATH_ITOR_MASK           (((lx_size_t)1 << LX_PATH_ITOR_BITS) - 1)
+#define LX_PATH_ITOR_CODE_ONE       ((lx_size_t)1 << LX_PATH_ITOR_BITS)
+#define lx_path_itor_make(c, p)     (((lx_size_t)(c) << LX_PATH_ITOR_BITS) | (lx_size_t)(p))
+#define lx_path_itor_code(itor)     ((itor) >> LX_PATH_ITOR_BITS)
+#define lx_path_itor_point(itor)    ((itor) & LX_PATH_ITOR_MASK)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -56,6 +80,17 @@ typedef enum lx_path_flag_e_ {
 ,   LX_PATH_FLAG_SINGLE        = 128   //< single contour?
 }lx_path_flag_e;
 
+// the cached polygon type of path for the given scale class and quality
+typedef struct lx_path_polygon_t_ {
+    lx_polygon_t        polygon;
+    lx_array_ref_t      points;
+    lx_array_ref_t      counts;
+    lx_size_t           used;
+    lx_int8_t           scale;
+    lx_uint8_t          quality;
+    lx_bool_t           valid;
+}lx_path_polygon_t;
+
 // the path type
 typedef struct lx_path_t_ {
     lx_iterator_base_t  base;
@@ -66,11 +101,24 @@ typedef struct lx_path_t_ {
     lx_path_item_t      item;
     lx_array_ref_t      codes;
     lx_array_ref_t      points;
-    lx_polygon_t        polygon;
-    lx_array_ref_t      polygon_points;
-    lx_array_ref_t      polygon_counts;
+    lx_path_polygon_t   polygons[LX_PATH_POLYGON_CACHE_MAXN];
+    lx_size_t           polygons_used;
+    lx_size_t           generation;
 }lx_path_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the generation counter of all paths
+ *
+ * each modified path gets a new generation, so the generations of the different path objects
+ * at the same address will not be equal after exiting and reallocating it.
+ *
+ * the paths may be modified in the different threads, so it need be increased atomically.
+ */
+static lx_atomic_t g_path_generation = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -81,9 +129,14 @@ static lx_inline lx_bool_t lx_path_is_last_code(lx_path_t* path, lx_uint8_t code
     return pcode? *pcode == code : lx_false;
 }
 
+static lx_inline lx_void_t lx_path_update_generation(lx_path_t* path) {
+    path->generation = lx_atomic_fetch_and_add(&g_path_generation, 1) + 1;
+}
+
 static lx_inline lx_void_t lx_path_insert_code(lx_path_t* path, lx_uint8_t code) {
     lx_assert(path->codes);
     lx_array_insert_tail(path->codes, &code);
+    lx_path_update_generation(path);
 }
 
 static lx_bool_t lx_path_make_hint(lx_path_t* path) {
@@ -379,68 +432,119 @@ static lx_void_t lx_path_make_quad_for_add_arc(lx_point_ref_t ctrl, lx_point_ref
     }
 }
 
-static lx_void_t lx_path_make_line_for_curve_to(lx_point_ref_t point, lx_cpointer_t udata) {
-    lx_value_t* values = (lx_value_t*)udata;
-    lx_assert(values && point);
-
-    // the polygon points
-    lx_array_ref_t polygon_points = (lx_array_ref_t)values[0].ptr;
-    lx_assert(polygon_points);
+/* get the scale class of the flattened polygon for the given matrix
+ *
+ * the curves are flattened with the scale 2^class (>= the max scale of the matrix),
+ * so the polygon can be reused for all matrices in the same octave.
+ */
+static lx_int8_t lx_path_polygon_scale(lx_matrix_ref_t matrix) {
+    lx_check_return_val(matrix, 0);
+    lx_float_t sx = matrix->sx * matrix->sx + matrix->ky * matrix->ky;
+    lx_float_t sy = matrix->kx * matrix->kx + matrix->sy * matrix->sy;
+    lx_float_t scale = lx_max(sx, sy) * 0.999f; // ignore the rounding error of the rotated matrix
+    lx_int8_t  value = 0;
+    if (scale > 1.0f) {
+        while (scale > 1.0f && value < LX_PATH_POLYGON_SCALE_MAX) {
+            scale *= 0.25f;
+            value++;
+        }
+    } else {
+        while (scale <= 0.25f && value > LX_PATH_POLYGON_SCALE_MIN) {
+            scale *= 4.0f;
+            value--;
+        }
+    }
+    return value;
+}
 
-    // append point
-    lx_array_insert_tail(polygon_points, point);
-    values[1].u16++;
+/* get the flattening scale of the given scale class and the current quality
+ *
+ * we bound the flattening error in the device space, and allow twice error for each lower quality level.
+ */
+static lx_float_t lx_path_polygon_flatten_scale(lx_int8_t scale, lx_size_t quality) {
+    lx_float_t factor = scale >= 0? (lx_float_t)(1 << scale) : 1.0f / (lx_float_t)(1 << -scale);
+    if (quality < LX_QUALITY_TOP) {
+        factor /= (lx_float_t)(1 << (LX_QUALITY_TOP - quality));
+    }
+    return factor;
 }
 
-static lx_bool_t lx_path_make_polygon(lx_path_t* path) {
-    lx_assert_and_check_return_val(path && path->codes && path->points, lx_false);
+static lx_bool_t lx_path_make_polygon(lx_path_t* path, lx_path_polygon_t* cache, lx_float_t scale) {
+    lx_assert_and_check_return_val(path && path->codes && path->points && cache, lx_false);
 
     // init polygon counts
-    if (!path->polygon_counts) {
-        path->polygon_counts = lx_array_init(8, lx_element_mem(sizeof(lx_uint16_t), lx_null, lx_null));
+    if (!cache->counts) {
+        cache->counts = lx_array_init(8, lx_element_mem(sizeof(lx_uint32_t), lx_null, lx_null));
     }
-    lx_assert_and_check_return_val(path->polygon_counts, lx_false);
+    lx_assert_and_check_return_val(cache->counts, lx_false);
 
     // have curve?
     lx_size_t total_count = 0;
     if (path->flags & LX_PATH_FLAG_CURVE) {
 
         // init polygon points
-        if (!path->polygon_points) {
-            path->polygon_points = lx_array_init(lx_array_size(path->points), lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+        if (!cache->points) {
+            cache->points = lx_array_init(lx_array_size(path->points), lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
         }
-        lx_assert_and_check_return_val(path->polygon_points, lx_false);
+        lx_assert_and_check_return_val(cache->points, lx_false);
 
-        // clear polygon points and counts
-        lx_array_clear(path->polygon_points);
-        lx_array_clear(path->polygon_counts);
+        // compute the total points count of all flattened curves first, so we need not grow the points for each curve
+        lx_size_t points_count = 0;
+        lx_for_all (lx_path_item_ref_t, curve_item, path) {
+            switch (curve_item->code) {
+            case LX_PATH_CODE_MOVE:
+            case LX_PATH_CODE_LINE:
+                points_count++;
+                break;
+            case LX_PATH_CODE_QUAD:
+                points_count += (lx_size_t)1 << lx_bezier2_divide_line_count_scaled(curve_item->points, scale);
+                break;
+            case LX_PATH_CODE_CUBIC:
+                points_count += (lx_size_t)1 << lx_bezier3_divide_line_count_scaled(curve_item->points, scale);
+                break;
+            case LX_PATH_CODE_CLOSE:
+            default:
+                break;
+            }
+        }
+
+        // clear polygon counts and resize polygon points
+        lx_array_clear(cache->counts);
+        lx_check_return_val(lx_array_resize(cache->points, points_count), lx_false);
 
-        // init values
-        lx_value_t values[2];
-        values[0].ptr = (lx_pointer_t)path->polygon_points;
-        values[1].u16 = 0;
+        // make the polygon points to the output buffer directly
+        lx_point_ref_t output = (lx_point_ref_t)lx_array_data(cache->points);
+        lx_uint32_t    count  = 0;
+        lx_size_t      n      = 0;
+        lx_assert_and_check_return_val(output, lx_false);
         lx_for_all (lx_path_item_ref_t, item, path) {
             switch (item->code) {
             case LX_PATH_CODE_MOVE: {
-                if (values[1].u16) {
-                    lx_array_insert_tail(path->polygon_counts, &values[1].u16);
-                    total_count += values[1].u16;
+                if (count) {
+                    lx_array_insert_tail(cache->counts, &count);
+                    total_count += count;
                 }
-                lx_array_insert_tail(path->polygon_points, &item->points[0]);
-                values[1].u16 = 1;
+                *output++ = item->points[0];
+                count = 1;
                 break;
             }
             case LX_PATH_CODE_LINE: {
-                lx_array_insert_tail(path->polygon_points, &item->points[1]);
-                values[1].u16++;
+                *output++ = item->points[1];
+                count++;
                 break;
             }
             case LX_PATH_CODE_QUAD: {
-                lx_bezier2_make_line(item->points, lx_path_make_line_for_curve_to, values);
+                n = lx_bezier2_divide_line_count_scaled(item->points, scale);
+                n = lx_bezier2_make_line_points(item->points, n, output);
+                output += n;
+                count += (lx_uint32_t)n;
                 break;
             }
             case LX_PATH_CODE_CUBIC: {
-                lx_bezier3_make_line(item->points, lx_path_make_line_for_curve_to, values);
+                n = lx_bezier3_divide_line_count_scaled(item->points, scale);
+                n = lx_bezier3_make_line_points(item->points, n, output);
+                output += n;
+                count += (lx_uint32_t)n;
                 break;
             }
             case LX_PATH_CODE_CLOSE:
@@ -448,64 +552,64 @@ static lx_bool_t lx_path_make_polygon(lx_path_t* path) {
                 break;
             }
         }
+        lx_assert(output == (lx_point_ref_t)lx_array_data(cache->points) + points_count);
 
         // append the last count
-        if (values[1].u16) {
-            lx_array_insert_tail(path->polygon_counts, &values[1].u16);
-            total_count += values[1].u16;
-            values[1].u16 = 0;
+        if (count) {
+            lx_array_insert_tail(cache->counts, &count);
+            total_count += count;
         }
 
         // append the tail count
-        lx_uint16_t zero = 0;
-        lx_array_insert_tail(path->polygon_counts, &zero);
+        count = 0;
+        lx_array_insert_tail(cache->counts, &count);
 
         // init polygon
-        path->polygon.points = (lx_point_ref_t)lx_array_data(path->polygon_points);
-        path->polygon.counts = (lx_uint16_t*)lx_array_data(path->polygon_counts);
+        cache->polygon.points = (lx_point_ref_t)lx_array_data(cache->points);
+        cache->polygon.counts = (lx_uint32_t*)lx_array_data(cache->counts);
     }
     // only move-to and line-to? using the points directly
     else {
         // init polygon counts
-        lx_uint16_t count = 0;
-        lx_array_clear(path->polygon_counts);
+        lx_uint32_t count = 0;
+        lx_array_clear(cache->counts);
         lx_for_all (lx_uint8_t*, pcode, path->codes) {
             lx_uint8_t code = *pcode;
             lx_assert(code >= 0 && code < LX_PATH_CODE_MAXN);
             if (code == LX_PATH_CODE_MOVE) {
                 if (count) {
-                    lx_array_insert_tail(path->polygon_counts, &count);
+                    lx_array_insert_tail(cache->counts, &count);
                     total_count += count;
                 }
                 count = 0;
             }
-            count += (lx_uint16_t)lx_path_point_step(code);
+            count += (lx_uint32_t)lx_path_point_step(code);
         }
 
         // append the last count
         if (count) {
-            lx_array_insert_tail(path->polygon_counts, &count);
+            lx_array_insert_tail(cache->counts, &count);
             total_count += count;
             count = 0;
         }
 
         // append the tail count
         count = 0;
-        lx_array_insert_tail(path->polygon_counts, &count);
+        lx_array_insert_tail(cache->counts, &count);
 
         // init polygon
-        path->polygon.points = (lx_point_ref_t)lx_array_data(path->points);
-        path->polygon.counts = (lx_uint16_t*)lx_array_data(path->polygon_counts);
+        cache->polygon.points = (lx_point_ref_t)lx_array_data(path->points);
+        cache->polygon.counts = (lx_uint32_t*)lx_array_data(cache->counts);
     }
 
     // check
-    lx_assert_and_check_return_val(path->polygon.points && path->polygon.counts, lx_false);
+    lx_assert_and_check_return_val(cache->polygon.points && cache->polygon.counts, lx_false);
 
     // save total count
-    path->polygon.total = total_count;
+    cache->polygon.total = total_count;
 
     // is convex polygon?
-    path->polygon.convex = lx_path_convex((lx_path_ref_t)path);
+    cache->polygon.convex = lx_path_convex((lx_path_ref_t)path);
     return lx_true;
 }
 
@@ -519,8 +623,8 @@ static lx_size_t lx_path_iterator_tail(lx_iterator_ref_t iterator) {
 
     lx_size_t code_tail  = lx_array_size(path->codes);
     lx_size_t point_tail = lx_array_size(path->points);
-    lx_assert(code_tail <= LX_MAXU16 && point_tail <= LX_MAXU16);
-    return ((code_tail << 16) | point_tail);
+    lx_assert(code_tail <= LX_PATH_ITOR_MASK && point_tail <= LX_PATH_ITOR_MASK);
+    return lx_path_itor_make(code_tail, point_tail);
 }
 
 static lx_size_t lx_path_iterator_next(lx_iterator_ref_t iterator, lx_size_t itor) {
@@ -528,14 +632,14 @@ static lx_size_t lx_path_iterator_next(lx_iterator_ref_t iterator, lx_size_t ito
     lx_assert(path && path->codes);
 
     // the code
-    lx_uint8_t* pcode = (lx_uint8_t*)lx_array_item(path->codes, itor >> 16);
+    lx_uint8_t* pcode = (lx_uint8_t*)lx_array_item(path->codes, lx_path_itor_code(itor));
     lx_uint8_t  code = *pcode;
     lx_assert(code < LX_PATH_CODE_MAXN);
 
     /* code_index++
      * point_index += point_step
      */
-    return itor + (0x10000 | lx_path_point_step(code));
+    return itor + (LX_PATH_ITOR_CODE_ONE | lx_path_point_step(code));
 }
 
 static lx_size_t lx_path_iterator_prev(lx_iterator_ref_t iterator, lx_size_t itor) {
@@ -543,20 +647,20 @@ static lx_size_t lx_path_iterator_prev(lx_iterator_ref_t iterator, lx_size_t ito
     lx_assert(path && path->codes);
 
     // check the code index
-    lx_assert(itor >> 16);
+    lx_assert(lx_path_itor_code(itor));
 
     // the code
-    lx_uint8_t* pcode = (lx_uint8_t*)lx_array_item(path->codes, (itor >> 16) - 1);
+    lx_uint8_t* pcode = (lx_uint8_t*)lx_array_item(path->codes, lx_path_itor_code(itor) - 1);
     lx_uint8_t  code = *pcode;
     lx_assert(code < LX_PATH_CODE_MAXN);
 
     // check the point index
-    lx_assert((itor & 0xffff) >= lx_path_point_step(code));
+    lx_assert(lx_path_itor_point(itor) >= lx_path_point_step(code));
 
     /* code_index--
      * point_index -= point_step
      */
-    return itor - (0x10000 | lx_path_point_step(code));
+    return itor - (LX_PATH_ITOR_CODE_ONE | lx_path_point_step(code));
 }
 
 static lx_pointer_t lx_path_iterator_item(lx_iterator_ref_t iterator, lx_size_t itor) {
@@ -564,8 +668,8 @@ static lx_pointer_t lx_path_iterator_item(lx_iterator_ref_t iterator, lx_size_t
     lx_assert(path && path->codes && path->points);
 
     // get code
-    lx_size_t   code_index  = itor >> 16;
-    lx_size_t   point_index = itor & 0xffff;
+    lx_size_t   code_index  = lx_path_itor_code(itor);
+    lx_size_t   point_index = lx_path_itor_point(itor);
     lx_uint8_t* pcode       = (lx_uint8_t*)lx_array_item(path->codes, code_index);
     lx_uint8_t  code        = *pcode;
     lx_assert(code < 1 || point_index);
@@ -604,6 +708,7 @@ lx_path_ref_t lx_path_init() {
         path->hint.type        = LX_SHAPE_TYPE_NONE;
         path->flags            = LX_PATH_FLAG_DIRTY_ALL | LX_PATH_FLAG_CLOSED | LX_PATH_FLAG_SINGLE;
         path->base.iterator_of = lx_path_iterator_of;
+        lx_path_update_generation(path);
 
         // init codes
         path->codes = lx_array_init(LX_PATH_POINTS_GROW >> 1, lx_element_mem(sizeof(lx_uint8_t), lx_null, lx_null));
@@ -628,13 +733,17 @@ lx_path_ref_t lx_path_init() {
 lx_void_t lx_path_exit(lx_path_ref_t self) {
     lx_path_t* path = (lx_path_t*)self;
     if (path) {
-        if (path->polygon_points) {
-            lx_array_exit(path->polygon_points);
-            path->polygon_points = lx_null;
-        }
-        if (path->polygon_counts) {
-            lx_array_exit(path->polygon_counts);
-            path->polygon_counts = lx_null;
+        lx_size_t i;
+        for (i = 0; i < LX_PATH_POLYGON_CACHE_MAXN; i++) {
+            lx_path_polygon_t* cache = &path->polygons[i];
+            if (cache->points) {
+                lx_array_exit(cache->points);
+                cache->points = lx_null;
+            }
+            if (cache->counts) {
+                lx_array_exit(cache->counts);
+                cache->counts = lx_null;
+            }
         }
         if (path->points) {
             lx_array_exit(path->points);
@@ -652,6 +761,7 @@ lx_void_t lx_path_clear(lx_path_ref_t self) {
     lx_path_t* path = (lx_path_t*)self;
     if (path) {
         path->flags = LX_PATH_FLAG_DIRTY_ALL | LX_PATH_FLAG_SINGLE;
+        lx_path_update_generation(path);
         if (path->codes) {
             lx_array_clear(path->codes);
         }
@@ -680,6 +790,7 @@ lx_void_t lx_path_copy(lx_path_ref_t self, lx_path_ref_t copied) {
     path->bounds = path_copied->bounds;
     lx_array_copy(path->codes, path_copied->codes);
     lx_array_copy(path->points, path_copied->points);
+    lx_path_update_generation(path);
 }
 
 lx_bool_t lx_path_empty(lx_path_ref_t self) {
@@ -688,6 +799,12 @@ lx_bool_t lx_path_empty(lx_path_ref_t self) {
     return lx_array_size(path->codes) == 0;
 }
 
+lx_size_t lx_path_generation(lx_path_ref_t self) {
+    lx_path_t* path = (lx_path_t*)self;
+    lx_assert_and_check_return_val(path, 0);
+    return path->generation;
+}
+
 lx_rect_ref_t lx_path_bounds(lx_path_ref_t self) {
     lx_path_t* path = (lx_path_t*)self;
     lx_assert_and_check_return_val(path && path->points, lx_null);
@@ -788,6 +905,7 @@ lx_void_t lx_path_last_set(lx_path_ref_t self, lx_point_ref_t point) {
     lx_assert_and_check_return(last);
 
     *last = *point;
+    lx_path_update_generation(path);
 }
 
 lx_shape_ref_t lx_path_hint(lx_path_ref_t self) {
@@ -808,6 +926,10 @@ lx_shape_ref_t lx_path_hint(lx_path_ref_t self) {
 }
 
 lx_polygon_ref_t lx_path_polygon(lx_path_ref_t self) {
+    return lx_path_polygon_for_matrix(self, lx_null);
+}
+
+lx_polygon_ref_t lx_path_polygon_for_matrix(lx_path_ref_t self, lx_matrix_ref_t matrix) {
     lx_path_t* path = (lx_path_t*)self;
     lx_assert_and_check_return_val(path, lx_null);
 
@@ -815,13 +937,47 @@ lx_polygon_ref_t lx_path_polygon(lx_path_ref_t self) {
         return lx_null;
     }
 
-    // polygon dirty? remake it
+    // polygon dirty? discard all cached polygons
+    lx_size_t i;
     if (path->flags & LX_PATH_FLAG_DIRTY_POLYGON) {
-        if (lx_path_make_polygon(path)) {
-            path->flags &= ~LX_PATH_FLAG_DIRTY_POLYGON;
+        for (i = 0; i < LX_PATH_POLYGON_CACHE_MAXN; i++) {
+            path->polygons[i].valid = lx_false;
         }
+        path->flags &= ~LX_PATH_FLAG_DIRTY_POLYGON;
     }
-    return &path->polygon;
+
+    /* find the cached polygon of this scale class and quality
+     *
+     * only the curves are flattened for the scale class, so all matrices share the same polygon of lines.
+     */
+    lx_int8_t  scale   = 0;
+    lx_size_t  quality = 0;
+    if (path->flags & LX_PATH_FLAG_CURVE) {
+        scale   = lx_path_polygon_scale(matrix);
+        quality = lx_quality();
+    }
+    lx_path_polygon_t* cache = lx_null;
+    for (i = 0; i < LX_PATH_POLYGON_CACHE_MAXN; i++) {
+        lx_path_polygon_t* item = &path->polygons[i];
+        if (item->valid && item->scale == scale && item->quality == quality) {
+            item->used = ++path->polygons_used;
+            return &item->polygon;
+        }
+
+        // we will remake the unused or the least recently used polygon if not found
+        if (!cache || !item->valid || (cache->valid && item->used < cache->used)) {
+            cache = item;
+        }
+    }
+
+    // make it
+    lx_assert(cache);
+    cache->valid = lx_path_make_polygon(path, cache, lx_path_polygon_flatten_scale(scale, quality));
+    lx_check_return_val(cache->valid, lx_null);
+    cache->scale   = scale;
+    cache->quality = (lx_uint8_t)quality;
+    cache->used    = ++path->polygons_used;
+    return &cache->polygon;
 }
 
 lx_void_t lx_path_apply(lx_path_ref_t self, lx_matrix_ref_t matrix) {
@@ -832,6 +988,7 @@ lx_void_t lx_path_apply(lx_path_ref_t self, lx_matrix_ref_t matrix) {
         lx_for_all(lx_point_ref_t, point, path->points) {
             lx_point_apply(point, matrix);
         }
+        lx_path_update_generation(path);
     }
 }
 
@@ -861,6 +1018,7 @@ lx_void_t lx_path_move_to(lx_path_ref_t self, lx_point_ref_t point)
     // replace the last point to avoid one alone move-to point
     if (lx_path_is_last_code(path, LX_PATH_CODE_MOVE)) {
         lx_array_replace_last(path->points, point);
+        lx_path_update_generation(path);
     } else {
         // move-to
         lx_path_insert_code(path, LX_PATH_CODE_MOVE);
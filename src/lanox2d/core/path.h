@@ -102,6 +102,16 @@ lx_void_t           lx_path_copy(lx_path_ref_t path, lx_path_ref_t copied);
  */
 lx_bool_t           lx_path_empty(lx_path_ref_t path);
 
+/*! the path generation
+ *
+ * it will be changed after modifying the path, so we can use it to cache the data made from this path.
+ *
+ * @param path      the path
+ *
+ * @return          the generation
+ */
+lx_size_t           lx_path_generation(lx_path_ref_t path);
+
 /*! the path bounds
  *
  * @param path      the path
@@ -158,6 +168,21 @@ lx_shape_ref_t      lx_path_hint(lx_path_ref_t path);
  */
 lx_polygon_ref_t    lx_path_polygon(lx_path_ref_t path);
 
+/*! the path polygon for drawing with the given matrix
+ *
+ * the curves are flattened with the error bounded in the device space by the max scale of the matrix
+ * and the current quality, so it will make less edges for the zoomed-out path.
+ *
+ * the polygons of a few recently used scale classes are cached, so drawing the same path
+ * with the different zoom levels alternately need not flatten it again.
+ *
+ * @param path      the path
+ * @param matrix    the matrix, using the identity matrix if be null
+ *
+ * @return          the polygon
+ */
+lx_polygon_ref_t    lx_path_polygon_for_matrix(lx_path_ref_t path, lx_matrix_ref_t matrix);
+
 /*! apply the matrix to the path
  *
  * @param path      the path
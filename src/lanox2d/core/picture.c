@@ -0,0 +1,539 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        picture.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "picture.h"
+#include "path.h"
+#include "paint.h"
+#include "device.h"
+#include "canvas.h"
+#include "clipper.h"
+#include "device/prefix.h"
+#include "private/paint.h"
+#include "private/canvas.h"
+#include "private/clipper.h"
+#include "../base/base.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk size of arena
+#ifdef LX_CONFIG_SMALL
+#   define LX_PICTURE_CHUNK_SIZE        (4096)
+#else
+#   define LX_PICTURE_CHUNK_SIZE        (16384)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the picture command type enum
+typedef enum lx_picture_cmd_type_e_ {
+    LX_PICTURE_CMD_TYPE_CLEAR       = 0
+,   LX_PICTURE_CMD_TYPE_PATH        = 1
+,   LX_PICTURE_CMD_TYPE_LINES       = 2
+,   LX_PICTURE_CMD_TYPE_POINTS      = 3
+,   LX_PICTURE_CMD_TYPE_POLYGON     = 4
+}lx_picture_cmd_type_e;
+
+// the picture command type
+typedef struct lx_picture_cmd_t_ {
+
+    // the next command
+    struct lx_picture_cmd_t_*   next;
+
+    // the command type
+    lx_size_t                   type;
+
+    // the paint and matrix, they are shared by the adjacent commands with the same state
+    lx_paint_t const*           paint;
+    lx_matrix_t const*          matrix;
+
+    // the clipper, it's shared by the adjacent commands with the same clipper and it's null if no clip
+    lx_clipper_ref_t            clipper;
+
+    // the bounds and hint, it may be null
+    lx_rect_ref_t               bounds;
+    lx_shape_ref_t              hint;
+
+    // the command data
+    union {
+        lx_color_t              color;
+        lx_path_ref_t           path;
+        struct {
+            lx_point_ref_t      data;
+            lx_size_t           count;
+        }                       points;
+        lx_polygon_t            polygon;
+    }u;
+
+}lx_picture_cmd_t;
+
+/* the arena chunk type
+ *
+ * chunk: [head][data .......................]
+ */
+typedef struct lx_picture_chunk_t_ {
+
+    // the next chunk
+    struct lx_picture_chunk_t_* next;
+
+    // the used size of data
+    lx_size_t                   size;
+
+    // the maximum size of data
+    lx_size_t                   maxn;
+
+}lx_picture_chunk_t;
+
+// the picture type
+typedef struct lx_picture_t_ {
+
+    // the arena chunks, we only free them when exiting picture
+    lx_picture_chunk_t*         chunks;
+
+    // the current chunk
+    lx_picture_chunk_t*         chunk;
+
+    // the commands
+    lx_picture_cmd_t*           head;
+    lx_picture_cmd_t*           tail;
+    lx_size_t                   size;
+
+    // the last recorded paint, matrix and clipper
+    lx_paint_t const*           paint;
+    lx_matrix_t const*          matrix;
+    lx_clipper_ref_t            clipper;
+
+}lx_picture_t;
+
+// the picture device type
+typedef struct lx_picture_device_t_ {
+    lx_device_t                 base;
+    lx_picture_t*               picture;
+}lx_picture_device_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static lx_pointer_t lx_picture_arena_malloc(lx_picture_t* picture, lx_size_t size) {
+    lx_assert(picture && size);
+
+    // align size
+    size = lx_align8(size);
+
+    // find a chunk with enough space, all chunks will be reused after clearing picture
+    lx_picture_chunk_t* chunk = picture->chunk;
+    while (chunk && chunk->size + size > chunk->maxn) {
+        chunk = chunk->next;
+    }
+
+    // make a new chunk
+    if (!chunk) {
+        lx_size_t maxn = lx_max(size, LX_PICTURE_CHUNK_SIZE);
+        chunk = (lx_picture_chunk_t*)lx_malloc(lx_align8(sizeof(lx_picture_chunk_t)) + maxn);
+        lx_assert_and_check_return_val(chunk, lx_null);
+
+        chunk->size = 0;
+        chunk->maxn = maxn;
+
+        // insert it after the current chunk
+        if (picture->chunk) {
+            chunk->next = picture->chunk->next;
+            picture->chunk->next = chunk;
+        } else {
+            chunk->next = picture->chunks;
+            picture->chunks = chunk;
+        }
+    }
+    picture->chunk = chunk;
+
+    // allocate data from the chunk
+    lx_byte_t* data = (lx_byte_t*)chunk + lx_align8(sizeof(lx_picture_chunk_t)) + chunk->size;
+    chunk->size += size;
+    return data;
+}
+
+static lx_pointer_t lx_picture_arena_memdup(lx_picture_t* picture, lx_cpointer_t data, lx_size_t size) {
+    lx_pointer_t copied = lx_picture_arena_malloc(picture, size);
+    if (copied) {
+        lx_memcpy(copied, data, size);
+    }
+    return copied;
+}
+
+static lx_bool_t lx_picture_paint_equal(lx_paint_t const* paint, lx_paint_t const* other) {
+    return  paint->mode == other->mode && paint->flags == other->flags
+        &&  paint->cap == other->cap && paint->join == other->join
+        &&  paint->rule == other->rule && paint->blend == other->blend
+        &&  paint->color.a == other->color.a && paint->color.r == other->color.r
+        &&  paint->color.g == other->color.g && paint->color.b == other->color.b
+        &&  paint->alpha == other->alpha && paint->width == other->width
+        &&  paint->miter == other->miter && paint->shader == other->shader
+        &&  paint->dash_count == other->dash_count && paint->dash_phase == other->dash_phase
+        &&  !lx_memcmp(paint->dash, other->dash, paint->dash_count * sizeof(lx_float_t));
+}
+
+static lx_bool_t lx_picture_matrix_equal(lx_matrix_t const* matrix, lx_matrix_t const* other) {
+    return  matrix->sx == other->sx && matrix->kx == other->kx && matrix->tx == other->tx
+        &&  matrix->ky == other->ky && matrix->sy == other->sy && matrix->ty == other->ty;
+}
+
+static lx_picture_cmd_t* lx_picture_cmd_init(lx_picture_device_t* device, lx_size_t type) {
+    lx_assert(device && device->picture);
+
+    // make command
+    lx_picture_t*     picture = device->picture;
+    lx_picture_cmd_t* cmd = (lx_picture_cmd_t*)lx_picture_arena_malloc(picture, sizeof(lx_picture_cmd_t));
+    lx_assert_and_check_return_val(cmd, lx_null);
+    lx_memset(cmd, 0, sizeof(lx_picture_cmd_t));
+    cmd->type = type;
+
+    // save paint if be changed
+    lx_paint_t const* paint = (lx_paint_t const*)device->base.paint;
+    if (paint) {
+        if (!picture->paint || !lx_picture_paint_equal(picture->paint, paint)) {
+            picture->paint = (lx_paint_t const*)lx_picture_arena_memdup(picture, paint, sizeof(lx_paint_t));
+            lx_assert_and_check_return_val(picture->paint, lx_null);
+        }
+        cmd->paint = picture->paint;
+    }
+
+    // save matrix if be changed
+    lx_matrix_t const* matrix = (lx_matrix_t const*)device->base.matrix;
+    if (matrix) {
+        if (!picture->matrix || !lx_picture_matrix_equal(picture->matrix, matrix)) {
+            picture->matrix = (lx_matrix_t const*)lx_picture_arena_memdup(picture, matrix, sizeof(lx_matrix_t));
+            lx_assert_and_check_return_val(picture->matrix, lx_null);
+        }
+        cmd->matrix = picture->matrix;
+    }
+
+    // save clipper if be changed, we only copy it when it's changed because it may contain some paths
+    lx_clipper_ref_t clipper = device->base.clipper;
+    if (clipper && lx_clipper_size(clipper)) {
+        if (!picture->clipper || !lx_clipper_equal(picture->clipper, clipper)) {
+            picture->clipper = lx_clipper_init();
+            lx_assert_and_check_return_val(picture->clipper, lx_null);
+            lx_clipper_copy(picture->clipper, clipper);
+        }
+        cmd->clipper = picture->clipper;
+    } else {
+        picture->clipper = lx_null;
+    }
+    return cmd;
+}
+
+static lx_void_t lx_picture_cmd_done(lx_picture_device_t* device, lx_picture_cmd_t* cmd) {
+    lx_assert(device && device->picture && cmd);
+
+    // append command to the tail
+    lx_picture_t* picture = device->picture;
+    if (picture->tail) picture->tail->next = cmd;
+    else picture->head = cmd;
+    picture->tail = cmd;
+    picture->size++;
+}
+
+static lx_bool_t lx_picture_cmd_save_bounds(lx_picture_t* picture, lx_picture_cmd_t* cmd, lx_rect_ref_t bounds, lx_shape_ref_t hint) {
+    if (bounds) {
+        cmd->bounds = (lx_rect_ref_t)lx_picture_arena_memdup(picture, bounds, sizeof(lx_rect_t));
+        lx_assert_and_check_return_val(cmd->bounds, lx_false);
+    }
+    if (hint && hint->type != LX_SHAPE_TYPE_NONE) {
+        cmd->hint = (lx_shape_ref_t)lx_picture_arena_memdup(picture, hint, sizeof(lx_shape_t));
+        lx_assert_and_check_return_val(cmd->hint, lx_false);
+    }
+    return lx_true;
+}
+
+static lx_bool_t lx_picture_device_draw_lock(lx_device_ref_t self) {
+    return lx_true;
+}
+
+static lx_void_t lx_picture_device_draw_commit(lx_device_ref_t self) {
+}
+
+static lx_void_t lx_picture_device_draw_clear(lx_device_ref_t self, lx_color_t color) {
+    lx_picture_device_t* device = (lx_picture_device_t*)self;
+    lx_assert(device);
+
+    lx_picture_cmd_t* cmd = lx_picture_cmd_init(device, LX_PICTURE_CMD_TYPE_CLEAR);
+    lx_assert_and_check_return(cmd);
+
+    cmd->u.color = color;
+    lx_picture_cmd_done(device, cmd);
+}
+
+static lx_void_t lx_picture_device_draw_path(lx_device_ref_t self, lx_path_ref_t path) {
+    lx_picture_device_t* device = (lx_picture_device_t*)self;
+    lx_assert(device && path);
+
+    lx_picture_cmd_t* cmd = lx_picture_cmd_init(device, LX_PICTURE_CMD_TYPE_PATH);
+    lx_assert_and_check_return(cmd);
+
+    // copy path
+    cmd->u.path = lx_path_init();
+    lx_assert_and_check_return(cmd->u.path);
+    lx_path_copy(cmd->u.path, path);
+
+    // make polygon and bounds of path now, we need not flatten it again when replaying it
+    lx_path_polygon(cmd->u.path);
+    lx_path_bounds(cmd->u.path);
+    lx_picture_cmd_done(device, cmd);
+}
+
+static lx_void_t lx_picture_device_draw_points_or_lines(lx_picture_device_t* device, lx_size_t type, lx_point_ref_t points, lx_size_t count, lx_rect_ref_t bounds) {
+    lx_assert(device && points && count);
+
+    lx_picture_cmd_t* cmd = lx_picture_cmd_init(device, type);
+    lx_assert_and_check_return(cmd);
+
+    cmd->u.points.data = (lx_point_ref_t)lx_picture_arena_memdup(device->picture, points, count * sizeof(lx_point_t));
+    cmd->u.points.count = count;
+    lx_assert_and_check_return(cmd->u.points.data);
+    lx_check_return(lx_picture_cmd_save_bounds(device->picture, cmd, bounds, lx_null));
+    lx_picture_cmd_done(device, cmd);
+}
+
+static lx_void_t lx_picture_device_draw_lines(lx_device_ref_t self, lx_point_ref_t points, lx_size_t count, lx_rect_ref_t bounds) {
+    lx_picture_device_draw_points_or_lines((lx_picture_device_t*)self, LX_PICTURE_CMD_TYPE_LINES, points, count, bounds);
+}
+
+static lx_void_t lx_picture_device_draw_points(lx_device_ref_t self, lx_point_ref_t points, lx_size_t count, lx_rect_ref_t bounds) {
+    lx_picture_device_draw_points_or_lines((lx_picture_device_t*)self, LX_PICTURE_CMD_TYPE_POINTS, points, count, bounds);
+}
+
+static lx_void_t lx_picture_device_draw_polygon(lx_device_ref_t self, lx_polygon_ref_t polygon, lx_shape_ref_t hint, lx_rect_ref_t bounds) {
+    lx_picture_device_t* device = (lx_picture_device_t*)self;
+    lx_assert(device && polygon && polygon->points && polygon->counts);
+
+    // get the points count
+    lx_size_t    total  = 0;
+    lx_size_t    size   = 0;
+    lx_uint32_t* counts = polygon->counts;
+    while (counts[size]) total += counts[size++];
+    lx_check_return(total);
+
+    lx_picture_cmd_t* cmd = lx_picture_cmd_init(device, LX_PICTURE_CMD_TYPE_POLYGON);
+    lx_assert_and_check_return(cmd);
+
+    // copy polygon
+    lx_point_ref_t points = (lx_point_ref_t)lx_picture_arena_memdup(device->picture, polygon->points, total * sizeof(lx_point_t));
+    lx_assert_and_check_return(points);
+    counts = (lx_uint32_t*)lx_picture_arena_memdup(device->picture, polygon->counts, (size + 1) * sizeof(lx_uint32_t));
+    lx_assert_and_check_return(counts);
+    lx_polygon_make(&cmd->u.polygon, points, counts, polygon->total, polygon->convex);
+    lx_check_return(lx_picture_cmd_save_bounds(device->picture, cmd, bounds, hint));
+    lx_picture_cmd_done(device, cmd);
+}
+
+static lx_void_t lx_picture_device_exit(lx_device_ref_t self) {
+    lx_picture_device_t* device = (lx_picture_device_t*)self;
+    if (device) {
+        lx_free(device);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+lx_picture_ref_t lx_picture_init() {
+    return (lx_picture_ref_t)lx_malloc0_type(lx_picture_t);
+}
+
+lx_void_t lx_picture_exit(lx_picture_ref_t self) {
+    lx_picture_t* picture = (lx_picture_t*)self;
+    if (picture) {
+
+        // clear commands
+        lx_picture_clear(self);
+
+        // exit all chunks
+        lx_picture_chunk_t* chunk = picture->chunks;
+        while (chunk) {
+            lx_picture_chunk_t* next = chunk->next;
+            lx_free(chunk);
+            chunk = next;
+        }
+        lx_free(picture);
+    }
+}
+
+lx_void_t lx_picture_clear(lx_picture_ref_t self) {
+    lx_picture_t* picture = (lx_picture_t*)self;
+    lx_assert_and_check_return(picture);
+
+    // exit all paths and clippers, the same clipper is only shared by the adjacent commands
+    lx_clipper_ref_t  clipper = lx_null;
+    lx_picture_cmd_t* cmd = picture->head;
+    while (cmd) {
+        if (cmd->type == LX_PICTURE_CMD_TYPE_PATH && cmd->u.path) {
+            lx_path_exit(cmd->u.path);
+        }
+        if (cmd->clipper && cmd->clipper != clipper) {
+            clipper = cmd->clipper;
+            lx_clipper_exit(clipper);
+        }
+        cmd = cmd->next;
+    }
+
+    // reset all chunks
+    lx_picture_chunk_t* chunk = picture->chunks;
+    while (chunk) {
+        chunk->size = 0;
+        chunk = chunk->next;
+    }
+    picture->chunk  = picture->chunks;
+    picture->head   = lx_null;
+    picture->tail   = lx_null;
+    picture->size   = 0;
+    picture->paint   = lx_null;
+    picture->matrix  = lx_null;
+    picture->clipper = lx_null;
+}
+
+lx_size_t lx_picture_size(lx_picture_ref_t self) {
+    lx_picture_t* picture = (lx_picture_t*)self;
+    return picture? picture->size : 0;
+}
+
+lx_void_t lx_picture_draw(lx_canvas_ref_t self, lx_picture_ref_t picture_ref) {
+    lx_canvas_t*  canvas  = (lx_canvas_t*)self;
+    lx_picture_t* picture = (lx_picture_t*)picture_ref;
+    lx_assert_and_check_return(canvas && canvas->device && picture);
+    lx_check_return(picture->head);
+
+    // save paint and matrix
+    lx_matrix_t     base   = canvas->matrix;
+    lx_paint_ref_t  paint  = lx_canvas_save_paint(self);
+    lx_matrix_ref_t matrix = lx_canvas_save_matrix(self);
+    lx_assert_and_check_return(paint && matrix);
+
+    // replay all commands
+    lx_device_ref_t     device = canvas->device;
+    lx_clipper_ref_t    clipper_base = ((lx_device_t*)device)->clipper;
+    lx_clipper_ref_t    clipper = lx_null;
+    lx_clipper_ref_t    clipper_last = lx_null;
+    lx_paint_t const*   paint_last = lx_null;
+    lx_matrix_t const*  matrix_last = lx_null;
+    lx_picture_cmd_t*   cmd = picture->head;
+    while (cmd) {
+
+        /* update clipper, the recorded clipper is combined with the current clipper of canvas
+         * and its items are relative to the current matrix of canvas
+         */
+        if (cmd->clipper != clipper_last) {
+            if (cmd->clipper) {
+                if (!clipper) clipper = lx_clipper_init();
+                lx_assert_and_check_break(clipper);
+                if (clipper_base) lx_clipper_copy(clipper, clipper_base);
+                else lx_clipper_clear(clipper);
+                lx_clipper_add_clipper(clipper, cmd->clipper, &base);
+                lx_device_bind_clipper(device, clipper);
+            } else {
+                lx_device_bind_clipper(device, clipper_base);
+            }
+            clipper_last = cmd->clipper;
+        }
+
+        // update paint
+        if (cmd->paint && cmd->paint != paint_last) {
+            lx_paint_copy(paint, (lx_paint_ref_t)cmd->paint);
+            paint_last = cmd->paint;
+        }
+
+        // update matrix, the recorded matrix is relative to the current matrix of canvas
+        if (cmd->matrix && cmd->matrix != matrix_last) {
+            *matrix = base;
+            lx_matrix_multiply(matrix, (lx_matrix_ref_t)cmd->matrix);
+            matrix_last = cmd->matrix;
+        }
+
+        // draw it
+        switch (cmd->type) {
+        case LX_PICTURE_CMD_TYPE_CLEAR:
+            lx_device_draw_clear(device, cmd->u.color);
+            break;
+        case LX_PICTURE_CMD_TYPE_PATH:
+            lx_device_draw_path(device, cmd->u.path);
+            break;
+        case LX_PICTURE_CMD_TYPE_LINES:
+            lx_device_draw_lines(device, cmd->u.points.data, cmd->u.points.count, cmd->bounds);
+            break;
+        case LX_PICTURE_CMD_TYPE_POINTS:
+            lx_device_draw_points(device, cmd->u.points.data, cmd->u.points.count, cmd->bounds);
+            break;
+        case LX_PICTURE_CMD_TYPE_POLYGON:
+            lx_device_draw_polygon(device, &cmd->u.polygon, cmd->hint, cmd->bounds);
+            break;
+        default:
+            lx_assert(0);
+            break;
+        }
+        cmd = cmd->next;
+    }
+
+    // restore clipper, paint and matrix
+    lx_device_bind_clipper(device, clipper_base);
+    if (clipper) lx_clipper_exit(clipper);
+    lx_canvas_load_matrix(self);
+    lx_canvas_load_paint(self);
+}
+
+lx_device_ref_t lx_device_init_from_picture(lx_picture_ref_t picture) {
+    lx_assert_and_check_return_val(picture, lx_null);
+
+    lx_bool_t            ok = lx_false;
+    lx_picture_device_t* device = lx_null;
+    do {
+
+        // init device
+        device = lx_malloc0_type(lx_picture_device_t);
+        lx_assert_and_check_break(device);
+
+        device->base.draw_lock    = lx_picture_device_draw_lock;
+        device->base.draw_commit  = lx_picture_device_draw_commit;
+        device->base.draw_clear   = lx_picture_device_draw_clear;
+        device->base.draw_path    = lx_picture_device_draw_path;
+        device->base.draw_lines   = lx_picture_device_draw_lines;
+        device->base.draw_points  = lx_picture_device_draw_points;
+        device->base.draw_polygon = lx_picture_device_draw_polygon;
+        device->base.exit         = lx_picture_device_exit;
+        device->picture           = (lx_picture_t*)picture;
+
+        // ok
+        ok = lx_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && device) {
+        lx_device_exit((lx_device_ref_t)device);
+        device = lx_null;
+    }
+    return (lx_device_ref_t)device;
+}
+
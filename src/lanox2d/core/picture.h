@@ -0,0 +1,97 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        picture.h
+ *
+ */
+#ifndef LX_CORE_PICTURE_H
+#define LX_CORE_PICTURE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init picture
+ *
+ * the picture is a display list, we can record the draw commands to it
+ * by the canvas of lx_device_init_from_picture() and replay them by lx_picture_draw().
+ *
+ * @return          the picture
+ */
+lx_picture_ref_t    lx_picture_init(lx_noarg_t);
+
+/*! exit picture
+ *
+ * @param picture   the picture
+ */
+lx_void_t           lx_picture_exit(lx_picture_ref_t picture);
+
+/*! clear all recorded commands of picture
+ *
+ * @param picture   the picture
+ */
+lx_void_t           lx_picture_clear(lx_picture_ref_t picture);
+
+/*! get the recorded commands count of picture
+ *
+ * @param picture   the picture
+ *
+ * @return          the commands count
+ */
+lx_size_t           lx_picture_size(lx_picture_ref_t picture);
+
+/*! draw picture to the given canvas
+ *
+ * all recorded commands will be replayed with the current matrix and clipper of canvas.
+ * the recorded clip shapes are relative to the current matrix and they are combined with
+ * the current clipper in order, so LX_CLIPPER_MODE_REPLACE will discard the current clipper.
+ *
+ * the paint, matrix and clipper of canvas will be not changed after drawing.
+ *
+ * @note the shaders of the recorded paints must be valid when drawing picture
+ *
+ * @param canvas    the canvas
+ * @param picture   the picture
+ */
+lx_void_t           lx_picture_draw(lx_canvas_ref_t canvas, lx_picture_ref_t picture);
+
+/*! init device from picture for recording commands
+ *
+ * @param picture   the picture
+ *
+ * @return          the device
+ */
+lx_device_ref_t     lx_device_init_from_picture(lx_picture_ref_t picture);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
+
+
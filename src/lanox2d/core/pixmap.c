@@ -39,6 +39,8 @@
 #include "pixmap/rgbx4444.c"
 #include "pixmap/rgba8888.c"
 #include "pixmap/rgbx8888.c"
+#include "pixmap/argb8888_premul.c"
+#include "pixmap/rgba8888_premul.c"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
@@ -75,6 +77,8 @@ static lx_pixmap_ref_t g_pixmaps_lo[] = {
 ,   lx_null
 ,   lx_null
 ,   lx_null
+,   &g_pixmap_lo_argb8888_premul
+,   &g_pixmap_lo_rgba8888_premul
 };
 
 // the pixmaps for opaque and big endian
@@ -108,6 +112,8 @@ static lx_pixmap_ref_t g_pixmaps_bo[] = {
 ,   lx_null
 ,   lx_null
 ,   lx_null
+,   &g_pixmap_bo_argb8888_premul
+,   &g_pixmap_bo_rgba8888_premul
 };
 
 // the pixmaps for alpha and little endian
@@ -141,6 +147,8 @@ static lx_pixmap_ref_t g_pixmaps_la[] = {
 ,   lx_null
 ,   lx_null
 ,   lx_null
+,   &g_pixmap_la_argb8888_premul
+,   &g_pixmap_la_rgba8888_premul
 };
 
 // the pixmaps for alpha and big endian
@@ -174,6 +182,139 @@ static lx_pixmap_ref_t g_pixmaps_ba[] = {
 ,   lx_null
 ,   lx_null
 ,   lx_null
+,   &g_pixmap_ba_argb8888_premul
+,   &g_pixmap_ba_rgba8888_premul
+};
+
+// the blenders for little endian
+static lx_pixmap_blender_t const* g_pixmap_blenders_l[] = {
+    lx_null
+,   &g_pixmap_blender_l_rgb565
+,   &g_pixmap_blender_l_rgb888
+,   &g_pixmap_blender_l_argb1555
+,   &g_pixmap_blender_l_xrgb1555
+,   &g_pixmap_blender_l_argb4444
+,   &g_pixmap_blender_l_xrgb4444
+,   &g_pixmap_blender_l_argb8888
+,   &g_pixmap_blender_l_xrgb8888
+,   &g_pixmap_blender_l_rgba5551
+,   &g_pixmap_blender_l_rgbx5551
+,   &g_pixmap_blender_l_rgba4444
+,   &g_pixmap_blender_l_rgbx4444
+,   &g_pixmap_blender_l_rgba8888
+,   &g_pixmap_blender_l_rgbx8888
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   &g_pixmap_blender_l_argb8888_premul
+,   &g_pixmap_blender_l_rgba8888_premul
+};
+
+// the blenders for big endian
+static lx_pixmap_blender_t const* g_pixmap_blenders_b[] = {
+    lx_null
+,   &g_pixmap_blender_b_rgb565
+,   &g_pixmap_blender_b_rgb888
+,   &g_pixmap_blender_b_argb1555
+,   &g_pixmap_blender_b_xrgb1555
+,   &g_pixmap_blender_b_argb4444
+,   &g_pixmap_blender_b_xrgb4444
+,   &g_pixmap_blender_b_argb8888
+,   &g_pixmap_blender_b_xrgb8888
+,   &g_pixmap_blender_b_rgba5551
+,   &g_pixmap_blender_b_rgbx5551
+,   &g_pixmap_blender_b_rgba4444
+,   &g_pixmap_blender_b_rgbx4444
+,   &g_pixmap_blender_b_rgba8888
+,   &g_pixmap_blender_b_rgbx8888
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   lx_null
+,   &g_pixmap_blender_b_argb8888_premul
+,   &g_pixmap_blender_b_rgba8888_premul
+};
+
+// the blend functions of the blend modes
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(src_over)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(clear)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(src)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(dst)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(dst_over)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(src_in)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(dst_in)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(src_out)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(dst_out)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(src_atop)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(dst_atop)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(xor)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(plus)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(multiply)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(screen)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(darken)
+LX_PIXMAP_BLENDER_MODE_IMPLEMENT(lighten)
+
+// the solid color blend functions, they are indexed by the blend mode
+static lx_pixmap_func_color_blend_t g_pixmap_color_blends[] = {
+    lx_pixmap_blender_color_blend_src_over
+,   lx_pixmap_blender_color_blend_clear
+,   lx_pixmap_blender_color_blend_src
+,   lx_pixmap_blender_color_blend_dst
+,   lx_pixmap_blender_color_blend_dst_over
+,   lx_pixmap_blender_color_blend_src_in
+,   lx_pixmap_blender_color_blend_dst_in
+,   lx_pixmap_blender_color_blend_src_out
+,   lx_pixmap_blender_color_blend_dst_out
+,   lx_pixmap_blender_color_blend_src_atop
+,   lx_pixmap_blender_color_blend_dst_atop
+,   lx_pixmap_blender_color_blend_xor
+,   lx_pixmap_blender_color_blend_plus
+,   lx_pixmap_blender_color_blend_multiply
+,   lx_pixmap_blender_color_blend_screen
+,   lx_pixmap_blender_color_blend_darken
+,   lx_pixmap_blender_color_blend_lighten
+};
+
+// the colors blend functions, they are indexed by the blend mode
+static lx_pixmap_func_colors_blend_t g_pixmap_colors_blends[] = {
+    lx_pixmap_blender_colors_blend_src_over
+,   lx_pixmap_blender_colors_blend_clear
+,   lx_pixmap_blender_colors_blend_src
+,   lx_pixmap_blender_colors_blend_dst
+,   lx_pixmap_blender_colors_blend_dst_over
+,   lx_pixmap_blender_colors_blend_src_in
+,   lx_pixmap_blender_colors_blend_dst_in
+,   lx_pixmap_blender_colors_blend_src_out
+,   lx_pixmap_blender_colors_blend_dst_out
+,   lx_pixmap_blender_colors_blend_src_atop
+,   lx_pixmap_blender_colors_blend_dst_atop
+,   lx_pixmap_blender_colors_blend_xor
+,   lx_pixmap_blender_colors_blend_plus
+,   lx_pixmap_blender_colors_blend_multiply
+,   lx_pixmap_blender_colors_blend_screen
+,   lx_pixmap_blender_colors_blend_darken
+,   lx_pixmap_blender_colors_blend_lighten
 };
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -201,6 +342,28 @@ lx_pixmap_ref_t lx_pixmap(lx_size_t pixfmt, lx_byte_t alpha) {
     return lx_null;
 }
 
+lx_bool_t lx_pixmap_blender_init(lx_pixmap_blender_t* blender, lx_size_t pixfmt, lx_size_t mode) {
+    lx_assert_and_check_return_val(blender && mode < lx_arrayn(g_pixmap_colors_blends), lx_false);
+
+    // big endian?
+    lx_size_t is_endian = LX_PIXFMT_BE(pixfmt);
+
+    // get pixfmt
+    pixfmt = LX_PIXFMT(pixfmt);
+    lx_assert_and_check_return_val(pixfmt && (pixfmt - 1) < lx_arrayn(g_pixmap_blenders_l), lx_false);
+
+    // get the loader and storer of this pixel format, the palette format has not blender
+    lx_pixmap_blender_t const* pixels = is_endian? g_pixmap_blenders_b[pixfmt - 1] : g_pixmap_blenders_l[pixfmt - 1];
+    lx_check_return_val(pixels && pixels->pixels_load && pixels->pixels_store, lx_false);
+
+    // init blender
+    blender->pixels_load  = pixels->pixels_load;
+    blender->pixels_store = pixels->pixels_store;
+    blender->color_blend  = g_pixmap_color_blends[mode];
+    blender->colors_blend = g_pixmap_colors_blends[mode];
+    return lx_true;
+}
+
 lx_byte_t lx_pixmap_btp(lx_size_t pixfmt) {
     lx_pixmap_ref_t pixmap = lx_pixmap(pixfmt, 0xff);
     return pixmap? pixmap->btp : 0;
@@ -98,6 +98,40 @@ typedef lx_void_t       (*lx_pixmap_func_color_set_t)(lx_pointer_t data, lx_colo
  */
 typedef lx_void_t       (*lx_pixmap_func_pixels_fill_t)(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha);
 
+/*! load the premultiplied colors from pixels
+ *
+ * @param data          the data
+ * @param colors        the premultiplied colors
+ * @param count         the count
+ */
+typedef lx_void_t       (*lx_pixmap_func_pixels_load_t)(lx_cpointer_t data, lx_color_t* colors, lx_size_t count);
+
+/*! store the premultiplied colors to pixels
+ *
+ * @param data          the data
+ * @param colors        the premultiplied colors
+ * @param count         the count
+ */
+typedef lx_void_t       (*lx_pixmap_func_pixels_store_t)(lx_pointer_t data, lx_color_t const* colors, lx_size_t count);
+
+/*! blend the solid color to the premultiplied colors with the blend mode
+ *
+ * @param colors        the premultiplied colors
+ * @param color         the source color, it's not premultiplied
+ * @param count         the count
+ * @param alpha         the coverage alpha
+ */
+typedef lx_void_t       (*lx_pixmap_func_color_blend_t)(lx_color_t* colors, lx_color_t color, lx_size_t count, lx_byte_t alpha);
+
+/*! blend the source colors to the premultiplied colors with the blend mode
+ *
+ * @param colors        the premultiplied colors
+ * @param source        the source colors, they are not premultiplied
+ * @param count         the count
+ * @param alpha         the coverage alpha
+ */
+typedef lx_void_t       (*lx_pixmap_func_colors_blend_t)(lx_color_t* colors, lx_color_t const* source, lx_size_t count, lx_byte_t alpha);
+
 /// the pixmap type
 typedef struct lx_pixmap_t_ {
 
@@ -142,6 +176,27 @@ typedef struct lx_pixmap_t_ {
 /// the pixmap reference type
 typedef lx_pixmap_t const*  lx_pixmap_ref_t;
 
+/*! the pixmap blender type
+ *
+ * we load the pixels span to the premultiplied colors, blend them with the blend mode and store them back,
+ * the loader and storer are specialized for each pixel format, and the blend functions are specialized for each blend mode.
+ */
+typedef struct lx_pixmap_blender_t_ {
+
+    /// load the premultiplied colors from pixels
+    lx_pixmap_func_pixels_load_t  pixels_load;
+
+    /// store the premultiplied colors to pixels
+    lx_pixmap_func_pixels_store_t pixels_store;
+
+    /// blend the solid color to the premultiplied colors
+    lx_pixmap_func_color_blend_t  color_blend;
+
+    /// blend the source colors to the premultiplied colors
+    lx_pixmap_func_colors_blend_t colors_blend;
+
+}lx_pixmap_blender_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -155,6 +210,16 @@ typedef lx_pixmap_t const*  lx_pixmap_ref_t;
  */
 lx_pixmap_ref_t         lx_pixmap(lx_size_t pixfmt, lx_byte_t alpha);
 
+/*! init the pixmap blender from the pixel format and blend mode
+ *
+ * @param blender       the pixmap blender
+ * @param pixfmt        the pixfmt with endian
+ * @param mode          the blend mode, e.g. LX_PAINT_BLEND_MODE_SRC_IN
+ *
+ * @return              lx_true or lx_false, it's false if this pixel format has not blender, e.g. pal8
+ */
+lx_bool_t               lx_pixmap_blender_init(lx_pixmap_blender_t* blender, lx_size_t pixfmt, lx_size_t mode);
+
 /*! get btp from pixel format
  *
  * @param pixfmt        the pixfmt with endian
@@ -0,0 +1,134 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        blend.h
+ *
+ */
+#ifndef LX_CORE_PIXMAP_ARCH_ARM_BLEND_H
+#define LX_CORE_PIXMAP_ARCH_ARM_BLEND_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../../prefix.h"
+#ifdef LX_ARCH_ARM_NEON
+#   include <arm_neon.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef LX_ARCH_ARM_NEON
+#   define LX_PIXMAP_ARCH_BLEND
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef LX_ARCH_ARM_NEON
+
+/* blend 4 x rgb32 pixels, d = (((a * (s - d)) >> 8) + d) & 0x00ff00ff for the high and low channels
+ *
+ * it's the same as lx_pixmap_rgb32_blend2(), so the results are exactly equal to the scalar version
+ */
+static lx_inline uint32x4_t lx_pixmap_rgb32_blend2_neon(uint32x4_t d, uint32x4_t hs, uint32x4_t ls, uint32_t a, uint32x4_t m) {
+    uint32x4_t hd = vandq_u32(vshrq_n_u32(d, 8), m);
+    uint32x4_t ld = vandq_u32(d, m);
+    hd = vandq_u32(vaddq_u32(vshrq_n_u32(vmulq_n_u32(vsubq_u32(hs, hd), a), 8), hd), m);
+    ld = vandq_u32(vaddq_u32(vshrq_n_u32(vmulq_n_u32(vsubq_u32(ls, ld), a), 8), ld), m);
+    return vorrq_u32(vshlq_n_u32(hd, 8), ld);
+}
+
+/* blend 4 x rgb16 pixels in the 32-bits lanes and narrow them to the 16-bits lanes
+ *
+ * d = (d | (d << lshift)) & mask
+ * d = ((((s - d) * a) >> 5) + d) & mask
+ * d = (d & 0xffff) | (d >> rshift)
+ */
+static lx_inline uint16x4_t lx_pixmap_rgb16_blend2_neon(uint32x4_t d, uint32x4_t s, uint32_t a, uint32x4_t m, int32x4_t lshift, int32x4_t rshift) {
+    d = vandq_u32(vorrq_u32(d, vshlq_u32(d, lshift)), m);
+    d = vandq_u32(vaddq_u32(vshrq_n_u32(vmulq_n_u32(vsubq_u32(s, d), a), 5), d), m);
+    return vmovn_u32(vorrq_u32(d, vshlq_u32(d, rshift)));
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef LX_PIXMAP_ARCH_BLEND
+
+/* blend the rgb32 pixels with the native endian
+ *
+ * @param p         the pixels
+ * @param pixel     the blended pixel
+ * @param count     the pixels count
+ * @param alpha     the alpha
+ *
+ * @return          the blended pixels count, the left pixels need be blended by the caller
+ */
+static lx_inline lx_size_t lx_pixmap_rgb32_pixels_blend_opt(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    // neon may be disabled by LX_CPU_LEVEL for testing the scalar version
+    lx_check_return_val(lx_cpu_features() & LX_CPU_FEATURE_NEON, 0);
+
+    lx_size_t   n = count & ~7;
+    lx_size_t   i = 0;
+    uint32x4_t  m = vdupq_n_u32(0x00ff00ff);
+    uint32x4_t  hs = vdupq_n_u32((pixel >> 8) & 0x00ff00ff);
+    uint32x4_t  ls = vdupq_n_u32(pixel & 0x00ff00ff);
+    for (i = 0; i < n; i += 8) {
+        uint32x4_t d0 = vld1q_u32(p + i);
+        uint32x4_t d1 = vld1q_u32(p + i + 4);
+        vst1q_u32(p + i, lx_pixmap_rgb32_blend2_neon(d0, hs, ls, alpha, m));
+        vst1q_u32(p + i + 4, lx_pixmap_rgb32_blend2_neon(d1, hs, ls, alpha, m));
+    }
+    return n;
+}
+
+/* blend the rgb16 pixels with the native endian
+ *
+ * @param p         the pixels
+ * @param s         the spread source pixel, (pixel | (pixel << 16)) & mask
+ * @param count     the pixels count
+ * @param alpha     the 5-bits alpha
+ * @param lshift    the spread shift
+ * @param rshift    the merged shift
+ * @param mask      the spread mask
+ * @param bits      the fixed bits of the blended pixel
+ *
+ * @return          the blended pixels count, the left pixels need be blended by the caller
+ */
+static lx_inline lx_size_t lx_pixmap_rgb16_pixels_blend_opt(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    lx_check_return_val(lx_cpu_features() & LX_CPU_FEATURE_NEON, 0);
+
+    lx_size_t   n = count & ~7;
+    lx_size_t   i = 0;
+    uint32x4_t  m = vdupq_n_u32(mask);
+    uint32x4_t  vs = vdupq_n_u32(s);
+    uint16x8_t  vb = vdupq_n_u16(bits);
+    int32x4_t   ls = vdupq_n_s32((lx_int_t)lshift);
+    int32x4_t   rs = vdupq_n_s32(-(lx_int_t)rshift);
+    for (i = 0; i < n; i += 8) {
+        uint16x8_t d = vld1q_u16(p + i);
+        uint16x4_t lo = lx_pixmap_rgb16_blend2_neon(vmovl_u16(vget_low_u16(d)), vs, alpha, m, ls, rs);
+        uint16x4_t hi = lx_pixmap_rgb16_blend2_neon(vmovl_u16(vget_high_u16(d)), vs, alpha, m, ls, rs);
+        vst1q_u16(p + i, vorrq_u16(vcombine_u16(lo, hi), vb));
+    }
+    return n;
+}
+#endif
+
+#endif
@@ -0,0 +1,361 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        blend.h
+ *
+ */
+#ifndef LX_CORE_PIXMAP_ARCH_X86_BLEND_H
+#define LX_CORE_PIXMAP_ARCH_X86_BLEND_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../../prefix.h"
+#if defined(LX_ARCH_SIMD_DISPATCH) || defined(LX_ARCH_AVX2)
+#   include <immintrin.h>
+#elif defined(LX_ARCH_SSE2)
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#if defined(LX_ARCH_SIMD_DISPATCH)
+#   define LX_PIXMAP_ARCH_BLEND_AVX512
+#   define LX_PIXMAP_ARCH_BLEND_AVX2
+#   define LX_PIXMAP_ARCH_BLEND_SSE2
+#elif defined(LX_ARCH_AVX2)
+#   define LX_PIXMAP_ARCH_BLEND_AVX2
+#elif defined(LX_ARCH_SSE2)
+#   define LX_PIXMAP_ARCH_BLEND_SSE2
+#endif
+
+#if defined(LX_PIXMAP_ARCH_BLEND_AVX2) || defined(LX_PIXMAP_ARCH_BLEND_SSE2)
+#   define LX_PIXMAP_ARCH_BLEND
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef LX_ARCH_SIMD_DISPATCH
+typedef lx_size_t (*lx_pixmap_rgb32_pixels_blend_func_t)(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha);
+typedef lx_size_t (*lx_pixmap_rgb16_pixels_blend_func_t)(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX512
+/* blend 16 x rgb32 pixels, d = (((a * (s - d)) >> 8) + d) & 0x00ff00ff for the high and low channels
+ *
+ * it's the same as lx_pixmap_rgb32_blend2(), so the results are exactly equal to the scalar version
+ */
+static lx_inline lx_target("avx512f,avx512bw") __m512i lx_pixmap_rgb32_blend2_avx512(__m512i d, __m512i hs, __m512i ls, __m512i a, __m512i m) {
+    __m512i hd = _mm512_and_si512(_mm512_srli_epi32(d, 8), m);
+    __m512i ld = _mm512_and_si512(d, m);
+    hd = _mm512_and_si512(_mm512_add_epi32(_mm512_srli_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(hs, hd), a), 8), hd), m);
+    ld = _mm512_and_si512(_mm512_add_epi32(_mm512_srli_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(ls, ld), a), 8), ld), m);
+    return _mm512_or_si512(_mm512_slli_epi32(hd, 8), ld);
+}
+
+/* blend 16 x rgb16 pixels in the 32-bits lanes
+ *
+ * d = (d | (d << lshift)) & mask
+ * d = ((((s - d) * a) >> 5) + d) & mask
+ * d = (d & 0xffff) | (d >> rshift) | bits
+ */
+static lx_inline lx_target("avx512f,avx512bw") __m512i lx_pixmap_rgb16_blend2_avx512(__m512i d, __m512i s, __m512i a, __m512i m, __m128i lshift, __m128i rshift) {
+    d = _mm512_and_si512(_mm512_or_si512(d, _mm512_sll_epi32(d, lshift)), m);
+    d = _mm512_and_si512(_mm512_add_epi32(_mm512_srli_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(s, d), a), 5), d), m);
+    return _mm512_or_si512(d, _mm512_srl_epi32(d, rshift));
+}
+#endif
+
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX2
+/* blend 8 x rgb32 pixels, d = (((a * (s - d)) >> 8) + d) & 0x00ff00ff for the high and low channels
+ *
+ * it's the same as lx_pixmap_rgb32_blend2(), so the results are exactly equal to the scalar version
+ */
+static lx_inline lx_target("avx2") __m256i lx_pixmap_rgb32_blend2_avx2(__m256i d, __m256i hs, __m256i ls, __m256i a, __m256i m) {
+    __m256i hd = _mm256_and_si256(_mm256_srli_epi32(d, 8), m);
+    __m256i ld = _mm256_and_si256(d, m);
+    hd = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(hs, hd), a), 8), hd), m);
+    ld = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(ls, ld), a), 8), ld), m);
+    return _mm256_or_si256(_mm256_slli_epi32(hd, 8), ld);
+}
+
+/* blend 8 x rgb16 pixels in the 32-bits lanes
+ *
+ * d = (d | (d << lshift)) & mask
+ * d = ((((s - d) * a) >> 5) + d) & mask
+ * d = (d & 0xffff) | (d >> rshift) | bits
+ */
+static lx_inline lx_target("avx2") __m256i lx_pixmap_rgb16_blend2_avx2(__m256i d, __m256i s, __m256i a, __m256i m, __m128i lshift, __m128i rshift) {
+    d = _mm256_and_si256(_mm256_or_si256(d, _mm256_sll_epi32(d, lshift)), m);
+    d = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s, d), a), 5), d), m);
+    return _mm256_or_si256(d, _mm256_srl_epi32(d, rshift));
+}
+#endif
+
+#ifdef LX_PIXMAP_ARCH_BLEND_SSE2
+/* the low 32-bits of x * a for the 32-bits lanes, a must be less than 0x10000
+ *
+ * sse2 has not pmulld, so we compute it by the 16-bits multiplications:
+ *
+ * x * a = xl * a + ((xh * a) << 16)
+ *       = lo16(xl * a) + ((hi16(xl * a) + lo16(xh * a)) << 16)
+ */
+static lx_inline lx_target("sse2") __m128i lx_pixmap_mul32_sse2(__m128i x, __m128i a) {
+    return _mm_add_epi32(_mm_mullo_epi16(x, a), _mm_slli_epi32(_mm_mulhi_epu16(x, a), 16));
+}
+
+/* blend 4 x rgb32 pixels, d = (((a * (s - d)) >> 8) + d) & 0x00ff00ff for the high and low channels
+ *
+ * it's the same as lx_pixmap_rgb32_blend2(), so the results are exactly equal to the scalar version
+ */
+static lx_inline lx_target("sse2") __m128i lx_pixmap_rgb32_blend2_sse2(__m128i d, __m128i hs, __m128i ls, __m128i a, __m128i m) {
+    __m128i hd = _mm_and_si128(_mm_srli_epi32(d, 8), m);
+    __m128i ld = _mm_and_si128(d, m);
+    hd = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(lx_pixmap_mul32_sse2(_mm_sub_epi32(hs, hd), a), 8), hd), m);
+    ld = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(lx_pixmap_mul32_sse2(_mm_sub_epi32(ls, ld), a), 8), ld), m);
+    return _mm_or_si128(_mm_slli_epi32(hd, 8), ld);
+}
+
+/* blend 4 x rgb16 pixels in the 32-bits lanes
+ *
+ * d = (d | (d << lshift)) & mask
+ * d = ((((s - d) * a) >> 5) + d) & mask
+ * d = (d & 0xffff) | (d >> rshift) | bits
+ */
+static lx_inline lx_target("sse2") __m128i lx_pixmap_rgb16_blend2_sse2(__m128i d, __m128i s, __m128i a, __m128i m, __m128i lshift, __m128i rshift) {
+    d = _mm_and_si128(_mm_or_si128(d, _mm_sll_epi32(d, lshift)), m);
+    d = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(lx_pixmap_mul32_sse2(_mm_sub_epi32(s, d), a), 5), d), m);
+    return _mm_or_si128(d, _mm_srl_epi32(d, rshift));
+}
+
+/* pack the 32-bits lanes to the 16-bits lanes with truncation
+ *
+ * _mm_packs_epi32 is saturated, so we need sign-extend the low 16-bits first
+ */
+static lx_inline lx_target("sse2") __m128i lx_pixmap_pack16_sse2(__m128i lo, __m128i hi) {
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+#endif
+
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX512
+static lx_target("avx512f,avx512bw") lx_size_t lx_pixmap_rgb32_pixels_blend_avx512(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t n = count & ~15;
+    lx_size_t i = 0;
+    __m512i   m = _mm512_set1_epi32(0x00ff00ff);
+    __m512i   a = _mm512_set1_epi32(alpha);
+    __m512i   hs = _mm512_set1_epi32((pixel >> 8) & 0x00ff00ff);
+    __m512i   ls = _mm512_set1_epi32(pixel & 0x00ff00ff);
+    for (i = 0; i < n; i += 16) {
+        __m512i d = _mm512_loadu_si512((lx_pointer_t)(p + i));
+        _mm512_storeu_si512((lx_pointer_t)(p + i), lx_pixmap_rgb32_blend2_avx512(d, hs, ls, a, m));
+    }
+    return n;
+}
+
+static lx_target("avx512f,avx512bw") lx_size_t lx_pixmap_rgb16_pixels_blend_avx512(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    lx_size_t n = count & ~31;
+    lx_size_t i = 0;
+    __m512i   z = _mm512_setzero_si512();
+    __m512i   m = _mm512_set1_epi32(mask);
+    __m512i   a = _mm512_set1_epi32(alpha);
+    __m512i   vs = _mm512_set1_epi32(s);
+    __m512i   vb = _mm512_set1_epi16(bits);
+    __m512i   vl = _mm512_set1_epi32(0xffff);
+    __m128i   ls = _mm_cvtsi32_si128((lx_int_t)lshift);
+    __m128i   rs = _mm_cvtsi32_si128((lx_int_t)rshift);
+    for (i = 0; i < n; i += 32) {
+        // the unpacked lanes are interleaved in the 128-bits quarters, but packus restores them
+        __m512i d = _mm512_loadu_si512((lx_pointer_t)(p + i));
+        __m512i lo = _mm512_and_si512(lx_pixmap_rgb16_blend2_avx512(_mm512_unpacklo_epi16(d, z), vs, a, m, ls, rs), vl);
+        __m512i hi = _mm512_and_si512(lx_pixmap_rgb16_blend2_avx512(_mm512_unpackhi_epi16(d, z), vs, a, m, ls, rs), vl);
+        _mm512_storeu_si512((lx_pointer_t)(p + i), _mm512_or_si512(_mm512_packus_epi32(lo, hi), vb));
+    }
+    return n;
+}
+#endif
+
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX2
+static lx_target("avx2") lx_size_t lx_pixmap_rgb32_pixels_blend_avx2(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t n = count & ~7;
+    lx_size_t i = 0;
+    __m256i   m = _mm256_set1_epi32(0x00ff00ff);
+    __m256i   a = _mm256_set1_epi32(alpha);
+    __m256i   hs = _mm256_set1_epi32((pixel >> 8) & 0x00ff00ff);
+    __m256i   ls = _mm256_set1_epi32(pixel & 0x00ff00ff);
+    for (i = 0; i < n; i += 8) {
+        __m256i d = _mm256_loadu_si256((__m256i const*)(p + i));
+        _mm256_storeu_si256((__m256i*)(p + i), lx_pixmap_rgb32_blend2_avx2(d, hs, ls, a, m));
+    }
+    return n;
+}
+
+static lx_target("avx2") lx_size_t lx_pixmap_rgb16_pixels_blend_avx2(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    lx_size_t n = count & ~15;
+    lx_size_t i = 0;
+    __m256i   z = _mm256_setzero_si256();
+    __m256i   m = _mm256_set1_epi32(mask);
+    __m256i   a = _mm256_set1_epi32(alpha);
+    __m256i   vs = _mm256_set1_epi32(s);
+    __m256i   vb = _mm256_set1_epi16(bits);
+    __m256i   vl = _mm256_set1_epi32(0xffff);
+    __m128i   ls = _mm_cvtsi32_si128((lx_int_t)lshift);
+    __m128i   rs = _mm_cvtsi32_si128((lx_int_t)rshift);
+    for (i = 0; i < n; i += 16) {
+        // the unpacked lanes are interleaved in the 128-bits halves, but packus restores them
+        __m256i d = _mm256_loadu_si256((__m256i const*)(p + i));
+        __m256i lo = _mm256_and_si256(lx_pixmap_rgb16_blend2_avx2(_mm256_unpacklo_epi16(d, z), vs, a, m, ls, rs), vl);
+        __m256i hi = _mm256_and_si256(lx_pixmap_rgb16_blend2_avx2(_mm256_unpackhi_epi16(d, z), vs, a, m, ls, rs), vl);
+        _mm256_storeu_si256((__m256i*)(p + i), _mm256_or_si256(_mm256_packus_epi32(lo, hi), vb));
+    }
+    return n;
+}
+#endif
+
+#ifdef LX_PIXMAP_ARCH_BLEND_SSE2
+static lx_target("sse2") lx_size_t lx_pixmap_rgb32_pixels_blend_sse2(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t n = count & ~7;
+    lx_size_t i = 0;
+    __m128i   m = _mm_set1_epi32(0x00ff00ff);
+    __m128i   a = _mm_set1_epi16(alpha);
+    __m128i   hs = _mm_set1_epi32((pixel >> 8) & 0x00ff00ff);
+    __m128i   ls = _mm_set1_epi32(pixel & 0x00ff00ff);
+    for (i = 0; i < n; i += 8) {
+        __m128i d0 = _mm_loadu_si128((__m128i const*)(p + i));
+        __m128i d1 = _mm_loadu_si128((__m128i const*)(p + i + 4));
+        _mm_storeu_si128((__m128i*)(p + i), lx_pixmap_rgb32_blend2_sse2(d0, hs, ls, a, m));
+        _mm_storeu_si128((__m128i*)(p + i + 4), lx_pixmap_rgb32_blend2_sse2(d1, hs, ls, a, m));
+    }
+    return n;
+}
+
+static lx_target("sse2") lx_size_t lx_pixmap_rgb16_pixels_blend_sse2(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    lx_size_t n = count & ~7;
+    lx_size_t i = 0;
+    __m128i   z = _mm_setzero_si128();
+    __m128i   m = _mm_set1_epi32(mask);
+    __m128i   a = _mm_set1_epi16(alpha);
+    __m128i   vs = _mm_set1_epi32(s);
+    __m128i   vb = _mm_set1_epi16(bits);
+    __m128i   ls = _mm_cvtsi32_si128((lx_int_t)lshift);
+    __m128i   rs = _mm_cvtsi32_si128((lx_int_t)rshift);
+    for (i = 0; i < n; i += 8) {
+        __m128i d = _mm_loadu_si128((__m128i const*)(p + i));
+        __m128i lo = lx_pixmap_rgb16_blend2_sse2(_mm_unpacklo_epi16(d, z), vs, a, m, ls, rs);
+        __m128i hi = lx_pixmap_rgb16_blend2_sse2(_mm_unpackhi_epi16(d, z), vs, a, m, ls, rs);
+        _mm_storeu_si128((__m128i*)(p + i), _mm_or_si128(lx_pixmap_pack16_sse2(lo, hi), vb));
+    }
+    return n;
+}
+#endif
+
+#ifdef LX_ARCH_SIMD_DISPATCH
+// no simd, all pixels will be blended by the caller
+static lx_size_t lx_pixmap_rgb32_pixels_blend_none(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    return 0;
+}
+
+static lx_size_t lx_pixmap_rgb16_pixels_blend_none(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    return 0;
+}
+
+/* select the best kernels for the current cpu at the first call
+ *
+ * it may be selected repeatly by the concurrent threads, but they always get the same function.
+ */
+static lx_size_t lx_pixmap_rgb32_pixels_blend_init(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha);
+static lx_pixmap_rgb32_pixels_blend_func_t g_pixmap_rgb32_pixels_blend = lx_pixmap_rgb32_pixels_blend_init;
+static lx_size_t lx_pixmap_rgb32_pixels_blend_init(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t features = lx_cpu_features();
+    lx_pixmap_rgb32_pixels_blend_func_t func = lx_pixmap_rgb32_pixels_blend_none;
+    if (features & LX_CPU_FEATURE_AVX512) func = lx_pixmap_rgb32_pixels_blend_avx512;
+    else if (features & LX_CPU_FEATURE_AVX2) func = lx_pixmap_rgb32_pixels_blend_avx2;
+    else if (features & LX_CPU_FEATURE_SSE2) func = lx_pixmap_rgb32_pixels_blend_sse2;
+    g_pixmap_rgb32_pixels_blend = func;
+    return func(p, pixel, count, alpha);
+}
+
+static lx_size_t lx_pixmap_rgb16_pixels_blend_init(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits);
+static lx_pixmap_rgb16_pixels_blend_func_t g_pixmap_rgb16_pixels_blend = lx_pixmap_rgb16_pixels_blend_init;
+static lx_size_t lx_pixmap_rgb16_pixels_blend_init(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+    lx_size_t features = lx_cpu_features();
+    lx_pixmap_rgb16_pixels_blend_func_t func = lx_pixmap_rgb16_pixels_blend_none;
+    if (features & LX_CPU_FEATURE_AVX512) func = lx_pixmap_rgb16_pixels_blend_avx512;
+    else if (features & LX_CPU_FEATURE_AVX2) func = lx_pixmap_rgb16_pixels_blend_avx2;
+    else if (features & LX_CPU_FEATURE_SSE2) func = lx_pixmap_rgb16_pixels_blend_sse2;
+    g_pixmap_rgb16_pixels_blend = func;
+    return func(p, s, count, alpha, lshift, rshift, mask, bits);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef LX_PIXMAP_ARCH_BLEND
+
+/* blend the rgb32 pixels with the native endian
+ *
+ * the kernel is selected by the cpu features at runtime if LX_ARCH_SIMD_DISPATCH is defined
+ *
+ * @param p         the pixels
+ * @param pixel     the blended pixel
+ * @param count     the pixels count
+ * @param alpha     the alpha
+ *
+ * @return          the blended pixels count, the left pixels need be blended by the caller
+ */
+static lx_inline lx_size_t lx_pixmap_rgb32_pixels_blend_opt(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+#if defined(LX_ARCH_SIMD_DISPATCH)
+    return g_pixmap_rgb32_pixels_blend(p, pixel, count, alpha);
+#elif defined(LX_PIXMAP_ARCH_BLEND_AVX2)
+    return lx_pixmap_rgb32_pixels_blend_avx2(p, pixel, count, alpha);
+#else
+    return lx_pixmap_rgb32_pixels_blend_sse2(p, pixel, count, alpha);
+#endif
+}
+
+/* blend the rgb16 pixels with the native endian
+ *
+ * @param p         the pixels
+ * @param s         the spread source pixel, (pixel | (pixel << 16)) & mask
+ * @param count     the pixels count
+ * @param alpha     the 5-bits alpha
+ * @param lshift    the spread shift
+ * @param rshift    the merged shift
+ * @param mask      the spread mask
+ * @param bits      the fixed bits of the blended pixel
+ *
+ * @return          the blended pixels count, the left pixels need be blended by the caller
+ */
+static lx_inline lx_size_t lx_pixmap_rgb16_pixels_blend_opt(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits) {
+#if defined(LX_ARCH_SIMD_DISPATCH)
+    return g_pixmap_rgb16_pixels_blend(p, s, count, alpha, lshift, rshift, mask, bits);
+#elif defined(LX_PIXMAP_ARCH_BLEND_AVX2)
+    return lx_pixmap_rgb16_pixels_blend_avx2(p, s, count, alpha, lshift, rshift, mask, bits);
+#else
+    return lx_pixmap_rgb16_pixels_blend_sse2(p, s, count, alpha, lshift, rshift, mask, bits);
+#endif
+}
+#endif
+
+#endif
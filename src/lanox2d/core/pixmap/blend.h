@@ -0,0 +1,44 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        blend.h
+ *
+ */
+#ifndef LX_CORE_PIXMAP_BLEND_H
+#define LX_CORE_PIXMAP_BLEND_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* the optimized blending of the translucent pixels
+ *
+ * the arch implementations only access the pixels with the native endian,
+ * so they are only used for the little-endian pixmaps on the little-endian host.
+ */
+#ifndef LX_WORDS_BIGENDIAN
+#   if defined(LX_ARCH_x86) || defined(LX_ARCH_x64)
+#       include "arch/x86/blend.h"
+#   elif defined(LX_ARCH_ARM)
+#       include "arch/arm/blend.h"
+#   endif
+#endif
+
+#endif
+
+
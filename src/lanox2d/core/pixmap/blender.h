@@ -0,0 +1,273 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        blender.h
+ *
+ */
+#ifndef LX_CORE_PIXMAP_BLENDER_H
+#define LX_CORE_PIXMAP_BLENDER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../paint.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// x / 255 with rounding, x must be in [0, 255 * 255]
+#define lx_pixmap_blender_div255(x)     ((((x) + 128) + (((x) + 128) >> 8)) >> 8)
+
+/* implement the pixels loader and storer of the given pixel format and endian
+ *
+ * the color_get and color_set functions are inlined into the span loops,
+ * so we get the specialized span kernels for each pixel format from the same template.
+ *
+ * it will define the blender: g_pixmap_blender_[e]_[fmt]
+ */
+#define LX_PIXMAP_BLENDER_IMPLEMENT(fmt, e, btp, opaque) \
+    static lx_void_t lx_pixmap_##fmt##_pixels_load_##e(lx_cpointer_t data, lx_color_t* colors, lx_size_t count) { \
+        lx_pixmap_blender_pixels_load((lx_byte_t const*)data, btp, colors, count, lx_pixmap_##fmt##_color_get_##e, opaque); \
+    } \
+    static lx_void_t lx_pixmap_##fmt##_pixels_store_##e(lx_pointer_t data, lx_color_t const* colors, lx_size_t count) { \
+        lx_pixmap_blender_pixels_store((lx_byte_t*)data, btp, colors, count, lx_pixmap_##fmt##_color_set_##e##o, opaque); \
+    } \
+    static lx_pixmap_blender_t const g_pixmap_blender_##e##_##fmt = { \
+        lx_pixmap_##fmt##_pixels_load_##e \
+    ,   lx_pixmap_##fmt##_pixels_store_##e \
+    ,   lx_null \
+    ,   lx_null \
+    };
+
+/* implement the pixels loader and storer of the given premultiplied pixel format and endian
+ *
+ * the pixels are already premultiplied, so we load and store the raw channels directly.
+ */
+#define LX_PIXMAP_BLENDER_IMPLEMENT_PREMUL(fmt, e, btp) \
+    static lx_void_t lx_pixmap_##fmt##_pixels_load_##e(lx_cpointer_t data, lx_color_t* colors, lx_size_t count) { \
+        lx_pixmap_blender_pixels_load_premul((lx_byte_t const*)data, btp, colors, count, lx_pixmap_##fmt##_raw_get_##e); \
+    } \
+    static lx_void_t lx_pixmap_##fmt##_pixels_store_##e(lx_pointer_t data, lx_color_t const* colors, lx_size_t count) { \
+        lx_pixmap_blender_pixels_store_premul((lx_byte_t*)data, btp, colors, count, lx_pixmap_##fmt##_raw_set_##e); \
+    } \
+    static lx_pixmap_blender_t const g_pixmap_blender_##e##_##fmt = { \
+        lx_pixmap_##fmt##_pixels_load_##e \
+    ,   lx_pixmap_##fmt##_pixels_store_##e \
+    ,   lx_null \
+    ,   lx_null \
+    };
+
+// no blender for the given pixel format and endian, e.g. this pixel format is disabled
+#define LX_PIXMAP_BLENDER_NONE(fmt, e) \
+    static lx_pixmap_blender_t const g_pixmap_blender_##e##_##fmt = {lx_null, lx_null, lx_null, lx_null};
+
+/* implement the blend functions of the given blend mode
+ *
+ * the blend mode function is inlined into the span loops, so there is no any per-pixel switch
+ */
+#define LX_PIXMAP_BLENDER_MODE_IMPLEMENT(mode) \
+    static lx_void_t lx_pixmap_blender_color_blend_##mode(lx_color_t* colors, lx_color_t color, lx_size_t count, lx_byte_t alpha) { \
+        lx_pixmap_blender_colors_blend(colors, &color, 0, count, alpha, lx_pixmap_blender_##mode); \
+    } \
+    static lx_void_t lx_pixmap_blender_colors_blend_##mode(lx_color_t* colors, lx_color_t const* source, lx_size_t count, lx_byte_t alpha) { \
+        lx_pixmap_blender_colors_blend(colors, source, 1, count, alpha, lx_pixmap_blender_##mode); \
+    }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the blend mode function, r = f(s, d, sa, da)
+ *
+ * all channels are premultiplied and in [0, 255], and s <= sa, d <= da,
+ * it's also used to blend the alpha channel with f(sa, da, sa, da).
+ */
+typedef lx_uint32_t (*lx_pixmap_blender_func_t)(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * blend modes
+ */
+static lx_inline_force lx_uint32_t lx_pixmap_blender_src_over(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return s + lx_pixmap_blender_div255(d * (255 - sa));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_clear(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return 0;
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_src(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return s;
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_dst(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return d;
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_dst_over(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return d + lx_pixmap_blender_div255(s * (255 - da));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_src_in(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(s * da);
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_dst_in(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(d * sa);
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_src_out(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(s * (255 - da));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_dst_out(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(d * (255 - sa));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_src_atop(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(s * da + d * (255 - sa));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_dst_atop(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(d * sa + s * (255 - da));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_xor(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(s * (255 - da) + d * (255 - sa));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_plus(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_min(s + d, 255);
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_multiply(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return lx_pixmap_blender_div255(s * (255 - da) + d * (255 - sa) + s * d);
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_screen(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return s + d - lx_pixmap_blender_div255(s * d);
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_darken(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return s + d - lx_pixmap_blender_div255(lx_max(s * da, d * sa));
+}
+
+static lx_inline_force lx_uint32_t lx_pixmap_blender_lighten(lx_uint32_t s, lx_uint32_t d, lx_uint32_t sa, lx_uint32_t da) {
+    return s + d - lx_pixmap_blender_div255(lx_min(s * da, d * sa));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+// load the premultiplied colors from the pixels, the alpha of the opaque pixel format is always 255
+static lx_inline_force lx_void_t lx_pixmap_blender_pixels_load(lx_byte_t const* p, lx_size_t btp, lx_color_t* colors, lx_size_t count, lx_pixmap_func_color_get_t color_get, lx_bool_t opaque) {
+    lx_byte_t const* e = p + count * btp;
+    for (; p < e; p += btp, colors++) {
+        lx_color_t color = color_get(p);
+        if (opaque) color.a = 0xff;
+        else if (color.a != 0xff) {
+            lx_uint32_t a = color.a;
+            color.r = (lx_byte_t)lx_pixmap_blender_div255(color.r * a);
+            color.g = (lx_byte_t)lx_pixmap_blender_div255(color.g * a);
+            color.b = (lx_byte_t)lx_pixmap_blender_div255(color.b * a);
+        }
+        *colors = color;
+    }
+}
+
+/* store the premultiplied colors to the pixels
+ *
+ * the colors will be unpremultiplied for the pixel format with alpha,
+ * and they are composited over black for the opaque pixel format.
+ */
+static lx_inline_force lx_void_t lx_pixmap_blender_pixels_store(lx_byte_t* p, lx_size_t btp, lx_color_t const* colors, lx_size_t count, lx_pixmap_func_color_set_t color_set, lx_bool_t opaque) {
+    lx_byte_t* e = p + count * btp;
+    for (; p < e; p += btp, colors++) {
+        lx_color_t  color = *colors;
+        lx_uint32_t a = color.a;
+        if (opaque || a == 0xff) color.a = 0xff;
+        else if (a) {
+            lx_uint32_t half = a >> 1;
+            color.r = (lx_byte_t)lx_min((color.r * 255 + half) / a, 255);
+            color.g = (lx_byte_t)lx_min((color.g * 255 + half) / a, 255);
+            color.b = (lx_byte_t)lx_min((color.b * 255 + half) / a, 255);
+        } else color = lx_color_make(0, 0, 0, 0);
+        color_set(p, color);
+    }
+}
+
+// load the premultiplied colors from the premultiplied pixels
+static lx_inline_force lx_void_t lx_pixmap_blender_pixels_load_premul(lx_byte_t const* p, lx_size_t btp, lx_color_t* colors, lx_size_t count, lx_pixmap_func_color_get_t color_get) {
+    lx_byte_t const* e = p + count * btp;
+    for (; p < e; p += btp, colors++) *colors = color_get(p);
+}
+
+// store the premultiplied colors to the premultiplied pixels
+static lx_inline_force lx_void_t lx_pixmap_blender_pixels_store_premul(lx_byte_t* p, lx_size_t btp, lx_color_t const* colors, lx_size_t count, lx_pixmap_func_color_set_t color_set) {
+    lx_byte_t* e = p + count * btp;
+    for (; p < e; p += btp, colors++) color_set(p, *colors);
+}
+
+/* blend the source colors to the premultiplied destination colors
+ *
+ * the source colors are not premultiplied, and we lerp the destination to the blended color by the coverage alpha.
+ *
+ * @param colors        the premultiplied destination colors
+ * @param source        the source colors
+ * @param step          the source step, it's zero for the solid color
+ * @param count         the colors count
+ * @param alpha         the coverage alpha
+ * @param blend         the blend mode function
+ */
+static lx_inline_force lx_void_t lx_pixmap_blender_colors_blend(lx_color_t* colors, lx_color_t const* source, lx_size_t step, lx_size_t count, lx_byte_t alpha, lx_pixmap_blender_func_t blend) {
+    lx_uint32_t ia = 0xff - alpha;
+    lx_color_t* e = colors + count;
+    for (; colors < e; colors++, source += step) {
+
+        // premultiply the source color
+        lx_uint32_t sa = source->a;
+        lx_uint32_t sr = lx_pixmap_blender_div255(source->r * sa);
+        lx_uint32_t sg = lx_pixmap_blender_div255(source->g * sa);
+        lx_uint32_t sb = lx_pixmap_blender_div255(source->b * sa);
+
+        // blend it
+        lx_uint32_t da = colors->a;
+        lx_uint32_t dr = colors->r;
+        lx_uint32_t dg = colors->g;
+        lx_uint32_t db = colors->b;
+        lx_uint32_t ra = blend(sa, da, sa, da);
+        lx_uint32_t rr = blend(sr, dr, sa, da);
+        lx_uint32_t rg = blend(sg, dg, sa, da);
+        lx_uint32_t rb = blend(sb, db, sa, da);
+
+        // lerp it by the coverage alpha
+        if (ia) {
+            ra = lx_pixmap_blender_div255(ra * alpha + da * ia);
+            rr = lx_pixmap_blender_div255(rr * alpha + dr * ia);
+            rg = lx_pixmap_blender_div255(rg * alpha + dg * ia);
+            rb = lx_pixmap_blender_div255(rb * alpha + db * ia);
+        }
+        colors->a = (lx_byte_t)ra;
+        colors->r = (lx_byte_t)rr;
+        colors->g = (lx_byte_t)rg;
+        colors->b = (lx_byte_t)rb;
+    }
+}
+
+#endif
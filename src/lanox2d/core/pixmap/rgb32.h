@@ -25,6 +25,7 @@
  * includes
  */
 #include "prefix.h"
+#include "blend.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
@@ -48,6 +49,45 @@ static lx_inline lx_uint32_t lx_pixmap_rgb32_blend2(lx_uint32_t d, lx_uint32_t h
     return (hd << 8) | ld;
 }
 
+// scale all channels of the rgb32 pixel, (p * a) >> 8, a: [0, 256]
+static lx_inline lx_uint32_t lx_pixmap_rgb32_scale(lx_uint32_t p, lx_uint32_t a) {
+    return ((((p >> 8) & 0x00ff00ff) * a) & 0xff00ff00) | ((((p & 0x00ff00ff) * a) >> 8) & 0x00ff00ff);
+}
+
+/* the src-over of the premultiplied rgb32 pixels, d = s + ((d * (256 - sa)) >> 8)
+ *
+ * it's only one multiply-add for each channel, the premultiplied channels of s must be not larger than sa
+ */
+static lx_inline lx_uint32_t lx_pixmap_rgb32_over(lx_uint32_t d, lx_uint32_t s, lx_uint32_t sa) {
+    return s + lx_pixmap_rgb32_scale(d, 256 - sa);
+}
+
+// premultiply the color, c * a / 255
+static lx_inline lx_color_t lx_pixmap_rgb32_color_premul(lx_color_t color) {
+    lx_uint32_t a = color.a;
+    if (a != 0xff) {
+        lx_uint32_t r = color.r * a + 128;
+        lx_uint32_t g = color.g * a + 128;
+        lx_uint32_t b = color.b * a + 128;
+        color.r = (lx_byte_t)((r + (r >> 8)) >> 8);
+        color.g = (lx_byte_t)((g + (g >> 8)) >> 8);
+        color.b = (lx_byte_t)((b + (b >> 8)) >> 8);
+    }
+    return color;
+}
+
+// unpremultiply the color, c * 255 / a
+static lx_inline lx_color_t lx_pixmap_rgb32_color_unpremul(lx_color_t color) {
+    lx_uint32_t a = color.a;
+    if (a && a != 0xff) {
+        lx_uint32_t half = a >> 1;
+        color.r = (lx_byte_t)lx_min((color.r * 255 + half) / a, 255);
+        color.g = (lx_byte_t)lx_min((color.g * 255 + half) / a, 255);
+        color.b = (lx_byte_t)lx_min((color.b * 255 + half) / a, 255);
+    } else if (!a) color = lx_color_make(0, 0, 0, 0);
+    return color;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
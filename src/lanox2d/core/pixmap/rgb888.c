@@ -25,6 +25,7 @@
 #include "prefix.h"
 #include "rgb24.h"
 #include "rgb32.h"
+#include "blender.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
@@ -194,3 +195,10 @@ static lx_pixmap_t const g_pixmap_ba_rgb888 = {
 #endif
 };
 
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGB888
+LX_PIXMAP_BLENDER_IMPLEMENT(rgb888, l, 3, lx_true)
+LX_PIXMAP_BLENDER_IMPLEMENT(rgb888, b, 3, lx_true)
+#else
+LX_PIXMAP_BLENDER_NONE(rgb888, l)
+LX_PIXMAP_BLENDER_NONE(rgb888, b)
+#endif
@@ -0,0 +1,234 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        rgba8888_premul.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "rgb32.h"
+#include "blender.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+
+/* the pixel is premultiplied, so the alpha of pixel_set and pixels_fill is only the coverage alpha,
+ * and we need not multiply the color alpha again.
+ */
+static lx_inline lx_pixel_t lx_pixmap_rgba8888_premul_raw_pixel(lx_color_t color) {
+    return ((lx_pixmap_rgb32_pixel(color) << 8) | color.a);
+}
+
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_raw_color(lx_pixel_t pixel) {
+    return lx_pixmap_rgb32_color((pixel >> 8) | (pixel << 24));
+}
+
+static lx_inline lx_pixel_t lx_pixmap_rgba8888_premul_pixel(lx_color_t color) {
+    return lx_pixmap_rgba8888_premul_raw_pixel(lx_pixmap_rgb32_color_premul(color));
+}
+
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_color(lx_pixel_t pixel) {
+    return lx_pixmap_rgb32_color_unpremul(lx_pixmap_rgba8888_premul_raw_color(pixel));
+}
+
+static lx_inline lx_uint32_t lx_pixmap_rgba8888_premul_over(lx_uint32_t d, lx_pixel_t pixel, lx_byte_t alpha) {
+    lx_uint32_t s = lx_pixmap_rgb32_scale(pixel, alpha + (alpha >> 7));
+    return lx_pixmap_rgb32_over(d, s, s & 0xff);
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixel_set_la(lx_pointer_t data, lx_pixel_t pixel, lx_byte_t alpha) {
+    lx_bits_set_u32_le(data, lx_pixmap_rgba8888_premul_over(lx_bits_get_u32_le(data), pixel, alpha));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixel_set_ba(lx_pointer_t data, lx_pixel_t pixel, lx_byte_t alpha) {
+    lx_bits_set_u32_be(data, lx_pixmap_rgba8888_premul_over(lx_bits_get_u32_be(data), pixel, alpha));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixel_copy_la(lx_pointer_t data, lx_cpointer_t source, lx_byte_t alpha) {
+    lx_bits_set_u32_le(data, lx_pixmap_rgba8888_premul_over(lx_bits_get_u32_le(data), lx_bits_get_u32_le(source), alpha));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixel_copy_ba(lx_pointer_t data, lx_cpointer_t source, lx_byte_t alpha) {
+    lx_bits_set_u32_be(data, lx_pixmap_rgba8888_premul_over(lx_bits_get_u32_be(data), lx_bits_get_u32_be(source), alpha));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_color_set_lo(lx_pointer_t data, lx_color_t color) {
+    lx_bits_set_u32_le(data, lx_pixmap_rgba8888_premul_pixel(color));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_color_set_bo(lx_pointer_t data, lx_color_t color) {
+    lx_bits_set_u32_be(data, lx_pixmap_rgba8888_premul_pixel(color));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_color_set_la(lx_pointer_t data, lx_color_t color) {
+    lx_pixel_t s = lx_pixmap_rgba8888_premul_pixel(color);
+    lx_bits_set_u32_le(data, lx_pixmap_rgb32_over(lx_bits_get_u32_le(data), s, color.a));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_color_set_ba(lx_pointer_t data, lx_color_t color) {
+    lx_pixel_t s = lx_pixmap_rgba8888_premul_pixel(color);
+    lx_bits_set_u32_be(data, lx_pixmap_rgb32_over(lx_bits_get_u32_be(data), s, color.a));
+}
+
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_color_get_l(lx_cpointer_t data) {
+    return lx_pixmap_rgba8888_premul_color(lx_bits_get_u32_le(data));
+}
+
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_color_get_b(lx_cpointer_t data) {
+    return lx_pixmap_rgba8888_premul_color(lx_bits_get_u32_be(data));
+}
+
+// get the premultiplied color without unpremultiplying it
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_raw_get_l(lx_cpointer_t data) {
+    return lx_pixmap_rgba8888_premul_raw_color(lx_bits_get_u32_le(data));
+}
+
+static lx_inline lx_color_t lx_pixmap_rgba8888_premul_raw_get_b(lx_cpointer_t data) {
+    return lx_pixmap_rgba8888_premul_raw_color(lx_bits_get_u32_be(data));
+}
+
+// set the premultiplied color without premultiplying it
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_raw_set_l(lx_pointer_t data, lx_color_t color) {
+    lx_bits_set_u32_le(data, lx_pixmap_rgba8888_premul_raw_pixel(color));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_raw_set_b(lx_pointer_t data, lx_color_t color) {
+    lx_bits_set_u32_be(data, lx_pixmap_rgba8888_premul_raw_pixel(color));
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixels_fill_la(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t    l = count & 0x3; count -= l;
+    lx_uint32_t* p = (lx_uint32_t*)data;
+    lx_uint32_t* e = p + count;
+    lx_uint32_t  s = lx_pixmap_rgb32_scale(pixel, alpha + (alpha >> 7));
+    lx_uint32_t  a = 256 - (s & 0xff);
+    while (p < e) {
+        lx_bits_set_u32_le(&p[0], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_le(&p[0]), a));
+        lx_bits_set_u32_le(&p[1], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_le(&p[1]), a));
+        lx_bits_set_u32_le(&p[2], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_le(&p[2]), a));
+        lx_bits_set_u32_le(&p[3], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_le(&p[3]), a));
+        p += 4;
+    }
+    while (l--) {
+        lx_bits_set_u32_le(&p[0], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_le(&p[0]), a));
+        p++;
+    }
+}
+
+static lx_inline lx_void_t lx_pixmap_rgba8888_premul_pixels_fill_ba(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+    lx_size_t    l = count & 0x3; count -= l;
+    lx_uint32_t* p = (lx_uint32_t*)data;
+    lx_uint32_t* e = p + count;
+    lx_uint32_t  s = lx_pixmap_rgb32_scale(pixel, alpha + (alpha >> 7));
+    lx_uint32_t  a = 256 - (s & 0xff);
+    while (p < e) {
+        lx_bits_set_u32_be(&p[0], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_be(&p[0]), a));
+        lx_bits_set_u32_be(&p[1], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_be(&p[1]), a));
+        lx_bits_set_u32_be(&p[2], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_be(&p[2]), a));
+        lx_bits_set_u32_be(&p[3], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_be(&p[3]), a));
+        p += 4;
+    }
+    while (l--) {
+        lx_bits_set_u32_be(&p[0], s + lx_pixmap_rgb32_scale(lx_bits_get_u32_be(&p[0]), a));
+        p++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+static lx_pixmap_t const g_pixmap_lo_rgba8888_premul = {
+    "rgba8888_premul"
+,   32
+,   4
+,   LX_PIXFMT_RGBA8888_PREMUL
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+,   lx_pixmap_rgba8888_premul_pixel
+,   lx_pixmap_rgba8888_premul_color
+,   lx_pixmap_rgb32_pixel_get_l
+,   lx_pixmap_rgb32_pixel_set_lo
+,   lx_pixmap_rgb32_pixel_copy_o
+,   lx_pixmap_rgba8888_premul_color_get_l
+,   lx_pixmap_rgba8888_premul_color_set_lo
+,   lx_pixmap_rgb32_pixels_fill_lo
+#endif
+};
+
+static lx_pixmap_t const g_pixmap_bo_rgba8888_premul = {
+    "rgba8888_premul"
+,   32
+,   4
+,   LX_PIXFMT_RGBA8888_PREMUL | LX_PIXFMT_BENDIAN
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+,   lx_pixmap_rgba8888_premul_pixel
+,   lx_pixmap_rgba8888_premul_color
+,   lx_pixmap_rgb32_pixel_get_b
+,   lx_pixmap_rgb32_pixel_set_bo
+,   lx_pixmap_rgb32_pixel_copy_o
+,   lx_pixmap_rgba8888_premul_color_get_b
+,   lx_pixmap_rgba8888_premul_color_set_bo
+,   lx_pixmap_rgb32_pixels_fill_bo
+#endif
+};
+
+static lx_pixmap_t const g_pixmap_la_rgba8888_premul = {
+    "rgba8888_premul"
+,   32
+,   4
+,   LX_PIXFMT_RGBA8888_PREMUL
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+,   lx_pixmap_rgba8888_premul_pixel
+,   lx_pixmap_rgba8888_premul_color
+,   lx_pixmap_rgb32_pixel_get_l
+,   lx_pixmap_rgba8888_premul_pixel_set_la
+,   lx_pixmap_rgba8888_premul_pixel_copy_la
+,   lx_pixmap_rgba8888_premul_color_get_l
+,   lx_pixmap_rgba8888_premul_color_set_la
+,   lx_pixmap_rgba8888_premul_pixels_fill_la
+#endif
+};
+
+static lx_pixmap_t const g_pixmap_ba_rgba8888_premul = {
+    "rgba8888_premul"
+,   32
+,   4
+,   LX_PIXFMT_RGBA8888_PREMUL | LX_PIXFMT_BENDIAN
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+,   lx_pixmap_rgba8888_premul_pixel
+,   lx_pixmap_rgba8888_premul_color
+,   lx_pixmap_rgb32_pixel_get_b
+,   lx_pixmap_rgba8888_premul_pixel_set_ba
+,   lx_pixmap_rgba8888_premul_pixel_copy_ba
+,   lx_pixmap_rgba8888_premul_color_get_b
+,   lx_pixmap_rgba8888_premul_color_set_ba
+,   lx_pixmap_rgba8888_premul_pixels_fill_ba
+#endif
+};
+
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBA8888_PREMUL
+LX_PIXMAP_BLENDER_IMPLEMENT_PREMUL(rgba8888_premul, l, 4)
+LX_PIXMAP_BLENDER_IMPLEMENT_PREMUL(rgba8888_premul, b, 4)
+#else
+LX_PIXMAP_BLENDER_NONE(rgba8888_premul, l)
+LX_PIXMAP_BLENDER_NONE(rgba8888_premul, b)
+#endif
+
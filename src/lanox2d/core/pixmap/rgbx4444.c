@@ -24,6 +24,7 @@
  */
 #include "prefix.h"
 #include "rgb16.h"
+#include "blender.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
@@ -119,6 +120,10 @@ static lx_inline lx_void_t lx_pixmap_rgbx4444_color_set_ba(lx_pointer_t data, lx
 }
 
 static lx_inline lx_void_t lx_pixmap_rgbx4444_pixels_fill_la(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+#ifdef LX_PIXMAP_ARCH_BLEND
+    lx_size_t    n = lx_pixmap_rgb16_pixels_blend_opt((lx_uint16_t*)data, (pixel | (pixel << 16)) & 0x0f00f0f0, count, alpha >> 3, 16, 16, 0x0f00f0f0, 0x000f);
+    data = (lx_uint16_t*)data + n; count -= n;
+#endif
     lx_size_t    l = count & 0x3; count -= l; alpha >>= 3;
     lx_uint16_t* p = (lx_uint16_t*)data;
     lx_uint16_t* e = p + count;
@@ -225,3 +230,11 @@ static lx_pixmap_t const g_pixmap_ba_rgbx4444 = {
 ,   lx_pixmap_rgbx4444_pixels_fill_ba
 #endif
 };
+
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBX4444
+LX_PIXMAP_BLENDER_IMPLEMENT(rgbx4444, l, 2, lx_true)
+LX_PIXMAP_BLENDER_IMPLEMENT(rgbx4444, b, 2, lx_true)
+#else
+LX_PIXMAP_BLENDER_NONE(rgbx4444, l)
+LX_PIXMAP_BLENDER_NONE(rgbx4444, b)
+#endif
@@ -24,6 +24,7 @@
  */
 #include "prefix.h"
 #include "rgb32.h"
+#include "blender.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -77,6 +78,10 @@ static lx_inline lx_color_t lx_pixmap_rgbx8888_color_get_b(lx_cpointer_t data) {
 }
 
 static lx_inline lx_void_t lx_pixmap_rgbx8888_pixels_fill_la(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+#ifdef LX_PIXMAP_ARCH_BLEND
+    lx_size_t    n = lx_pixmap_rgb32_pixels_blend_opt((lx_uint32_t*)data, pixel, count, alpha);
+    data = (lx_uint32_t*)data + n; count -= n;
+#endif
     lx_size_t    l = count & 0x3; count -= l;
     lx_uint32_t* p = (lx_uint32_t*)data;
     lx_uint32_t* e = p + count;
@@ -184,3 +189,11 @@ static lx_pixmap_t const g_pixmap_ba_rgbx8888 = {
 ,   lx_pixmap_rgbx8888_pixels_fill_ba
 #endif
 };
+
+#ifdef LX_CONFIG_PIXFMT_HAVE_RGBX8888
+LX_PIXMAP_BLENDER_IMPLEMENT(rgbx8888, l, 4, lx_true)
+LX_PIXMAP_BLENDER_IMPLEMENT(rgbx8888, b, 4, lx_true)
+#else
+LX_PIXMAP_BLENDER_NONE(rgbx8888, l)
+LX_PIXMAP_BLENDER_NONE(rgbx8888, b)
+#endif
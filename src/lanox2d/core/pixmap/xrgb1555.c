@@ -24,6 +24,7 @@
  */
 #include "prefix.h"
 #include "rgb16.h"
+#include "blender.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
@@ -119,6 +120,10 @@ static lx_inline lx_void_t lx_pixmap_xrgb1555_color_set_ba(lx_pointer_t data, lx
 }
 
 static lx_inline lx_void_t lx_pixmap_xrgb1555_pixels_fill_la(lx_pointer_t data, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha) {
+#ifdef LX_PIXMAP_ARCH_BLEND
+    lx_size_t    n = lx_pixmap_rgb16_pixels_blend_opt((lx_uint16_t*)data, (pixel | (pixel << 16)) & 0x3e07c1f, count, alpha >> 3, 15, 15, 0x3e07c1f, 0x8000);
+    data = (lx_uint16_t*)data + n; count -= n;
+#endif
     lx_size_t    l = count & 0x3; count -= l; alpha >>= 3;
     lx_uint16_t* p = (lx_uint16_t*)data;
     lx_uint16_t* e = p + count;
@@ -226,3 +231,10 @@ static lx_pixmap_t const g_pixmap_ba_xrgb1555 = {
 #endif
 };
 
+#ifdef LX_CONFIG_PIXFMT_HAVE_XRGB1555
+LX_PIXMAP_BLENDER_IMPLEMENT(xrgb1555, l, 2, lx_true)
+LX_PIXMAP_BLENDER_IMPLEMENT(xrgb1555, b, 2, lx_true)
+#else
+LX_PIXMAP_BLENDER_NONE(xrgb1555, l)
+LX_PIXMAP_BLENDER_NONE(xrgb1555, b)
+#endif
@@ -29,37 +29,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static lx_void_t lx_bezier2_make_line_impl(lx_point_t const points[3], lx_size_t count, lx_bezier2_line_cb_t callback, lx_cpointer_t udata) {
-    /* divide it
-     *
-     *
-     *                  p1
-     *                  .
-     *                .  .
-     *              .     .
-     *            .        .
-     *       o1 . . . . . . . o3
-     *        .      o2      .
-     *      .                 .
-     *    .                    .
-     * p0, o0                p2, o4
-     *
-     */
-    if (count) {
-        // chop the quad at half
-        lx_point_t output[5];
-        lx_bezier2_chop_at_half(points, output);
-
-        // make line for quad(o0, o1, o2)
-        lx_bezier2_make_line_impl(output, count - 1, callback, udata);
-
-        // make line to quad(o2, o3, o4)
-        lx_bezier2_make_line_impl(output + 2, count - 1, callback, udata);
-    } else {
-        callback((lx_point_ref_t)&points[2], udata);
-    }
-}
-
 static lx_void_t lx_bezier2_chop_xy_at(lx_float_t const* xy, lx_float_t* output, lx_float_t factor) {
     // compute the interpolation of p0 => p1
     lx_float_t xy01 = lx_interp(xy[0], xy[2], factor);
@@ -188,7 +157,36 @@ lx_size_t lx_bezier2_divide_line_count(lx_point_t const points[3]) {
     lx_assert(distance >= 0);
 
     // get the integer distance
-    lx_uint32_t idistance = (lx_uint32_t)lx_ceil(distance);
+    lx_uint32_t idistance = distance < 65536.0f? (lx_uint32_t)lx_ceil(distance) : 65536;
+
+    // compute the divided count
+    lx_uint32_t count = (lx_ilog2i(idistance) >> 1) + 1;
+    if (count > LX_BEZIER2_DIVIDED_MAXN) {
+        count = LX_BEZIER2_DIVIDED_MAXN;
+    }
+    return (lx_size_t)count;
+}
+
+lx_size_t lx_bezier2_divide_line_count_scaled(lx_point_t const points[3], lx_float_t scale) {
+    // check
+    lx_assert(points && scale > 0);
+
+    // the unscaled curve is divided as before, the flat tolerance is only used for the scaled curve
+    if (scale == 1.0f) {
+        return lx_bezier2_divide_line_count(points);
+    }
+
+    // compute the approximate distance in the device space
+    lx_float_t distance = lx_bezier2_near_distance(points) * scale;
+    lx_assert(distance >= 0);
+
+    // it is almost a line at this scale? only line-to the end point
+    if (distance < LX_BEZIER2_DIVIDED_FLAT) {
+        return 0;
+    }
+
+    // get the integer distance
+    lx_uint32_t idistance = distance < 65536.0f? (lx_uint32_t)lx_ceil(distance) : 65536;
 
     // compute the divided count
     lx_uint32_t count = (lx_ilog2i(idistance) >> 1) + 1;
@@ -254,8 +252,60 @@ lx_size_t lx_bezier2_chop_at_max_curvature(lx_point_t const points[3], lx_point_
     return count;
 }
 
+lx_size_t lx_bezier2_make_line_points(lx_point_t const points[3], lx_size_t count, lx_point_ref_t output) {
+    lx_assert(points && output && count <= LX_BEZIER2_DIVIDED_MAXN);
+
+    /* make the uniform points by the forward differencing, it's same as dividing it at half recursively
+     *
+     * P(t) = A * t^2 + B * t + p0
+     *
+     * A = p0 - 2 * p1 + p2
+     * B = 2 * (p1 - p0)
+     *
+     * step: h = 1 / n
+     *
+     * D1 = P(t + h) - P(t) = A * h^2 + B * h (t = 0), and D1 += D2 for the next step
+     * D2 = D1(t + h) - D1(t) = 2 * A * h^2
+     */
+    lx_size_t  n = (lx_size_t)1 << count;
+    lx_float_t h = 1.0f / (lx_float_t)n;
+    lx_float_t hh = h * h;
+    lx_float_t ax = points[0].x - points[1].x - points[1].x + points[2].x;
+    lx_float_t ay = points[0].y - points[1].y - points[1].y + points[2].y;
+    lx_float_t bx = (points[1].x - points[0].x) * 2;
+    lx_float_t by = (points[1].y - points[0].y) * 2;
+    lx_float_t d1x = ax * hh + bx * h;
+    lx_float_t d1y = ay * hh + by * h;
+    lx_float_t d2x = (ax * hh) * 2;
+    lx_float_t d2y = (ay * hh) * 2;
+    lx_float_t x = points[0].x;
+    lx_float_t y = points[0].y;
+    lx_size_t  i;
+    for (i = 1; i < n; i++) {
+        x += d1x;
+        y += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        output->x = x;
+        output->y = y;
+        output++;
+    }
+
+    // using the end point directly to avoid the accumulated error
+    *output = points[2];
+    return n;
+}
+
 lx_void_t lx_bezier2_make_line(lx_point_t const points[3], lx_bezier2_line_cb_t callback, lx_cpointer_t udata) {
+    lx_bezier2_make_line_scaled(points, 1.0f, callback, udata);
+}
+
+lx_void_t lx_bezier2_make_line_scaled(lx_point_t const points[3], lx_float_t scale, lx_bezier2_line_cb_t callback, lx_cpointer_t udata) {
     lx_assert(callback && points);
-    lx_size_t count = lx_bezier2_divide_line_count(points);
-    lx_bezier2_make_line_impl(points, count, callback, udata);
+    lx_point_t output[1 << LX_BEZIER2_DIVIDED_MAXN];
+    lx_size_t  count = lx_bezier2_make_line_points(points, lx_bezier2_divide_line_count_scaled(points, scale), output);
+    lx_size_t  i;
+    for (i = 0; i < count; i++) {
+        callback(&output[i], udata);
+    }
 }
@@ -38,6 +38,9 @@ lx_extern_c_enter
 // the max quadratic curve divided count
 #define LX_BEZIER2_DIVIDED_MAXN          (5)
 
+// the max near distance of the scaled quadratic curve which can be approached by only one line-to
+#define LX_BEZIER2_DIVIDED_FLAT          (0.25f)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -82,6 +85,18 @@ lx_float_t          lx_bezier2_near_distance(lx_point_t const points[3]);
  */
 lx_size_t           lx_bezier2_divide_line_count(lx_point_t const points[3]);
 
+/* compute the approximate divided count for approaching the line-to in the scaled space
+ *
+ * it's the same as lx_bezier2_divide_line_count() if the scale is 1,
+ * otherwise the curve will be only one line-to if it's almost flat in the scaled space.
+ *
+ * @param points    the points
+ * @param scale     the max scale of the matrix, the error will be bounded in the scaled space
+ *
+ * @return          the approximate divided count
+ */
+lx_size_t           lx_bezier2_divide_line_count_scaled(lx_point_t const points[3], lx_float_t scale);
+
 /* chop the quad curve at the given position
  *
  *               chop
@@ -138,6 +153,19 @@ lx_void_t           lx_bezier2_chop_at_half(lx_point_t const points[3], lx_point
  */
 lx_size_t           lx_bezier2_chop_at_max_curvature(lx_point_t const points[3], lx_point_t output[5]);
 
+/* make the line-to points of the quadratic curve to the given output buffer directly
+ *
+ * the curve will be divided into 2^count lines with the uniform steps by the forward differencing,
+ * and the start point will not be written.
+ *
+ * @param points    the points
+ * @param count     the divided count, lx_bezier2_divide_line_count() or lx_bezier2_divide_line_count_scaled()
+ * @param output    the output points, at least 2^count points
+ *
+ * @return          the written points count, 2^count
+ */
+lx_size_t           lx_bezier2_make_line_points(lx_point_t const points[3], lx_size_t count, lx_point_ref_t output);
+
 /* make line-to points for the quadratic curve
  *
  * @param points    the points
@@ -146,6 +174,15 @@ lx_size_t           lx_bezier2_chop_at_max_curvature(lx_point_t const points[3],
  */
 lx_void_t           lx_bezier2_make_line(lx_point_t const points[3], lx_bezier2_line_cb_t callback, lx_cpointer_t udata);
 
+/* make line-to points for the quadratic curve in the scaled space
+ *
+ * @param points    the points
+ * @param scale     the max scale of the matrix
+ * @param callback  the make callback
+ * @param udata     the make callback private data for user
+ */
+lx_void_t           lx_bezier2_make_line_scaled(lx_point_t const points[3], lx_float_t scale, lx_bezier2_line_cb_t callback, lx_cpointer_t udata);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -29,39 +29,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static lx_void_t lx_bezier3_make_line_impl(lx_point_t const points[4], lx_size_t count, lx_bezier3_line_cb_t callback, lx_cpointer_t udata) {
-    /* divide it
-     *
-     *          p1                 p2
-     *          . . . . . . . . . . .
-     *         .                     .
-     *        .    o2 . . . . . o4    .
-     *       .           o3            .
-     *   o1 .             |             . o5
-     *     .            chop             .
-     *    .                               .
-     *   .                                 .
-     *  .                                   .
-     * .                                     .
-     * p0, o0                                p3, o6
-     *
-     */
-    if (count) {
-        // chop the cubic at half
-        lx_point_t output[7];
-        lx_bezier3_chop_at_half(points, output);
-
-        // make line for cubic(o0, o1, o2, o3)
-        lx_bezier3_make_line_impl(output, count - 1, callback, udata);
-
-        // make line to cubic(o3, o4, o5, o6)
-        lx_bezier3_make_line_impl(output + 3, count - 1, callback, udata);
-    }
-    else {
-        callback((lx_point_ref_t)&points[3], udata);
-    }
-}
-
 static lx_void_t lx_bezier3_chop_xy_at(lx_float_t const* xy, lx_float_t* output, lx_float_t factor) {
     // compute the interpolation of p0 => p1
     lx_float_t xy01 = lx_interp(xy[0], xy[2], factor);
@@ -134,6 +101,7 @@ lx_float_t lx_bezier3_near_distance(lx_point_t const points[4]) {
 }
 
 lx_size_t lx_bezier3_divide_line_count(lx_point_t const points[4]) {
+    // check
     lx_assert(points);
 
     // compute the approximate distance
@@ -141,7 +109,54 @@ lx_size_t lx_bezier3_divide_line_count(lx_point_t const points[4]) {
     lx_assert(distance >= 0);
 
     // get the integer distance
-    lx_uint32_t idistance = (lx_uint32_t)lx_ceil(distance);
+    lx_uint32_t idistance = distance < 65536.0f? (lx_uint32_t)lx_ceil(distance) : 65536;
+
+    // compute the divided count
+    lx_uint32_t count = (lx_ilog2i(idistance) >> 1) + 1;
+    if (count > LX_BEZIER3_DIVIDED_MAXN) {
+        count = LX_BEZIER3_DIVIDED_MAXN;
+    }
+    return (lx_size_t)count;
+}
+
+lx_size_t lx_bezier3_divide_line_count_scaled(lx_point_t const points[4], lx_float_t scale) {
+    // check
+    lx_assert(points && scale > 0);
+
+    // the unscaled curve is divided as before, the flat tolerance is only used for the scaled curve
+    if (scale == 1.0f) {
+        return lx_bezier3_divide_line_count(points);
+    }
+
+    /* compute the approximate distance in the device space
+     *
+     * the near distance of the control points does not bound the flattening error of the cubic curve,
+     * so we use the second differences: P''(t) = 6 * ((1 - t) * (p0 - 2 * p1 + p2) + t * (p1 - 2 * p2 + p3))
+     *
+     * the error of the n uniform lines: max(|P''|) / (8 * n^2) <= 3 * max(|d0|, |d1|) / (4 * n^2)
+     *
+     * it's the same as the quadratic curve with the near distance: 3 * max(|d0|, |d1|) / 2
+     */
+    lx_float_t d0x = points[0].x - points[1].x - points[1].x + points[2].x;
+    lx_float_t d0y = points[0].y - points[1].y - points[1].y + points[2].y;
+    lx_float_t d1x = points[1].x - points[2].x - points[2].x + points[3].x;
+    lx_float_t d1y = points[1].y - points[2].y - points[2].y + points[3].y;
+    d0x = lx_abs(d0x);
+    d0y = lx_abs(d0y);
+    d1x = lx_abs(d1x);
+    d1y = lx_abs(d1y);
+    lx_float_t d0 = (d0x > d0y)? (d0x + lx_half(d0y)) : (d0y + lx_half(d0x));
+    lx_float_t d1 = (d1x > d1y)? (d1x + lx_half(d1y)) : (d1y + lx_half(d1x));
+    lx_float_t distance = lx_max(d0, d1) * 1.5f * scale;
+    lx_assert(distance >= 0);
+
+    // it is almost a line at this scale? only line-to the end point
+    if (distance < LX_BEZIER3_DIVIDED_FLAT) {
+        return 0;
+    }
+
+    // get the integer distance
+    lx_uint32_t idistance = distance < 65536.0f? (lx_uint32_t)lx_ceil(distance) : 65536;
 
     // compute the divided count
     lx_uint32_t count = (lx_ilog2i(idistance) >> 1) + 1;
@@ -259,9 +274,70 @@ lx_size_t lx_bezier3_chop_at_max_curvature(lx_point_t const points[4], lx_point_
     return factors_count + 1;
 }
 
+lx_size_t lx_bezier3_make_line_points(lx_point_t const points[4], lx_size_t count, lx_point_ref_t output) {
+    lx_assert(points && output && count <= LX_BEZIER3_DIVIDED_MAXN);
+
+    /* make the uniform points by the forward differencing, it's same as dividing it at half recursively
+     *
+     * P(t) = A * t^3 + B * t^2 + C * t + p0
+     *
+     * A = p3 - 3 * p2 + 3 * p1 - p0
+     * B = 3 * (p2 - 2 * p1 + p0)
+     * C = 3 * (p1 - p0)
+     *
+     * step: h = 1 / n
+     *
+     * D1 = A * h^3 + B * h^2 + C * h (t = 0), and D1 += D2, D2 += D3 for the next step
+     * D2 = 6 * A * h^3 + 2 * B * h^2 (t = 0)
+     * D3 = 6 * A * h^3
+     */
+    lx_size_t  n = (lx_size_t)1 << count;
+    lx_float_t h = 1.0f / (lx_float_t)n;
+    lx_float_t hh = h * h;
+    lx_float_t hhh = hh * h;
+    lx_float_t ax = points[3].x - points[0].x + (points[1].x - points[2].x) * 3;
+    lx_float_t ay = points[3].y - points[0].y + (points[1].y - points[2].y) * 3;
+    lx_float_t bx = (points[2].x - points[1].x - points[1].x + points[0].x) * 3;
+    lx_float_t by = (points[2].y - points[1].y - points[1].y + points[0].y) * 3;
+    lx_float_t cx = (points[1].x - points[0].x) * 3;
+    lx_float_t cy = (points[1].y - points[0].y) * 3;
+    lx_float_t d3x = (ax * hhh) * 6;
+    lx_float_t d3y = (ay * hhh) * 6;
+    lx_float_t d2x = d3x + (bx * hh) * 2;
+    lx_float_t d2y = d3y + (by * hh) * 2;
+    lx_float_t d1x = ax * hhh + bx * hh + cx * h;
+    lx_float_t d1y = ay * hhh + by * hh + cy * h;
+    lx_float_t x = points[0].x;
+    lx_float_t y = points[0].y;
+    lx_size_t  i;
+    for (i = 1; i < n; i++) {
+        x += d1x;
+        y += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        d2x += d3x;
+        d2y += d3y;
+        output->x = x;
+        output->y = y;
+        output++;
+    }
+
+    // using the end point directly to avoid the accumulated error
+    *output = points[3];
+    return n;
+}
+
 lx_void_t lx_bezier3_make_line(lx_point_t const points[4], lx_bezier3_line_cb_t callback, lx_cpointer_t udata) {
+    lx_bezier3_make_line_scaled(points, 1.0f, callback, udata);
+}
+
+lx_void_t lx_bezier3_make_line_scaled(lx_point_t const points[4], lx_float_t scale, lx_bezier3_line_cb_t callback, lx_cpointer_t udata) {
     lx_assert(callback && points);
-    lx_size_t count = lx_bezier3_divide_line_count(points);
-    lx_bezier3_make_line_impl(points, count, callback, udata);
+    lx_point_t output[1 << LX_BEZIER3_DIVIDED_MAXN];
+    lx_size_t  count = lx_bezier3_make_line_points(points, lx_bezier3_divide_line_count_scaled(points, scale), output);
+    lx_size_t  i;
+    for (i = 0; i < count; i++) {
+        callback(&output[i], udata);
+    }
 }
 
@@ -38,6 +38,9 @@ lx_extern_c_enter
 // the max cubic curve divided count
 #define LX_BEZIER3_DIVIDED_MAXN          (6)
 
+// the max near distance of the scaled cubic curve which can be approached by only one line-to
+#define LX_BEZIER3_DIVIDED_FLAT          (0.25f)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -80,6 +83,18 @@ lx_float_t          lx_bezier3_near_distance(lx_point_t const points[4]);
  */
 lx_size_t           lx_bezier3_divide_line_count(lx_point_t const points[4]);
 
+/* compute the approximate divided count for approaching the line-to in the scaled space
+ *
+ * it's the same as lx_bezier3_divide_line_count() if the scale is 1,
+ * otherwise the curve will be only one line-to if it's almost flat in the scaled space.
+ *
+ * @param points    the points
+ * @param scale     the max scale of the matrix, the error will be bounded in the scaled space
+ *
+ * @return          the approximate divided count
+ */
+lx_size_t           lx_bezier3_divide_line_count_scaled(lx_point_t const points[4], lx_float_t scale);
+
 /* chop the cubic curve at the given position
  *
  *               chop
@@ -146,6 +161,19 @@ lx_void_t           lx_bezier3_chop_at_half(lx_point_t const points[4], lx_point
  */
 lx_size_t           lx_bezier3_chop_at_max_curvature(lx_point_t const points[4], lx_point_t output[13]);
 
+/* make the line-to points of the cubic curve to the given output buffer directly
+ *
+ * the curve will be divided into 2^count lines with the uniform steps by the forward differencing,
+ * and the start point will not be written.
+ *
+ * @param points    the points
+ * @param count     the divided count, lx_bezier3_divide_line_count() or lx_bezier3_divide_line_count_scaled()
+ * @param output    the output points, at least 2^count points
+ *
+ * @return          the written points count, 2^count
+ */
+lx_size_t           lx_bezier3_make_line_points(lx_point_t const points[4], lx_size_t count, lx_point_ref_t output);
+
 /* make line-to points for the cubic curve
  *
  * @param points    the points
@@ -154,6 +182,15 @@ lx_size_t           lx_bezier3_chop_at_max_curvature(lx_point_t const points[4],
  */
 lx_void_t           lx_bezier3_make_line(lx_point_t const points[4], lx_bezier3_line_cb_t callback, lx_cpointer_t udata);
 
+/* make line-to points for the cubic curve in the scaled space
+ *
+ * @param points    the points
+ * @param scale     the max scale of the matrix
+ * @param callback  the make callback
+ * @param udata     the make callback private data for user
+ */
+lx_void_t           lx_bezier3_make_line_scaled(lx_point_t const points[4], lx_float_t scale, lx_bezier3_line_cb_t callback, lx_cpointer_t udata);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -143,6 +143,9 @@
 /// pixfmt ok?
 #define LX_PIXFMT_OK(pixfmt)        (LX_PIXFMT(pixfmt) != LX_PIXFMT_NONE)
 
+/// is premultiplied alpha?
+#define LX_PIXFMT_IS_PREMUL(pixfmt) (LX_PIXFMT(pixfmt) == LX_PIXFMT(LX_PIXFMT_ARGB8888_PREMUL) || LX_PIXFMT(pixfmt) == LX_PIXFMT(LX_PIXFMT_RGBA8888_PREMUL))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -183,6 +186,9 @@ typedef enum lx_pixfmt_t_ {
 ,   LX_PIXFMT_BGRA8888      = 28    | LX_PIXFMT_ALPHA       //!< 32-bit b g r a: 8 8 8 8
 ,   LX_PIXFMT_BGRX8888      = 29                            //!< 32-bit b g r x: 8 8 8 8
 
+,   LX_PIXFMT_ARGB8888_PREMUL = 30  | LX_PIXFMT_ALPHA       //!< 32-bit a r g b: 8 8 8 8, the color channels are premultiplied by alpha
+,   LX_PIXFMT_RGBA8888_PREMUL = 31  | LX_PIXFMT_ALPHA       //!< 32-bit r g b a: 8 8 8 8, the color channels are premultiplied by alpha
+
 }lx_pixfmt_t;
 
 #endif
@@ -43,7 +43,7 @@ lx_extern_c_enter
  * @param total     the total count
  * @param convex    is convex?
  */
-static lx_inline lx_void_t lx_polygon_make(lx_polygon_ref_t polygon, lx_point_ref_t points, lx_uint16_t* counts, lx_size_t total, lx_bool_t convex) {
+static lx_inline lx_void_t lx_polygon_make(lx_polygon_ref_t polygon, lx_point_ref_t points, lx_uint32_t* counts, lx_size_t total, lx_bool_t convex) {
     polygon->points = points;
     polygon->counts = counts;
     polygon->total  = total;
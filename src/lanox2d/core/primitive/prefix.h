@@ -31,11 +31,15 @@
  * macros
  */
 
-/// the max width
-#define LX_WIDTH_MAX           (8192)
+/*! the max width
+ *
+ * the device coordinates are rasterized with the 16.16 fixed-point numbers,
+ * so the width and height are limited to the 16-bits signed integer range.
+ */
+#define LX_WIDTH_MAX           (32767)
 
 /// the max height
-#define LX_HEIGHT_MAX          (8192)
+#define LX_HEIGHT_MAX          (32767)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -68,6 +72,9 @@ typedef lx_typeref(clipper);
 /// the path ref type
 typedef lx_typeref(path);
 
+/// the picture ref type
+typedef lx_typeref(picture);
+
 /*! @def the color type
  *
  * the color type
@@ -196,13 +203,13 @@ typedef struct lx_arc_t_ {
  * @code
     lx_point_t      points[] = {    {x0, y0}, {x1, y1}, {x2, y2}
                                 ,   {x3, y3}, {x4, y4}, {x5, y5}, {x3, y3}};
-    lx_size_t       counts[] = {3, 4, 0};
+    lx_uint32_t     counts[] = {3, 4, 0};
     lx_polygon_t    polygon = {points, counts, 7};
  * @endcode
  */
 typedef struct lx_polygon_t_ {
     lx_point_ref_t      points;
-    lx_uint16_t*        counts;
+    lx_uint32_t*        counts;
     lx_size_t           total; // the total count of points
     lx_bool_t           convex;
 }lx_polygon_t, *lx_polygon_ref_t;
@@ -38,6 +38,7 @@ lx_void_t lx_round_rect_make(lx_round_rect_ref_t rect, lx_rect_ref_t bounds, lx_
     rect->radius[1] = radius[1];
     rect->radius[2] = radius[2];
     rect->radius[3] = radius[3];
+    rect->bounds    = *bounds;
 }
 
 lx_void_t lx_round_rect_make_same(lx_round_rect_ref_t rect, lx_rect_ref_t bounds, lx_float_t rx, lx_float_t ry) {
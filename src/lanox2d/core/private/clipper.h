@@ -0,0 +1,102 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        clipper.h
+ *
+ */
+#ifndef LX_CORE_PRIVATE_CLIPPER_H
+#define LX_CORE_PRIVATE_CLIPPER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the clipper item type enum
+typedef enum lx_clipper_item_type_e_ {
+    LX_CLIPPER_ITEM_TYPE_NONE       = 0
+,   LX_CLIPPER_ITEM_TYPE_PATH       = 1
+,   LX_CLIPPER_ITEM_TYPE_TRIANGLE   = 2
+,   LX_CLIPPER_ITEM_TYPE_RECT       = 3
+,   LX_CLIPPER_ITEM_TYPE_ROUND_RECT = 4
+,   LX_CLIPPER_ITEM_TYPE_CIRCLE     = 5
+,   LX_CLIPPER_ITEM_TYPE_ELLIPSE    = 6
+}lx_clipper_item_type_e;
+
+// the clipper item type
+typedef struct lx_clipper_item_t_ {
+    lx_uint8_t              type;
+    lx_uint8_t              mode;
+    lx_uint8_t              rule;
+    lx_matrix_t             matrix;
+    union {
+        lx_path_ref_t       path;
+        lx_triangle_t       triangle;
+        lx_rect_t           rect;
+        lx_round_rect_t     round_rect;
+        lx_circle_t         circle;
+        lx_ellipse_t        ellipse;
+    }u;
+}lx_clipper_item_t, *lx_clipper_item_ref_t;
+
+// the clipper type
+typedef struct lx_clipper_t_ {
+    lx_array_ref_t          items;
+    lx_matrix_t             matrix;
+    lx_size_t               rule;
+}lx_clipper_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_enter
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* is the clipper equal to the other clipper? all items need be same
+ *
+ * @param clipper           the clipper
+ * @param other             the other clipper
+ *
+ * @return                  lx_true or lx_false
+ */
+lx_bool_t                   lx_clipper_equal(lx_clipper_ref_t clipper, lx_clipper_ref_t other);
+
+/* add all items of the other clipper in order
+ *
+ * the matrix of each added item will be multiplied by the given matrix at the left side.
+ *
+ * @param clipper           the clipper
+ * @param other             the other clipper
+ * @param matrix            the base matrix
+ */
+lx_void_t                   lx_clipper_add_clipper(lx_clipper_ref_t clipper, lx_clipper_ref_t other, lx_matrix_ref_t matrix);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+lx_extern_c_leave
+
+#endif
+
+
@@ -71,7 +71,7 @@ static lx_void_t lx_object_stack_object_exit(lx_size_t type, lx_handle_t object)
         lx_paint_exit((lx_paint_ref_t)object);
         break;
     case LX_OBJECT_STACK_TYPE_CLIPPER:
-        //lx_clipper_exit((lx_clipper_ref_t)object);
+        lx_clipper_exit((lx_clipper_ref_t)object);
         break;
     default:
         break;
@@ -88,7 +88,7 @@ static lx_void_t lx_object_stack_object_copy(lx_size_t type, lx_handle_t object,
         lx_paint_copy((lx_paint_ref_t)object, (lx_paint_ref_t)copied);
         break;
     case LX_OBJECT_STACK_TYPE_CLIPPER:
-        //lx_clipper_copy((lx_clipper_ref_t)object, (lx_clipper_ref_t)copied);
+        lx_clipper_copy((lx_clipper_ref_t)object, (lx_clipper_ref_t)copied);
         break;
     default:
         break;
@@ -0,0 +1,54 @@
+/*!A lightweight and fast 2D vector graphics engine
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2021-present, Lanox2D Open Source Group.
+ *
+ * @author      ruki
+ * @file        paint.h
+ *
+ */
+#ifndef LX_CORE_PRIVATE_PAINT_H
+#define LX_CORE_PRIVATE_PAINT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../paint.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the paint type
+typedef struct lx_paint_t_ {
+    lx_uint32_t      mode    : 4;
+    lx_uint32_t      flags   : 4;
+    lx_uint32_t      cap     : 4;
+    lx_uint32_t      join    : 4;
+    lx_uint32_t      rule    : 1;
+    lx_uint32_t      blend   : 5;
+    lx_color_t       color;
+    lx_byte_t        alpha;
+    lx_float_t       width;
+    lx_float_t       miter;
+    lx_shader_ref_t shader;
+    lx_uint8_t       dash_count;
+    lx_float_t       dash_phase;
+    lx_float_t       dash[LX_PAINT_STROKE_DASH_MAXN];
+}lx_paint_t;
+
+#endif
+
+
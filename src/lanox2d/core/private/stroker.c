@@ -24,6 +24,7 @@
 #include "stroker.h"
 #include "../path.h"
 #include "../paint.h"
+#include "../quality.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -32,6 +33,38 @@
 // cos(179.55c): -0.9999691576f
 #define LX_STROKER_TOO_SHARP_LIMIT       (-0.9999691576f)
 
+// the points grow of the direct stroked polygon
+#ifdef LX_CONFIG_SMALL
+#   define LX_STROKER_POLYGON_POINTS_GROW   (64)
+#else
+#   define LX_STROKER_POLYGON_POINTS_GROW   (256)
+#endif
+
+// the max device error of the round joins and caps of the streamed outline
+#define LX_STROKER_OUTLINE_ARC_ERROR        (0.1f)
+
+// the max points count of the round joins and caps for the half circle
+#define LX_STROKER_OUTLINE_ARC_MAXN         (64)
+
+// the max error of the offset curves in the user space, it will be divided by the matrix scale octave
+#define LX_STROKER_OFFSET_ERROR             (1.0f / 8)
+
+// the max matrix scale octave of the offset curves error
+#define LX_STROKER_OFFSET_OCTAVE_MAXN       (12)
+
+// the max dash pieces count of one contour, it will be stroked as solid if there are too many tiny dashes
+#define LX_STROKER_DASH_PIECES_MAXN         (1 << 20)
+
+// the buckets count of the stroked path cache
+#ifdef LX_CONFIG_SMALL
+#   define LX_STROKER_CACHE_BUCKETS         (64)
+#else
+#   define LX_STROKER_CACHE_BUCKETS         (256)
+#endif
+
+// the estimated base size of the cached path object, excluding its points
+#define LX_STROKER_CACHE_PATH_SIZE          (256)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -68,6 +101,55 @@ typedef enum lx_stroker_joiner_angle_type_e {
 ,   LX_STROKER_JOINER_ANGLE_SHARP   = 3
 }lx_stroker_joiner_angle_type_e;
 
+/* the stroked path cache entry type
+ *
+ * the key is the source path identity (address and generation) and the stroke parameters,
+ * and the stroked path is owned by this entry.
+ *
+ * the offset error of the stroked path is bounded by the matrix scale octave, so it's also a part of the key,
+ * and it can be reused for all zoom levels in the same octave, its curves will be flattened for the current matrix scale.
+ */
+typedef struct lx_stroker_cache_entry_t_ {
+
+    // the list entry of the lru order, the head is the least recently used entry
+    lx_list_entry_t                         entry;
+
+    // the next entry of the same bucket
+    struct lx_stroker_cache_entry_t_*       next;
+
+    // the source path, it's only used as the identity and will not be accessed
+    lx_cpointer_t                           path;
+
+    // the generation of the source path
+    lx_size_t                               generation;
+
+    // the stroke width
+    lx_float_t                              width;
+
+    // the miter limit
+    lx_float_t                              miter;
+
+    // the cap and join
+    lx_uint8_t                              cap;
+    lx_uint8_t                              join;
+
+    // the matrix scale class of the estimated memory size
+    lx_uint16_t                             scale;
+
+    // the matrix scale octave of the offset curves error
+    lx_uint8_t                              octave;
+
+    // the bucket index
+    lx_uint16_t                             bucket;
+
+    // the estimated memory size
+    lx_size_t                               size;
+
+    // the stroked path
+    lx_path_ref_t                           stroked;
+
+}lx_stroker_cache_entry_t;
+
 // the stroker stroker type
 typedef struct __lx_stroker_t {
 
@@ -131,8 +213,72 @@ typedef struct __lx_stroker_t {
     // the joiner
     lx_stroker_joiner_t     joiner;
 
+    // the points of the direct stroked polygon
+    lx_array_ref_t          polygon_points;
+
+    // the counts of the direct stroked polygon
+    lx_array_ref_t          polygon_counts;
+
+    // the direct stroked polygon
+    lx_polygon_t            polygon;
+
+    // the flattened points of the current contour for streaming the stroked outline or dashing it
+    lx_array_ref_t          contour_points;
+
+    // the right side points of the current streamed outline, it will be reversed and appended to the polygon
+    lx_array_ref_t          outline_right;
+
+    // the angle step of the round joins and caps of the streamed outline
+    lx_float_t              outline_arc_step;
+
+    // the max tan(a / 2) of the smooth joins of the streamed outline, we only add the intersection points for them
+    lx_float_t              outline_smooth_tan;
+
+    // the dash intervals, the stroke is solid if the count is zero
+    lx_float_t              dash[LX_PAINT_STROKE_DASH_MAXN];
+    lx_size_t               dash_count;
+
+    // the total length of the dash intervals
+    lx_float_t              dash_length;
+
+    // the start interval of each contour after applying the dash phase
+    lx_size_t               dash_index;
+
+    // the remaining length of the start interval
+    lx_float_t              dash_remain;
+
+    // the points of the current dash pieces
+    lx_array_ref_t          dash_points;
+
+    // the flattening scale of the curves for dashing the path
+    lx_float_t              dash_scale;
+
+    // the max error of the offset curves in the user space
+    lx_float_t              offset_error;
+
+    // the buckets of the stroked path cache
+    lx_stroker_cache_entry_t** cache_buckets;
+
+    // the lru list of the stroked path cache
+    lx_list_entry_head_t    cache_list;
+
+    // the estimated memory size of the stroked path cache
+    lx_size_t               cache_size;
+
+    // the maximum memory size of the stroked path cache, it's disabled if it's zero
+    lx_size_t               cache_maxsize;
+
 }lx_stroker_t;
 
+/* the stroker contour type
+ *
+ * @param stroker               the stroker
+ * @param points                the flattened points of the contour
+ * @param count                 the points count
+ * @param closed                is closed contour?
+ */
+typedef lx_void_t               (*lx_stroker_contour_t)(lx_stroker_t* stroker, lx_point_ref_t points, lx_size_t count, lx_bool_t closed);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -812,6 +958,35 @@ static lx_inline lx_bool_t lx_stroker_normals_too_sharp(lx_vector_ref_t normal_u
 }
 #endif
 
+/* the offset cubic curve is close enough to the exact offset curve?
+ *
+ * we only check the middle point, the offset cubic curve is at:
+ *
+ * B(0.5) + (normal_01 + normal_1 * 3 + normal_2 * 3 + normal_23) / 8
+ *
+ * and the exact offset curve is at B(0.5) + R * unit(B'(0.5)) rotated by ccw.
+ * the inner contour has the same error, so we need not check it.
+ */
+static lx_bool_t lx_stroker_offset_is_near(lx_stroker_t* stroker, lx_point_ref_t points, lx_vector_ref_t normal_01, lx_vector_ref_t normal_1, lx_vector_ref_t normal_2, lx_vector_ref_t normal_23) {
+    lx_assert(stroker && points && normal_01 && normal_1 && normal_2 && normal_23);
+
+    // compute the unit normal at the middle point, B'(0.5) = (p2 + p3 - p0 - p1) * 3 / 4
+    lx_vector_t normal_unit;
+    if (!lx_vector_make_unit(&normal_unit, points[2].x + points[3].x - points[0].x - points[1].x, points[2].y + points[3].y - points[0].y - points[1].y)) {
+        return lx_true;
+    }
+    lx_vector_rotate(&normal_unit, LX_ROTATE_DIRECTION_CCW);
+
+    // compute the error vector
+    lx_float_t radius = stroker->radius;
+    lx_float_t dx = (normal_01->x + (normal_1->x + normal_2->x) * 3.0f + normal_23->x) * 0.125f - normal_unit.x * radius;
+    lx_float_t dy = (normal_01->y + (normal_1->y + normal_2->y) * 3.0f + normal_23->y) * 0.125f - normal_unit.y * radius;
+
+    // the error is in the user space, it has been divided by the matrix scale octave
+    lx_float_t error = stroker->offset_error;
+    return dx * dx + dy * dy <= error * error;
+}
+
 static lx_void_t lx_stroker_make_line_to(lx_stroker_t* stroker, lx_point_ref_t point, lx_vector_ref_t normal) {
     lx_assert(stroker && stroker->path_inner && stroker->path_outer && point && normal);
 
@@ -952,8 +1127,69 @@ static lx_void_t lx_stroker_make_cubic_to(lx_stroker_t* stroker, lx_point_ref_t
     // compute the cos(angle) of the normal_12 and normal_23
     lx_float_t cos_angle_123 = lx_vector_dot(&normal_unit_12, normal_unit_23);
 
-    // this curve is too curvy? divide to the more flat curve
-    if (divided_count && (lx_stroker_normals_too_curvy(cos_angle_012) || lx_stroker_normals_too_curvy(cos_angle_123))) {
+    // this curve is too curvy?
+    lx_bool_t too_curvy = lx_stroker_normals_too_curvy(cos_angle_012) || lx_stroker_normals_too_curvy(cos_angle_123);
+
+    /* compute the approximate normal of the vector(p1, p1^) and vector(p2, p2^)
+     *
+     *                      normal_1(p1, p1^)
+     *                            p1^
+     *                            .
+     *                        .   .   .     normal_12
+     *       normal_01    .       .  .   . /
+     *              \ .          .. . R     .       normal_2(p2, p2^)
+     *            .          .    p1   .       .   /
+     *        .          .        .       .    p2^.
+     *       R .     .             .         .   .  .
+     *           .                 .         p2 . .R  .     normal_23
+     *         p0  .               .           .  .     . /
+     *               .             .          .     .     .
+     *                 .           .         .        .     .
+     *                   .          .       .           . R
+     *                     .        .      .        .   p3
+     *                       .      .     .      .
+     *                         .    .    .    .
+     *                           .   .  .  .
+     *                             . . . .
+     *                               .. O
+     *                              angle
+     *
+     * angle_012 = angle(p0, O, p2)
+     * angle_123 = angle(p1, O, p3)
+     *
+     * (O, p1) ~= (O, p1^) if be flat curve
+     * (O, p2) ~= (O, p2^) if be flat curve
+     *
+     * normal_1(p1, p1^) ~= center(normal_01, normal_12)
+     * normal_1(p2, p2^) ~= center(normal_12, normal_23)
+     */
+    lx_vector_t normal_1;
+    lx_vector_t normal_2;
+    if (!too_curvy) {
+        lx_vector_make(&normal_1, normal_unit_01->x + normal_unit_12.x, normal_unit_01->y + normal_unit_12.y);
+        lx_vector_make(&normal_2, normal_unit_12.x + normal_unit_23->x, normal_unit_12.y + normal_unit_23->y);
+
+        /* compute the approximate length of the normal_1 and set it
+         *
+         * length(p1, p1^) ~= R / cos(angle/2) = R / sqrt((1 + cos(angle)) / 2)
+         */
+        if (!lx_vector_length_set(&normal_1, stroker->radius / lx_sqrtf(lx_avg(1.0f, cos_angle_012)))) {
+            lx_assert(0);
+            return ;
+        }
+
+        /* compute the approximate length of the normal_2 and set it
+         *
+         * length(p1, p1^) ~= R / cos(angle/2) = R / sqrt((1 + cos(angle)) / 2)
+         */
+        if (!lx_vector_length_set(&normal_2, stroker->radius / lx_sqrtf(lx_avg(1.0f, cos_angle_123)))) {
+            lx_assert(0);
+            return ;
+        }
+    }
+
+    // this curve is too curvy or the offset curve is not close enough? divide to the more flat curve
+    if (divided_count && (too_curvy || !lx_stroker_offset_is_near(stroker, points, normal_01, &normal_1, &normal_2, normal_23))) {
 
         // chop the cubic at half
         lx_point_t output[7];
@@ -968,7 +1204,7 @@ static lx_void_t lx_stroker_make_cubic_to(lx_stroker_t* stroker, lx_point_ref_t
         lx_stroker_make_cubic_to(stroker, output, normal_01, normal_unit_01, &normal, &normal_unit, lx_false, divided_count - 1);
         lx_stroker_make_cubic_to(stroker, output + 3, &normal, &normal_unit, normal_23, normal_unit_23, lx_true, divided_count - 1);
 
-    } else if (!divided_count && (lx_stroker_normals_too_curvy(cos_angle_012) || lx_stroker_normals_too_curvy(cos_angle_123))) {
+    } else if (too_curvy) {
 
         /* too sharp and short?
          *
@@ -994,62 +1230,6 @@ static lx_void_t lx_stroker_make_cubic_to(lx_stroker_t* stroker, lx_point_ref_t
     } else { // for flat curve
         lx_assert(stroker->path_inner && stroker->path_outer);
 
-        /* compute the approximate normal of the vector(p1, p1^) and vector(p2, p2^)
-         *
-         *                      normal_1(p1, p1^)
-         *                            p1^
-         *                            .
-         *                        .   .   .     normal_12
-         *       normal_01    .       .  .   . /
-         *              \ .          .. . R     .       normal_2(p2, p2^)
-         *            .          .    p1   .       .   /
-         *        .          .        .       .    p2^.
-         *       R .     .             .         .   .  .
-         *           .                 .         p2 . .R  .     normal_23
-         *         p0  .               .           .  .     . /
-         *               .             .          .     .     .
-         *                 .           .         .        .     .
-         *                   .          .       .           . R
-         *                     .        .      .        .   p3
-         *                       .      .     .      .
-         *                         .    .    .    .
-         *                           .   .  .  .
-         *                             . . . .
-         *                               .. O
-         *                              angle
-         *
-         * angle_012 = angle(p0, O, p2)
-         * angle_123 = angle(p1, O, p3)
-         *
-         * (O, p1) ~= (O, p1^) if be flat curve
-         * (O, p2) ~= (O, p2^) if be flat curve
-         *
-         * normal_1(p1, p1^) ~= center(normal_01, normal_12)
-         * normal_1(p2, p2^) ~= center(normal_12, normal_23)
-         */
-        lx_vector_t normal_1;
-        lx_vector_t normal_2;
-        lx_vector_make(&normal_1, normal_unit_01->x + normal_unit_12.x, normal_unit_01->y + normal_unit_12.y);
-        lx_vector_make(&normal_2, normal_unit_12.x + normal_unit_23->x, normal_unit_12.y + normal_unit_23->y);
-
-         /* compute the approximate length of the normal_1 and set it
-         *
-         * length(p1, p1^) ~= R / cos(angle/2) = R / sqrt((1 + cos(angle)) / 2)
-         */
-        if (!lx_vector_length_set(&normal_1, stroker->radius / lx_sqrtf(lx_avg(1.0f, cos_angle_012)))) {
-            lx_assert(0);
-            return ;
-        }
-
-        /* compute the approximate length of the normal_2 and set it
-         *
-         * length(p1, p1^) ~= R / cos(angle/2) = R / sqrt((1 + cos(angle)) / 2)
-         */
-        if (!lx_vector_length_set(&normal_2, stroker->radius / lx_sqrtf(lx_avg(1.0f, cos_angle_123)))) {
-            lx_assert(0);
-            return ;
-        }
-
         // cubic-to the inner and outer contour
         lx_path_cubic2_to(stroker->path_outer, points[1].x + normal_1.x, points[1].y + normal_1.y, points[2].x + normal_2.x, points[2].y + normal_2.y, points[3].x + normal_23->x, points[3].y + normal_23->y);
         lx_path_cubic2_to(stroker->path_inner, points[1].x - normal_1.x, points[1].y - normal_1.y, points[2].x - normal_2.x, points[2].y - normal_2.y, points[3].x - normal_23->x, points[3].y - normal_23->y);
@@ -1185,6 +1365,913 @@ static lx_void_t lx_stroker_finish(lx_stroker_t* stroker, lx_bool_t closed) {
     lx_path_clear(stroker->path_inner);
 }
 
+static lx_void_t lx_stroker_polygon_add_contour(lx_stroker_t* stroker, lx_point_ref_t points, lx_uint32_t count) {
+    lx_assert(stroker && stroker->polygon_points && stroker->polygon_counts && points && count);
+
+    /* compute the signed area of this convex piece
+     *
+     * all pieces of the stroked polyline are overlapped at the joins and merged by the nonzero rule,
+     * so we need keep the same orientation for them, otherwise the overlapped regions will be cancelled.
+     */
+    lx_uint32_t i;
+    lx_float_t  area = 0;
+    for (i = 0; i < count; i++) {
+        lx_point_ref_t p = points + i;
+        lx_point_ref_t q = points + (i + 1 < count? i + 1 : 0);
+        area += p->x * q->y - q->x * p->y;
+    }
+
+    // add points and close this contour
+    if (area < 0) {
+        for (i = count; i > 0; i--) {
+            lx_array_insert_tail(stroker->polygon_points, points + i - 1);
+        }
+        lx_array_insert_tail(stroker->polygon_points, points + count - 1);
+    } else {
+        for (i = 0; i < count; i++) {
+            lx_array_insert_tail(stroker->polygon_points, points + i);
+        }
+        lx_array_insert_tail(stroker->polygon_points, points);
+    }
+    count++;
+    lx_array_insert_tail(stroker->polygon_counts, &count);
+}
+
+static lx_void_t lx_stroker_polygon_add_segment(lx_stroker_t* stroker, lx_point_ref_t p0, lx_point_ref_t p1, lx_vector_ref_t direction, lx_bool_t cap0, lx_bool_t cap1) {
+    lx_assert(stroker && p0 && p1 && direction);
+
+    /* make the quad of the segment
+     *
+     *  q0 . . . . . . . . . . . . q1
+     *   .                          .
+     *  p0 ----------------------> p1
+     *   .                          .
+     *  q3 . . . . . . . . . . . . q2
+     *
+     * the square cap will extend the start and end points with the radius
+     */
+    lx_float_t  radius = stroker->radius;
+    lx_vector_t normal;
+    lx_vector_rotate2(direction, &normal, LX_ROTATE_DIRECTION_CCW);
+    lx_vector_scale(&normal, radius);
+
+    lx_point_t b = *p0;
+    lx_point_t e = *p1;
+    if (stroker->cap == LX_PAINT_STROKE_CAP_SQUARE) {
+        if (cap0) {
+            b.x -= direction->x * radius;
+            b.y -= direction->y * radius;
+        }
+        if (cap1) {
+            e.x += direction->x * radius;
+            e.y += direction->y * radius;
+        }
+    }
+
+    lx_point_t quad[4];
+    lx_point_make(&quad[0], b.x + normal.x, b.y + normal.y);
+    lx_point_make(&quad[1], e.x + normal.x, e.y + normal.y);
+    lx_point_make(&quad[2], e.x - normal.x, e.y - normal.y);
+    lx_point_make(&quad[3], b.x - normal.x, b.y - normal.y);
+    lx_stroker_polygon_add_contour(stroker, quad, 4);
+}
+
+static lx_void_t lx_stroker_polygon_add_join(lx_stroker_t* stroker, lx_point_ref_t center, lx_vector_ref_t normal_unit_before, lx_vector_ref_t normal_unit_after) {
+    lx_assert(stroker && center && normal_unit_before && normal_unit_after);
+
+    // the join is nearly line? ignore this join directly
+    lx_size_t   type;
+    lx_float_t  cos_angle = lx_stroker_joiner_angle(normal_unit_before, normal_unit_after, &type);
+    lx_check_return(type != LX_STROKER_JOINER_ANGLE_NEAR0);
+
+    // counter-clockwise? the outer side is on the opposite normals
+    lx_vector_t before = *normal_unit_before;
+    lx_vector_t after  = *normal_unit_after;
+    lx_bool_t   clockwise = lx_vector_is_clockwise(normal_unit_before, normal_unit_after);
+    if (!clockwise) {
+        lx_vector_negate(&before);
+        lx_vector_negate(&after);
+    }
+
+    /* make the join piece on the outer side, it's the same as lx_stroker_joiner_miter/bevel()
+     *
+     *   bevel: center => outer_before => outer_after
+     *   miter: center => outer_before => miter => outer_after
+     *
+     * the inner side has been covered by the quads of the two segments
+     */
+    lx_size_t   n = 0;
+    lx_point_t  join[4];
+    lx_float_t  radius = stroker->radius;
+    join[n++] = *center;
+    lx_point_make(&join[n++], center->x + before.x * radius, center->y + before.y * radius);
+    if (stroker->join == LX_PAINT_STROKE_JOIN_MITER && type != LX_STROKER_JOINER_ANGLE_NEAR180) {
+        lx_vector_t miter;
+        lx_bool_t   miter_join = lx_true;
+        if (lx_near0(cos_angle) && stroker->miter_invert <= LX_ONEOVER_SQRT2) {
+            lx_vector_make(&miter, (before.x + after.x) * radius, (before.y + after.y) * radius);
+        } else {
+            // limit the miter length, 1 / M > cos(a/2)?
+            lx_float_t cos_half_a = lx_sqrtf(lx_avg(1.0f, cos_angle));
+            if (stroker->miter_invert > cos_half_a) {
+                miter_join = lx_false;
+            } else {
+                if (type == LX_STROKER_JOINER_ANGLE_OBTUSE) {
+                    lx_vector_make(&miter, after.y - before.y, before.x - after.x);
+                    if (!clockwise) {
+                        lx_vector_negate(&miter);
+                    }
+                } else {
+                    lx_vector_make(&miter, before.x + after.x, before.y + after.y);
+                }
+                lx_vector_length_set(&miter, radius / cos_half_a);
+            }
+        }
+        if (miter_join) {
+            lx_point_make(&join[n++], center->x + miter.x, center->y + miter.y);
+        }
+    }
+    lx_point_make(&join[n++], center->x + after.x * radius, center->y + after.y * radius);
+    lx_stroker_polygon_add_contour(stroker, join, (lx_uint32_t)n);
+}
+
+static lx_void_t lx_stroker_polygon_add_polyline(lx_stroker_t* stroker, lx_point_ref_t points, lx_uint32_t count) {
+    lx_assert(stroker && points && count);
+
+    // is closed contour?
+    lx_point_ref_t first = points;
+    lx_point_ref_t last = points + count - 1;
+    lx_bool_t      closed = count > 2 && first->x == last->x && first->y == last->y;
+
+    /* add the segment quads and the joins between them
+     *
+     * we delay to add the previous segment until the next segment is found,
+     * because only the last segment of the open contour need the end cap.
+     */
+    lx_uint32_t     index;
+    lx_point_ref_t  segment_begin = lx_null;
+    lx_point_ref_t  segment_end = first;
+    lx_vector_t     direction_prev;
+    lx_vector_t     normal_unit_prev;
+    lx_vector_t     normal_unit_first;
+    lx_size_t       segment_count = 0;
+    for (index = 1; index < count; index++) {
+        lx_point_ref_t point = points + index;
+
+        // make the direction and normal of this segment, ignore the empty segment
+        lx_vector_t direction;
+        lx_vector_t normal_unit;
+        if (!lx_vector_make_unit(&direction, point->x - segment_end->x, point->y - segment_end->y)) {
+            continue;
+        }
+        lx_vector_rotate2(&direction, &normal_unit, LX_ROTATE_DIRECTION_CCW);
+
+        // add the previous segment and join it to this segment
+        if (segment_begin) {
+            lx_stroker_polygon_add_segment(stroker, segment_begin, segment_end, &direction_prev, !closed && segment_count == 1, lx_false);
+            lx_stroker_polygon_add_join(stroker, segment_end, &normal_unit_prev, &normal_unit);
+        } else {
+            normal_unit_first = normal_unit;
+        }
+        segment_begin       = segment_end;
+        segment_end         = point;
+        direction_prev      = direction;
+        normal_unit_prev    = normal_unit;
+        segment_count++;
+    }
+
+    // add the last segment
+    if (segment_begin) {
+        lx_stroker_polygon_add_segment(stroker, segment_begin, segment_end, &direction_prev, !closed && segment_count == 1, !closed);
+        if (closed) {
+            lx_stroker_polygon_add_join(stroker, segment_end, &normal_unit_prev, &normal_unit_first);
+        }
+    }
+}
+
+static lx_bool_t lx_stroker_polygon_init_points(lx_stroker_t* stroker, lx_paint_ref_t paint) {
+    lx_assert(stroker && paint);
+
+    // apply paint
+    lx_stroker_clear((lx_stroker_ref_t)stroker);
+    lx_stroker_apply_paint((lx_stroker_ref_t)stroker, paint);
+    lx_check_return_val(stroker->radius > 0, lx_false);
+
+    // init the polygon points and counts
+    if (!stroker->polygon_points) {
+        stroker->polygon_points = lx_array_init(LX_STROKER_POLYGON_POINTS_GROW, lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+    }
+    if (!stroker->polygon_counts) {
+        stroker->polygon_counts = lx_array_init(LX_STROKER_POLYGON_POINTS_GROW >> 2, lx_element_mem(sizeof(lx_uint32_t), lx_null, lx_null));
+    }
+    lx_assert_and_check_return_val(stroker->polygon_points && stroker->polygon_counts, lx_false);
+
+    lx_array_clear(stroker->polygon_points);
+    lx_array_clear(stroker->polygon_counts);
+    return lx_true;
+}
+
+static lx_bool_t lx_stroker_polygon_init(lx_stroker_t* stroker, lx_paint_ref_t paint, lx_bool_t joined) {
+    lx_check_return_val(lx_stroker_polygon_init_points(stroker, paint), lx_false);
+
+    // only butt/square caps and miter/bevel joins can be made as the convex pieces directly
+    lx_check_return_val(stroker->cap != LX_PAINT_STROKE_CAP_ROUND, lx_false);
+    lx_check_return_val(!joined || stroker->join != LX_PAINT_STROKE_JOIN_ROUND, lx_false);
+
+    // the dashed lines need be split by the stroker
+    lx_check_return_val(!stroker->dash_count, lx_false);
+    return lx_true;
+}
+
+static lx_polygon_ref_t lx_stroker_polygon_make(lx_stroker_t* stroker, lx_bool_t convex) {
+    lx_assert(stroker && stroker->polygon_points && stroker->polygon_counts);
+
+    lx_size_t total = lx_array_size(stroker->polygon_points);
+    lx_check_return_val(total, lx_null);
+
+    // end of the counts
+    lx_uint32_t end = 0;
+    lx_array_insert_tail(stroker->polygon_counts, &end);
+    lx_polygon_make(&stroker->polygon, (lx_point_ref_t)lx_array_data(stroker->polygon_points),
+        (lx_uint32_t*)lx_array_data(stroker->polygon_counts), total, convex);
+    return &stroker->polygon;
+}
+
+// get the max scale of the matrix axes
+static lx_float_t lx_stroker_matrix_scale(lx_matrix_ref_t matrix) {
+    lx_assert(matrix);
+    lx_float_t sx = matrix->sx * matrix->sx + matrix->ky * matrix->ky;
+    lx_float_t sy = matrix->kx * matrix->kx + matrix->sy * matrix->sy;
+    return lx_sqrtf(lx_max(sx, sy));
+}
+
+/* get the flattening scale of the center line for the matrix
+ *
+ * it allows twice error for each lower quality level, it's the same as lx_path_polygon_for_matrix(),
+ * and we use the half error for the center line, because both sides of the stroke will show it.
+ */
+static lx_float_t lx_stroker_flatten_scale(lx_matrix_ref_t matrix) {
+    lx_float_t scale = matrix? lx_stroker_matrix_scale(matrix) * 2.0f : 1.0f;
+    if (lx_quality() < LX_QUALITY_TOP) {
+        scale /= (lx_float_t)(1 << (LX_QUALITY_TOP - lx_quality()));
+    }
+    return scale;
+}
+
+static lx_inline lx_void_t lx_stroker_outline_add(lx_array_ref_t points, lx_point_ref_t center, lx_vector_ref_t normal, lx_float_t radius) {
+    lx_point_t point;
+    lx_point_make(&point, center->x + normal->x * radius, center->y + normal->y * radius);
+    lx_array_insert_tail(points, &point);
+}
+
+/* add the inner points of the arc, excluding the start and end points
+ *
+ * it starts from the unit vector: from, and rotates with the given angle to the side of the vector: through
+ */
+static lx_void_t lx_stroker_outline_add_arc(lx_stroker_t* stroker, lx_array_ref_t points, lx_point_ref_t center, lx_vector_ref_t from, lx_vector_ref_t through, lx_float_t angle) {
+    lx_assert(stroker && points && center && from && through && stroker->outline_arc_step > 0);
+
+    lx_size_t n = (lx_size_t)lx_ceil(angle / stroker->outline_arc_step);
+    lx_check_return(n > 1);
+    if (n > LX_STROKER_OUTLINE_ARC_MAXN) {
+        n = LX_STROKER_OUTLINE_ARC_MAXN;
+    }
+
+    lx_float_t sin = 0;
+    lx_float_t cos = 1;
+    lx_sincosf(angle / (lx_float_t)n, &sin, &cos);
+    if (lx_vector_cross(from, through) < 0) {
+        sin = -sin;
+    }
+
+    lx_size_t   i;
+    lx_vector_t vector = *from;
+    for (i = 1; i < n; i++) {
+        lx_float_t x = vector.x * cos - vector.y * sin;
+        vector.y = vector.x * sin + vector.y * cos;
+        vector.x = x;
+        lx_stroker_outline_add(points, center, &vector, stroker->radius);
+    }
+}
+
+/* add the join points of the left and right sides
+ *
+ * the outer side gets the miter, round or bevel join, it's the same as lx_stroker_joiner_miter/round/bevel(),
+ * and the inner side passes through the center point, so the short segments can be filled with the nonzero rule.
+ */
+static lx_void_t lx_stroker_outline_add_join(lx_stroker_t* stroker, lx_array_ref_t left, lx_array_ref_t right, lx_point_ref_t center, lx_vector_ref_t normal_unit_before, lx_vector_ref_t normal_unit_after, lx_float_t length_min) {
+    lx_assert(stroker && left && right && center && normal_unit_before && normal_unit_after);
+
+    /* the join is smooth? only add the intersection points of the offset lines, it's the most case of the flattened curves
+     *
+     * the intersection vector: (n0 + n1) * r / (1 + cos(a)),
+     * and the offset lines overlap tan(a / 2) * r, it need be not larger than the segment lengths.
+     *
+     * the miter, round and bevel joins are nearly same if the angle is less than the arc step
+     */
+    lx_float_t radius = stroker->radius;
+    lx_float_t dot = lx_vector_dot(normal_unit_before, normal_unit_after);
+    if (dot > 0) {
+        lx_float_t cross = lx_abs(lx_vector_cross(normal_unit_before, normal_unit_after));
+        lx_float_t dot1 = 1.0f + dot;
+        if (cross <= stroker->outline_smooth_tan * dot1 && cross * radius <= dot1 * length_min) {
+            lx_vector_t miter;
+            lx_float_t  factor = radius / dot1;
+            lx_vector_make(&miter, (normal_unit_before->x + normal_unit_after->x) * factor, (normal_unit_before->y + normal_unit_after->y) * factor);
+            lx_point_t point;
+            lx_point_make(&point, center->x + miter.x, center->y + miter.y);
+            lx_array_insert_tail(left, &point);
+            lx_point_make(&point, center->x - miter.x, center->y - miter.y);
+            lx_array_insert_tail(right, &point);
+            return ;
+        }
+    }
+
+    // the join is nearly line? only add the end points of the previous segment
+    lx_size_t   type;
+    lx_float_t  cos_angle = lx_stroker_joiner_angle(normal_unit_before, normal_unit_after, &type);
+    if (type == LX_STROKER_JOINER_ANGLE_NEAR0) {
+        lx_vector_t normal_unit_inner;
+        lx_vector_make(&normal_unit_inner, -normal_unit_before->x, -normal_unit_before->y);
+        lx_stroker_outline_add(left, center, normal_unit_before, radius);
+        lx_stroker_outline_add(right, center, &normal_unit_inner, radius);
+        return ;
+    }
+
+    // clockwise? the outer side is the left side, otherwise it's the right side
+    lx_vector_t     before = *normal_unit_before;
+    lx_vector_t     after  = *normal_unit_after;
+    lx_bool_t       clockwise = lx_vector_is_clockwise(normal_unit_before, normal_unit_after);
+    lx_array_ref_t  outer = left;
+    lx_array_ref_t  inner = right;
+    if (!clockwise) {
+        lx_vector_negate(&before);
+        lx_vector_negate(&after);
+        outer = right;
+        inner = left;
+    }
+
+    // add the inner points: before => center => after
+    lx_vector_t before_inner;
+    lx_vector_t after_inner;
+    lx_vector_make(&before_inner, -before.x, -before.y);
+    lx_vector_make(&after_inner, -after.x, -after.y);
+    lx_stroker_outline_add(inner, center, &before_inner, radius);
+    lx_array_insert_tail(inner, center);
+    lx_stroker_outline_add(inner, center, &after_inner, radius);
+
+    // add the outer points
+    lx_stroker_outline_add(outer, center, &before, radius);
+    if (stroker->join == LX_PAINT_STROKE_JOIN_ROUND) {
+        /* tan(a / 2) = sin(a) / (1 + cos(a))
+         *
+         * it rotates through the direction of the previous segment if they are nearly opposite
+         */
+        if (type == LX_STROKER_JOINER_ANGLE_NEAR180) {
+            lx_vector_t direction;
+            lx_vector_rotate2(normal_unit_before, &direction, LX_ROTATE_DIRECTION_CW);
+            lx_stroker_outline_add_arc(stroker, outer, center, &before, &direction, LX_PI);
+        } else {
+            lx_float_t angle = 2.0f * lx_atanf(lx_abs(lx_vector_cross(&before, &after)) / (1.0f + cos_angle));
+            lx_stroker_outline_add_arc(stroker, outer, center, &before, &after, angle);
+        }
+    } else if (stroker->join == LX_PAINT_STROKE_JOIN_MITER && type != LX_STROKER_JOINER_ANGLE_NEAR180) {
+        lx_vector_t miter;
+        lx_bool_t   miter_join = lx_true;
+        if (lx_near0(cos_angle) && stroker->miter_invert <= LX_ONEOVER_SQRT2) {
+            lx_vector_make(&miter, before.x + after.x, before.y + after.y);
+        } else {
+            // limit the miter length, 1 / M > cos(a/2)?
+            lx_float_t cos_half_a = lx_sqrtf(lx_avg(1.0f, cos_angle));
+            if (stroker->miter_invert > cos_half_a) {
+                miter_join = lx_false;
+            } else {
+                if (type == LX_STROKER_JOINER_ANGLE_OBTUSE) {
+                    lx_vector_make(&miter, after.y - before.y, before.x - after.x);
+                    if (!clockwise) {
+                        lx_vector_negate(&miter);
+                    }
+                } else {
+                    lx_vector_make(&miter, before.x + after.x, before.y + after.y);
+                }
+                lx_vector_length_set(&miter, 1.0f / cos_half_a);
+            }
+        }
+        if (miter_join) {
+            lx_stroker_outline_add(outer, center, &miter, radius);
+        }
+    }
+    lx_stroker_outline_add(outer, center, &after, radius);
+}
+
+/* add the cap points from the left side to the right side at the end point
+ *
+ * the start cap is the same as the end cap with the negated direction and normal
+ */
+static lx_void_t lx_stroker_outline_add_cap(lx_stroker_t* stroker, lx_array_ref_t points, lx_point_ref_t center, lx_vector_ref_t direction, lx_vector_ref_t normal_unit) {
+    lx_assert(stroker && points && center && direction && normal_unit);
+
+    switch (stroker->cap) {
+    case LX_PAINT_STROKE_CAP_SQUARE: {
+        lx_point_t  point;
+        lx_float_t  radius = stroker->radius;
+        lx_point_make(&point, center->x + (direction->x + normal_unit->x) * radius, center->y + (direction->y + normal_unit->y) * radius);
+        lx_array_insert_tail(points, &point);
+        lx_point_make(&point, center->x + (direction->x - normal_unit->x) * radius, center->y + (direction->y - normal_unit->y) * radius);
+        lx_array_insert_tail(points, &point);
+        break;
+    }
+    case LX_PAINT_STROKE_CAP_ROUND:
+        lx_stroker_outline_add_arc(stroker, points, center, normal_unit, direction, LX_PI);
+        break;
+    case LX_PAINT_STROKE_CAP_BUTT:
+    default:
+        break;
+    }
+}
+
+// append the contour points from the given start index to the polygon counts
+static lx_void_t lx_stroker_outline_add_count(lx_stroker_t* stroker, lx_size_t start) {
+    lx_array_ref_t  points = stroker->polygon_points;
+    lx_size_t       count  = lx_array_size(points) - start;
+    lx_check_return(count > 2);
+
+    // close this contour
+    lx_point_ref_t first = (lx_point_ref_t)lx_array_item(points, start);
+    lx_point_ref_t last  = (lx_point_ref_t)lx_array_last(points);
+    if (first->x != last->x || first->y != last->y) {
+        lx_point_t point = *first;
+        lx_array_insert_tail(points, &point);
+        count++;
+    }
+
+    lx_uint32_t value = (lx_uint32_t)count;
+    lx_array_insert_tail(stroker->polygon_counts, &value);
+}
+
+/* stroke the flattened contour to the outline of the polygon directly
+ *
+ * the left side points are appended to the polygon points directly, and the right side points
+ * are saved to a reused buffer and appended to the polygon in the reverse order after the end cap.
+ *
+ * open contour: left side => end cap => reversed right side => start cap
+ * closed contour: left side and reversed right side, two contours with the opposite orientation
+ */
+static lx_void_t lx_stroker_outline_add_contour(lx_stroker_t* stroker, lx_point_ref_t points, lx_size_t count, lx_bool_t closed) {
+    lx_assert(stroker && stroker->polygon_points && stroker->outline_right && points);
+
+    lx_array_ref_t  left = stroker->polygon_points;
+    lx_array_ref_t  right = stroker->outline_right;
+    lx_size_t       start = lx_array_size(left);
+    lx_float_t      radius = stroker->radius;
+    lx_point_ref_t  point_prev = points;
+    lx_point_ref_t  point_first = points;
+    lx_vector_t     direction_first = {0};
+    lx_vector_t     direction_prev = {0};
+    lx_vector_t     normal_unit_first = {0};
+    lx_vector_t     normal_unit_prev = {0};
+    lx_float_t      length_first = 0;
+    lx_float_t      length_prev = 0;
+    lx_size_t       segment_count = 0;
+    lx_size_t       index;
+    lx_array_clear(right);
+    for (index = 1; index < count; index++) {
+        lx_point_ref_t point = points + index;
+
+        // make the direction and normal of this segment, ignore the empty segment
+        lx_vector_t direction;
+        lx_vector_t normal_unit;
+        lx_vector_make(&direction, point->x - point_prev->x, point->y - point_prev->y);
+        lx_float_t length = lx_vector_length(&direction);
+        if (lx_near0(length)) {
+            continue;
+        }
+        lx_vector_scale(&direction, 1.0f / length);
+        lx_vector_rotate2(&direction, &normal_unit, LX_ROTATE_DIRECTION_CCW);
+
+        // add the start points or join it to the previous segment
+        if (!segment_count) {
+            lx_vector_t normal_unit_right;
+            lx_vector_make(&normal_unit_right, -normal_unit.x, -normal_unit.y);
+            lx_stroker_outline_add(left, point_prev, &normal_unit, radius);
+            lx_stroker_outline_add(right, point_prev, &normal_unit_right, radius);
+            point_first         = point_prev;
+            direction_first     = direction;
+            normal_unit_first   = normal_unit;
+            length_first        = length;
+        } else {
+            lx_stroker_outline_add_join(stroker, left, right, point_prev, &normal_unit_prev, &normal_unit, lx_min(length_prev, length));
+        }
+        point_prev          = point;
+        direction_prev      = direction;
+        normal_unit_prev    = normal_unit;
+        length_prev         = length;
+        segment_count++;
+    }
+    lx_check_return(segment_count);
+
+    // closed? join the last segment to the first segment
+    closed = closed && (point_prev->x == point_first->x && point_prev->y == point_first->y) && segment_count > 1;
+    if (closed) {
+        lx_stroker_outline_add_join(stroker, left, right, point_prev, &normal_unit_prev, &normal_unit_first, lx_min(length_prev, length_first));
+        lx_stroker_outline_add_count(stroker, start);
+        start = lx_array_size(left);
+    } else {
+        // add the end points and the end cap
+        lx_vector_t normal_unit_right;
+        lx_vector_make(&normal_unit_right, -normal_unit_prev.x, -normal_unit_prev.y);
+        lx_stroker_outline_add(left, point_prev, &normal_unit_prev, radius);
+        lx_stroker_outline_add(right, point_prev, &normal_unit_right, radius);
+        lx_stroker_outline_add_cap(stroker, left, point_prev, &direction_prev, &normal_unit_prev);
+    }
+
+    // append the reversed right side
+    lx_size_t right_count = lx_array_size(right);
+    if (right_count) {
+        lx_size_t left_count = lx_array_size(left);
+        if (lx_array_resize(left, left_count + right_count)) {
+            lx_point_ref_t output = (lx_point_ref_t)lx_array_data(left) + left_count;
+            lx_point_ref_t input  = (lx_point_ref_t)lx_array_data(right) + right_count;
+            while (right_count--) {
+                *output++ = *--input;
+            }
+        }
+    }
+
+    // add the start cap
+    if (!closed) {
+        lx_vector_t direction_back;
+        lx_vector_t normal_unit_back;
+        lx_vector_make(&direction_back, -direction_first.x, -direction_first.y);
+        lx_vector_make(&normal_unit_back, -normal_unit_first.x, -normal_unit_first.y);
+        lx_stroker_outline_add_cap(stroker, left, point_first, &direction_back, &normal_unit_back);
+    }
+    lx_stroker_outline_add_count(stroker, start);
+}
+
+// add the dash piece from the given start index of the dash points, and remove it
+static lx_void_t lx_stroker_dash_add_piece(lx_stroker_t* stroker, lx_size_t start, lx_stroker_contour_t func) {
+    lx_array_ref_t  pieces = stroker->dash_points;
+    lx_size_t       count = lx_array_size(pieces) - start;
+    if (count > 1) {
+        func(stroker, (lx_point_ref_t)lx_array_data(pieces) + start, count, lx_false);
+    }
+    lx_array_resize(pieces, start);
+}
+
+/* dash the flattened contour and only add the "on" pieces
+ *
+ * we walk the arc length of the contour incrementally and split the segments at the ends of the dash intervals,
+ * so the dashed path need not be made. the dash pattern is restarted from the phase for each contour,
+ * and the last piece will be connected to the first piece if the closed contour starts and ends with a dash.
+ */
+static lx_void_t lx_stroker_dash_add_contour(lx_stroker_t* stroker, lx_point_ref_t points, lx_size_t count, lx_bool_t closed, lx_stroker_contour_t func) {
+    lx_assert(stroker && stroker->dash_count && stroker->dash_length > 0 && points && count > 1 && func);
+
+    // init the dash points
+    if (!stroker->dash_points) {
+        stroker->dash_points = lx_array_init(LX_STROKER_POLYGON_POINTS_GROW, lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+    }
+    lx_assert_and_check_return(stroker->dash_points);
+
+    // compute the contour length
+    lx_size_t  index;
+    lx_float_t length = 0;
+    for (index = 1; index < count; index++) {
+        lx_float_t dx = points[index].x - points[index - 1].x;
+        lx_float_t dy = points[index].y - points[index - 1].y;
+        length += lx_sqrtf(dx * dx + dy * dy);
+    }
+    lx_check_return(length > 0);
+
+    // too many tiny dashes? we stroke it as solid
+    if (length * (lx_float_t)stroker->dash_count > stroker->dash_length * LX_STROKER_DASH_PIECES_MAXN) {
+        func(stroker, points, count, closed);
+        return ;
+    }
+
+    // walk the contour
+    lx_array_ref_t  pieces = stroker->dash_points;
+    lx_size_t       dash_index = stroker->dash_index;
+    lx_float_t      dash_remain = stroker->dash_remain;
+    lx_bool_t       dash_on = !(dash_index & 0x1);
+    lx_bool_t       first_on = dash_on && closed;
+    lx_bool_t       splitted = lx_false;
+    lx_size_t       first_count = 0;
+    lx_array_clear(pieces);
+    if (dash_on) {
+        lx_array_insert_tail(pieces, points);
+    }
+    for (index = 1; index < count; index++) {
+        lx_point_ref_t  p0 = points + index - 1;
+        lx_point_ref_t  p1 = points + index;
+        lx_float_t      dx = p1->x - p0->x;
+        lx_float_t      dy = p1->y - p0->y;
+        lx_float_t      segment = lx_sqrtf(dx * dx + dy * dy);
+        lx_float_t      offset = 0;
+        while (segment - offset > dash_remain) {
+
+            // split this segment at the end of the current interval
+            lx_point_t point;
+            offset += dash_remain;
+            lx_point_make(&point, p0->x + dx * offset / segment, p0->y + dy * offset / segment);
+            lx_array_insert_tail(pieces, &point);
+
+            // end the current dash, the first dash of the closed contour need be deferred
+            if (dash_on) {
+                if (first_on && !splitted) {
+                    first_count = lx_array_size(pieces);
+                } else {
+                    lx_stroker_dash_add_piece(stroker, first_count, func);
+                }
+            }
+            splitted = lx_true;
+
+            // the next interval
+            dash_on = !dash_on;
+            if (++dash_index == stroker->dash_count) {
+                dash_index = 0;
+            }
+            dash_remain = stroker->dash[dash_index];
+        }
+        dash_remain -= segment - offset;
+        if (dash_on) {
+            lx_array_insert_tail(pieces, p1);
+        }
+    }
+
+    // it's not splitted? add the whole contour
+    if (!splitted) {
+        if (dash_on) {
+            func(stroker, points, count, closed);
+        }
+        lx_array_clear(pieces);
+        return ;
+    }
+
+    // end the last dash and connect the first dash to it
+    if (dash_on) {
+        lx_size_t size = lx_array_size(pieces);
+        if (first_count > 1 && lx_array_resize(pieces, size + first_count - 1)) {
+            lx_point_ref_t data = (lx_point_ref_t)lx_array_data(pieces);
+            lx_memcpy(data + size, data + 1, (first_count - 1) * sizeof(lx_point_t));
+        }
+        lx_stroker_dash_add_piece(stroker, first_count, func);
+    }
+
+    // add the first dash
+    if (first_count) {
+        lx_stroker_dash_add_piece(stroker, 0, func);
+    }
+}
+
+// add the dash piece to the stroked path
+static lx_void_t lx_stroker_dash_add_lines(lx_stroker_t* stroker, lx_point_ref_t points, lx_size_t count, lx_bool_t closed) {
+    lx_assert(stroker && points && count > 1);
+
+    lx_size_t index;
+    lx_stroker_move_to((lx_stroker_ref_t)stroker, points);
+    for (index = 1; index < count; index++) {
+        lx_stroker_line_to((lx_stroker_ref_t)stroker, points + index);
+    }
+    if (closed) {
+        lx_stroker_finish(stroker, lx_true);
+    }
+}
+
+// add the flattened points of the current contour, and dash it if the dash intervals are set
+static lx_void_t lx_stroker_contour_add_points(lx_stroker_t* stroker, lx_bool_t closed, lx_stroker_contour_t func) {
+    lx_assert(stroker && stroker->contour_points && func);
+    lx_size_t count = lx_array_size(stroker->contour_points);
+    if (count > 1) {
+        lx_point_ref_t points = (lx_point_ref_t)lx_array_data(stroker->contour_points);
+        if (stroker->dash_count) {
+            lx_stroker_dash_add_contour(stroker, points, count, closed, func);
+        } else {
+            func(stroker, points, count, closed);
+        }
+    }
+    lx_array_clear(stroker->contour_points);
+}
+
+/* flatten the path and add each contour
+ *
+ * the curves are flattened with the given device scale, it's the same as lx_path_polygon_for_matrix()
+ */
+static lx_void_t lx_stroker_contour_add_path(lx_stroker_t* stroker, lx_path_ref_t path, lx_float_t scale, lx_stroker_contour_t func) {
+    lx_assert(stroker && path && scale > 0 && func);
+
+    // init the contour points
+    if (!stroker->contour_points) {
+        stroker->contour_points = lx_array_init(LX_STROKER_POLYGON_POINTS_GROW, lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+    }
+    lx_assert_and_check_return(stroker->contour_points);
+    lx_array_clear(stroker->contour_points);
+
+    // flatten each contour
+    lx_array_ref_t points = stroker->contour_points;
+    lx_for_all (lx_path_item_ref_t, item, path) {
+        lx_size_t size = lx_array_size(points);
+        switch (item->code) {
+        case LX_PATH_CODE_MOVE:
+            lx_stroker_contour_add_points(stroker, lx_false, func);
+            lx_array_insert_tail(points, &item->points[0]);
+            break;
+        case LX_PATH_CODE_LINE:
+            if (!size) lx_array_insert_tail(points, &item->points[0]);
+            lx_array_insert_tail(points, &item->points[1]);
+            break;
+        case LX_PATH_CODE_QUAD: {
+            if (!size) lx_array_insert_tail(points, &item->points[0]);
+            size = lx_array_size(points);
+            lx_size_t count = lx_bezier2_divide_line_count_scaled(item->points, scale);
+            if (lx_array_resize(points, size + ((lx_size_t)1 << count))) {
+                lx_bezier2_make_line_points(item->points, count, (lx_point_ref_t)lx_array_data(points) + size);
+            }
+            break;
+        }
+        case LX_PATH_CODE_CUBIC: {
+            if (!size) lx_array_insert_tail(points, &item->points[0]);
+            size = lx_array_size(points);
+            lx_size_t count = lx_bezier3_divide_line_count_scaled(item->points, scale);
+            if (lx_array_resize(points, size + ((lx_size_t)1 << count))) {
+                lx_bezier3_make_line_points(item->points, count, (lx_point_ref_t)lx_array_data(points) + size);
+            }
+            break;
+        }
+        case LX_PATH_CODE_CLOSE:
+            lx_stroker_contour_add_points(stroker, lx_true, func);
+            break;
+        default:
+            break;
+        }
+    }
+    lx_stroker_contour_add_points(stroker, lx_false, func);
+}
+
+/* get the matrix scale class
+ *
+ * the scale is quantized to the half octaves, so the estimated size of the cached path will be updated
+ * only if the matrix scale is changed obviously.
+ */
+static lx_uint16_t lx_stroker_cache_scale(lx_matrix_ref_t matrix) {
+    lx_check_return_val(matrix, 0);
+    lx_float_t sx = matrix->sx * matrix->sx + matrix->ky * matrix->ky;
+    lx_float_t sy = matrix->kx * matrix->kx + matrix->sy * matrix->sy;
+    lx_float_t scale = lx_max(sx, sy) * 256.0f;
+    lx_uint32_t value = scale < 4294967040.0f? (lx_uint32_t)scale : 0xffffff00;
+    return (lx_uint16_t)lx_ilog2i(value + 1);
+}
+
+/* get the matrix scale octave of the offset curves error
+ *
+ * the error will be LX_STROKER_OFFSET_ERROR / 2^octave in the user space, so it's at most twice of
+ * LX_STROKER_OFFSET_ERROR in the device space for all zoom levels in the same octave.
+ */
+static lx_size_t lx_stroker_offset_octave(lx_matrix_ref_t matrix) {
+    lx_check_return_val(matrix, 0);
+    lx_float_t scale = lx_stroker_matrix_scale(matrix);
+    lx_check_return_val(scale >= 2.0f, 0);
+    lx_size_t octave = scale < 4294967040.0f? lx_ilog2i((lx_uint32_t)scale) : 31;
+    return lx_min(octave, LX_STROKER_OFFSET_OCTAVE_MAXN);
+}
+
+static lx_size_t lx_stroker_cache_bucket(lx_cpointer_t path, lx_float_t width, lx_size_t cap, lx_size_t join) {
+    lx_size_t hash = ((lx_size_t)path >> 3) ^ ((lx_size_t)path >> 11);
+    hash = hash * 31 + (lx_size_t)(width * 16.0f);
+    hash = hash * 31 + (cap << 4) + join;
+    return hash % LX_STROKER_CACHE_BUCKETS;
+}
+
+// get the estimated size of the cached path and its flattened polygon for the given matrix
+static lx_size_t lx_stroker_cache_size(lx_path_ref_t stroked, lx_matrix_ref_t matrix) {
+    lx_polygon_ref_t polygon = lx_path_polygon_for_matrix(stroked, matrix);
+    lx_check_return_val(polygon, 0);
+    return sizeof(lx_stroker_cache_entry_t) + LX_STROKER_CACHE_PATH_SIZE + polygon->total * (sizeof(lx_point_t) << 1);
+}
+
+// remove the cache entry, and return the stroked path if the path pointer is given
+static lx_void_t lx_stroker_cache_remove(lx_stroker_t* stroker, lx_stroker_cache_entry_t* entry, lx_path_ref_t* pstroked) {
+    lx_assert(stroker && stroker->cache_buckets && entry);
+
+    // remove it from the bucket
+    lx_stroker_cache_entry_t** pitem = &stroker->cache_buckets[entry->bucket];
+    while (*pitem && *pitem != entry) pitem = &(*pitem)->next;
+    if (*pitem) *pitem = entry->next;
+
+    // remove it from the lru list
+    lx_list_entry_remove(&stroker->cache_list, &entry->entry);
+    stroker->cache_size -= entry->size;
+
+    // exit or reuse the stroked path
+    if (pstroked && !*pstroked) {
+        lx_path_clear(entry->stroked);
+        *pstroked = entry->stroked;
+    } else {
+        lx_path_exit(entry->stroked);
+    }
+    lx_free(entry);
+}
+
+// remove the least recently used entries until the cache size is not larger than the given size
+static lx_void_t lx_stroker_cache_shrink(lx_stroker_t* stroker, lx_size_t size, lx_path_ref_t* pstroked) {
+    lx_assert(stroker);
+    while (stroker->cache_size > size && !lx_list_entry_is_empty(&stroker->cache_list)) {
+        lx_stroker_cache_entry_t* entry = (lx_stroker_cache_entry_t*)lx_list_entry(&stroker->cache_list, lx_list_entry_head(&stroker->cache_list));
+        lx_stroker_cache_remove(stroker, entry, pstroked);
+    }
+}
+
+/* find the cached stroked path
+ *
+ * the stale entry of the modified source path will be removed, it will never be hit again.
+ * and the estimated size will be updated if the matrix scale class is changed, because it will be flattened to more or less points.
+ */
+static lx_path_ref_t lx_stroker_cache_find(lx_stroker_t* stroker, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_uint16_t scale, lx_size_t octave, lx_path_ref_t path, lx_size_t* pbucket) {
+    lx_assert(stroker && stroker->cache_buckets && paint && path && pbucket);
+
+    lx_float_t width  = lx_paint_stroke_width(paint);
+    lx_float_t miter  = lx_paint_stroke_miter(paint);
+    lx_size_t  cap    = lx_paint_stroke_cap(paint);
+    lx_size_t  join   = lx_paint_stroke_join(paint);
+    lx_size_t  bucket = lx_stroker_cache_bucket(path, width, cap, join);
+    lx_stroker_cache_entry_t* entry = stroker->cache_buckets[bucket];
+    *pbucket = bucket;
+    while (entry) {
+        if (    entry->path == path && entry->width == width && entry->miter == miter
+            &&  entry->cap == cap && entry->join == join && entry->octave == octave) {
+            if (entry->generation == lx_path_generation(path)) {
+                lx_list_entry_moveto_tail(&stroker->cache_list, &entry->entry);
+                if (entry->scale != scale) {
+                    lx_size_t size = lx_stroker_cache_size(entry->stroked, matrix);
+                    if (size) {
+                        stroker->cache_size = stroker->cache_size - entry->size + size;
+                        entry->size  = size;
+                        entry->scale = scale;
+                    }
+
+                    // remove the other least recently used entries if it's larger now, this entry is the last one
+                    while (stroker->cache_size > stroker->cache_maxsize) {
+                        lx_stroker_cache_entry_t* head = (lx_stroker_cache_entry_t*)lx_list_entry(&stroker->cache_list, lx_list_entry_head(&stroker->cache_list));
+                        lx_check_break(head != entry);
+                        lx_stroker_cache_remove(stroker, head, lx_null);
+                    }
+                }
+                return entry->stroked;
+            }
+            lx_stroker_cache_remove(stroker, entry, lx_null);
+            break;
+        }
+        entry = entry->next;
+    }
+    return lx_null;
+}
+
+/* save the stroked path to the cache
+ *
+ * the cache entry will take over the output path directly and we use a new output path,
+ * so we need not copy the stroked path.
+ */
+static lx_void_t lx_stroker_cache_save(lx_stroker_t* stroker, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_uint16_t scale, lx_size_t octave, lx_path_ref_t path, lx_size_t bucket) {
+    lx_assert(stroker && stroker->cache_buckets && paint && path);
+
+    // get the estimated size of the stroked path and its flattened polygon
+    lx_path_ref_t stroked = stroker->path_outer;
+    lx_size_t     size = lx_stroker_cache_size(stroked, matrix);
+    lx_check_return(size && size <= stroker->cache_maxsize);
+
+    // remove the least recently used entries, and reuse the first removed path as the new output path
+    lx_path_ref_t path_outer = lx_null;
+    lx_stroker_cache_shrink(stroker, stroker->cache_maxsize - size, &path_outer);
+    if (!path_outer) {
+        path_outer = lx_path_init();
+        lx_assert_and_check_return(path_outer);
+    }
+
+    // make entry
+    lx_stroker_cache_entry_t* entry = lx_malloc0_type(lx_stroker_cache_entry_t);
+    if (!entry) {
+        lx_path_exit(path_outer);
+        return ;
+    }
+    entry->path       = path;
+    entry->generation = lx_path_generation(path);
+    entry->width      = lx_paint_stroke_width(paint);
+    entry->miter      = lx_paint_stroke_miter(paint);
+    entry->cap        = (lx_uint8_t)lx_paint_stroke_cap(paint);
+    entry->join       = (lx_uint8_t)lx_paint_stroke_join(paint);
+    entry->scale      = scale;
+    entry->octave     = (lx_uint8_t)octave;
+    entry->bucket     = (lx_uint16_t)bucket;
+    entry->size       = size;
+    entry->stroked    = stroked;
+    entry->next       = stroker->cache_buckets[bucket];
+    stroker->cache_buckets[bucket] = entry;
+    lx_list_entry_insert_tail(&stroker->cache_list, &entry->entry);
+    stroker->cache_size += size;
+    stroker->path_outer = path_outer;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -1206,6 +2293,10 @@ lx_stroker_ref_t lx_stroker_init() {
         stroker->miter_invert      = lx_invert(LX_STROKER_DEFAULT_MITER);
         stroker->is_line_to_prev   = lx_false;
         stroker->is_line_to_first  = lx_false;
+        stroker->offset_error      = LX_STROKER_OFFSET_ERROR;
+
+        // init the lru list of cache
+        lx_list_entry_init(&stroker->cache_list, lx_stroker_cache_entry_t, entry);
 
         // init the outer path
         stroker->path_outer = lx_path_init();
@@ -1234,6 +2325,31 @@ lx_stroker_ref_t lx_stroker_init() {
 lx_void_t lx_stroker_exit(lx_stroker_ref_t self) {
     lx_stroker_t* stroker = (lx_stroker_t*)self;
     if (stroker) {
+        if (stroker->cache_buckets) {
+            lx_stroker_cache_shrink(stroker, 0, lx_null);
+            lx_free(stroker->cache_buckets);
+            stroker->cache_buckets = lx_null;
+        }
+        if (stroker->dash_points) {
+            lx_array_exit(stroker->dash_points);
+            stroker->dash_points = lx_null;
+        }
+        if (stroker->outline_right) {
+            lx_array_exit(stroker->outline_right);
+            stroker->outline_right = lx_null;
+        }
+        if (stroker->contour_points) {
+            lx_array_exit(stroker->contour_points);
+            stroker->contour_points = lx_null;
+        }
+        if (stroker->polygon_counts) {
+            lx_array_exit(stroker->polygon_counts);
+            stroker->polygon_counts = lx_null;
+        }
+        if (stroker->polygon_points) {
+            lx_array_exit(stroker->polygon_points);
+            stroker->polygon_points = lx_null;
+        }
         if (stroker->path_other) {
             lx_path_exit(stroker->path_other);
             stroker->path_other = lx_null;
@@ -1265,6 +2381,9 @@ lx_void_t lx_stroker_clear(lx_stroker_ref_t self) {
     stroker->miter_invert      = lx_invert(LX_STROKER_DEFAULT_MITER);
     stroker->is_line_to_prev   = lx_false;
     stroker->is_line_to_first  = lx_false;
+    stroker->dash_count        = 0;
+    stroker->dash_scale        = 1.0f;
+    stroker->offset_error      = LX_STROKER_OFFSET_ERROR;
 
     // clear the other path
     if (stroker->path_other) lx_path_clear(stroker->path_other);
@@ -1332,6 +2451,39 @@ lx_void_t lx_stroker_apply_paint(lx_stroker_ref_t self, lx_paint_ref_t paint) {
 
     // set joiner
     stroker->joiner = s_joiners[stroker->join];
+
+    // set the dash intervals
+    lx_float_t          phase = 0;
+    lx_float_t const*   intervals = lx_null;
+    lx_size_t           count = lx_paint_stroke_dash(paint, &intervals, &phase);
+    stroker->dash_count = 0;
+    if (count && intervals) {
+        lx_size_t  i;
+        lx_float_t length = 0;
+        lx_assert(count <= LX_PAINT_STROKE_DASH_MAXN && !(count & 0x1));
+        for (i = 0; i < count; i++) {
+            stroker->dash[i] = intervals[i];
+            length += intervals[i];
+        }
+        lx_assert(length > 0);
+
+        // wrap the phase to [0, length)
+        lx_float_t loops = phase / length;
+        phase = lx_abs(loops) < 1e6f? phase - length * (lx_float_t)lx_floor(loops) : 0;
+
+        // find the start interval
+        for (i = 0; i < count && phase >= stroker->dash[i]; i++) {
+            phase -= stroker->dash[i];
+        }
+        if (i == count) {
+            i = 0;
+            phase = 0;
+        }
+        stroker->dash_count     = count;
+        stroker->dash_length    = length;
+        stroker->dash_index     = i;
+        stroker->dash_remain    = stroker->dash[i] - phase;
+    }
 }
 
 lx_void_t lx_stroker_close(lx_stroker_ref_t self) {
@@ -1540,6 +2692,15 @@ lx_void_t lx_stroker_cubic_to(lx_stroker_ref_t self, lx_point_ref_t ctrl0, lx_po
 }
 
 lx_void_t lx_stroker_add_path(lx_stroker_ref_t self, lx_path_ref_t path) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return(stroker && path);
+
+    // dash it? we only add the dash pieces of the flattened contours, the dashed path need not be made
+    if (stroker->dash_count) {
+        lx_stroker_contour_add_path(stroker, path, stroker->dash_scale, lx_stroker_dash_add_lines);
+        return ;
+    }
+
     lx_for_all_if (lx_path_item_ref_t, item, path, item) {
         switch (item->code) {
         case LX_PATH_CODE_MOVE:
@@ -1694,12 +2855,17 @@ lx_void_t lx_stroker_add_ellipse(lx_stroker_ref_t self, lx_ellipse_ref_t ellipse
 }
 
 lx_void_t lx_stroker_add_lines(lx_stroker_ref_t self, lx_point_ref_t points, lx_size_t count) {
-    lx_assert_and_check_return(points && count && !(count & 0x1));
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return(stroker && points && count && !(count & 0x1));
 
     lx_size_t index;
     for (index = 0; index < count; index += 2) {
-        lx_stroker_move_to(self, points + index);
-        lx_stroker_line_to(self, points + index + 1);
+        if (stroker->dash_count) {
+            lx_stroker_dash_add_contour(stroker, points + index, 2, lx_false, lx_stroker_dash_add_lines);
+        } else {
+            lx_stroker_move_to(self, points + index);
+            lx_stroker_line_to(self, points + index + 1);
+        }
     }
 }
 
@@ -1742,13 +2908,30 @@ lx_void_t lx_stroker_add_points(lx_stroker_ref_t self, lx_point_ref_t points, lx
 }
 
 lx_void_t lx_stroker_add_polygon(lx_stroker_ref_t self, lx_polygon_ref_t polygon) {
-    lx_assert_and_check_return(polygon && polygon->points && polygon->counts);
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return(stroker && polygon && polygon->points && polygon->counts);
+
+    // dash it?
+    if (stroker->dash_count) {
+        lx_point_ref_t  points = polygon->points;
+        lx_uint32_t*    counts = polygon->counts;
+        lx_uint32_t     count;
+        while ((count = *counts++)) {
+            if (count > 1) {
+                lx_point_ref_t first = points;
+                lx_point_ref_t last = points + count - 1;
+                lx_stroker_dash_add_contour(stroker, points, count, first->x == last->x && first->y == last->y, lx_stroker_dash_add_lines);
+            }
+            points += count;
+        }
+        return ;
+    }
 
     lx_point_ref_t  first = lx_null;
     lx_point_ref_t  point = lx_null;
     lx_point_ref_t  points = polygon->points;
-    lx_uint16_t*    counts = polygon->counts;
-    lx_uint16_t     count = *counts++;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count = *counts++;
     lx_size_t       index = 0;
     while (index < count) {
         point = points++;
@@ -1791,15 +2974,56 @@ lx_path_ref_t lx_stroker_make(lx_stroker_ref_t self, lx_bool_t convex) {
     return stroker->path_outer;
 }
 
-lx_path_ref_t lx_stroker_make_from_path(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_path_ref_t path) {
+lx_void_t lx_stroker_cache_set(lx_stroker_ref_t self, lx_size_t maxsize) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return(stroker);
+
+    // init buckets
+    if (maxsize && !stroker->cache_buckets) {
+        stroker->cache_buckets = lx_nalloc0_type(LX_STROKER_CACHE_BUCKETS, lx_stroker_cache_entry_t*);
+        lx_assert_and_check_return(stroker->cache_buckets);
+    }
+
+    // remove the entries out of the new budget
+    if (stroker->cache_buckets) {
+        lx_stroker_cache_shrink(stroker, maxsize, lx_null);
+    }
+    stroker->cache_maxsize = maxsize;
+}
+
+lx_path_ref_t lx_stroker_make_from_path(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_path_ref_t path) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return_val(stroker && paint && path, lx_null);
+
+    // attempt to get the cached stroked path
+    lx_size_t   bucket = 0;
+    lx_uint16_t scale = 0;
+    lx_size_t   octave = lx_stroker_offset_octave(matrix);
+    lx_bool_t   cached = stroker->cache_maxsize && stroker->cache_buckets && !lx_paint_stroke_dash(paint, lx_null, lx_null);
+    if (cached) {
+        scale = lx_stroker_cache_scale(matrix);
+        lx_path_ref_t stroked = lx_stroker_cache_find(stroker, paint, matrix, scale, octave, path, &bucket);
+        if (stroked) return stroked;
+    }
+
+    // make the stroked path
     lx_stroker_clear(self);
     lx_stroker_apply_paint(self, paint);
-    // attempt to add hint first
+    stroker->dash_scale = lx_stroker_flatten_scale(matrix);
+    stroker->offset_error = LX_STROKER_OFFSET_ERROR / (lx_float_t)(1 << octave);
+
+    // attempt to add hint first, but the dashed hint shape need be flattened
     lx_bool_t convex = lx_false;
-    if (!lx_stroker_add_hint(self, lx_path_hint(path), &convex)) {
+    if (stroker->dash_count || !lx_stroker_add_hint(self, lx_path_hint(path), &convex)) {
         lx_stroker_add_path(self, path);
     }
-    return lx_stroker_make(self, convex);
+    lx_path_ref_t stroked = lx_stroker_make(self, convex);
+
+    // save it to the cache
+    if (cached && stroked && !lx_path_empty(stroked)) {
+        lx_stroker_cache_save(stroker, paint, matrix, scale, octave, path, bucket);
+    }
+    return stroked;
 }
 
 lx_path_ref_t lx_stroker_make_from_lines(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_point_ref_t points, lx_size_t count) {
@@ -1821,8 +3045,94 @@ lx_path_ref_t lx_stroker_make_from_polygon(lx_stroker_ref_t self, lx_paint_ref_t
     lx_stroker_apply_paint(self, paint);
     // attempt to add hint first
     lx_bool_t convex = lx_false;
-    if (!lx_stroker_add_hint(self, hint, &convex)) {
+    if (lx_paint_stroke_dash(paint, lx_null, lx_null) || !lx_stroker_add_hint(self, hint, &convex)) {
         lx_stroker_add_polygon(self, polygon);
     }
     return lx_stroker_make(self, convex);
 }
+
+lx_polygon_ref_t lx_stroker_make_polygon_from_lines(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_point_ref_t points, lx_size_t count) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return_val(stroker && paint && points && count && !(count & 0x1), lx_null);
+    lx_check_return_val(lx_stroker_polygon_init(stroker, paint, lx_false), lx_null);
+
+    lx_size_t index;
+    for (index = 0; index < count; index += 2) {
+        lx_vector_t     direction;
+        lx_point_ref_t  p0 = points + index;
+        lx_point_ref_t  p1 = points + index + 1;
+        if (lx_vector_make_unit(&direction, p1->x - p0->x, p1->y - p0->y)) {
+            lx_stroker_polygon_add_segment(stroker, p0, p1, &direction, lx_true, lx_true);
+        }
+    }
+
+    /* the quads may be overlapped, so we need merge them by the nonzero rule
+     *
+     * all lines are filled as one polygon, so the overlapped pixels will be only blended once
+     */
+    return lx_stroker_polygon_make(stroker, lx_false);
+}
+
+lx_polygon_ref_t lx_stroker_make_polygon_from_polygon(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_polygon_ref_t polygon, lx_shape_ref_t hint) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return_val(stroker && paint && polygon && polygon->points && polygon->counts, lx_null);
+
+    // the curve shapes need be stroked with the exact curves
+    lx_check_return_val(!hint || hint->type == LX_SHAPE_TYPE_RECT || hint->type == LX_SHAPE_TYPE_TRIANGLE, lx_null);
+    lx_check_return_val(lx_stroker_polygon_init(stroker, paint, lx_true), lx_null);
+
+    lx_point_ref_t  points = polygon->points;
+    lx_uint32_t*    counts = polygon->counts;
+    lx_uint32_t     count;
+    while ((count = *counts++)) {
+        lx_stroker_polygon_add_polyline(stroker, points, count);
+        points += count;
+    }
+
+    // the pieces are overlapped at the joins, so we need merge them by the nonzero rule
+    return lx_stroker_polygon_make(stroker, lx_false);
+}
+
+lx_polygon_ref_t lx_stroker_make_polygon_from_path(lx_stroker_ref_t self, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_path_ref_t path) {
+    lx_stroker_t* stroker = (lx_stroker_t*)self;
+    lx_assert_and_check_return_val(stroker && paint && matrix && path, lx_null);
+
+    // the stroked path cache is enabled? we use the cached stroked path instead of restroking it every time
+    lx_bool_t dashed = lx_paint_stroke_dash(paint, lx_null, lx_null) > 0;
+    lx_check_return_val(!stroker->cache_maxsize || dashed, lx_null);
+
+    // the curve shapes need be stroked with the exact curves, but we need dash them along the flattened contours
+    lx_shape_ref_t hint = lx_path_hint(path);
+    lx_check_return_val(dashed || !hint || hint->type == LX_SHAPE_TYPE_RECT || hint->type == LX_SHAPE_TYPE_TRIANGLE || hint->type == LX_SHAPE_TYPE_LINE, lx_null);
+    lx_check_return_val(lx_stroker_polygon_init_points(stroker, paint), lx_null);
+
+    // init the outline points
+    if (!stroker->outline_right) {
+        stroker->outline_right = lx_array_init(LX_STROKER_POLYGON_POINTS_GROW, lx_element_mem(sizeof(lx_point_t), lx_null, lx_null));
+    }
+    lx_assert_and_check_return_val(stroker->outline_right, lx_null);
+
+    /* compute the arc step of the round joins and caps for the device radius: R
+     *
+     * error = R * (1 - cos(step / 2)) ~= R * step^2 / 8
+     * => step = sqrt(8 * error / R)
+     */
+    lx_float_t radius = stroker->radius * lx_stroker_matrix_scale(matrix);
+    lx_float_t step = radius > 0? lx_sqrtf(8.0f * LX_STROKER_OUTLINE_ARC_ERROR / radius) : LX_PI;
+    stroker->outline_arc_step = lx_max(step, LX_PI / LX_STROKER_OUTLINE_ARC_MAXN);
+
+    // the smooth joins need be less than the arc step, and the miter error is also about R * step^2 / 8
+    lx_float_t sin = 0;
+    lx_float_t cos = 1;
+    lx_sincosf(lx_half(lx_min(step, LX_PI / 2)), &sin, &cos);
+    stroker->outline_smooth_tan = sin / cos;
+
+    /* flatten and stroke each contour to the polygon directly
+     *
+     * we need not make the inner and outer paths and flatten the stroked path again.
+     */
+    lx_stroker_contour_add_path(stroker, path, lx_stroker_flatten_scale(matrix), lx_stroker_outline_add_contour);
+
+    // the outlines may be self-intersected at the inner joins, so we need fill them with the nonzero rule
+    return lx_stroker_polygon_make(stroker, lx_false);
+}
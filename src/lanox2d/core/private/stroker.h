@@ -171,15 +171,29 @@ lx_void_t                   lx_stroker_add_polygon(lx_stroker_ref_t stroker, lx_
  */
 lx_path_ref_t               lx_stroker_make(lx_stroker_ref_t stroker, lx_bool_t convex);
 
+/* set the memory budget of the stroked path cache
+ *
+ * the stroked paths made from lx_stroker_make_from_path() will be cached by the source path generation
+ * and the stroke parameters, they will be reused for all zoom levels in the same matrix scale octave,
+ * and the least recently used paths will be removed if the estimated size exceeds the budget.
+ *
+ * @param stroker           the stroker
+ * @param maxsize           the maximum memory size in bytes, it will disable and clear the cache if it's zero
+ */
+lx_void_t                   lx_stroker_cache_set(lx_stroker_ref_t stroker, lx_size_t maxsize);
+
 /* make the stroked path from the given path
+ *
+ * the returned path may be owned by the stroked path cache, so it cannot be modified.
  *
  * @param stroker           the stroker
  * @param paint             the paint
+ * @param matrix            the matrix for the offset error, the estimated size of cache and the dash flattening, it can be null
  * @param path              the path
  *
  * @return                  the stroked path
  */
-lx_path_ref_t               lx_stroker_make_from_path(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_path_ref_t path);
+lx_path_ref_t               lx_stroker_make_from_path(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_path_ref_t path);
 
 /* make the stroked path from the given lines
  *
@@ -214,6 +228,52 @@ lx_path_ref_t               lx_stroker_make_from_points(lx_stroker_ref_t stroker
  */
 lx_path_ref_t               lx_stroker_make_from_polygon(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_polygon_ref_t polygon, lx_shape_ref_t hint);
 
+/* make the stroked polygon from the given lines directly
+ *
+ * it does not build the stroked path, each line is stroked to a convex quad,
+ * and only the butt and square caps are supported.
+ *
+ * all quads are returned as one polygon and need be filled by the nonzero rule,
+ * so the overlapped lines will be only blended once.
+ *
+ * @param stroker           the stroker
+ * @param paint             the paint
+ * @param points            the points
+ * @param count             the points count
+ *
+ * @return                  the stroked polygon, return lx_null if this paint is not supported
+ */
+lx_polygon_ref_t            lx_stroker_make_polygon_from_lines(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_point_ref_t points, lx_size_t count);
+
+/* make the stroked polygon from the given polyline polygon directly
+ *
+ * each segment is stroked to a convex quad and each join to a convex miter or bevel piece,
+ * they need be filled with the nonzero rule. only the butt/square caps and miter/bevel joins are supported.
+ *
+ * @param stroker           the stroker
+ * @param paint             the paint
+ * @param polygon           the polygon
+ * @param hint              the hint shape
+ *
+ * @return                  the stroked polygon, return lx_null if this paint or hint is not supported
+ */
+lx_polygon_ref_t            lx_stroker_make_polygon_from_polygon(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_polygon_ref_t polygon, lx_shape_ref_t hint);
+
+/* make the stroked polygon from the given path directly
+ *
+ * the curves are flattened for the matrix and the outline of each contour is streamed to the polygon,
+ * we need not build the inner, outer and stroked paths. it needs be filled with the nonzero rule.
+ *
+ * @param stroker           the stroker
+ * @param paint             the paint
+ * @param matrix            the matrix
+ * @param path              the path
+ *
+ * @return                  the stroked polygon, return lx_null if the path hint is not supported
+ *                          or the stroked path cache is enabled
+ */
+lx_polygon_ref_t            lx_stroker_make_polygon_from_path(lx_stroker_ref_t stroker, lx_paint_ref_t paint, lx_matrix_ref_t matrix, lx_path_ref_t path);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
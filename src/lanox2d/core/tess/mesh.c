@@ -385,6 +385,15 @@ lx_void_t lx_mesh_clear(lx_mesh_ref_t self) {
     }
 }
 
+lx_size_t lx_mesh_allocs(lx_mesh_ref_t self) {
+    lx_mesh_t* mesh = (lx_mesh_t*)self;
+    lx_assert_and_check_return_val(mesh && mesh->edges && mesh->faces && mesh->vertices, 0);
+
+    return  lx_mesh_edge_list_allocs(mesh->edges)
+        +   lx_mesh_face_list_allocs(mesh->faces)
+        +   lx_mesh_vertex_list_allocs(mesh->vertices);
+}
+
 lx_bool_t lx_mesh_is_empty(lx_mesh_ref_t self) {
     lx_mesh_t* mesh = (lx_mesh_t*)self;
     lx_assert_and_check_return_val(mesh, lx_true);
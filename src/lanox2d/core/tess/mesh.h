@@ -358,6 +358,16 @@ lx_void_t                       lx_mesh_exit(lx_mesh_ref_t mesh);
  */
 lx_void_t                       lx_mesh_clear(lx_mesh_ref_t mesh);
 
+/*! the allocation count of the edges, faces and vertices
+ *
+ * the mesh keeps them after clearing, so it will not grow if the mesh is made and cleared repeatedly.
+ *
+ * @param mesh                  the mesh
+ *
+ * @return                      the allocation count
+ */
+lx_size_t                       lx_mesh_allocs(lx_mesh_ref_t mesh);
+
 /*! is empty?
  *
  * @param mesh                  the mesh
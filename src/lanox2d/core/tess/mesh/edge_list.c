@@ -259,6 +259,13 @@ lx_size_t lx_mesh_edge_list_size(lx_mesh_edge_list_ref_t self) {
     return lx_fixed_pool_size(list->pool);
 }
 
+lx_size_t lx_mesh_edge_list_allocs(lx_mesh_edge_list_ref_t self) {
+    lx_mesh_edge_list_t* list = (lx_mesh_edge_list_t*)self;
+    lx_assert_and_check_return_val(list && list->pool, 0);
+
+    return lx_fixed_pool_allocs(list->pool);
+}
+
 lx_mesh_edge_ref_t lx_mesh_edge_list_head(lx_mesh_edge_list_ref_t self) {
     lx_mesh_edge_list_t* list = (lx_mesh_edge_list_t*)self;
     lx_assert(list);
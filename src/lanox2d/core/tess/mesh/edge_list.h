@@ -63,6 +63,14 @@ lx_void_t                   lx_mesh_edge_list_clear(lx_mesh_edge_list_ref_t list
  */
 lx_size_t                   lx_mesh_edge_list_size(lx_mesh_edge_list_ref_t list);
 
+/*! the slot allocation count of the edge pool
+ *
+ * @param list              the list
+ *
+ * @return                  the allocation count
+ */
+lx_size_t                   lx_mesh_edge_list_allocs(lx_mesh_edge_list_ref_t list);
+
 /*! the head edge
  *
  * @param list              the list
@@ -62,6 +62,14 @@ lx_void_t                   lx_mesh_face_list_clear(lx_mesh_face_list_ref_t list
  */
 lx_size_t                   lx_mesh_face_list_size(lx_mesh_face_list_ref_t list);
 
+/*! the slot allocation count of the face pool
+ *
+ * @param list              the list
+ *
+ * @return                  the allocation count
+ */
+lx_size_t                   lx_mesh_face_list_allocs(lx_mesh_face_list_ref_t list);
+
 /*! the head face
  *
  * @param list              the list
@@ -141,6 +141,13 @@ lx_size_t lx_mesh_vertex_list_size(lx_mesh_vertex_list_ref_t self) {
     return lx_list_entry_size(&list->head);
 }
 
+lx_size_t lx_mesh_vertex_list_allocs(lx_mesh_vertex_list_ref_t self) {
+    lx_mesh_vertex_list_t* list = (lx_mesh_vertex_list_t*)self;
+    lx_assert_and_check_return_val(list && list->pool, 0);
+
+    return lx_fixed_pool_allocs(list->pool);
+}
+
 lx_mesh_vertex_ref_t lx_mesh_vertex_list_head(lx_mesh_vertex_list_ref_t self) {
     lx_mesh_vertex_list_t* list = (lx_mesh_vertex_list_t*)self;
     lx_assert(list);
@@ -63,6 +63,14 @@ lx_void_t                   lx_mesh_vertex_list_clear(lx_mesh_vertex_list_ref_t
  */
 lx_size_t                   lx_mesh_vertex_list_size(lx_mesh_vertex_list_ref_t list);
 
+/*! the slot allocation count of the vertex pool
+ *
+ * @param list              the list
+ *
+ * @return                  the allocation count
+ */
+lx_size_t                   lx_mesh_vertex_list_allocs(lx_mesh_vertex_list_ref_t list);
+
 /*! the head vertex
  *
  * @param list              the list
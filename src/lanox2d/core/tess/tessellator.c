@@ -66,8 +66,10 @@ static lx_void_t lx_tessellator_result_clear(lx_tessellator_t* tessellator) {
     // clear polygon counts
     if (tessellator->mode != LX_TESSELLATOR_MODE_TRIANGULATION) { // we need not counts to optimize memory if be only triangulation
         if (!tessellator->polygon_counts) {
-            tessellator->polygon_counts = lx_array_init(LX_TESSELLATOR_POLYGON_COUNTS_GROW, lx_element_mem(sizeof(lx_uint16_t), lx_null, lx_null));
+            tessellator->polygon_counts = lx_array_init(LX_TESSELLATOR_POLYGON_COUNTS_GROW, lx_element_mem(sizeof(lx_uint32_t), lx_null, lx_null));
         }
+    }
+    if (tessellator->polygon_counts) { // it may be still kept after switching to the triangulation mode
         lx_array_clear(tessellator->polygon_counts);
     }
 }
@@ -87,7 +89,7 @@ static lx_void_t lx_tessellator_result_append(lx_tessellator_t* tessellator) {
             lx_mesh_edge_ref_t  edge        = head;
             lx_point_ref_t      point       = lx_null;
             lx_point_ref_t      point_first = lx_null;
-            lx_uint16_t         count       = 0;
+            lx_uint32_t         count       = 0;
             do {
                 point = lx_tessellator_vertex_point(lx_mesh_edge_org(edge));
                 lx_assert(point);
@@ -122,9 +124,9 @@ static lx_void_t lx_tessellator_result_append(lx_tessellator_t* tessellator) {
     if (tessellator->polygon.total) {
         tessellator->polygon.points = (lx_point_ref_t)lx_array_data(polygon_points);
         if (polygon_counts) {
-            lx_uint16_t zero = 0;
+            lx_uint32_t zero = 0;
             lx_array_insert_tail(polygon_counts, &zero);
-            tessellator->polygon.counts = (lx_uint16_t*)lx_array_data(polygon_counts);
+            tessellator->polygon.counts = (lx_uint32_t*)lx_array_data(polygon_counts);
         }
     }
 }
@@ -256,6 +258,11 @@ lx_polygon_ref_t lx_tessellator_make(lx_tessellator_ref_t self, lx_polygon_ref_t
         return polygon;
     }
 
+    // save the buffer sizes for counting allocations
+    lx_size_t points_maxn = lx_array_maxn(tessellator->polygon_points);
+    lx_size_t counts_maxn = lx_array_maxn(tessellator->polygon_counts);
+    lx_size_t events_maxn = lx_priority_queue_maxn(tessellator->event_queue);
+
     // clear result
     lx_tessellator_result_clear(tessellator);
 
@@ -264,8 +271,8 @@ lx_polygon_ref_t lx_tessellator_make(lx_tessellator_ref_t self, lx_polygon_ref_t
         lx_polygon_t    contour;
         lx_size_t       index               = 0;
         lx_point_ref_t  points              = polygon->points;
-        lx_uint16_t*    counts              = polygon->counts;
-        lx_uint16_t     contour_counts[2]   = {0, 0};
+        lx_uint32_t*    counts              = polygon->counts;
+        lx_uint32_t     contour_counts[2]   = {0, 0};
         lx_polygon_make(&contour, lx_null, contour_counts, 0, lx_true);
         while ((contour_counts[0] = *counts++)) {
             contour.points = points + index;
@@ -275,5 +282,24 @@ lx_polygon_ref_t lx_tessellator_make(lx_tessellator_ref_t self, lx_polygon_ref_t
     } else {
         lx_tessellator_make_from_concave(tessellator, polygon, bounds);
     }
+
+    // count the grown buffers
+    if (lx_array_maxn(tessellator->polygon_points) != points_maxn) tessellator->allocs++;
+    if (lx_array_maxn(tessellator->polygon_counts) != counts_maxn) tessellator->allocs++;
+    if (lx_priority_queue_maxn(tessellator->event_queue) != events_maxn) tessellator->allocs++;
     return tessellator->polygon.total? &tessellator->polygon : lx_null;
 }
+
+lx_size_t lx_tessellator_allocs(lx_tessellator_ref_t self) {
+    lx_tessellator_t* tessellator = (lx_tessellator_t*)self;
+    lx_assert_and_check_return_val(tessellator, 0);
+
+    lx_size_t allocs = tessellator->allocs;
+    if (tessellator->mesh) {
+        allocs += lx_mesh_allocs(tessellator->mesh);
+    }
+    if (tessellator->active_regions) {
+        allocs += lx_list_allocs(tessellator->active_regions);
+    }
+    return allocs;
+}
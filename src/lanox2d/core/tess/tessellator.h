@@ -171,6 +171,17 @@ lx_void_t               lx_tessellator_flags_set(lx_tessellator_ref_t tessellato
  */
 lx_polygon_ref_t        lx_tessellator_make(lx_tessellator_ref_t tessellator, lx_polygon_ref_t polygon, lx_rect_ref_t bounds);
 
+/*! the allocation count of the tessellator
+ *
+ * the mesh, event queue, active regions and output polygon are kept and reused for the next tessellation,
+ * so it should not grow any more after warm-up if we tessellate the similar polygons repeatedly.
+ *
+ * @param tessellator   the tessellator
+ *
+ * @return              the count of the allocated pool slots and grown buffers
+ */
+lx_size_t               lx_tessellator_allocs(lx_tessellator_ref_t tessellator);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
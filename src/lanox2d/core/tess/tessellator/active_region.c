@@ -269,6 +269,7 @@ static lx_void_t lx_tessellator_active_regions_insert_bounds(lx_tessellator_t* t
     region.inside   = 0;
     region.fixedge  = 0;
     region.bounds   = 1;
+    region.dirty    = 0;
 
     // insert region
     lx_tessellator_active_regions_insert(tessellator, &region);
@@ -299,6 +300,8 @@ static lx_void_t lx_tessellator_active_regions_test_insert(lx_tessellator_t* tes
     region.edge     = edge;
     region.winding  = 0;
     region.inside   = 0;
+    region.fixedge  = 0;
+    region.dirty    = 0;
     region.bounds   = 1;
 
     // insert region
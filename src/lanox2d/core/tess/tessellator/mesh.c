@@ -90,7 +90,7 @@ lx_bool_t lx_tessellator_mesh_make(lx_tessellator_t* tessellator, lx_polygon_ref
 
     // the points
     lx_point_ref_t      points = polygon->points;
-    lx_uint16_t const*  counts = polygon->counts;
+    lx_uint32_t const*  counts = polygon->counts;
     lx_assert_and_check_return_val(points && counts, lx_false);
 
     // not exists mesh?
@@ -137,7 +137,7 @@ lx_bool_t lx_tessellator_mesh_make(lx_tessellator_t* tessellator, lx_polygon_ref
     lx_mesh_clear(mesh);
 
     lx_point_ref_t      point       = lx_null;
-    lx_uint16_t         count       = *counts++;
+    lx_uint32_t         count       = *counts++;
     lx_size_t           index       = 0;
     lx_mesh_edge_ref_t  edge        = lx_null;
     lx_mesh_edge_ref_t  edge_first  = lx_null;
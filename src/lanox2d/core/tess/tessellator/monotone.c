@@ -2533,6 +2533,7 @@ static lx_tessellator_active_region_ref_t lx_tessellator_insert_region_at_right(
     region.inside   = 0;
     region.bounds   = 0;
     region.fixedge  = 0;
+    region.dirty    = 0;
 
     // insert region after the left region
     return lx_tessellator_active_regions_insert_after(tessellator, region_left, &region);
@@ -174,6 +174,9 @@ typedef struct lx_tessellator_t_ {
     lx_list_ref_t                       active_regions;
     lx_iterator_t                       active_regions_iterator;
 
+    // the grown count of the output polygon and event queue buffers
+    lx_size_t                           allocs;
+
 }lx_tessellator_t;
 
 #endif
@@ -106,7 +106,7 @@
 #   if defined(__thumb__)
 #       define LX_ARCH_ARM_THUMB
 #   endif
-#   if defined(__ARM_NEON__)
+#   if defined(__ARM_NEON__) || defined(__ARM_NEON)
 #       define LX_ARCH_ARM_NEON
 #   endif
 #elif defined(mips) \
@@ -143,6 +143,26 @@
 #   endif
 #endif
 
+// avx
+#if defined(LX_ARCH_x86) || defined(LX_ARCH_x64)
+#   if defined(__AVX__)
+#       define LX_ARCH_AVX
+#   endif
+#   if defined(__AVX2__)
+#       define LX_ARCH_AVX2
+#   endif
+#endif
+
+/* the runtime simd dispatch for x86
+ *
+ * we can compile the sse2, avx2 and avx512 implementations together without -mavx2 ...,
+ * and select the best implementation by lx_cpu_features() at runtime.
+ */
+#if (defined(LX_ARCH_x86) || defined(LX_ARCH_x64)) && \
+    (defined(LX_COMPILER_IS_MSVC) || defined(LX_COMPILER_IS_CLANG) || (defined(LX_COMPILER_IS_GCC) && LX_COMPILER_VERSION_BE(4, 9)))
+#   define LX_ARCH_SIMD_DISPATCH
+#endif
+
 // vfp
 #if defined(__VFP_FP__) || (defined(LX_COMPILER_IS_TINYC) && defined(TCC_ARM_VFP))
 #   define LX_ARCH_VFP
@@ -227,6 +227,16 @@
 #   define lx_has_builtin(x)                            0
 #endif
 
+/* the function target attribute, e.g. lx_target("avx2")
+ *
+ * it's used to compile the simd implementations without the global arch flags for the runtime cpu dispatch.
+ */
+#if defined(LX_COMPILER_IS_GCC)
+#   define lx_target(t)                                 __attribute__((target(t)))
+#else
+#   define lx_target(t)
+#endif
+
 // no_sanitize_address
 #if lx_has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
 #   define lx_no_sanitize_address                       __attribute__((no_sanitize_address))
@@ -1,6 +1,23 @@
 #include "lanox2d/lanox2d.h"
 
+static lx_void_t lx_test_bitmap_row_bytes() {
+    // the row bytes of the ARGB8888 bitmap wider than 4096 pixels will not be overflow
+    lx_bitmap_ref_t bitmap = lx_bitmap_init(lx_null, LX_PIXFMT_ARGB8888, 5000, 4, 0, lx_true);
+    if (!bitmap) lx_abort();
+    if (lx_bitmap_width(bitmap) != 5000 || lx_bitmap_height(bitmap) != 4) lx_abort();
+    if (lx_bitmap_row_bytes(bitmap) != 5000 * 4) lx_abort();
+    if (lx_bitmap_size(bitmap) != 5000 * 4 * 4) lx_abort();
+
+    // resize it to the wider bitmap
+    if (!lx_bitmap_resize(bitmap, 20000, 2)) lx_abort();
+    if (lx_bitmap_width(bitmap) != 20000 || lx_bitmap_row_bytes(bitmap) != 20000 * 4) lx_abort();
+    lx_bitmap_exit(bitmap);
+}
+
 int main(int argc, char** argv) {
+    lx_test_bitmap_row_bytes();
+    if (argc < 2) return 0;
+
     lx_bitmap_ref_t bitmap = lx_bitmap_init_from_file(argv[1], LX_PIXFMT_XRGB8888);
     if (bitmap) {
         lx_trace_i("bitmap: %lux%lu, row_bytes: %lu, pixfmt: %s",
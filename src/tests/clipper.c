@@ -0,0 +1,146 @@
+#include "lanox2d/lanox2d.h"
+#include "lanox2d/core/private/clipper.h"
+
+static lx_void_t lx_test_clipper_check(lx_clipper_ref_t clipper, lx_float_t x, lx_float_t y, lx_float_t w, lx_float_t h, lx_bool_t exact) {
+
+    // get the clip bounds in the 100x100 device
+    lx_rect_t bounds;
+    lx_rect_imake(&bounds, 0, 0, 100, 100);
+    if (lx_clipper_bounds(clipper, &bounds) != exact) lx_abort();
+
+    // the rotated bounds are not integers, so we compare them with a small tolerance
+    if (    lx_abs(bounds.x - x) > 0.01f || lx_abs(bounds.y - y) > 0.01f
+        ||  lx_abs(bounds.w - w) > 0.01f || lx_abs(bounds.h - h) > 0.01f) {
+        lx_trace_i("bounds: %{rect} != %f, %f, %f, %f", &bounds, x, y, w, h);
+        lx_abort();
+    }
+}
+
+static lx_clipper_ref_t lx_test_clipper_init(lx_size_t mode, lx_float_t x, lx_float_t y, lx_float_t w, lx_float_t h, lx_bool_t is_path, lx_bool_t rotated) {
+    lx_clipper_ref_t clipper = lx_clipper_init();
+    if (!clipper) lx_abort();
+
+    // the base clip rect is (10, 10, 60, 60)
+    lx_rect_t rect;
+    lx_rect_imake(&rect, 10, 10, 60, 60);
+    lx_clipper_add_rect(clipper, LX_CLIPPER_MODE_INTERSECT, &rect);
+
+    // rotate the next item by 45 degrees around its center
+    if (rotated) {
+        lx_matrix_t matrix;
+        lx_matrix_init_rotatep(&matrix, 45, x + lx_half(w), y + lx_half(h));
+        lx_clipper_matrix_set(clipper, &matrix);
+    }
+
+    // add the next item
+    if (is_path) {
+        lx_path_ref_t path = lx_path_init();
+        if (!path) lx_abort();
+        lx_path_add_rect2(path, x, y, w, h, LX_ROTATE_DIRECTION_CW);
+        lx_clipper_add_path(clipper, mode, path);
+        lx_path_exit(path);
+    } else {
+        lx_rect_make(&rect, x, y, w, h);
+        lx_clipper_add_rect(clipper, mode, &rect);
+    }
+    return clipper;
+}
+
+static lx_void_t lx_test_clipper_bounds_check(lx_size_t mode, lx_float_t x, lx_float_t y, lx_float_t w, lx_float_t h, lx_bool_t is_path, lx_bool_t rotated,
+                                              lx_float_t bx, lx_float_t by, lx_float_t bw, lx_float_t bh, lx_bool_t exact) {
+    lx_clipper_ref_t clipper = lx_test_clipper_init(mode, x, y, w, h, is_path, rotated);
+    lx_test_clipper_check(clipper, bx, by, bw, bh, exact);
+    lx_clipper_exit(clipper);
+}
+
+static lx_void_t lx_test_clipper_bounds() {
+
+    // the rotated 20x20 rect has the 28.28x28.28 bounds
+    lx_float_t d = 10.0f * LX_SQRT2;
+
+    // the intersected rect is exact, but the path and rotated rect are not
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_INTERSECT, 40, 20, 60, 30, lx_false, lx_false, 40, 20, 30, 30, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_INTERSECT, 40, 20, 60, 30, lx_true, lx_false, 40, 20, 30, 30, lx_false);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_INTERSECT, 30, 30, 20, 20, lx_false, lx_true, 40 - d, 40 - d, d * 2, d * 2, lx_false);
+
+    // the intersected rect outside the base rect clips all, it's always exact
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_INTERSECT, 80, 80, 10, 10, lx_false, lx_false, 80, 80, 0, 0, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_INTERSECT, 80, 80, 10, 10, lx_true, lx_false, 80, 80, 0, 0, lx_true);
+
+    // the union rect is exact if it's adjacent with the same edges, and it's clipped by the device bounds
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_UNION, 70, 10, 60, 60, lx_false, lx_false, 10, 10, 90, 60, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_UNION, 30, 30, 10, 10, lx_false, lx_false, 10, 10, 60, 60, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_UNION, 80, 80, 10, 10, lx_false, lx_false, 10, 10, 80, 80, lx_false);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_UNION, 70, 10, 60, 60, lx_true, lx_false, 10, 10, 90, 60, lx_false);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_UNION, 65, 30, 20, 20, lx_false, lx_true, 10, 10, 75 + d - 10, 60, lx_false);
+
+    // the subtracted rect is exact if it cuts a whole side, the subtracted path and rotated rect only keep the bounds
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 40, 0, 100, 100, lx_false, lx_false, 10, 10, 30, 60, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 0, 0, 100, 30, lx_false, lx_false, 10, 30, 60, 40, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 30, 30, 10, 10, lx_false, lx_false, 10, 10, 60, 60, lx_false);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 40, 0, 100, 100, lx_true, lx_false, 10, 10, 60, 60, lx_false);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 30, 30, 20, 20, lx_false, lx_true, 10, 10, 60, 60, lx_false);
+
+    // the subtracted items outside the base rect change nothing
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 80, 80, 10, 10, lx_false, lx_false, 10, 10, 60, 60, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 80, 80, 10, 10, lx_true, lx_false, 10, 10, 60, 60, lx_true);
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 80, 80, 10, 10, lx_false, lx_true, 10, 10, 60, 60, lx_true);
+
+    // the subtracted rect covering the base rect clips all
+    lx_test_clipper_bounds_check(LX_CLIPPER_MODE_SUBTRACT, 0, 0, 100, 100, lx_false, lx_false, 10, 10, 0, 0, lx_true);
+}
+
+static lx_void_t lx_test_clipper_equal() {
+
+    // the same items are equal, the paths are compared by their points
+    lx_clipper_ref_t clipper = lx_test_clipper_init(LX_CLIPPER_MODE_INTERSECT, 20, 20, 30, 30, lx_true, lx_false);
+    lx_clipper_ref_t other = lx_test_clipper_init(LX_CLIPPER_MODE_INTERSECT, 20, 20, 30, 30, lx_true, lx_false);
+    if (!lx_clipper_equal(clipper, other)) lx_abort();
+    lx_clipper_exit(other);
+
+    // only the fill rule of path is different
+    other = lx_clipper_init();
+    if (!other) lx_abort();
+    lx_clipper_fill_rule_set(other, LX_PAINT_FILL_RULE_NONZERO);
+    {
+        lx_rect_t rect;
+        lx_rect_imake(&rect, 10, 10, 60, 60);
+        lx_clipper_add_rect(other, LX_CLIPPER_MODE_INTERSECT, &rect);
+
+        lx_path_ref_t path = lx_path_init();
+        if (!path) lx_abort();
+        lx_path_add_rect2(path, 20, 20, 30, 30, LX_ROTATE_DIRECTION_CW);
+        lx_clipper_add_path(other, LX_CLIPPER_MODE_INTERSECT, path);
+        lx_path_exit(path);
+    }
+    if (lx_clipper_fill_rule(clipper) == lx_clipper_fill_rule(other)) lx_abort();
+    if (lx_clipper_equal(clipper, other)) lx_abort();
+    lx_clipper_exit(other);
+    lx_clipper_exit(clipper);
+
+    // only the matrix of rect is different
+    clipper = lx_test_clipper_init(LX_CLIPPER_MODE_INTERSECT, 20, 20, 30, 30, lx_false, lx_false);
+    other = lx_test_clipper_init(LX_CLIPPER_MODE_INTERSECT, 20, 20, 30, 30, lx_false, lx_false);
+    if (!lx_clipper_equal(clipper, other)) lx_abort();
+    lx_clipper_exit(other);
+    other = lx_test_clipper_init(LX_CLIPPER_MODE_INTERSECT, 20, 20, 30, 30, lx_false, lx_true);
+    if (lx_clipper_equal(clipper, other)) lx_abort();
+    lx_clipper_exit(other);
+
+    // the matrix of the added clipper is applied to all items
+    lx_matrix_t matrix;
+    other = lx_clipper_init();
+    if (!other) lx_abort();
+    lx_matrix_init_translate(&matrix, 5, 5);
+    lx_clipper_add_clipper(other, clipper, &matrix);
+    if (lx_clipper_equal(clipper, other)) lx_abort();
+    lx_test_clipper_check(other, 25, 25, 30, 30, lx_true);
+    lx_clipper_exit(other);
+    lx_clipper_exit(clipper);
+}
+
+int main(int argc, char** argv) {
+    lx_test_clipper_bounds();
+    lx_test_clipper_equal();
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "lanox2d/lanox2d.h"
+
+static lx_void_t lx_test_cpu_features_level() {
+
+    // the known levels only allow their features
+    if (lx_cpu_features_level("none") != LX_CPU_FEATURE_NONE) lx_abort();
+    if (lx_cpu_features_level("sse2") != LX_CPU_FEATURE_SSE2) lx_abort();
+    if (lx_cpu_features_level("avx2") != (LX_CPU_FEATURE_SSE2 | LX_CPU_FEATURE_AVX2)) lx_abort();
+    if (lx_cpu_features_level("avx512") != (LX_CPU_FEATURE_SSE2 | LX_CPU_FEATURE_AVX2 | LX_CPU_FEATURE_AVX512)) lx_abort();
+    if (lx_cpu_features_level("neon") != LX_CPU_FEATURE_NEON) lx_abort();
+
+    // the unknown levels allow all features, so we still use the detected features
+    if (lx_cpu_features_level(lx_null) != (lx_size_t)-1) lx_abort();
+    if (lx_cpu_features_level("") != (lx_size_t)-1) lx_abort();
+    if (lx_cpu_features_level("avx3") != (lx_size_t)-1) lx_abort();
+    if (lx_cpu_features_level("SSE2") != (lx_size_t)-1) lx_abort();
+}
+
+static lx_void_t lx_test_cpu_features() {
+
+    // the features are limited by LX_CPU_LEVEL
+    lx_char_t level[32];
+    lx_size_t features = lx_cpu_features();
+    lx_size_t allowed = lx_environment_get("LX_CPU_LEVEL", level, sizeof(level))? lx_cpu_features_level(level) : (lx_size_t)-1;
+    if (features & ~allowed) lx_abort();
+    if (features != lx_cpu_features()) lx_abort();
+
+#ifdef LX_ARCH_x64
+    // all x64 cpus support sse2, so it's never disabled by the unknown level
+    if (allowed == (lx_size_t)-1 && !(features & LX_CPU_FEATURE_SSE2)) lx_abort();
+#endif
+}
+
+int main(int argc, char** argv) {
+    lx_test_cpu_features_level();
+    lx_test_cpu_features();
+    return 0;
+}
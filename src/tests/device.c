@@ -0,0 +1,1158 @@
+#include "lanox2d/lanox2d.h"
+#include "lanox2d/core/private/stroker.h"
+
+#define LX_TEST_DEVICE_WIDTH    (100)
+#define LX_TEST_DEVICE_HEIGHT   (100)
+
+// the scene size, it's not aligned by the 64x64 tiles
+#define LX_TEST_DEVICE_SCENE_WIDTH      (301)
+#define LX_TEST_DEVICE_SCENE_HEIGHT     (203)
+
+// the output file of the streamed device
+#define LX_TEST_DEVICE_STREAM_FILE      "test_device.raw"
+
+typedef struct lx_test_device_target_t_ {
+    lx_uint32_t     data[LX_TEST_DEVICE_WIDTH * LX_TEST_DEVICE_HEIGHT];
+    lx_bitmap_ref_t bitmap;
+    lx_device_ref_t device;
+    lx_canvas_ref_t canvas;
+}lx_test_device_target_t;
+
+static lx_canvas_ref_t lx_test_device_target_init(lx_test_device_target_t* target, lx_size_t mode, lx_size_t flags) {
+    target->bitmap = lx_bitmap_init(target->data, LX_PIXFMT_XRGB8888, LX_TEST_DEVICE_WIDTH, LX_TEST_DEVICE_HEIGHT, 0, lx_false);
+    target->device = target->bitmap? lx_device_init_from_bitmap(target->bitmap) : lx_null;
+    target->canvas = target->device? lx_canvas_init(target->device) : lx_null;
+    if (!target->canvas) lx_abort();
+
+    // draw black on white, so the coverage of pixel is 0xff - blue
+    lx_canvas_draw_clear(target->canvas, LX_COLOR_WHITE);
+    lx_paint_ref_t paint = lx_canvas_paint(target->canvas);
+    lx_paint_mode_set(paint, mode);
+    lx_paint_flags_set(paint, flags);
+    lx_paint_color_set(paint, LX_COLOR_BLACK);
+    return target->canvas;
+}
+
+static lx_void_t lx_test_device_target_exit(lx_test_device_target_t* target) {
+    lx_canvas_exit(target->canvas);
+    lx_device_exit(target->device);
+    lx_bitmap_exit(target->bitmap);
+}
+
+static lx_size_t lx_test_device_coverage(lx_test_device_target_t* target, lx_long_t x, lx_long_t y) {
+    return 0xff - (target->data[y * LX_TEST_DEVICE_WIDTH + x] & 0xff);
+}
+
+// the total coverage of all pixels in the pixel area
+static lx_float_t lx_test_device_area(lx_test_device_target_t* target) {
+    lx_size_t i;
+    lx_size_t coverage = 0;
+    for (i = 0; i < LX_TEST_DEVICE_WIDTH * LX_TEST_DEVICE_HEIGHT; i++) {
+        coverage += 0xff - (target->data[i] & 0xff);
+    }
+    return (lx_float_t)coverage / 0xff;
+}
+
+static lx_void_t lx_test_device_antialiasing() {
+    /* fill the triangle with the diagonal edge
+     *
+     * (10, 10)      (50, 10)
+     *     . . . . . . .
+     *         .       .
+     *             .   .
+     *                 .
+     *              (50, 50)
+     */
+    lx_test_device_target_t target;
+    lx_canvas_draw_triangle2i(lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), 10, 10, 50, 10, 50, 50);
+
+    // the diagonal pixels are covered by half
+    lx_size_t coverage = lx_test_device_coverage(&target, 30, 30);
+    if (coverage < 0x70 || coverage > 0x90) lx_abort();
+    if (lx_test_device_coverage(&target, 40, 20) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 20, 40) != 0) lx_abort();
+
+    // the total coverage is the triangle area
+    if (lx_abs(lx_test_device_area(&target) - 800.0f) > 4.0f) lx_abort();
+    lx_test_device_target_exit(&target);
+
+    // the aliased pixels are covered fully or not at all, the antialiasing flag is disabled by the low quality
+    lx_size_t quality = lx_quality();
+    lx_quality_set(LX_QUALITY_LOW);
+    lx_canvas_draw_triangle2i(lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), 10, 10, 50, 10, 50, 50);
+    lx_size_t i;
+    for (i = 0; i < LX_TEST_DEVICE_WIDTH * LX_TEST_DEVICE_HEIGHT; i++) {
+        coverage = 0xff - (target.data[i] & 0xff);
+        if (coverage != 0 && coverage != 0xff) lx_abort();
+    }
+    if (lx_abs(lx_test_device_area(&target) - 800.0f) > 40.0f) lx_abort();
+    lx_test_device_target_exit(&target);
+    lx_quality_set(quality);
+}
+
+static lx_void_t lx_test_device_large_polygon() {
+    /* fill the polygon with over 65535 edges, the top edge is a dense zigzag
+     *
+     * (10, 10) /\/\/\/\/\/\/\ (90, 10)
+     *         |               |
+     *         |               |
+     *         . . . . . . . . .
+     *     (10, 90)        (90, 90)
+     */
+    lx_path_ref_t path = lx_path_init();
+    if (!path) lx_abort();
+    lx_size_t i;
+    lx_size_t n = 70000;
+    lx_path_move2i_to(path, 10, 90);
+    for (i = 0; i <= n; i++) {
+        lx_path_line2_to(path, 10.0f + 80.0f * i / n, (i & 1)? 10.0f : 11.0f);
+    }
+    lx_path_line2i_to(path, 90, 90);
+    lx_path_close(path);
+
+    // draw it
+    lx_test_device_target_t target;
+    lx_canvas_draw_path(lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), path);
+
+    // check
+    if (lx_test_device_coverage(&target, 50, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 5, 5) != 0) lx_abort();
+    if (lx_test_device_coverage(&target, 50, 95) != 0) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - 80.0f * 79.5f) > 40.0f) lx_abort();
+
+    /* the zigzag covers the half of the top row, so it's same as the polygon with the half-pixel top edge
+     *
+     * we add the middle point to the top edge, so it will not be filled as the aligned rect
+     *
+     * (10, 10.5)  (50, 10.5)  (90, 10.5)
+     *     . . . . . . . . . . . .
+     *     .                     .
+     *     . . . . . . . . . . . .
+     * (10, 90)                (90, 90)
+     */
+    lx_test_device_target_t reference;
+    lx_path_clear(path);
+    lx_path_move2_to(path, 10.0f, 10.5f);
+    lx_path_line2_to(path, 50.0f, 10.5f);
+    lx_path_line2_to(path, 90.0f, 10.5f);
+    lx_path_line2i_to(path, 90, 90);
+    lx_path_line2i_to(path, 10, 90);
+    lx_path_close(path);
+    lx_canvas_draw_path(lx_test_device_target_init(&reference, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), path);
+    for (i = 0; i < LX_TEST_DEVICE_WIDTH * LX_TEST_DEVICE_HEIGHT; i++) {
+        lx_long_t x = (lx_long_t)(i % LX_TEST_DEVICE_WIDTH);
+        lx_long_t y = (lx_long_t)(i / LX_TEST_DEVICE_WIDTH);
+        lx_long_t d = (lx_long_t)lx_test_device_coverage(&target, x, y) - (lx_long_t)lx_test_device_coverage(&reference, x, y);
+        if (lx_abs(d) > 2) lx_abort();
+    }
+    lx_test_device_target_exit(&reference);
+    lx_test_device_target_exit(&target);
+    lx_path_exit(path);
+}
+
+static lx_void_t lx_test_device_stroke_path() {
+    /* stroke the closed polyline with the miter joins
+     *
+     * (20, 20)        (80, 20)
+     *     . . . . . . . .
+     *     .             .
+     *     .             .
+     *     . . . . . . . .
+     * (20, 80)        (80, 80)
+     */
+    lx_path_ref_t path = lx_path_init();
+    if (!path) lx_abort();
+    lx_path_move2i_to(path, 20, 20);
+    lx_path_line2i_to(path, 80, 20);
+    lx_path_line2i_to(path, 80, 80);
+    lx_path_line2i_to(path, 20, 80);
+    lx_path_close(path);
+
+    lx_test_device_target_t target;
+    lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+    lx_paint_ref_t  paint = lx_canvas_paint(canvas);
+    lx_paint_stroke_width_set(paint, 10);
+    lx_paint_stroke_join_set(paint, LX_PAINT_STROKE_JOIN_MITER);
+    lx_canvas_draw_path(canvas, path);
+
+    // the stroked area is the outer square minus the inner square
+    if (lx_test_device_coverage(&target, 20, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 16, 16) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 50, 50) != 0) lx_abort();
+    if (lx_test_device_coverage(&target, 10, 10) != 0) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - (70.0f * 70.0f - 50.0f * 50.0f)) > 8.0f) lx_abort();
+    lx_test_device_target_exit(&target);
+
+    /* stroke the open curve with the butt caps
+     *
+     *          (50, 10)
+     *             .
+     *        .         .
+     *     .               .
+     * (10, 60)          (90, 60)
+     */
+    lx_path_clear(path);
+    lx_path_move2i_to(path, 10, 60);
+    lx_path_quad2i_to(path, 50, 10, 90, 60);
+
+    canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+    paint = lx_canvas_paint(canvas);
+    lx_paint_stroke_width_set(paint, 6);
+    lx_paint_stroke_cap_set(paint, LX_PAINT_STROKE_CAP_BUTT);
+    lx_canvas_draw_path(canvas, path);
+
+    // the stroked area is the curve length multiplied by the stroke width
+    lx_size_t  i;
+    lx_size_t  n = 1000;
+    lx_float_t length = 0;
+    lx_float_t x0 = 10.0f;
+    lx_float_t y0 = 60.0f;
+    for (i = 1; i <= n; i++) {
+        lx_float_t t = (lx_float_t)i / n;
+        lx_float_t x = (1 - t) * (1 - t) * 10.0f + 2 * t * (1 - t) * 50.0f + t * t * 90.0f;
+        lx_float_t y = (1 - t) * (1 - t) * 60.0f + 2 * t * (1 - t) * 10.0f + t * t * 60.0f;
+        length += lx_sqrtf((x - x0) * (x - x0) + (y - y0) * (y - y0));
+        x0 = x;
+        y0 = y;
+    }
+    if (lx_test_device_coverage(&target, 50, 35) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 50, 50) != 0) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - length * 6.0f) > length * 6.0f * 0.02f) lx_abort();
+    lx_test_device_target_exit(&target);
+    lx_path_exit(path);
+}
+
+static lx_void_t lx_test_device_stroke_dash() {
+    /* stroke the horizontal line with the dash intervals [10, 10]
+     *
+     * (10, 50)                                (90, 50)
+     *     ------    ------    ------    ------
+     */
+    lx_path_ref_t path = lx_path_init();
+    if (!path) lx_abort();
+    lx_path_move2i_to(path, 10, 50);
+    lx_path_line2i_to(path, 90, 50);
+
+    lx_test_device_target_t target;
+    lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+    lx_paint_ref_t  paint = lx_canvas_paint(canvas);
+    lx_float_t      intervals[] = {10, 10};
+    lx_paint_stroke_width_set(paint, 4);
+    lx_paint_stroke_cap_set(paint, LX_PAINT_STROKE_CAP_BUTT);
+    lx_paint_stroke_dash_set(paint, intervals, 2, 0);
+
+    // the repeated intervals are saved to the paint
+    lx_float_t const* dash = lx_null;
+    lx_float_t        phase = -1;
+    if (lx_paint_stroke_dash(paint, &dash, &phase) != 2 || !dash || dash[0] != 10 || dash[1] != 10 || phase != 0) lx_abort();
+    lx_canvas_draw_path(canvas, path);
+
+    // only the dashes are stroked
+    if (lx_test_device_coverage(&target, 15, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 25, 50) != 0) lx_abort();
+    if (lx_test_device_coverage(&target, 75, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 85, 50) != 0) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - 40.0f * 4.0f) > 2.0f) lx_abort();
+    lx_test_device_target_exit(&target);
+
+    /* stroke it with the phase 5
+     *
+     * (10, 50)                                (90, 50)
+     *     ---    ------    ------    ------    ---
+     */
+    canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+    paint = lx_canvas_paint(canvas);
+    lx_paint_stroke_width_set(paint, 4);
+    lx_paint_stroke_cap_set(paint, LX_PAINT_STROKE_CAP_BUTT);
+    lx_paint_stroke_dash_set(paint, intervals, 2, 5);
+    lx_canvas_draw_path(canvas, path);
+    if (lx_test_device_coverage(&target, 12, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 20, 50) != 0) lx_abort();
+    if (lx_test_device_coverage(&target, 30, 50) != 0xff) lx_abort();
+    if (lx_test_device_coverage(&target, 87, 50) != 0xff) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - 40.0f * 4.0f) > 2.0f) lx_abort();
+
+    // the solid stroke is restored after clearing the dash intervals
+    lx_paint_stroke_dash_set(paint, lx_null, 0, 0);
+    if (lx_paint_stroke_dash(paint, lx_null, lx_null)) lx_abort();
+    lx_canvas_draw_path(canvas, path);
+    if (lx_test_device_coverage(&target, 20, 50) != 0xff) lx_abort();
+    if (lx_abs(lx_test_device_area(&target) - 80.0f * 4.0f) > 2.0f) lx_abort();
+    lx_test_device_target_exit(&target);
+    lx_path_exit(path);
+}
+
+/* check the column of the anti-aliased hairline, the line center is split to the two nearest pixels
+ *
+ * the endpoints are rounded to 1/64 pixel and the fraction is truncated to 8 bits, so the coverage may be different by 3.
+ */
+static lx_void_t lx_test_device_hairline_check(lx_test_device_target_t* target, lx_long_t x, lx_float_t top, lx_size_t alpha) {
+    lx_long_t  y;
+    lx_long_t  iy = lx_floor(top);
+    lx_float_t f = top - (lx_float_t)iy;
+    for (y = 0; y < LX_TEST_DEVICE_HEIGHT; y++) {
+        lx_float_t expected = 0;
+        if (y == iy) expected = (1.0f - f) * alpha;
+        else if (y == iy + 1) expected = f * alpha;
+        if (lx_abs((lx_float_t)lx_test_device_coverage(target, x, y) - expected) > 3.0f) {
+            lx_trace_i("hairline(%ld, %ld): %lu != %f", x, y, lx_test_device_coverage(target, x, y), expected);
+            lx_abort();
+        }
+    }
+}
+
+static lx_void_t lx_test_device_hairline() {
+    /* stroke the 30 degrees hairline
+     *
+     * (10.5, 20.25)
+     *     .   .   .
+     *                 .   .   .
+     *                             (10.5 + 60 * cos(30), 50.25)
+     */
+    lx_float_t xb = 10.5f;
+    lx_float_t yb = 20.25f;
+    lx_float_t xe = xb + 30.0f * lx_sqrtf(3.0f);
+    lx_float_t slope = 1.0f / lx_sqrtf(3.0f);
+    lx_path_ref_t path = lx_path_init();
+    if (!path) lx_abort();
+    lx_path_move2_to(path, xb, yb);
+    lx_path_line2_to(path, xe, yb + 30.0f);
+
+    lx_size_t quality = lx_quality();
+    lx_quality_set(LX_QUALITY_TOP);
+
+    lx_size_t alphas[] = {255, 128};
+    lx_size_t i;
+    lx_long_t x;
+    for (i = 0; i < lx_arrayn(alphas); i++) {
+
+        // the thinner hairline is drawn with the less coverage
+        lx_test_device_target_t target;
+        lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+        lx_paint_stroke_width_set(lx_canvas_paint(canvas), alphas[i] == 255? 1.0f : 0.5f);
+        lx_canvas_draw_path(canvas, path);
+
+        /* the pixel centers in [xb, xe) are drawn, so the endpoint columns are 10 and 61
+         *
+         * the top edge of the line at the pixel center is yb - 0.5 + (x + 0.5 - xb) * tan(30)
+         */
+        for (x = 0; x < LX_TEST_DEVICE_WIDTH; x++) {
+            if (x >= 10 && x <= 61) lx_test_device_hairline_check(&target, x, yb - 0.5f + ((lx_float_t)x + 0.5f - xb) * slope, alphas[i]);
+            else lx_test_device_hairline_check(&target, x, -10.0f, 0);
+        }
+        lx_test_device_target_exit(&target);
+    }
+    lx_quality_set(quality);
+    lx_path_exit(path);
+}
+
+/* stroke the polyline and the closed polygon with all caps and joins
+ *
+ * the convex pieces of the butt/square caps and miter/bevel joins are filled directly,
+ * and they need be same as the filled outline of the stroked path.
+ */
+static lx_void_t lx_test_device_stroke_polygon() {
+    lx_point_t          points[] = {{15, 70}, {40, 20}, {60, 60}, {85, 25}, {20, 85}, {50, 75}, {80, 90}, {20, 85}};
+    lx_uint32_t         counts[] = {4, 4, 0};
+    lx_polygon_t        polygon = {points, counts, 8, lx_false};
+    lx_size_t           caps[] = {LX_PAINT_STROKE_CAP_BUTT, LX_PAINT_STROKE_CAP_SQUARE, LX_PAINT_STROKE_CAP_ROUND};
+    lx_size_t           joins[] = {LX_PAINT_STROKE_JOIN_MITER, LX_PAINT_STROKE_JOIN_BEVEL, LX_PAINT_STROKE_JOIN_ROUND};
+    lx_stroker_ref_t    stroker = lx_stroker_init();
+    lx_size_t           i;
+    lx_size_t           j;
+    lx_long_t           x;
+    lx_long_t           y;
+    if (!stroker) lx_abort();
+    for (i = 0; i < lx_arrayn(caps); i++) {
+        for (j = 0; j < lx_arrayn(joins); j++) {
+
+            // stroke the polygon, the device fills the convex pieces directly if they are supported
+            lx_test_device_target_t target;
+            lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_STROKE, LX_PAINT_FLAG_ANTIALIASING);
+            lx_paint_ref_t  paint = lx_canvas_paint(canvas);
+            lx_paint_stroke_width_set(paint, 8);
+            lx_paint_stroke_cap_set(paint, caps[i]);
+            lx_paint_stroke_join_set(paint, joins[j]);
+            lx_canvas_draw_polygon(canvas, &polygon);
+
+            // only the round caps and joins are not supported by the convex pieces
+            lx_bool_t supported = caps[i] != LX_PAINT_STROKE_CAP_ROUND && joins[j] != LX_PAINT_STROKE_JOIN_ROUND;
+            if (!lx_stroker_make_polygon_from_polygon(stroker, paint, &polygon, lx_null) != !supported) lx_abort();
+
+            // fill the outline of the stroked path
+            lx_test_device_target_t reference;
+            lx_path_ref_t path = lx_stroker_make_from_polygon(stroker, paint, &polygon, lx_null);
+            canvas = lx_test_device_target_init(&reference, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING);
+            lx_paint_fill_rule_set(lx_canvas_paint(canvas), LX_PAINT_FILL_RULE_NONZERO);
+            if (!path) lx_abort();
+            lx_canvas_draw_path(canvas, path);
+
+            // compare them
+            for (y = 0; y < LX_TEST_DEVICE_HEIGHT; y++) {
+                for (x = 0; x < LX_TEST_DEVICE_WIDTH; x++) {
+                    lx_long_t coverage = (lx_long_t)lx_test_device_coverage(&target, x, y);
+                    lx_long_t coverage_reference = (lx_long_t)lx_test_device_coverage(&reference, x, y);
+                    if (lx_abs(coverage - coverage_reference) > 2) {
+                        lx_trace_i("cap: %lu, join: %lu, (%ld, %ld): %ld != %ld", caps[i], joins[j], x, y, coverage, coverage_reference);
+                        lx_abort();
+                    }
+                }
+            }
+            lx_test_device_target_exit(&reference);
+            lx_test_device_target_exit(&target);
+        }
+    }
+    lx_stroker_exit(stroker);
+}
+
+// get the point of the line, quad or cubic curve at the given factor
+static lx_void_t lx_test_device_curve_point(lx_point_ref_t points, lx_size_t count, lx_float_t factor, lx_point_ref_t point) {
+    lx_point_t  p[4];
+    lx_size_t   i;
+    lx_size_t   j;
+    for (i = 0; i < count; i++) p[i] = points[i];
+    for (j = count - 1; j > 0; j--) {
+        for (i = 0; i < j; i++) {
+            p[i].x += (p[i + 1].x - p[i].x) * factor;
+            p[i].y += (p[i + 1].y - p[i].y) * factor;
+        }
+    }
+    *point = p[0];
+}
+
+static lx_float_t lx_test_device_curve_distance2(lx_point_t points[4], lx_point_ref_t point, lx_float_t factor) {
+    lx_point_t p;
+    lx_test_device_curve_point(points, 4, factor, &p);
+    return (p.x - point->x) * (p.x - point->x) + (p.y - point->y) * (p.y - point->y);
+}
+
+/* get the distance from the point to the cubic curve
+ *
+ * @return      the distance, or -1 if the nearest point is the start or end point, e.g. the point is on the butt caps
+ */
+static lx_float_t lx_test_device_curve_distance(lx_point_t points[4], lx_point_ref_t point) {
+
+    // find the nearest sample
+    lx_size_t   i;
+    lx_size_t   n = 512;
+    lx_float_t  factor = 0;
+    lx_float_t  distance2 = lx_test_device_curve_distance2(points, point, 0);
+    for (i = 1; i <= n; i++) {
+        lx_float_t d = lx_test_device_curve_distance2(points, point, (lx_float_t)i / n);
+        if (d < distance2) {
+            distance2 = d;
+            factor = (lx_float_t)i / n;
+        }
+    }
+
+    // refine it by the ternary search around this sample
+    lx_float_t t0 = lx_max(factor - 1.0f / n, 0);
+    lx_float_t t1 = lx_min(factor + 1.0f / n, 1.0f);
+    for (i = 0; i < 32; i++) {
+        lx_float_t m0 = t0 + (t1 - t0) / 3;
+        lx_float_t m1 = t1 - (t1 - t0) / 3;
+        if (lx_test_device_curve_distance2(points, point, m0) < lx_test_device_curve_distance2(points, point, m1)) t1 = m1;
+        else t0 = m0;
+    }
+    factor = lx_half(t0 + t1);
+    return factor > 0.001f && factor < 0.999f? lx_sqrtf(lx_test_device_curve_distance2(points, point, factor)) : -1.0f;
+}
+
+/* stroke the cubic curve for the different zoom levels with the stroked path cache
+ *
+ * the offset curves error is 1/8 in the user space, and it's divided by the matrix scale octave,
+ * so the stroked path is cached and reused for all scales in the same octave, and the error is at most 1/4 pixel in the device space.
+ */
+static lx_void_t lx_test_device_stroke_offset() {
+    lx_point_t          points[4] = {{10, 60}, {35, 15}, {65, 105}, {90, 60}};
+    lx_float_t          scales[] = {0.5f, 1.0f, 1.9f, 2.1f, 8.0f};
+    lx_size_t           octaves[] = {0, 0, 0, 1, 3};
+    lx_path_ref_t       cached[4] = {lx_null};
+    lx_path_ref_t       path = lx_path_init();
+    lx_paint_ref_t      paint = lx_paint_init();
+    lx_stroker_ref_t    stroker = lx_stroker_init();
+    if (!path || !paint || !stroker) lx_abort();
+    lx_path_move_to(path, &points[0]);
+    lx_path_cubic_to(path, &points[1], &points[2], &points[3]);
+    lx_paint_mode_set(paint, LX_PAINT_MODE_STROKE);
+    lx_paint_stroke_width_set(paint, 8);
+    lx_paint_stroke_cap_set(paint, LX_PAINT_STROKE_CAP_BUTT);
+    lx_stroker_cache_set(stroker, 1 << 20);
+
+    // all scales will hit the cache in the second pass
+    lx_size_t pass;
+    lx_size_t i;
+    lx_size_t j;
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 0; i < lx_arrayn(scales); i++) {
+            lx_matrix_t matrix;
+            lx_matrix_init_scale(&matrix, scales[i], scales[i]);
+            lx_path_ref_t stroked = lx_stroker_make_from_path(stroker, paint, &matrix, path);
+            if (!stroked || lx_path_empty(stroked)) lx_abort();
+
+            // the first scale of each octave misses the cache, and the other scales in the same octave hit it
+            lx_size_t octave = octaves[i];
+            if (cached[octave]) {
+                if (stroked != cached[octave]) lx_abort();
+            } else {
+                for (j = 0; j < lx_arrayn(cached); j++) {
+                    if (stroked == cached[j]) lx_abort();
+                }
+                cached[octave] = stroked;
+            }
+
+            // the offset curves are on the exact offset curve within the error of this octave
+            lx_float_t error = 0.125f / (lx_float_t)(1 << octave);
+            lx_size_t  checked = 0;
+            lx_for_all (lx_path_item_ref_t, item, stroked) {
+                lx_check_continue(item->code >= LX_PATH_CODE_LINE);
+                for (j = 0; j <= 16; j++) {
+                    lx_point_t point;
+                    lx_test_device_curve_point(item->points, item->code - LX_PATH_CODE_LINE + 2, (lx_float_t)j / 16, &point);
+                    lx_float_t distance = lx_test_device_curve_distance(points, &point);
+                    if (distance >= 0) {
+                        if (lx_abs(distance - 4) > error) {
+                            lx_trace_i("scale: %f, %{point}: %f != 4 +- %f", scales[i], &point, distance, error);
+                            lx_abort();
+                        }
+                        checked++;
+                    }
+                }
+            }
+            if (checked < 32) lx_abort();
+        }
+    }
+    lx_stroker_exit(stroker);
+    lx_paint_exit(paint);
+    lx_path_exit(path);
+}
+
+// the arc pieces count of each round rect corner for the reference polygon
+#define LX_TEST_DEVICE_ROUND_RECT_PIECES    (64)
+
+/* fill the round rect analytically and compare it with the filled polygon of the finely flattened round rect
+ *
+ * the polygon raster accumulates the exact cell areas, so both coverages must be within 1 / 255.
+ */
+static lx_void_t lx_test_device_round_rect_check(lx_round_rect_ref_t rect) {
+    static lx_point_t   points[(LX_TEST_DEVICE_ROUND_RECT_PIECES + 1) * 4 + 1];
+    lx_uint32_t         counts[2] = {lx_arrayn(points), 0};
+    lx_polygon_t        polygon = {points, counts, lx_arrayn(points), lx_false};
+    lx_rect_ref_t       bounds = &rect->bounds;
+    lx_size_t           i;
+    lx_size_t           n = 0;
+    for (i = 0; i < LX_RECT_CORNER_MAXN; i++) {
+
+        // the corner centers and their start angles from the left-top corner in the clockwise direction
+        lx_vector_ref_t radius = &rect->radius[i];
+        lx_float_t cx = i == LX_RECT_CORNER_LT || i == LX_RECT_CORNER_LB? bounds->x + radius->x : bounds->x + bounds->w - radius->x;
+        lx_float_t cy = i == LX_RECT_CORNER_LT || i == LX_RECT_CORNER_RT? bounds->y + radius->y : bounds->y + bounds->h - radius->y;
+        lx_float_t angle = LX_PI + (lx_float_t)i * LX_PI / 2.0f;
+
+        lx_size_t j;
+        for (j = 0; j <= LX_TEST_DEVICE_ROUND_RECT_PIECES; j++) {
+            lx_float_t a = angle + (lx_float_t)j * LX_PI / 2.0f / LX_TEST_DEVICE_ROUND_RECT_PIECES;
+            lx_point_make(&points[n++], cx + radius->x * lx_cosf(a), cy + radius->y * lx_sinf(a));
+        }
+    }
+    points[n++] = points[0];
+
+    lx_test_device_target_t target;
+    lx_test_device_target_t reference;
+    lx_canvas_draw_round_rect(lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), rect);
+    lx_canvas_draw_polygon(lx_test_device_target_init(&reference, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING), &polygon);
+
+    lx_long_t x;
+    lx_long_t y;
+    for (y = 0; y < LX_TEST_DEVICE_HEIGHT; y++) {
+        for (x = 0; x < LX_TEST_DEVICE_WIDTH; x++) {
+            lx_long_t coverage = (lx_long_t)lx_test_device_coverage(&target, x, y);
+            lx_long_t coverage_reference = (lx_long_t)lx_test_device_coverage(&reference, x, y);
+            if (lx_abs(coverage - coverage_reference) > 1) {
+                lx_trace_i("round rect(%ld, %ld): %ld != %ld", x, y, coverage, coverage_reference);
+                lx_abort();
+            }
+        }
+    }
+    lx_test_device_target_exit(&reference);
+    lx_test_device_target_exit(&target);
+}
+
+static lx_void_t lx_test_device_round_rect() {
+    lx_size_t quality = lx_quality();
+    lx_quality_set(LX_QUALITY_TOP);
+
+    // the same circular and elliptical corners at the subpixel positions
+    lx_rect_t       bounds;
+    lx_round_rect_t rect;
+    lx_rect_make(&bounds, 10.3f, 12.7f, 70.5f, 60.25f);
+    lx_round_rect_make_same(&rect, &bounds, 12, 12);
+    lx_test_device_round_rect_check(&rect);
+    lx_round_rect_make_same(&rect, &bounds, 25, 7.5f);
+    lx_test_device_round_rect_check(&rect);
+
+    // the different corners, the small corner is inside one pixel
+    lx_vector_t radius[LX_RECT_CORNER_MAXN] = {{5, 5}, {30, 20}, {0.5f, 0.5f}, {15, 28}};
+    lx_rect_make(&bounds, 5.5f, 4.75f, 88.0f, 90.1f);
+    lx_round_rect_make(&rect, &bounds, radius);
+    if (rect.bounds.x != bounds.x || rect.bounds.y != bounds.y || rect.bounds.w != bounds.w || rect.bounds.h != bounds.h) lx_abort();
+    lx_test_device_round_rect_check(&rect);
+    lx_quality_set(quality);
+}
+
+static lx_void_t lx_test_device_clip_check(lx_test_device_target_t* target, lx_long_t x, lx_long_t y, lx_size_t coverage_min, lx_size_t coverage_max) {
+    lx_size_t coverage = lx_test_device_coverage(target, x, y);
+    if (coverage < coverage_min || coverage > coverage_max) {
+        lx_trace_i("clip: coverage(%ld, %ld): %#lx", x, y, coverage);
+        lx_abort();
+    }
+}
+
+static lx_void_t lx_test_device_clip() {
+    /* fill all pixels through the circle minus the middle rect, and union the small rect in the top-right corner
+     *
+     *            . . . .       . .
+     *        .           .     . .
+     *      .    . . . .    .
+     *      .    .     .    .
+     *      .    . . . .    .
+     *        .           .
+     *            . . . .
+     */
+    lx_test_device_target_t target;
+    lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING);
+    lx_canvas_clip_circle2i(canvas, LX_CLIPPER_MODE_INTERSECT, 50, 50, 40);
+    lx_canvas_clip_rect2i(canvas, LX_CLIPPER_MODE_UNION, 85, 0, 10, 10);
+    lx_canvas_save_clipper(canvas);
+    lx_canvas_clip_rect2(canvas, LX_CLIPPER_MODE_SUBTRACT, 40.5f, 40, 20, 20);
+    lx_canvas_draw_rect2i(canvas, 0, 0, LX_TEST_DEVICE_WIDTH, LX_TEST_DEVICE_HEIGHT);
+
+    // the pixels inside and outside the clipped region
+    lx_test_device_clip_check(&target, 50, 20, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 20, 50, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 90, 5, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 50, 50, 0, 0);
+    lx_test_device_clip_check(&target, 5, 5, 0, 0);
+    lx_test_device_clip_check(&target, 95, 95, 0, 0);
+    lx_test_device_clip_check(&target, 80, 5, 0, 0);
+
+    // the pixels on the edges of the subtracted rect and circle are covered partially
+    lx_test_device_clip_check(&target, 40, 50, 0x70, 0x90);
+    lx_test_device_clip_check(&target, 21, 21, 0x10, 0x50);
+    lx_test_device_clip_check(&target, 78, 78, 0x10, 0x50);
+
+    // move the subtracted rect, the clip bounds are not changed, but the old mask cannot be reused
+    lx_canvas_load_clipper(canvas);
+    lx_canvas_save_clipper(canvas);
+    lx_canvas_clip_rect2i(canvas, LX_CLIPPER_MODE_SUBTRACT, 20, 40, 10, 20);
+    lx_canvas_draw_clear(canvas, LX_COLOR_WHITE);
+    lx_canvas_draw_rect2i(canvas, 0, 0, LX_TEST_DEVICE_WIDTH, LX_TEST_DEVICE_HEIGHT);
+    lx_test_device_clip_check(&target, 50, 50, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 40, 50, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 25, 50, 0, 0);
+    lx_test_device_clip_check(&target, 90, 5, 0xff, 0xff);
+    lx_test_device_clip_check(&target, 5, 5, 0, 0);
+    lx_canvas_load_clipper(canvas);
+    lx_test_device_target_exit(&target);
+}
+
+static lx_color_t lx_test_device_color(lx_test_device_target_t* target, lx_long_t x, lx_long_t y) {
+    return lx_pixmap(LX_PIXFMT_XRGB8888, 0xff)->color(target->data[y * LX_TEST_DEVICE_WIDTH + x]);
+}
+
+static lx_void_t lx_test_device_color_check(lx_test_device_target_t* target, lx_long_t x, lx_long_t y, lx_color_t color, lx_long_t tolerance) {
+    lx_color_t pixel = lx_test_device_color(target, x, y);
+    if (    lx_abs((lx_long_t)pixel.r - color.r) > tolerance
+        ||  lx_abs((lx_long_t)pixel.g - color.g) > tolerance
+        ||  lx_abs((lx_long_t)pixel.b - color.b) > tolerance) {
+        lx_trace_i("color(%ld, %ld): %{color} != %{color}", x, y, &pixel, &color);
+        lx_abort();
+    }
+}
+
+// get the gradient position of the tile mode, it's negative if it's out of the gradient for border mode
+static lx_float_t lx_test_device_gradient_tile(lx_float_t t, lx_size_t tile_mode) {
+    switch (tile_mode) {
+    case LX_SHADER_TILE_MODE_CLAMP:
+        return lx_max(lx_min(t, 1.0f), 0.0f);
+    case LX_SHADER_TILE_MODE_REPEAT:
+        return t - (lx_float_t)lx_floor(t);
+    case LX_SHADER_TILE_MODE_MIRROR:
+        t = t - (lx_float_t)lx_floor(t / 2.0f) * 2.0f;
+        return t > 1.0f? 2.0f - t : t;
+    default:
+        return t >= 0.0f && t <= 1.0f? t : -1.0f;
+    }
+}
+
+/* check the pixel of the red-to-blue gradient at the position t
+ *
+ * the colors are interpolated in the color table of 256 entries, so they have a small error
+ */
+static lx_void_t lx_test_device_gradient_check(lx_test_device_target_t* target, lx_long_t x, lx_long_t y, lx_float_t t, lx_size_t tile_mode) {
+    t = lx_test_device_gradient_tile(t, tile_mode);
+    if (t < 0) lx_test_device_color_check(target, x, y, LX_COLOR_WHITE, 0);
+    else lx_test_device_color_check(target, x, y, lx_color_make(0xff, (lx_byte_t)(255.0f * (1.0f - t) + 0.5f), 0, (lx_byte_t)(255.0f * t + 0.5f)), 3);
+}
+
+// fill the whole target with the shader, the shader matrix is cleared if no matrix
+static lx_void_t lx_test_device_shader_draw(lx_test_device_target_t* target, lx_shader_ref_t shader, lx_matrix_ref_t matrix) {
+    lx_canvas_ref_t canvas = lx_test_device_target_init(target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING);
+    lx_paint_shader_set(lx_canvas_paint(canvas), shader);
+    lx_shader_matrix_set(shader, matrix);
+    lx_canvas_draw_rect2i(canvas, 0, 0, LX_TEST_DEVICE_WIDTH, LX_TEST_DEVICE_HEIGHT);
+    lx_paint_shader_set(lx_canvas_paint(canvas), lx_null);
+}
+
+// check the shaders with the different matrices, they are same in the device coordinates
+static lx_void_t lx_test_device_shader_check(lx_shader_ref_t shader, lx_matrix_ref_t matrix, lx_shader_ref_t shader_other, lx_matrix_ref_t matrix_other, lx_long_t tolerance) {
+    lx_long_t x;
+    lx_long_t y;
+    lx_test_device_target_t target;
+    lx_test_device_target_t target_other;
+    lx_test_device_shader_draw(&target, shader, matrix);
+    lx_test_device_shader_draw(&target_other, shader_other, matrix_other);
+    for (y = 0; y < LX_TEST_DEVICE_HEIGHT; y++) {
+        for (x = 0; x < LX_TEST_DEVICE_WIDTH; x++) {
+            lx_test_device_color_check(&target, x, y, lx_test_device_color(&target_other, x, y), tolerance);
+        }
+    }
+    lx_test_device_target_exit(&target_other);
+    lx_test_device_target_exit(&target);
+}
+
+static lx_void_t lx_test_device_gradient() {
+    lx_color_t      colors[2] = {LX_COLOR_RED, LX_COLOR_BLUE};
+    lx_gradient_t   gradient = {colors, lx_null, 2};
+    lx_size_t       tile_modes[] = {LX_SHADER_TILE_MODE_BORDER, LX_SHADER_TILE_MODE_CLAMP, LX_SHADER_TILE_MODE_REPEAT, LX_SHADER_TILE_MODE_MIRROR};
+    lx_long_t       xs[] = {2, 22, 37, 63, 77, 97};
+    lx_size_t       quality = lx_quality();
+    lx_size_t       i;
+    lx_size_t       j;
+    lx_quality_set(LX_QUALITY_TOP);
+    for (i = 0; i < lx_arrayn(tile_modes); i++) {
+
+        // the linear gradient from x = 10 to x = 50, the pixels are sampled at their centers
+        lx_test_device_target_t target;
+        lx_shader_ref_t shader = lx_shader_init2_linear_gradient(tile_modes[i], &gradient, 10, 0, 50, 0);
+        if (!shader) lx_abort();
+        lx_test_device_shader_draw(&target, shader, lx_null);
+        for (j = 0; j < lx_arrayn(xs); j++) {
+            lx_test_device_gradient_check(&target, xs[j], 50, ((lx_float_t)xs[j] + 0.5f - 10.0f) / 40.0f, tile_modes[i]);
+        }
+        lx_test_device_target_exit(&target);
+        lx_shader_exit(shader);
+
+        // the radial gradient with the center (50, 50) and the radius 20
+        shader = lx_shader_init2_radial_gradient(tile_modes[i], &gradient, 50, 50, 20);
+        if (!shader) lx_abort();
+        lx_test_device_shader_draw(&target, shader, lx_null);
+        for (j = 0; j < lx_arrayn(xs); j++) {
+            lx_float_t dx = (lx_float_t)xs[j] + 0.5f - 50.0f;
+            lx_test_device_gradient_check(&target, xs[j], 50, lx_sqrtf(dx * dx + 0.25f) / 20.0f, tile_modes[i]);
+        }
+        lx_test_device_target_exit(&target);
+        lx_shader_exit(shader);
+    }
+
+    // the translated and scaled gradients are same as the gradients with the moved endpoints
+    lx_matrix_t     matrix;
+    lx_shader_ref_t shader = lx_shader_init2_linear_gradient(LX_SHADER_TILE_MODE_MIRROR, &gradient, 10, 0, 30, 0);
+    lx_shader_ref_t shader_other = lx_shader_init2_linear_gradient(LX_SHADER_TILE_MODE_MIRROR, &gradient, 17, 3, 37, 3);
+    if (!shader || !shader_other) lx_abort();
+    lx_matrix_init_translate(&matrix, 7, 3);
+    lx_test_device_shader_check(shader, &matrix, shader_other, lx_null, 0);
+    lx_shader_exit(shader_other);
+    shader_other = lx_shader_init2_linear_gradient(LX_SHADER_TILE_MODE_MIRROR, &gradient, 20, 0, 60, 0);
+    if (!shader_other) lx_abort();
+    lx_matrix_init_scale(&matrix, 2, 0.5f);
+    lx_test_device_shader_check(shader, &matrix, shader_other, lx_null, 0);
+
+    // the rotated gradient is same as the gradient with the rotated endpoints
+    lx_shader_exit(shader_other);
+    shader_other = lx_shader_init2_linear_gradient(LX_SHADER_TILE_MODE_MIRROR, &gradient, 10.0f * 0.6f, 10.0f * 0.8f, 30.0f * 0.6f, 30.0f * 0.8f);
+    if (!shader_other) lx_abort();
+    lx_matrix_init_sincos(&matrix, 0.8f, 0.6f);
+    lx_test_device_shader_check(shader, &matrix, shader_other, lx_null, 2);
+    lx_shader_exit(shader_other);
+    lx_shader_exit(shader);
+
+    // the scaled and rotated radial gradients are same as the radial gradient with the moved circle
+    shader = lx_shader_init2_radial_gradient(LX_SHADER_TILE_MODE_REPEAT, &gradient, 20, 25, 10);
+    shader_other = lx_shader_init2_radial_gradient(LX_SHADER_TILE_MODE_REPEAT, &gradient, 40, 50, 20);
+    if (!shader || !shader_other) lx_abort();
+    lx_matrix_init_scale(&matrix, 2, 2);
+    lx_test_device_shader_check(shader, &matrix, shader_other, lx_null, 0);
+    lx_matrix_init_sincosp(&matrix, 0.8f, 0.6f, 40, 50);
+    lx_test_device_shader_check(shader_other, &matrix, shader_other, lx_null, 2);
+    lx_shader_exit(shader_other);
+    lx_shader_exit(shader);
+    lx_quality_set(quality);
+}
+
+/* the general matrix is same as the given matrix, but the tiny skew disables the translate and scale fast paths
+ *
+ * the pixel centers should not be mapped to the texel edges, otherwise the tiny skew may change the sampled texels.
+ */
+static lx_void_t lx_test_device_bitmap_check(lx_shader_ref_t shader, lx_float_t sx, lx_float_t sy, lx_float_t tx, lx_float_t ty) {
+    lx_matrix_t matrix;
+    lx_matrix_t matrix_general;
+    lx_matrix_init(&matrix, sx, 0, 0, sy, tx, ty);
+    lx_matrix_init(&matrix_general, sx, 1e-5f, 1e-5f, sy, tx, ty);
+    lx_test_device_shader_check(shader, &matrix, shader, &matrix_general, 0);
+}
+
+/* check the pixels of the 128x128 repeated bitmap, all pixel centers need be mapped to the texel centers
+ *
+ * the filtered pixels at the texel centers are same as the texels
+ */
+static lx_void_t lx_test_device_bitmap_texels_check(lx_shader_ref_t shader, lx_uint32_t const* pixels, lx_matrix_ref_t matrix) {
+    lx_long_t               x;
+    lx_long_t               y;
+    lx_matrix_t             inverse = *matrix;
+    lx_test_device_target_t target;
+    if (!lx_matrix_invert(&inverse)) lx_abort();
+    lx_test_device_shader_draw(&target, shader, matrix);
+    for (y = 0; y < LX_TEST_DEVICE_HEIGHT; y++) {
+        for (x = 0; x < LX_TEST_DEVICE_WIDTH; x++) {
+            lx_float_t px = (lx_float_t)x + 0.5f;
+            lx_float_t py = (lx_float_t)y + 0.5f;
+            lx_long_t  u = lx_floor(inverse.sx * px + inverse.kx * py + inverse.tx) & 127;
+            lx_long_t  v = lx_floor(inverse.ky * px + inverse.sy * py + inverse.ty) & 127;
+            if (target.data[y * LX_TEST_DEVICE_WIDTH + x] != pixels[v * 128 + u]) lx_abort();
+        }
+    }
+    lx_test_device_target_exit(&target);
+}
+
+static lx_void_t lx_test_device_bitmap() {
+    static lx_uint32_t  pixels[128 * 128];
+    lx_uint32_t         rand = 0xbeaf;
+    lx_size_t           quality = lx_quality();
+    lx_size_t           i;
+    lx_long_t           x;
+    lx_long_t           y;
+
+    // init the bitmap of the random opaque pixels, it's larger than the device to copy the rows directly
+    for (i = 0; i < lx_arrayn(pixels); i++) {
+        rand = rand * 1103515245 + 12345;
+        pixels[i] = 0xff000000 | (rand >> 8);
+    }
+    lx_bitmap_ref_t bitmap = lx_bitmap_init(pixels, LX_PIXFMT_XRGB8888, 128, 128, 0, lx_false);
+    lx_shader_ref_t shader = bitmap? lx_shader_init_bitmap(LX_SHADER_TILE_MODE_REPEAT, bitmap) : lx_null;
+    if (!shader) lx_abort();
+
+    // the identity and integer translate fast paths need not filter the bitmap, and the rotated bitmap is sampled at the texel centers
+    lx_matrix_t matrix;
+    lx_quality_set(LX_QUALITY_TOP);
+    lx_matrix_clear(&matrix);
+    lx_test_device_bitmap_texels_check(shader, pixels, &matrix);
+    lx_matrix_init_translate(&matrix, -3, 2);
+    lx_test_device_bitmap_texels_check(shader, pixels, &matrix);
+    lx_matrix_init(&matrix, -1, 0, 0, -1, 100, 100);
+    lx_test_device_bitmap_texels_check(shader, pixels, &matrix);
+    lx_matrix_init_sincosp(&matrix, 1, 0, 50, 50);
+    lx_test_device_bitmap_texels_check(shader, pixels, &matrix);
+
+    // the identity, translate and scale fast paths are same as the general matrix path without filter
+    lx_quality_set(LX_QUALITY_LOW);
+    lx_test_device_bitmap_check(shader, 1, 1, 0, 0);
+    lx_test_device_bitmap_check(shader, 1, 1, 20, 10);
+    lx_test_device_bitmap_check(shader, 1, 1, -3, 2);
+    lx_test_device_bitmap_check(shader, 1, 1, 3.25f, -2.25f);
+    lx_test_device_bitmap_check(shader, 2, 3, 0, 0);
+    lx_test_device_bitmap_check(shader, 0.4f, 0.8f, -5, 7);
+    lx_shader_exit(shader);
+    lx_bitmap_exit(bitmap);
+
+    /* sample the 4x4 bitmap at the subpixel offset (0.25, 0.5) with the bilinear filter
+     *
+     * the texel (i, j) is (40 * i + 20, 40 * j + 20, 0), so the pixel center (1.5, 1.5) is sampled at (1.75, 2.0)
+     * between the texels (1, 1) and (2, 2), it's (60 * 0.75 + 100 * 0.25, 60 * 0.5 + 100 * 0.5, 0) = (70, 80, 0).
+     */
+    for (y = 0; y < 4; y++) {
+        for (x = 0; x < 4; x++) {
+            pixels[y * 4 + x] = lx_pixmap(LX_PIXFMT_XRGB8888, 0xff)->pixel(lx_color_make(0xff, (lx_byte_t)(40 * x + 20), (lx_byte_t)(40 * y + 20), 0));
+        }
+    }
+    lx_quality_set(LX_QUALITY_TOP);
+    bitmap = lx_bitmap_init(pixels, LX_PIXFMT_XRGB8888, 4, 4, 0, lx_false);
+    shader = bitmap? lx_shader_init_bitmap(LX_SHADER_TILE_MODE_CLAMP, bitmap) : lx_null;
+    if (!shader) lx_abort();
+    lx_matrix_init_translate(&matrix, -0.25f, -0.5f);
+    lx_shader_matrix_set(shader, &matrix);
+    lx_test_device_target_t target;
+    lx_canvas_ref_t canvas = lx_test_device_target_init(&target, LX_PAINT_MODE_FILL, LX_PAINT_FLAG_ANTIALIASING | LX_PAINT_FLAG_FILTER_BITMAP);
+    lx_paint_shader_set(lx_canvas_paint(canvas), shader);
+    lx_canvas_draw_rect2i(canvas, 0, 0, LX_TEST_DEVICE_WIDTH, LX_TEST_DEVICE_HEIGHT);
+    lx_paint_shader_set(lx_canvas_paint(canvas), lx_null);
+    lx_test_device_color_check(&target, 1, 1, lx_color_make(0xff, 70, 80, 0), 0);
+    lx_test_device_target_exit(&target);
+    lx_shader_exit(shader);
+    lx_bitmap_exit(bitmap);
+    lx_quality_set(quality);
+}
+
+// get the premultiplied channels of the raw pixel
+static lx_color_t lx_test_device_premul_color(lx_pixel_t pixel, lx_bool_t rgba) {
+    if (rgba) pixel = (pixel >> 8) | (pixel << 24);
+    return lx_color_make((lx_byte_t)(pixel >> 24), (lx_byte_t)(pixel >> 16), (lx_byte_t)(pixel >> 8), (lx_byte_t)pixel);
+}
+
+/* draw the translucent color with src-over on the premultiplied target, d = s * sa + d * (1 - sa)
+ *
+ * the premultiplied pixel is scaled by (256 - sa) >> 8, so the blended channels may be different by 2.
+ */
+static lx_void_t lx_test_device_premul_check(lx_size_t pixfmt, lx_bool_t rgba, lx_color_t target_color, lx_byte_t alpha) {
+    lx_uint32_t     data[8 * 8];
+    lx_bitmap_ref_t bitmap = lx_bitmap_init(data, pixfmt, 8, 8, 0, lx_true);
+    lx_device_ref_t device = bitmap? lx_device_init_from_bitmap(bitmap) : lx_null;
+    lx_canvas_ref_t canvas = device? lx_canvas_init(device) : lx_null;
+    lx_pixmap_ref_t pixmap = lx_pixmap(pixfmt, 0xff);
+    if (!canvas || !pixmap) lx_abort();
+
+    // clear the target and get its premultiplied pixel
+    lx_canvas_draw_clear(canvas, target_color);
+    lx_color_t dst = lx_test_device_premul_color(pixmap->pixel_get(&data[27]), rgba);
+
+    // draw the translucent color
+    lx_color_t color = lx_color_make(alpha, 0x40, 0x80, 0xff);
+    lx_paint_ref_t paint = lx_canvas_paint(canvas);
+    lx_paint_mode_set(paint, LX_PAINT_MODE_FILL);
+    lx_paint_flags_set(paint, LX_PAINT_FLAG_ANTIALIASING);
+    lx_paint_color_set(paint, color);
+    lx_canvas_draw_rect2i(canvas, 2, 2, 4, 4);
+
+    // the transparent color changes nothing, and the opaque color overwrites the target
+    lx_color_t result = lx_test_device_premul_color(pixmap->pixel_get(&data[27]), rgba);
+    lx_color_t blended;
+    if (!alpha) blended = dst;
+    else if (alpha == 0xff) blended = color;
+    else {
+        lx_float_t sa = (lx_float_t)alpha / 255.0f;
+        blended.a = (lx_byte_t)(alpha + dst.a * (1.0f - sa) + 0.5f);
+        blended.r = (lx_byte_t)(color.r * sa + dst.r * (1.0f - sa) + 0.5f);
+        blended.g = (lx_byte_t)(color.g * sa + dst.g * (1.0f - sa) + 0.5f);
+        blended.b = (lx_byte_t)(color.b * sa + dst.b * (1.0f - sa) + 0.5f);
+    }
+    lx_long_t tolerance = alpha && alpha != 0xff? 2 : 0;
+    if (    lx_abs((lx_long_t)result.a - blended.a) > tolerance
+        ||  lx_abs((lx_long_t)result.r - blended.r) > tolerance
+        ||  lx_abs((lx_long_t)result.g - blended.g) > tolerance
+        ||  lx_abs((lx_long_t)result.b - blended.b) > tolerance) {
+        lx_trace_i("%s: %{color} over %{color}: %{color} != %{color}", pixmap->name, &color, &dst, &result, &blended);
+        lx_abort();
+    }
+
+    // the pixels outside the rect are not changed
+    if (lx_color_pixel(lx_test_device_premul_color(pixmap->pixel_get(&data[0]), rgba)) != lx_color_pixel(dst)) lx_abort();
+    lx_canvas_exit(canvas);
+    lx_device_exit(device);
+    lx_bitmap_exit(bitmap);
+}
+
+static lx_void_t lx_test_device_premul() {
+    lx_byte_t   alphas[] = {0, 1, 128, 255};
+    lx_color_t  colors[] = {LX_COLOR_WHITE, LX_COLOR_BLACK, lx_color_make(0x80, 0x20, 0x40, 0x60), lx_color_make(0, 0, 0, 0)};
+    lx_size_t   quality = lx_quality();
+    lx_size_t   i;
+    lx_size_t   j;
+    lx_quality_set(LX_QUALITY_TOP);
+    for (i = 0; i < lx_arrayn(colors); i++) {
+        for (j = 0; j < lx_arrayn(alphas); j++) {
+            lx_test_device_premul_check(LX_PIXFMT_ARGB8888_PREMUL, lx_false, colors[i], alphas[j]);
+            lx_test_device_premul_check(LX_PIXFMT_RGBA8888_PREMUL, lx_true, colors[i], alphas[j]);
+        }
+    }
+    lx_quality_set(quality);
+}
+
+/* the scene type
+ *
+ * the shaders need be valid until committing the draw of the tiled and streamed device
+ */
+typedef struct lx_test_device_scene_t_ {
+    lx_uint32_t     pixels[8 * 8];
+    lx_color_t      colors[3];
+    lx_bitmap_ref_t bitmap;
+    lx_shader_ref_t shaders[3];
+}lx_test_device_scene_t;
+
+static lx_void_t lx_test_device_scene_init(lx_test_device_scene_t* scene) {
+    // init the checkerboard bitmap
+    lx_size_t i;
+    for (i = 0; i < lx_arrayn(scene->pixels); i++) {
+        scene->pixels[i] = ((i >> 3) ^ i) & 1? 0xff2060c0 : 0xfff0c020;
+    }
+    scene->bitmap = lx_bitmap_init(scene->pixels, LX_PIXFMT_XRGB8888, 8, 8, 0, lx_false);
+    if (!scene->bitmap) lx_abort();
+
+    // init shaders
+    lx_gradient_t gradient = {scene->colors, lx_null, 3};
+    scene->colors[0] = LX_COLOR_RED;
+    scene->colors[1] = LX_COLOR_GREEN;
+    scene->colors[2] = LX_COLOR_BLUE;
+    scene->shaders[0] = lx_shader_init2_linear_gradient(LX_SHADER_TILE_MODE_REPEAT, &gradient, 10, 10, 70, 40);
+    scene->shaders[1] = lx_shader_init2_radial_gradient(LX_SHADER_TILE_MODE_MIRROR, &gradient, 150, 100, 40);
+    scene->shaders[2] = lx_shader_init_bitmap(LX_SHADER_TILE_MODE_REPEAT, scene->bitmap);
+    if (!scene->shaders[0] || !scene->shaders[1] || !scene->shaders[2]) lx_abort();
+}
+
+static lx_void_t lx_test_device_scene_exit(lx_test_device_scene_t* scene) {
+    lx_size_t i;
+    for (i = 0; i < lx_arrayn(scene->shaders); i++) {
+        lx_shader_exit(scene->shaders[i]);
+    }
+    lx_bitmap_exit(scene->bitmap);
+}
+
+/* draw the scene of the random shapes
+ *
+ * the middle shapes are clipped by the ring, and the clipper is changed between draws
+ */
+static lx_void_t lx_test_device_scene_draw(lx_test_device_scene_t* scene, lx_canvas_ref_t canvas) {
+    lx_canvas_draw_clear(canvas, LX_COLOR_WHITE);
+    lx_paint_ref_t paint = lx_canvas_paint(canvas);
+    lx_size_t i;
+    for (i = 0; i < 120; i++) {
+        if (i == 40) {
+            lx_canvas_save_clipper(canvas);
+            lx_canvas_clip_circle2(canvas, LX_CLIPPER_MODE_INTERSECT, 150, 100, 90);
+            lx_canvas_clip_circle2(canvas, LX_CLIPPER_MODE_SUBTRACT, 150, 100, 30);
+        } else if (i == 60) {
+            lx_canvas_clip_ellipse2(canvas, LX_CLIPPER_MODE_UNION, 240, 60, 50, 20);
+        } else if (i == 80) {
+            lx_canvas_load_clipper(canvas);
+        }
+
+        lx_float_t x = (lx_float_t)((i * 37) % 320) - 10.0f;
+        lx_float_t y = (lx_float_t)((i * 53) % 220) - 10.0f;
+        lx_float_t r = (lx_float_t)(4 + (i * 7) % 40);
+        lx_paint_mode_set(paint, (i % 3)? LX_PAINT_MODE_FILL : LX_PAINT_MODE_STROKE);
+        lx_paint_stroke_width_set(paint, (i & 1)? 1.0f : 5.0f);
+        lx_paint_color_set(paint, lx_color_make(0xff, (lx_byte_t)(i * 41), (lx_byte_t)(i * 83), (lx_byte_t)(i * 29)));
+        lx_paint_alpha_set(paint, (i & 1)? 0xff : 0x80);
+        lx_paint_shader_set(paint, (i % 5)? lx_null : scene->shaders[(i / 5) % 3]);
+        if (i % 6 == 1) {
+            lx_canvas_save_matrix(canvas);
+            lx_canvas_rotate(canvas, 15);
+        }
+        switch (i % 4) {
+        case 0:
+            lx_canvas_draw_circle2(canvas, x, y, r);
+            break;
+        case 1:
+            lx_canvas_draw_rect2(canvas, x, y, r * 1.5f, r);
+            break;
+        case 2:
+            lx_canvas_draw_line2(canvas, x, y, x + r * 2.0f, y + r - 10.0f);
+            break;
+        default:
+            lx_canvas_draw_triangle2(canvas, x, y, x + r, y + r / 3.0f, x + r / 2.0f, y + r);
+            break;
+        }
+        if (i % 6 == 1) lx_canvas_load_matrix(canvas);
+    }
+    lx_paint_shader_set(paint, lx_null);
+}
+
+// draw the scene on the bitmap device
+static lx_uint32_t* lx_test_device_scene_bitmap(lx_test_device_scene_t* scene) {
+    lx_uint32_t*    data = lx_nalloc0_type(LX_TEST_DEVICE_SCENE_WIDTH * LX_TEST_DEVICE_SCENE_HEIGHT, lx_uint32_t);
+    lx_bitmap_ref_t bitmap = data? lx_bitmap_init(data, LX_PIXFMT_XRGB8888, LX_TEST_DEVICE_SCENE_WIDTH, LX_TEST_DEVICE_SCENE_HEIGHT, 0, lx_false) : lx_null;
+    lx_device_ref_t device = bitmap? lx_device_init_from_bitmap(bitmap) : lx_null;
+    lx_canvas_ref_t canvas = device? lx_canvas_init(device) : lx_null;
+    if (!canvas) lx_abort();
+    lx_test_device_scene_draw(scene, canvas);
+    lx_canvas_exit(canvas);
+    lx_device_exit(device);
+    lx_bitmap_exit(bitmap);
+    return data;
+}
+
+static lx_void_t lx_test_device_tiled() {
+    lx_test_device_scene_t scene;
+    lx_test_device_scene_init(&scene);
+
+    // draw the same scene on the tiled devices with the different threads count
+    lx_size_t threads[] = {1, 2, 3, 4};
+    lx_size_t quality = lx_quality();
+    lx_size_t size = LX_TEST_DEVICE_SCENE_WIDTH * LX_TEST_DEVICE_SCENE_HEIGHT * sizeof(lx_uint32_t);
+    lx_size_t i;
+    lx_size_t j;
+    for (i = 0; i < 2; i++) {
+        lx_quality_set(i? LX_QUALITY_LOW : LX_QUALITY_TOP);
+        lx_uint32_t* data = lx_test_device_scene_bitmap(&scene);
+        lx_uint32_t* tiled = lx_nalloc0_type(LX_TEST_DEVICE_SCENE_WIDTH * LX_TEST_DEVICE_SCENE_HEIGHT, lx_uint32_t);
+        if (!tiled) lx_abort();
+        for (j = 0; j < lx_arrayn(threads); j++) {
+            lx_bitmap_ref_t bitmap = lx_bitmap_init(tiled, LX_PIXFMT_XRGB8888, LX_TEST_DEVICE_SCENE_WIDTH, LX_TEST_DEVICE_SCENE_HEIGHT, 0, lx_false);
+            lx_device_ref_t device = bitmap? lx_device_init_from_bitmap_tiled(bitmap, threads[j]) : lx_null;
+            lx_canvas_ref_t canvas = device? lx_canvas_init(device) : lx_null;
+            if (!canvas) lx_abort();
+            lx_test_device_scene_draw(&scene, canvas);
+            lx_device_draw_commit(device);
+            if (lx_memcmp(tiled, data, size)) lx_abort();
+            lx_canvas_exit(canvas);
+            lx_device_exit(device);
+            lx_bitmap_exit(bitmap);
+        }
+        lx_free(tiled);
+        lx_free(data);
+    }
+    lx_quality_set(quality);
+    lx_test_device_scene_exit(&scene);
+}
+
+static lx_void_t lx_test_device_stream() {
+    lx_test_device_scene_t scene;
+    lx_test_device_scene_init(&scene);
+
+    lx_size_t quality = lx_quality();
+    lx_size_t size = LX_TEST_DEVICE_SCENE_WIDTH * LX_TEST_DEVICE_SCENE_HEIGHT * sizeof(lx_uint32_t);
+    lx_size_t i;
+    for (i = 0; i < 2; i++) {
+        lx_quality_set(i? LX_QUALITY_LOW : LX_QUALITY_TOP);
+        lx_uint32_t* data = lx_test_device_scene_bitmap(&scene);
+
+        // draw the same scene on the streamed device, all bands are written to the file
+        lx_stream_ref_t stream = lx_stream_init_file(LX_TEST_DEVICE_STREAM_FILE, "w");
+        lx_device_ref_t device = stream? lx_device_init_from_stream(stream, LX_PIXFMT_XRGB8888, LX_TEST_DEVICE_SCENE_WIDTH, LX_TEST_DEVICE_SCENE_HEIGHT, 2) : lx_null;
+        lx_canvas_ref_t canvas = device? lx_canvas_init(device) : lx_null;
+        if (!canvas) lx_abort();
+        if (lx_device_width(device) != LX_TEST_DEVICE_SCENE_WIDTH || lx_device_height(device) != LX_TEST_DEVICE_SCENE_HEIGHT) lx_abort();
+        lx_test_device_scene_draw(&scene, canvas);
+        lx_device_draw_commit(device);
+        lx_canvas_exit(canvas);
+        lx_device_exit(device);
+        lx_stream_exit(stream);
+
+        // the written pixels are same as the pixels of the bitmap device
+        lx_byte_t const* pixels = lx_null;
+        stream = lx_stream_init_file(LX_TEST_DEVICE_STREAM_FILE, "r");
+        if (!stream || lx_stream_size(stream) != size) lx_abort();
+        if (lx_stream_peek(stream, &pixels, size) != (lx_long_t)size || lx_memcmp(pixels, data, size)) lx_abort();
+        lx_stream_exit(stream);
+        lx_free(data);
+    }
+    lx_quality_set(quality);
+    lx_test_device_scene_exit(&scene);
+}
+
+int main(int argc, char** argv) {
+    lx_test_device_antialiasing();
+    lx_test_device_large_polygon();
+    lx_test_device_stroke_path();
+    lx_test_device_stroke_dash();
+    lx_test_device_hairline();
+    lx_test_device_stroke_polygon();
+    lx_test_device_stroke_offset();
+    lx_test_device_round_rect();
+    lx_test_device_clip();
+    lx_test_device_gradient();
+    lx_test_device_bitmap();
+    lx_test_device_premul();
+    lx_test_device_tiled();
+    lx_test_device_stream();
+    return 0;
+}
@@ -92,6 +92,27 @@ static lx_void_t lx_test_fixed_pool_underflow2() {
 }
 #endif
 
+static lx_void_t lx_test_fixed_pool_clear() {
+    lx_fixed_pool_ref_t pool = lx_fixed_pool_init(0, 64, lx_null, lx_null);
+    if (!pool) lx_abort();
+
+    // the cleared slots will be reused, so it need not allocate new slots
+    lx_size_t i;
+    lx_size_t round;
+    lx_size_t allocs = 0;
+    for (round = 0; round < 4; round++) {
+        for (i = 0; i < 10000; i++) {
+            if (!lx_fixed_pool_malloc(pool)) lx_abort();
+        }
+        if (lx_fixed_pool_size(pool) != 10000) lx_abort();
+        if (round && lx_fixed_pool_allocs(pool) != allocs) lx_abort();
+        allocs = lx_fixed_pool_allocs(pool);
+        lx_fixed_pool_clear(pool);
+        if (lx_fixed_pool_size(pool)) lx_abort();
+    }
+    lx_fixed_pool_exit(pool);
+}
+
 static lx_void_t lx_test_fixed_pool_perf(lx_size_t item_size) {
     lx_fixed_pool_ref_t pool = lx_null;
     do {
@@ -139,6 +160,8 @@ static lx_void_t lx_test_fixed_pool_perf(lx_size_t item_size) {
 }
 
 int main(int argc, char** argv) {
+    lx_test_fixed_pool_clear();
+
 #if 1
     lx_test_fixed_pool_perf(16);
     lx_test_fixed_pool_perf(32);
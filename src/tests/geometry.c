@@ -134,10 +134,64 @@ static lx_void_t lx_test_utils_geometry_intersection() {
     lx_trace_i("intersection: count: %lu, time: %lld ms", in, dt);
 }
 
+static lx_void_t lx_test_utils_geometry_bezier_make_line_points() {
+    // the curves
+    lx_point_t quad[3];
+    lx_point_t cubic[4];
+    lx_point_imake(&quad[0], 10, 200);
+    lx_point_imake(&quad[1], 150, -80);
+    lx_point_imake(&quad[2], 300, 120);
+    lx_point_imake(&cubic[0], 10, 200);
+    lx_point_imake(&cubic[1], 80, -100);
+    lx_point_imake(&cubic[2], 220, 400);
+    lx_point_imake(&cubic[3], 300, 20);
+
+    // the forward differencing points should be the uniform points on the curves
+    lx_size_t  i;
+    lx_size_t  count;
+    lx_point_t output[1 << LX_BEZIER3_DIVIDED_MAXN];
+    for (count = 0; count <= LX_BEZIER2_DIVIDED_MAXN; count++) {
+        lx_size_t n = lx_bezier2_make_line_points(quad, count, output);
+        if (n != (1 << count)) lx_abort();
+        for (i = 0; i < n; i++) {
+            lx_float_t t = (lx_float_t)(i + 1) / n;
+            lx_float_t x = (1 - t) * (1 - t) * quad[0].x + 2 * t * (1 - t) * quad[1].x + t * t * quad[2].x;
+            lx_float_t y = (1 - t) * (1 - t) * quad[0].y + 2 * t * (1 - t) * quad[1].y + t * t * quad[2].y;
+            if (lx_abs(output[i].x - x) > 0.01f || lx_abs(output[i].y - y) > 0.01f) lx_abort();
+        }
+        if (output[n - 1].x != quad[2].x || output[n - 1].y != quad[2].y) lx_abort();
+    }
+    for (count = 0; count <= LX_BEZIER3_DIVIDED_MAXN; count++) {
+        lx_size_t n = lx_bezier3_make_line_points(cubic, count, output);
+        if (n != (1 << count)) lx_abort();
+        for (i = 0; i < n; i++) {
+            lx_float_t t = (lx_float_t)(i + 1) / n;
+            lx_float_t a = (1 - t) * (1 - t) * (1 - t);
+            lx_float_t b = 3 * t * (1 - t) * (1 - t);
+            lx_float_t c = 3 * t * t * (1 - t);
+            lx_float_t d = t * t * t;
+            lx_float_t x = a * cubic[0].x + b * cubic[1].x + c * cubic[2].x + d * cubic[3].x;
+            lx_float_t y = a * cubic[0].y + b * cubic[1].y + c * cubic[2].y + d * cubic[3].y;
+            if (lx_abs(output[i].x - x) > 0.01f || lx_abs(output[i].y - y) > 0.01f) lx_abort();
+        }
+        if (output[n - 1].x != cubic[3].x || output[n - 1].y != cubic[3].y) lx_abort();
+    }
+
+    // the middle point should be same as the chopped point at the half position
+    lx_point_t chopped[7];
+    lx_bezier2_make_line_points(quad, 2, output);
+    lx_bezier2_chop_at_half(quad, chopped);
+    if (lx_abs(output[1].x - chopped[2].x) > 0.01f || lx_abs(output[1].y - chopped[2].y) > 0.01f) lx_abort();
+    lx_bezier3_make_line_points(cubic, 2, output);
+    lx_bezier3_chop_at_half(cubic, chopped);
+    if (lx_abs(output[1].x - chopped[3].x) > 0.01f || lx_abs(output[1].y - chopped[3].y) > 0.01f) lx_abort();
+}
+
 int main(int argc, char** argv) {
     lx_test_utils_geometry_is_ccw();
     lx_test_utils_geometry_in_point();
     lx_test_utils_geometry_in_segment();
     lx_test_utils_geometry_intersection();
+    lx_test_utils_geometry_bezier_make_line_points();
     return 0;
 }
@@ -0,0 +1,57 @@
+#include "lanox2d/lanox2d.h"
+
+// the guard bytes before and after the filled pixels
+#define LX_TEST_MEMSET_GUARD    (16)
+
+static lx_void_t lx_test_memset24_check(lx_size_t offset, lx_size_t n, lx_uint32_t c) {
+    lx_byte_t data[LX_TEST_MEMSET_GUARD * 2 + 256 * 3];
+    lx_assert(offset + n * 3 + LX_TEST_MEMSET_GUARD <= sizeof(data));
+    lx_memset(data, 0xcc, sizeof(data));
+
+    // fill the 24-bits pixels from the unaligned address
+    lx_byte_t* p = data + LX_TEST_MEMSET_GUARD + offset;
+    if (lx_memset24(p, c, n) != p) lx_abort();
+
+    // only the low 24-bits of all pixels are filled
+    lx_size_t i;
+    for (i = 0; i < n; i++) {
+        if (lx_bits_get_u24_ne(p + i * 3) != (c & 0xffffff)) {
+            lx_trace_i("memset24: offset: %lu, n: %lu, pixel[%lu]: %#x != %#x", offset, n, i, lx_bits_get_u24_ne(p + i * 3), c & 0xffffff);
+            lx_abort();
+        }
+    }
+
+    // the guard bytes are not changed
+    for (i = 0; i < sizeof(data); i++) {
+        if ((i < LX_TEST_MEMSET_GUARD + offset || i >= LX_TEST_MEMSET_GUARD + offset + n * 3) && data[i] != 0xcc) {
+            lx_trace_i("memset24: offset: %lu, n: %lu, byte[%lu] is changed", offset, n, i);
+            lx_abort();
+        }
+    }
+}
+
+static lx_void_t lx_test_memset24() {
+    lx_size_t n;
+    lx_size_t offset;
+    lx_uint32_t c = 0x12345678;
+    for (n = 0; n <= 64; n++) {
+        for (offset = 0; offset < LX_TEST_MEMSET_GUARD; offset++) {
+            lx_test_memset24_check(offset, n, c);
+            c = c * 1103515245 + 12345;
+        }
+    }
+
+    // the multiple simd blocks with the tails
+    lx_size_t sizes[] = {95, 96, 97, 191, 192, 193, 255};
+    for (n = 0; n < lx_arrayn(sizes); n++) {
+        for (offset = 0; offset < LX_TEST_MEMSET_GUARD; offset++) {
+            lx_test_memset24_check(offset, sizes[n], c);
+            c = c * 1103515245 + 12345;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    lx_test_memset24();
+    return 0;
+}
@@ -1,6 +1,83 @@
 #include "lanox2d/lanox2d.h"
 
+static lx_void_t lx_test_path_generation() {
+    lx_path_ref_t path = lx_path_init();
+    lx_path_ref_t other = lx_path_init();
+    if (!path || !other) lx_abort();
+
+    // each modified path gets a new generation
+    lx_size_t generation = lx_path_generation(path);
+    lx_path_move2i_to(path, 10, 10);
+    lx_path_line2i_to(path, 100, 10);
+    lx_path_quad2i_to(path, 100, 100, 10, 100);
+    if (lx_path_generation(path) == generation) lx_abort();
+
+    // it will not be changed if we only read it
+    generation = lx_path_generation(path);
+    lx_path_hint(path);
+    if (!lx_path_polygon(path) || !lx_path_bounds(path)) lx_abort();
+    if (lx_path_generation(path) != generation) lx_abort();
+
+    // the copied path is a new path with the different generation
+    lx_path_copy(other, path);
+    if (lx_path_generation(other) == generation || lx_path_generation(path) != generation) lx_abort();
+
+    // the transformed and cleared path gets a new generation too
+    lx_matrix_t matrix;
+    lx_matrix_init_scale(&matrix, 2, 2);
+    generation = lx_path_generation(other);
+    lx_path_apply(other, &matrix);
+    if (lx_path_generation(other) == generation) lx_abort();
+    generation = lx_path_generation(other);
+    lx_path_clear(other);
+    if (lx_path_generation(other) == generation) lx_abort();
+
+    lx_path_exit(other);
+    lx_path_exit(path);
+}
+
+static lx_void_t lx_test_path_polygon_for_matrix() {
+    lx_path_ref_t path = lx_path_init();
+    if (!path) lx_abort();
+
+    // the unscaled curve is divided as lx_bezier2_divide_line_count()
+    lx_point_t points[3];
+    lx_point_imake(&points[0], 10, 10);
+    lx_point_imake(&points[1], 100, 100);
+    lx_point_imake(&points[2], 10, 190);
+    lx_path_move_to(path, &points[0]);
+    lx_path_quad_to(path, &points[1], &points[2]);
+    lx_quality_set(LX_QUALITY_TOP);
+    lx_polygon_ref_t polygon = lx_path_polygon(path);
+    if (!polygon || polygon->total != 1 + ((lx_size_t)1 << lx_bezier2_divide_line_count(points))) lx_abort();
+
+    // the zoomed-in curve is divided into more lines
+    lx_matrix_t matrix;
+    lx_matrix_init_scale(&matrix, 8, 8);
+    lx_size_t total = polygon->total;
+    lx_polygon_ref_t polygon_zoomed = lx_path_polygon_for_matrix(path, &matrix);
+    if (!polygon_zoomed || polygon_zoomed == polygon || polygon_zoomed->total <= total) lx_abort();
+
+    // the polygons of the different scale classes are all cached
+    lx_size_t total_zoomed = polygon_zoomed->total;
+    if (lx_path_polygon(path) != polygon || polygon->total != total) lx_abort();
+    if (lx_path_polygon_for_matrix(path, &matrix) != polygon_zoomed || polygon_zoomed->total != total_zoomed) lx_abort();
+
+    // the matrices in the same scale class share the same polygon
+    lx_matrix_init_scale(&matrix, 7, 7);
+    if (lx_path_polygon_for_matrix(path, &matrix) != polygon_zoomed) lx_abort();
+
+    // all cached polygons will be remade after modifying the path
+    lx_path_line2i_to(path, 10, 10);
+    polygon = lx_path_polygon(path);
+    if (!polygon || polygon->total != total + 1) lx_abort();
+    lx_path_exit(path);
+}
+
 int main(int argc, char** argv) {
+    lx_test_path_generation();
+    lx_test_path_polygon_for_matrix();
+
     lx_path_ref_t path = lx_path_init();
     if (path) {
         // init path
@@ -0,0 +1,146 @@
+#include "lanox2d/lanox2d.h"
+
+#define LX_TEST_PICTURE_WIDTH   (200)
+#define LX_TEST_PICTURE_HEIGHT  (160)
+
+typedef lx_void_t (*lx_test_picture_scene_t)(lx_canvas_ref_t canvas);
+
+static lx_void_t lx_test_picture_scene_clip(lx_canvas_ref_t canvas) {
+    lx_canvas_draw_clear(canvas, LX_COLOR_WHITE);
+    lx_paint_ref_t paint = lx_canvas_paint(canvas);
+    lx_paint_mode_set(paint, LX_PAINT_MODE_FILL);
+    lx_paint_color_set(paint, LX_COLOR_RED);
+
+    // draw with the intersected circle
+    lx_canvas_save_clipper(canvas);
+    lx_canvas_clip_circle2i(canvas, LX_CLIPPER_MODE_INTERSECT, 100, 80, 50);
+    lx_canvas_draw_rect2i(canvas, 20, 20, 160, 120);
+
+    // draw with the union path
+    lx_path_ref_t path = lx_path_init();
+    if (path) {
+        lx_path_move2i_to(path, 10, 10);
+        lx_path_line2i_to(path, 190, 20);
+        lx_path_line2i_to(path, 30, 150);
+        lx_path_close(path);
+        lx_canvas_clip_path(canvas, LX_CLIPPER_MODE_UNION, path);
+        lx_path_exit(path);
+    }
+    lx_paint_color_set(paint, LX_COLOR_BLUE);
+    lx_paint_alpha_set(paint, 128);
+    lx_canvas_draw_rect2i(canvas, 0, 0, 200, 160);
+    lx_canvas_load_clipper(canvas);
+
+    // draw without clipper
+    lx_paint_color_set(paint, LX_COLOR_GREEN);
+    lx_canvas_draw_circle2i(canvas, 160, 120, 30);
+}
+
+static lx_void_t lx_test_picture_scene_blend(lx_canvas_ref_t canvas) {
+    lx_canvas_draw_clear(canvas, LX_COLOR_WHITE);
+    lx_paint_ref_t paint = lx_canvas_paint(canvas);
+    lx_paint_mode_set(paint, LX_PAINT_MODE_FILL);
+    lx_paint_color_set(paint, LX_COLOR_RED);
+    lx_canvas_draw_rect2i(canvas, 10, 10, 120, 100);
+
+    // only the blend mode is changed, the recorded paint should be changed too
+    lx_paint_blend_mode_set(paint, LX_PAINT_BLEND_MODE_CLEAR);
+    lx_canvas_draw_rect2i(canvas, 40, 30, 120, 100);
+    lx_paint_blend_mode_set(paint, LX_PAINT_BLEND_MODE_MULTIPLY);
+    lx_paint_color_set(paint, LX_COLOR_BLUE);
+    lx_canvas_draw_circle2i(canvas, 100, 80, 40);
+    lx_paint_blend_mode_set(paint, LX_PAINT_BLEND_MODE_SRC_OVER);
+    lx_canvas_draw_circle2i(canvas, 160, 120, 20);
+}
+
+static lx_void_t lx_test_picture_scene_dash(lx_canvas_ref_t canvas) {
+    lx_canvas_draw_clear(canvas, LX_COLOR_WHITE);
+    lx_paint_ref_t paint = lx_canvas_paint(canvas);
+    lx_paint_mode_set(paint, LX_PAINT_MODE_STROKE);
+    lx_paint_color_set(paint, LX_COLOR_RED);
+    lx_paint_stroke_width_set(paint, 6);
+    lx_canvas_draw_circle2i(canvas, 100, 80, 50);
+
+    // only the dash intervals and phase are changed, the recorded paint should be changed too
+    lx_float_t intervals[] = {12, 6, 3};
+    lx_paint_stroke_dash_set(paint, intervals, 3, 0);
+    lx_canvas_draw_circle2i(canvas, 100, 80, 30);
+    lx_paint_stroke_dash_set(paint, intervals, 3, 7);
+    lx_canvas_draw_line2i(canvas, 10, 150, 190, 150);
+    lx_paint_stroke_dash_set(paint, lx_null, 0, 0);
+    lx_canvas_draw_rect2i(canvas, 20, 20, 160, 120);
+}
+
+typedef struct lx_test_picture_target_t_ {
+    lx_bitmap_ref_t bitmap;
+    lx_device_ref_t device;
+    lx_canvas_ref_t canvas;
+}lx_test_picture_target_t;
+
+static lx_canvas_ref_t lx_test_picture_target_init(lx_test_picture_target_t* target, lx_pointer_t data) {
+    target->bitmap = lx_bitmap_init(data, LX_PIXFMT_XRGB8888, LX_TEST_PICTURE_WIDTH, LX_TEST_PICTURE_HEIGHT, 0, lx_false);
+    target->device = target->bitmap? lx_device_init_from_bitmap(target->bitmap) : lx_null;
+    target->canvas = target->device? lx_canvas_init(target->device) : lx_null;
+    if (!target->canvas) lx_abort();
+
+    // offset and clip the canvas, the picture should be replayed relative to them
+    lx_canvas_translate(target->canvas, 8, 4);
+    lx_canvas_clip_rect2i(target->canvas, LX_CLIPPER_MODE_INTERSECT, 4, 4, 180, 140);
+    return target->canvas;
+}
+
+static lx_void_t lx_test_picture_target_exit(lx_test_picture_target_t* target) {
+    lx_canvas_exit(target->canvas);
+    lx_device_exit(target->device);
+    lx_bitmap_exit(target->bitmap);
+}
+
+/* the replayed picture should be same as drawing it directly
+ *
+ * and the clipper of canvas will be not changed after drawing picture
+ */
+static lx_void_t lx_test_picture_replay(lx_test_picture_scene_t scene) {
+    lx_size_t    size = LX_TEST_PICTURE_WIDTH * LX_TEST_PICTURE_HEIGHT;
+    lx_uint32_t* data_drawn = lx_nalloc0_type(size, lx_uint32_t);
+    lx_uint32_t* data_replayed = lx_nalloc0_type(size, lx_uint32_t);
+    if (!data_drawn || !data_replayed) lx_abort();
+
+    // draw it directly
+    lx_test_picture_target_t target;
+    scene(lx_test_picture_target_init(&target, data_drawn));
+    lx_test_picture_target_exit(&target);
+
+    // record it
+    lx_picture_ref_t picture = lx_picture_init();
+    lx_device_ref_t  device = picture? lx_device_init_from_picture(picture) : lx_null;
+    lx_canvas_ref_t  recorder = device? lx_canvas_init(device) : lx_null;
+    if (!recorder) lx_abort();
+    scene(recorder);
+    lx_canvas_exit(recorder);
+    lx_device_exit(device);
+
+    // replay it
+    lx_canvas_ref_t canvas = lx_test_picture_target_init(&target, data_replayed);
+    lx_picture_draw(canvas, picture);
+    if (lx_clipper_size(lx_canvas_clipper(canvas)) != 1) lx_abort();
+    lx_test_picture_target_exit(&target);
+    lx_picture_exit(picture);
+
+    // check
+    lx_size_t i;
+    for (i = 0; i < size; i++) {
+        if (data_drawn[i] != data_replayed[i]) {
+            lx_trace_i("replayed pixel(%lu, %lu): %x != %x", i % LX_TEST_PICTURE_WIDTH, i / LX_TEST_PICTURE_WIDTH, data_replayed[i], data_drawn[i]);
+            lx_abort();
+        }
+    }
+    lx_free(data_drawn);
+    lx_free(data_replayed);
+}
+
+int main(int argc, char** argv) {
+    lx_test_picture_replay(lx_test_picture_scene_clip);
+    lx_test_picture_replay(lx_test_picture_scene_blend);
+    lx_test_picture_replay(lx_test_picture_scene_dash);
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include "lanox2d/lanox2d.h"
+#include "lanox2d/core/pixmap/blend.h"
+
+// the maximum count of the blended pixels
+#define LX_TEST_PIXMAP_MAXN     (256 + 16)
+
+// the extra pixels before and after the blended pixels, they need not be changed
+#define LX_TEST_PIXMAP_EXTRA    (8)
+
+typedef lx_size_t (*lx_test_pixmap_rgb32_blend_t)(lx_uint32_t* p, lx_pixel_t pixel, lx_size_t count, lx_byte_t alpha);
+typedef lx_size_t (*lx_test_pixmap_rgb16_blend_t)(lx_uint16_t* p, lx_uint32_t s, lx_size_t count, lx_byte_t alpha, lx_size_t lshift, lx_size_t rshift, lx_uint32_t mask, lx_uint16_t bits);
+
+// the blend kernel type
+typedef struct lx_test_pixmap_kernel_t_ {
+    lx_char_t const*                name;
+    lx_size_t                       feature;
+    lx_test_pixmap_rgb32_blend_t    rgb32_blend;
+    lx_test_pixmap_rgb16_blend_t    rgb16_blend;
+}lx_test_pixmap_kernel_t;
+
+/* the rgb16 pixfmt type
+ *
+ * the arguments of the rgb16 kernel are same as the arguments passed by the pixels_fill of this pixfmt
+ */
+typedef struct lx_test_pixmap_rgb16_t_ {
+    lx_size_t                       pixfmt;
+    lx_uint32_t                     mask;
+    lx_size_t                       lshift;
+    lx_size_t                       rshift;
+    lx_uint16_t                     bits;
+}lx_test_pixmap_rgb16_t;
+
+// the simd kernels from the highest level to the lowest level
+static lx_test_pixmap_kernel_t g_kernels[] = {
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX512
+    {"avx512",  LX_CPU_FEATURE_AVX512,  lx_pixmap_rgb32_pixels_blend_avx512,    lx_pixmap_rgb16_pixels_blend_avx512},
+#endif
+#ifdef LX_PIXMAP_ARCH_BLEND_AVX2
+    {"avx2",    LX_CPU_FEATURE_AVX2,    lx_pixmap_rgb32_pixels_blend_avx2,      lx_pixmap_rgb16_pixels_blend_avx2},
+#endif
+#ifdef LX_PIXMAP_ARCH_BLEND_SSE2
+    {"sse2",    LX_CPU_FEATURE_SSE2,    lx_pixmap_rgb32_pixels_blend_sse2,      lx_pixmap_rgb16_pixels_blend_sse2},
+#endif
+#if defined(LX_ARCH_ARM_NEON) && defined(LX_PIXMAP_ARCH_BLEND)
+    {"neon",    LX_CPU_FEATURE_NEON,    lx_pixmap_rgb32_pixels_blend_opt,       lx_pixmap_rgb16_pixels_blend_opt},
+#endif
+    {lx_null,   0,                      lx_null,                                lx_null}
+};
+
+static lx_test_pixmap_rgb16_t g_rgb16[] = {
+    {LX_PIXFMT_RGB565,      0x7e0f81f,  16, 16, 0}
+,   {LX_PIXFMT_ARGB1555,    0x41f07c1f, 15, 15, 0x8000}
+,   {LX_PIXFMT_ARGB4444,    0x0f0f0f0f, 12, 12, 0}
+,   {LX_PIXFMT_XRGB4444,    0x000f0f0f, 16, 12, 0xf000}
+};
+
+static lx_uint32_t lx_test_pixmap_rand() {
+    static lx_uint32_t rand = 0xbeaf;
+    rand = rand * 1103515245 + 12345;
+    return (rand >> 16) | (rand << 16);
+}
+
+static lx_void_t lx_test_pixmap_rand_fill(lx_byte_t* data, lx_size_t size) {
+    lx_size_t i;
+    for (i = 0; i < size; i++) {
+        data[i] = (lx_byte_t)lx_test_pixmap_rand();
+    }
+}
+
+// the span lengths of the whole simd blocks with all tail lengths
+static lx_size_t lx_test_pixmap_count(lx_size_t i) {
+    static lx_size_t blocks[] = {0, 16, 32, 64, 256};
+    return blocks[(i >> 4) % lx_arrayn(blocks)] + (i & 15);
+}
+
+static lx_void_t lx_test_pixmap_rgb32_check(lx_test_pixmap_kernel_t const* kernel, lx_size_t pixfmt) {
+    lx_uint32_t data[LX_TEST_PIXMAP_MAXN + LX_TEST_PIXMAP_EXTRA * 2];
+    lx_uint32_t blended[LX_TEST_PIXMAP_MAXN + LX_TEST_PIXMAP_EXTRA * 2];
+    lx_pixmap_ref_t pixmap = lx_pixmap(pixfmt, 0x80);
+    if (!pixmap || pixmap->btp != 4) lx_abort();
+
+    lx_size_t i;
+    lx_size_t j;
+    for (i = 0; i < 80 * 4; i++) {
+        lx_size_t   count = lx_test_pixmap_count(i);
+        lx_size_t   offset = LX_TEST_PIXMAP_EXTRA - (i & 3);
+        lx_pixel_t  pixel = lx_test_pixmap_rand();
+        lx_byte_t   alpha = (lx_byte_t)lx_test_pixmap_rand();
+        lx_test_pixmap_rand_fill((lx_byte_t*)data, sizeof(data));
+        lx_memcpy(blended, data, sizeof(data));
+
+        // blend all pixels one by one with the scalar version, the simd kernels need more pixels
+        for (j = 0; j < count; j++) {
+            pixmap->pixels_fill(data + offset + j, pixel, 1, alpha);
+        }
+
+        // blend the simd blocks and the left pixels
+        if (kernel) {
+            lx_size_t n = kernel->rgb32_blend(blended + offset, pixel, count, alpha);
+            if (n > count) lx_abort();
+            pixmap->pixels_fill(blended + offset + n, pixel, count - n, alpha);
+        } else {
+            pixmap->pixels_fill(blended + offset, pixel, count, alpha);
+        }
+        if (lx_memcmp(data, blended, sizeof(data))) {
+            lx_trace_i("%s: %s, count: %lu, alpha: %#x", kernel? kernel->name : "dispatch", pixmap->name, count, alpha);
+            lx_abort();
+        }
+    }
+}
+
+static lx_void_t lx_test_pixmap_rgb16_check(lx_test_pixmap_kernel_t const* kernel, lx_test_pixmap_rgb16_t const* rgb16) {
+    lx_uint16_t data[LX_TEST_PIXMAP_MAXN + LX_TEST_PIXMAP_EXTRA * 2];
+    lx_uint16_t blended[LX_TEST_PIXMAP_MAXN + LX_TEST_PIXMAP_EXTRA * 2];
+    lx_pixmap_ref_t pixmap = lx_pixmap(rgb16->pixfmt, 0x80);
+    if (!pixmap || pixmap->btp != 2) lx_abort();
+
+    lx_size_t i;
+    lx_size_t j;
+    for (i = 0; i < 80 * 4; i++) {
+        lx_size_t   count = lx_test_pixmap_count(i);
+        lx_size_t   offset = LX_TEST_PIXMAP_EXTRA - (i & 7);
+        lx_pixel_t  pixel = lx_test_pixmap_rand() & 0xffff;
+        lx_byte_t   alpha = (lx_byte_t)lx_test_pixmap_rand();
+        lx_test_pixmap_rand_fill((lx_byte_t*)data, sizeof(data));
+        lx_memcpy(blended, data, sizeof(data));
+
+        for (j = 0; j < count; j++) {
+            pixmap->pixels_fill(data + offset + j, pixel, 1, alpha);
+        }
+        if (kernel) {
+            lx_size_t n = kernel->rgb16_blend(blended + offset, (pixel | (pixel << 16)) & rgb16->mask, count, alpha >> 3, rgb16->lshift, rgb16->rshift, rgb16->mask, rgb16->bits);
+            if (n > count) lx_abort();
+            pixmap->pixels_fill(blended + offset + n, pixel, count - n, alpha);
+        } else {
+            pixmap->pixels_fill(blended + offset, pixel, count, alpha);
+        }
+        if (lx_memcmp(data, blended, sizeof(data))) {
+            lx_trace_i("%s: %s, count: %lu, alpha: %#x", kernel? kernel->name : "dispatch", pixmap->name, count, alpha);
+            lx_abort();
+        }
+    }
+}
+
+/* check all supported simd kernels and the dispatched kernel with the scalar version
+ *
+ * the supported kernels are limited by LX_CPU_LEVEL, e.g. LX_CPU_LEVEL=sse2 only checks the sse2 kernel,
+ * and the dispatched kernel is the kernel of this level.
+ */
+static lx_void_t lx_test_pixmap_blend() {
+    lx_size_t quality = lx_quality();
+    lx_quality_set(LX_QUALITY_TOP);
+
+    lx_size_t i;
+    lx_size_t j;
+    lx_size_t features = lx_cpu_features();
+    for (i = 0; g_kernels[i].name; i++) {
+        if (features & g_kernels[i].feature) {
+            lx_test_pixmap_rgb32_check(&g_kernels[i], LX_PIXFMT_XRGB8888);
+            lx_test_pixmap_rgb32_check(&g_kernels[i], LX_PIXFMT_ARGB8888);
+            for (j = 0; j < lx_arrayn(g_rgb16); j++) {
+                lx_test_pixmap_rgb16_check(&g_kernels[i], &g_rgb16[j]);
+            }
+        }
+    }
+    lx_test_pixmap_rgb32_check(lx_null, LX_PIXFMT_XRGB8888);
+    lx_test_pixmap_rgb32_check(lx_null, LX_PIXFMT_ARGB8888);
+    for (j = 0; j < lx_arrayn(g_rgb16); j++) {
+        lx_test_pixmap_rgb16_check(lx_null, &g_rgb16[j]);
+    }
+
+#ifdef LX_ARCH_SIMD_DISPATCH
+    // the first supported kernel of the forced level is selected
+    lx_uint32_t pixel = 0;
+    lx_pixmap_rgb32_pixels_blend_opt(&pixel, 0, 1, 0x80);
+    for (i = 0; g_kernels[i].name && !(features & g_kernels[i].feature); i++) ;
+    if (g_kernels[i].name? g_pixmap_rgb32_pixels_blend != g_kernels[i].rgb32_blend : g_pixmap_rgb32_pixels_blend != lx_pixmap_rgb32_pixels_blend_none) {
+        lx_abort();
+    }
+#endif
+    lx_quality_set(quality);
+}
+
+/* check the color => pixel => color and pixel => color => pixel round trips of the premultiplied pixfmts
+ *
+ * the unpremultiplied color loses the low bits of the translucent color, its error is about 128 / alpha,
+ * but the premultiplied pixel with the channels not larger than alpha is always restored exactly.
+ */
+static lx_void_t lx_test_pixmap_premul_check(lx_size_t pixfmt, lx_bool_t rgba) {
+    lx_pixmap_ref_t pixmap = lx_pixmap(pixfmt, 0xff);
+    if (!pixmap || !pixmap->pixel || !pixmap->color) lx_abort();
+
+    lx_size_t a;
+    lx_size_t c;
+    for (a = 0; a < 256; a++) {
+        lx_long_t tolerance = a? 128 / (lx_long_t)a + 1 : 0;
+        for (c = 0; c < 256; c++) {
+
+            // color => pixel => color, the transparent color is always transparent black
+            lx_color_t color = lx_color_make((lx_byte_t)a, (lx_byte_t)c, (lx_byte_t)(255 - c), (lx_byte_t)(c >> 1));
+            lx_color_t result = pixmap->color(pixmap->pixel(color));
+            if (!a) {
+                if (lx_color_pixel(result)) lx_abort();
+            } else if (result.a != color.a || (a == 0xff && lx_color_pixel(result) != lx_color_pixel(color))
+                ||  lx_abs((lx_long_t)result.r - color.r) > tolerance
+                ||  lx_abs((lx_long_t)result.g - color.g) > tolerance
+                ||  lx_abs((lx_long_t)result.b - color.b) > tolerance) {
+                lx_trace_i("%s: %{color} => %{color}", pixmap->name, &color, &result);
+                lx_abort();
+            }
+
+            // color_set and color_get are same as pixel and color
+            lx_uint32_t data = 0;
+            lx_color_t  stored;
+            pixmap->color_set(&data, color);
+            stored = pixmap->color_get(&data);
+            if (lx_color_pixel(stored) != lx_color_pixel(result)) lx_abort();
+
+            // pixel => color => pixel, the premultiplied channels are (c, a - c, c / 2)
+            if (c <= a) {
+                lx_pixel_t pixel = ((lx_pixel_t)c << 16) | ((lx_pixel_t)(a - c) << 8) | (lx_pixel_t)(c >> 1);
+                pixel = rgba? (pixel << 8) | (lx_pixel_t)a : pixel | ((lx_pixel_t)a << 24);
+                if (pixmap->pixel(pixmap->color(pixel)) != pixel) {
+                    lx_trace_i("%s: %#x => %#x", pixmap->name, pixel, pixmap->pixel(pixmap->color(pixel)));
+                    lx_abort();
+                }
+            }
+        }
+    }
+}
+
+static lx_void_t lx_test_pixmap_premul() {
+    lx_test_pixmap_premul_check(LX_PIXFMT_ARGB8888_PREMUL, lx_false);
+    lx_test_pixmap_premul_check(LX_PIXFMT_RGBA8888_PREMUL, lx_true);
+    lx_test_pixmap_premul_check(LX_PIXFMT_ARGB8888_PREMUL | LX_PIXFMT_BENDIAN, lx_false);
+    lx_test_pixmap_premul_check(LX_PIXFMT_RGBA8888_PREMUL | LX_PIXFMT_BENDIAN, lx_true);
+}
+
+int main(int argc, char** argv) {
+    lx_test_pixmap_blend();
+    lx_test_pixmap_premul();
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "lanox2d/lanox2d.h"
+
+#define LX_TEST_TESSELLATOR_CIRCLES     (6)
+#define LX_TEST_TESSELLATOR_POINTS      (64)
+
+/* make the circles with holes
+ *
+ *   ----     ----     ----
+ *  | +  |   | -  |   | +  |
+ *   ----     ----     ----
+ *   ----     ----     ----
+ *  | -  |   | +  |   | -  |
+ *   ----     ----     ----
+ *
+ * the odd circles are clockwise and they are overlapped with the neighbours
+ */
+static lx_size_t lx_test_tessellator_make_circles(lx_point_ref_t points, lx_uint32_t* counts, lx_float_t phase) {
+    lx_size_t i;
+    lx_size_t j;
+    lx_size_t n = 0;
+    for (j = 0; j < LX_TEST_TESSELLATOR_CIRCLES; j++) {
+        lx_size_t  start = n;
+        lx_float_t cx = 100.0f + (j % 3) * 100.0f;
+        lx_float_t cy = 120.0f + (j / 3) * 150.0f;
+        lx_float_t r = 70.0f + 10.0f * lx_sinf(phase + j);
+        for (i = 0; i < LX_TEST_TESSELLATOR_POINTS; i++) {
+            lx_float_t a = (j & 1? -1.0f : 1.0f) * i * 2 * LX_PI / LX_TEST_TESSELLATOR_POINTS;
+            lx_point_make(&points[n++], cx + r * lx_cosf(a), cy + r * lx_sinf(a));
+        }
+        points[n++] = points[start];
+        counts[j] = (lx_uint32_t)(n - start);
+    }
+    counts[j] = 0;
+    return n;
+}
+
+/* tessellate the similar polygons repeatedly
+ *
+ * the mesh, event queue, active regions and output polygon are reused after the first tessellation,
+ * so the allocation count should not be changed.
+ */
+static lx_void_t lx_test_tessellator_allocs(lx_size_t mode) {
+    lx_tessellator_ref_t tessellator = lx_tessellator_init();
+    if (!tessellator) lx_abort();
+    lx_tessellator_mode_set(tessellator, mode);
+    lx_tessellator_rule_set(tessellator, LX_TESSELLATOR_RULE_NONZERO);
+
+    lx_size_t    i;
+    lx_size_t    allocs = 0;
+    lx_point_t   points[LX_TEST_TESSELLATOR_CIRCLES * (LX_TEST_TESSELLATOR_POINTS + 1)];
+    lx_uint32_t  counts[LX_TEST_TESSELLATOR_CIRCLES + 1];
+    lx_rect_t    bounds = {0, 0, 400, 400};
+    lx_polygon_t polygon;
+    for (i = 0; i < 8; i++) {
+        lx_size_t total = lx_test_tessellator_make_circles(points, counts, i * 0.001f);
+        lx_polygon_make(&polygon, points, counts, total, lx_false);
+        lx_polygon_ref_t result = lx_tessellator_make(tessellator, &polygon, &bounds);
+        if (!result || !result->total) lx_abort();
+
+        // warm up at the first two tessellations
+        if (i == 1) allocs = lx_tessellator_allocs(tessellator);
+        else if (i > 1 && lx_tessellator_allocs(tessellator) != allocs) {
+            lx_trace_i("mode: %lu, allocs: %lu != %lu", mode, lx_tessellator_allocs(tessellator), allocs);
+            lx_abort();
+        }
+    }
+    lx_tessellator_exit(tessellator);
+}
+
+int main(int argc, char** argv) {
+    lx_test_tessellator_allocs(LX_TESSELLATOR_MODE_CONVEX);
+    lx_test_tessellator_allocs(LX_TESSELLATOR_MODE_MONOTONE);
+    lx_test_tessellator_allocs(LX_TESSELLATOR_MODE_TRIANGULATION);
+    return 0;
+}
@@ -75,5 +75,6 @@ function check_interfaces()
     if not is_plat("windows") then
         check_module_cfuncs("posix", "dlfcn.h",  "dlopen")
         check_module_cfuncs("posix", "unistd.h", "getpagesize", "sysconf")
+        check_module_cfuncs("posix", "pthread.h", "pthread_create")
     end
 end
@@ -11,7 +11,7 @@ option("small",    {showmenu = true, default = true, configvar = {"LX_CONFIG_SMA
 -- pixfmt option
 option("pixfmt")
     set_showmenu(true)
-    set_default("rgb565,xrgb8888,argb8888,rgbx8888,rgba8888")
+    set_default("rgb565,xrgb8888,argb8888,rgbx8888,rgba8888,argb8888_premul,rgba8888_premul")
     set_description("Enable pixel formats")
     after_check(function (option)
         local value = option:value()